@@ -0,0 +1,49 @@
+/*
+ *   Copyright (C) 2021-2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "APRSFrameView.h"
+
+CAPRSFrameView::CAPRSFrameView() :
+m_source(),
+m_destination(),
+m_path(),
+m_body(),
+m_type(APFT_UNKNOWN)
+{
+
+}
+
+void CAPRSFrameView::clear()
+{
+    m_source = std::string_view();
+    m_destination = std::string_view();
+    m_path.clear();
+    m_body = std::string_view();
+    m_type = APFT_UNKNOWN;
+}
+
+void CAPRSFrameView::toFrame(CAPRSFrame& frame, bool withPath) const
+{
+    frame.getSource().assign(m_source);
+    frame.getDestination().assign(m_destination);
+    frame.getPath().clear();
+    if(withPath)
+        frame.getPath().assign(m_path.begin(), m_path.end());
+    frame.getBody().assign(m_body);
+    frame.getType() = m_type;
+}
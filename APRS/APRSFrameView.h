@@ -0,0 +1,53 @@
+/*
+ *   Copyright (C) 2021-2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+#include "APRSFrame.h"
+
+// Parsed APRS frame pointing into the text it was parsed from, only valid as long as that text is
+class CAPRSFrameView {
+public:
+    CAPRSFrameView();
+
+    void clear();
+    std::string_view& getSource() { return m_source; }
+    std::string_view& getDestination() { return m_destination; }
+    std::vector<std::string_view>& getPath() { return m_path; }
+    std::string_view& getBody() { return m_body; }
+    APRS_FRAME_TYPE& getType() { return m_type; }
+
+    const std::string_view& getSource() const { return m_source; }
+    const std::string_view& getDestination() const { return m_destination; }
+    const std::vector<std::string_view>& getPath() const { return m_path; }
+    const std::string_view& getBody() const { return m_body; }
+    APRS_FRAME_TYPE getType() const { return m_type; }
+
+    // Copies the frame out for keeping
+    void toFrame(CAPRSFrame& frame, bool withPath = true) const;
+
+private:
+    std::string_view m_source;
+    std::string_view m_destination;
+    std::vector<std::string_view> m_path;
+    std::string_view m_body;
+    APRS_FRAME_TYPE m_type;
+};
@@ -16,50 +16,71 @@
  *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
  */
 
+#include <algorithm>
+
 #include "APRSParser.h"
 #include "Log.h"
 
 bool CAPRSParser::parseFrame(const std::string& frameStr, CAPRSFrame& frame)
-{   
-    frame.clear();
-    bool ret = false;
+{
+    CAPRSFrameView view;
+    bool ret = parseFrame(std::string_view(frameStr), view);
 
-    if(!frameStr.empty()) {
-        auto pos = frameStr.find_first_of(':');
-        if(pos != std::string::npos && pos != frameStr.length() - 1) {
-            auto header = frameStr.substr(0, pos); // contains source, dest and path
-            auto body = frameStr.substr(pos +1);
+    if(ret)
+        view.toFrame(frame);
+    else
+        frame.clear();
 
-            std::vector<std::string> headerSplits;
-            boost::split(headerSplits, header, [](char c) { return c == ',' || c == '>';});
+    return ret;
+}
 
-             //we need at least source and dest to form a valid frame, also headers shall not contain empty strings
-            if(headerSplits.size() >= 2 && std::none_of(headerSplits.begin(), headerSplits.end(), [](std::string s){ return s.empty(); })) {
-                frame.getSource().assign(headerSplits[0]);
-                frame.getDestination().assign(headerSplits[1]);
+bool CAPRSParser::parseFrame(std::string_view frameStr, CAPRSFrameView& frame)
+{
+    frame.clear();
 
-                for(unsigned int i = 2; i < headerSplits.size(); i++) {
-                    frame.getPath().push_back(headerSplits[i]);
-                }
+    auto pos = frameStr.find(':');
+    if(pos == std::string_view::npos || pos == frameStr.length() - 1)
+        return false;
 
-                frame.getBody().assign(body);
+    auto header = frameStr.substr(0, pos); // contains source, dest and path
+    frame.getBody() = frameStr.substr(pos + 1);
 
-                ret = parseInt(frame);
-                if(!ret) {
-                    frame.clear();
-                }
-            }
+    //we need at least source and dest to form a valid frame, also headers shall not contain empty strings
+    unsigned int count = 0U;
+    size_t start = 0U;
+    for(size_t i = 0U; i <= header.length(); i++) {
+        if(i != header.length() && header[i] != ',' && header[i] != '>')
+            continue;
+
+        if(i == start) {
+            frame.clear();
+            return false;
         }
+
+        auto field = header.substr(start, i - start);
+        if(count == 0U)
+            frame.getSource() = field;
+        else if(count == 1U)
+            frame.getDestination() = field;
+        else
+            frame.getPath().push_back(field);
+        count++;
+        start = i + 1U;
     }
 
-    return ret;
+    if(count < 2U || !parseInt(frame)) {
+        frame.clear();
+        return false;
+    }
+
+    return true;
 }
 
-bool CAPRSParser::parseInt(CAPRSFrame& frame)
+bool CAPRSParser::parseInt(CAPRSFrameView& frame)
 {
     APRS_FRAME_TYPE type = APFT_UNKNOWN;
     unsigned char typeChar = frame.getBody()[0];
-    std::string body(frame.getBody().substr(1));//strip the type char for processing purposes
+    std::string_view body(frame.getBody().substr(1));//strip the type char for processing purposes
     
     if(body.empty())
         return false;
@@ -84,7 +105,7 @@ bool CAPRSParser::parseInt(CAPRSFrame& frame)
                 */
                 type = APFT_POSITION;
                 if(typeChar == '/' || typeChar== '@')//With a prepended timestamp, jump over it. 
-                    body = body.substr(7U);
+                    body.remove_prefix(7U);
 
                 auto posChar = body[0];
                 if(valid_sym_table_compressed(posChar)//Compressed format
@@ -107,16 +128,16 @@ bool CAPRSParser::parseInt(CAPRSFrame& frame)
             break;
         case ':':
             // we have either message or telemetry labels or telemetry EQNS
-            if(body[9] == ':'
+            if(body.length() >= 10 && body[9] == ':'
                 && std::all_of(body.begin(), body.begin() + 9, [](char c){ return c == ' ' || c == '-' || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9'); })) {
                 type = APFT_MESSAGE;
 
                 //If reciepient is same as source and we donot have a sequence number at the end of message, Then it is telemetry
-                if(body.find(frame.getSource()) == 0U) {
+                if(body.compare(0, frame.getSource().length(), frame.getSource()) == 0) {
                     auto eqnsPos = body.find("EQNS.");
                     auto parmPos = body.find("PARM.");
                     auto seqNumPos = body.find_last_of('{');
-                    if((eqnsPos == 10U || parmPos == 10U) && seqNumPos == std::string::npos) {
+                    if((eqnsPos == 10U || parmPos == 10U) && seqNumPos == std::string_view::npos) {
                         type = APFT_TELEMETRY;
                     }
                 }
@@ -19,17 +19,20 @@
 #pragma once
 
 #include <string>
-#include <boost/algorithm/string.hpp>
+#include <string_view>
 
 #include "APRSFrame.h"
+#include "APRSFrameView.h"
 
 class CAPRSParser
 {
 public:
     static bool parseFrame(const std::string& frameStr, CAPRSFrame& frame);
+    // Does not copy anything, frame points into frameStr
+    static bool parseFrame(std::string_view frameStr, CAPRSFrameView& frame);
 
 private:
-    static bool parseInt(CAPRSFrame& frame);
+    static bool parseInt(CAPRSFrameView& frame);
     static bool valid_sym_table_compressed(unsigned char c);
     static bool valid_sym_table_uncompressed(unsigned char c);
 };
\ No newline at end of file
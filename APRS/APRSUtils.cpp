@@ -19,6 +19,7 @@
 #include <boost/algorithm/string.hpp>
 
 #include "APRSUtils.h"
+#include "CCITTChecksum.h"
 
 void CAPRSUtils::dstarCallsignToAPRS(std::string& dstarCallsign)
 {
@@ -35,27 +36,16 @@ void CAPRSUtils::dstarCallsignToAPRS(std::string& dstarCallsign)
 
 unsigned int CAPRSUtils::calcGPSAIcomCRC(const std::string& gpsa)
 {
-	unsigned int icomcrc = 0xFFFFU;
-
 	unsigned int dataBegin = 0U;
 	if(boost::starts_with(gpsa, "$$CRC") && gpsa.length() >= 10 && gpsa[9] == ',')
 		dataBegin = 10U;
 
-    auto length = gpsa.length();
-	for (unsigned int j = dataBegin; j < length; j++) {
-		unsigned char ch = (unsigned char)gpsa[j];
-
-		for (unsigned int i = 0U; i < 8U; i++) {
-			bool xorflag = (((icomcrc ^ ch) & 0x01U) == 0x01U);
-
-			icomcrc >>= 1;
+	// Same reflected 0x8408 polynomial and preset as the header checksum
+	CCCITTChecksum checksum;
+	checksum.update((const unsigned char*)gpsa.data() + dataBegin, gpsa.length() - dataBegin);
 
-			if (xorflag)
-				icomcrc ^= 0x8408U;
-
-			ch >>= 1;
-		} 
-	}
+	unsigned char crc[2U];
+	checksum.result(crc);
 
-	return ~icomcrc & 0xFFFFU;
+	return (unsigned int)crc[0] | ((unsigned int)crc[1] << 8);
 }
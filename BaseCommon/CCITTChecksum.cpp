@@ -12,12 +12,13 @@
  */
 
 #include <cassert>
+#include <cstring>
 
 #include "CCITTChecksum.h"
 
 #include "Utils.h"
 
-static const unsigned short ccittTab[] = {
+static constexpr unsigned short ccittTab[] = {
 	0x0000,0x1189,0x2312,0x329b,0x4624,0x57ad,0x6536,0x74bf,
 	0x8c48,0x9dc1,0xaf5a,0xbed3,0xca6c,0xdbe5,0xe97e,0xf8f7,
 	0x1081,0x0108,0x3393,0x221a,0x56a5,0x472c,0x75b7,0x643e,
@@ -51,6 +52,30 @@ static const unsigned short ccittTab[] = {
 	0xf78f,0xe606,0xd49d,0xc514,0xb1ab,0xa022,0x92b9,0x8330,
 	0x7bc7,0x6a4e,0x58d5,0x495c,0x3de3,0x2c6a,0x1ef1,0x0f78};
 
+// Slicing-by-8 tables, slice n holds the CRC of a byte followed by n zero bytes
+typedef struct {
+	uint16_t slice[8][256];
+} TCCITTSlices;
+
+static constexpr TCCITTSlices buildSlices()
+{
+	TCCITTSlices slices = {};
+
+	for (unsigned int i = 0U; i < 256U; i++)
+		slices.slice[0][i] = ccittTab[i];
+
+	for (unsigned int n = 1U; n < 8U; n++) {
+		for (unsigned int i = 0U; i < 256U; i++) {
+			uint16_t crc = slices.slice[n - 1U][i];
+			slices.slice[n][i] = (crc >> 8) ^ slices.slice[0][crc & 0x00FF];
+		}
+	}
+
+	return slices;
+}
+
+static constexpr TCCITTSlices ccittSlices = buildSlices();
+
 
 CCCITTChecksum::CCCITTChecksum() :
 m_crc(0xFFFF)
@@ -65,13 +90,25 @@ void CCCITTChecksum::update(const unsigned char* data, unsigned int length)
 {
 	assert(data != NULL);
 
-	for (unsigned int i = 0U; i < length; i++) {
-		unsigned short byte = data[i];
+	uint16_t crc = m_crc;
+	const uint16_t (*t)[256] = ccittSlices.slice;
 
-		unsigned short tmp = (m_crc & 0x00FF) ^ byte;
+	// The CRC is reflected, so it folds into the first two of every eight bytes
+	for (; length >= 8U; length -= 8U, data += 8U) {
+		uint32_t lo, hi;
+		::memcpy(&lo, data, sizeof(uint32_t));
+		::memcpy(&hi, data + 4U, sizeof(uint32_t));
+		lo = CUtils::swap_endian_be(lo) ^ crc;
+		hi = CUtils::swap_endian_be(hi);
 
-		m_crc = (m_crc >> 8) ^ ccittTab[tmp];
+		crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^
+		      t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
 	}
+
+	for (; length > 0U; length--, data++)
+		crc = (crc >> 8) ^ ccittTab[(crc & 0x00FF) ^ *data];
+
+	m_crc = crc;
 }
 
 void CCCITTChecksum::update(const bool* data)
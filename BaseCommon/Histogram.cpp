@@ -0,0 +1,155 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <cstring>
+#include <cmath>
+
+#include "Histogram.h"
+#include "StringUtils.h"
+
+CHistogram::CHistogram() :
+m_count(0U),
+m_sum(0U),
+m_min(0U),
+m_max(0U)
+{
+	::memset(m_buckets, 0, sizeof(m_buckets));
+}
+
+void CHistogram::add(uint64_t value)
+{
+	m_buckets[getBucketIndex(value)]++;
+
+	if (m_count == 0U || value < m_min)
+		m_min = value;
+	if (value > m_max)
+		m_max = value;
+
+	m_count++;
+	m_sum += value;
+}
+
+void CHistogram::merge(const CHistogram& other)
+{
+	if (other.m_count == 0U)
+		return;
+
+	for (unsigned int i = 0U; i < HISTOGRAM_BUCKETS; i++)
+		m_buckets[i] += other.m_buckets[i];
+
+	if (m_count == 0U || other.m_min < m_min)
+		m_min = other.m_min;
+	if (other.m_max > m_max)
+		m_max = other.m_max;
+
+	m_count += other.m_count;
+	m_sum   += other.m_sum;
+}
+
+void CHistogram::reset()
+{
+	::memset(m_buckets, 0, sizeof(m_buckets));
+	m_count = 0U;
+	m_sum   = 0U;
+	m_min   = 0U;
+	m_max   = 0U;
+}
+
+uint64_t CHistogram::getCount() const
+{
+	return m_count;
+}
+
+uint64_t CHistogram::getMin() const
+{
+	return m_min;
+}
+
+uint64_t CHistogram::getMax() const
+{
+	return m_max;
+}
+
+uint64_t CHistogram::getMean() const
+{
+	if (m_count == 0U)
+		return 0U;
+
+	return m_sum / m_count;
+}
+
+uint64_t CHistogram::getPercentile(double percentile) const
+{
+	if (m_count == 0U)
+		return 0U;
+
+	if (percentile <= 0.0)
+		return m_min;
+
+	uint64_t rank = uint64_t(std::ceil((percentile / 100.0) * double(m_count)));
+	if (rank == 0U)
+		rank = 1U;
+
+	uint64_t seen = 0U;
+	for (unsigned int i = 0U; i < HISTOGRAM_BUCKETS; i++) {
+		seen += m_buckets[i];
+		if (seen >= rank) {
+			uint64_t bound = getBucketUpperBound(i);
+			if (bound > m_max)
+				return m_max;
+			if (bound < m_min)
+				return m_min;
+			return bound;
+		}
+	}
+
+	return m_max;
+}
+
+std::string CHistogram::toString(const std::string& unit) const
+{
+	return CStringUtils::string_format("count=%llu p50=%llu%s p99=%llu%s max=%llu%s",
+					(unsigned long long)getCount(),
+					(unsigned long long)getPercentile(50.0), unit.c_str(),
+					(unsigned long long)getPercentile(99.0), unit.c_str(),
+					(unsigned long long)getMax(), unit.c_str());
+}
+
+unsigned int CHistogram::getBucketIndex(uint64_t value)
+{
+	if (value < HISTOGRAM_SUB_BUCKETS)
+		return (unsigned int)value;
+
+	unsigned int exponent = 63U - (unsigned int)__builtin_clzll(value);	// >= 3
+	unsigned int sub      = (unsigned int)(value >> (exponent - 3U)) & (HISTOGRAM_SUB_BUCKETS - 1U);
+
+	return HISTOGRAM_SUB_BUCKETS + (exponent - 3U) * HISTOGRAM_SUB_BUCKETS + sub;
+}
+
+uint64_t CHistogram::getBucketUpperBound(unsigned int index)
+{
+	if (index < HISTOGRAM_SUB_BUCKETS)
+		return index;
+
+	unsigned int shift = (index - HISTOGRAM_SUB_BUCKETS) / HISTOGRAM_SUB_BUCKETS;
+	uint64_t sub       = (index - HISTOGRAM_SUB_BUCKETS) % HISTOGRAM_SUB_BUCKETS;
+
+	uint64_t lower = (HISTOGRAM_SUB_BUCKETS + sub) << shift;
+
+	return lower + ((uint64_t(1U) << shift) - 1U);
+}
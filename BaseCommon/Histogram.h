@@ -0,0 +1,55 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Log-linear histogram, 8 sub buckets per power of two giving at most 12.5% error on reported values
+// Values below 8 are counted exactly. Not thread safe, callers have to take care of locking
+const unsigned int HISTOGRAM_SUB_BUCKETS = 8U;
+const unsigned int HISTOGRAM_BUCKETS     = HISTOGRAM_SUB_BUCKETS + (64U - 3U) * HISTOGRAM_SUB_BUCKETS;
+
+class CHistogram {
+public:
+	CHistogram();
+
+	void add(uint64_t value);
+	void merge(const CHistogram& other);
+	void reset();
+
+	uint64_t getCount() const;
+	uint64_t getMin() const;
+	uint64_t getMax() const;
+	uint64_t getMean() const;
+	uint64_t getPercentile(double percentile) const;
+
+	// Formats as "count=N p50=X p99=Y max=Z" with the given unit appended to the values
+	std::string toString(const std::string& unit) const;
+
+	static unsigned int getBucketIndex(uint64_t value);
+	static uint64_t getBucketUpperBound(unsigned int index);
+
+private:
+	uint64_t m_buckets[HISTOGRAM_BUCKETS];
+	uint64_t m_count;
+	uint64_t m_sum;
+	uint64_t m_min;
+	uint64_t m_max;
+};
@@ -0,0 +1,197 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <cassert>
+#include <cstring>
+#include <netinet/in.h>
+
+#include "PacketCapture.h"
+#include "NetUtils.h"
+#include "Log.h"
+
+const unsigned char  CAPTURE_MAGIC[]     = { 'D', 'G', 'W', 'C', 'A', 'P' };
+const unsigned int   CAPTURE_MAGIC_LEN   = 6U;
+const unsigned char  CAPTURE_VERSION     = 1U;
+const unsigned int   CAPTURE_RECORD_LEN  = 8U + 2U + 1U + 1U + 16U + 2U + 2U;
+const unsigned char  CAPTURE_FAMILY_IPV4 = 4U;
+const unsigned char  CAPTURE_FAMILY_IPV6 = 6U;
+
+CPacketCaptureWriter::CPacketCaptureWriter(const std::string& fileName) :
+m_fileName(fileName),
+m_file(NULL),
+m_count(0U),
+m_mutex()
+{
+}
+
+CPacketCaptureWriter::~CPacketCaptureWriter()
+{
+	close();
+}
+
+bool CPacketCaptureWriter::open()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_file = ::fopen(m_fileName.c_str(), "wb");
+	if (m_file == NULL) {
+		CLog::logError("Cannot open the capture file %s for writing", m_fileName.c_str());
+		return false;
+	}
+
+	::fwrite(CAPTURE_MAGIC, 1U, CAPTURE_MAGIC_LEN, m_file);
+	::fwrite(&CAPTURE_VERSION, 1U, 1U, m_file);
+	m_count = 0U;
+
+	return true;
+}
+
+void CPacketCaptureWriter::write(uint64_t time, unsigned int localPort, CAPTURE_DIRECTION direction, const struct sockaddr_storage& address, const unsigned char* data, unsigned int length)
+{
+	assert(data != NULL);
+
+	if (length > 0xFFFFU)
+		return;
+
+	unsigned char record[CAPTURE_RECORD_LEN];
+	::memset(record, 0x00U, CAPTURE_RECORD_LEN);
+
+	for (unsigned int i = 0U; i < 8U; i++)
+		record[i] = (time >> (56U - i * 8U)) & 0xFFU;
+
+	record[8U]  = (localPort >> 8) & 0xFFU;
+	record[9U]  = localPort & 0xFFU;
+	record[10U] = direction == CD_INCOMING ? 0U : 1U;
+
+	unsigned int port = 0U;
+	if (address.ss_family == AF_INET) {
+		record[11U] = CAPTURE_FAMILY_IPV4;
+		::memcpy(record + 12U, &TOIPV4(address)->sin_addr, 4U);
+		port = ntohs(TOIPV4(address)->sin_port);
+	} else if (address.ss_family == AF_INET6) {
+		record[11U] = CAPTURE_FAMILY_IPV6;
+		::memcpy(record + 12U, &TOIPV6(address)->sin6_addr, 16U);
+		port = ntohs(TOIPV6(address)->sin6_port);
+	}
+
+	record[28U] = (port >> 8) & 0xFFU;
+	record[29U] = port & 0xFFU;
+	record[30U] = (length >> 8) & 0xFFU;
+	record[31U] = length & 0xFFU;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if (m_file == NULL)
+		return;
+
+	::fwrite(record, 1U, CAPTURE_RECORD_LEN, m_file);
+	::fwrite(data, 1U, length, m_file);
+	m_count++;
+}
+
+void CPacketCaptureWriter::close()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if (m_file != NULL) {
+		::fclose(m_file);
+		m_file = NULL;
+	}
+}
+
+unsigned int CPacketCaptureWriter::getCount() const
+{
+	return m_count;
+}
+
+CPacketCaptureReader::CPacketCaptureReader(const std::string& fileName) :
+m_fileName(fileName),
+m_file(NULL)
+{
+}
+
+CPacketCaptureReader::~CPacketCaptureReader()
+{
+	close();
+}
+
+bool CPacketCaptureReader::open()
+{
+	m_file = ::fopen(m_fileName.c_str(), "rb");
+	if (m_file == NULL) {
+		CLog::logError("Cannot open the capture file %s", m_fileName.c_str());
+		return false;
+	}
+
+	unsigned char header[CAPTURE_MAGIC_LEN + 1U];
+	if (::fread(header, 1U, CAPTURE_MAGIC_LEN + 1U, m_file) != CAPTURE_MAGIC_LEN + 1U
+		|| ::memcmp(header, CAPTURE_MAGIC, CAPTURE_MAGIC_LEN) != 0 || header[CAPTURE_MAGIC_LEN] != CAPTURE_VERSION) {
+		CLog::logError("%s is not a valid capture file", m_fileName.c_str());
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+bool CPacketCaptureReader::read(TCapturedPacket& packet)
+{
+	if (m_file == NULL)
+		return false;
+
+	unsigned char record[CAPTURE_RECORD_LEN];
+	if (::fread(record, 1U, CAPTURE_RECORD_LEN, m_file) != CAPTURE_RECORD_LEN)
+		return false;
+
+	packet.time = 0U;
+	for (unsigned int i = 0U; i < 8U; i++)
+		packet.time = (packet.time << 8) | record[i];
+
+	packet.localPort = (record[8U] << 8) | record[9U];
+	packet.direction = record[10U] == 0U ? CD_INCOMING : CD_OUTGOING;
+
+	unsigned int port = (record[28U] << 8) | record[29U];
+
+	::memset(&packet.address, 0x00, sizeof(struct sockaddr_storage));
+	if (record[11U] == CAPTURE_FAMILY_IPV4) {
+		packet.address.ss_family = AF_INET;
+		::memcpy(&TOIPV4(packet.address)->sin_addr, record + 12U, 4U);
+		TOIPV4(packet.address)->sin_port = htons(port);
+	} else if (record[11U] == CAPTURE_FAMILY_IPV6) {
+		packet.address.ss_family = AF_INET6;
+		::memcpy(&TOIPV6(packet.address)->sin6_addr, record + 12U, 16U);
+		TOIPV6(packet.address)->sin6_port = htons(port);
+	}
+
+	unsigned int length = (record[30U] << 8) | record[31U];
+	packet.data.resize(length);
+	if (length > 0U && ::fread(packet.data.data(), 1U, length, m_file) != length) {
+		CLog::logWarning("Truncated record at the end of %s", m_fileName.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+void CPacketCaptureReader::close()
+{
+	if (m_file != NULL) {
+		::fclose(m_file);
+		m_file = NULL;
+	}
+}
@@ -0,0 +1,74 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <cstdio>
+#include <cstdint>
+#include <sys/socket.h>
+
+enum CAPTURE_DIRECTION {
+	CD_INCOMING,
+	CD_OUTGOING
+};
+
+typedef struct {
+	uint64_t                   time;		// Monotonic time in nanoseconds
+	unsigned int               localPort;	// Port of the gateway socket the datagram went through
+	CAPTURE_DIRECTION          direction;
+	struct sockaddr_storage    address;		// Remote end
+	std::vector<unsigned char> data;
+} TCapturedPacket;
+
+// Capture file layout, all fields big endian:
+//   header: "DGWCAP" version(1)
+//   record: time(8) localPort(2) direction(1) family(1) address(16) port(2) length(2) data(length)
+class CPacketCaptureWriter {
+public:
+	CPacketCaptureWriter(const std::string& fileName);
+	~CPacketCaptureWriter();
+
+	bool open();
+	void write(uint64_t time, unsigned int localPort, CAPTURE_DIRECTION direction, const struct sockaddr_storage& address, const unsigned char* data, unsigned int length);
+	void close();
+
+	unsigned int getCount() const;
+
+private:
+	std::string  m_fileName;
+	FILE*        m_file;
+	unsigned int m_count;
+	std::mutex   m_mutex;
+};
+
+class CPacketCaptureReader {
+public:
+	CPacketCaptureReader(const std::string& fileName);
+	~CPacketCaptureReader();
+
+	bool open();
+	bool read(TCapturedPacket& packet);
+	void close();
+
+private:
+	std::string m_fileName;
+	FILE*       m_file;
+};
@@ -0,0 +1,172 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <cassert>
+#include <cstring>
+
+#include "PacketReplay.h"
+#include "Log.h"
+
+// Keeps the replay running after the last datagram so that timers fire and streams time out
+const uint64_t REPLAY_DRAIN_NS = 5000000000ULL;
+
+CPacketReplay::CPacketReplay(const std::string& fileName, const std::string& outputFileName) :
+m_fileName(fileName),
+m_outputFileName(outputFileName),
+m_output(NULL),
+m_queues(),
+m_now(0U),
+m_end(0U),
+m_pending(0U),
+m_delivered(0U),
+m_mutex()
+{
+}
+
+CPacketReplay::~CPacketReplay()
+{
+	close();
+}
+
+bool CPacketReplay::open()
+{
+	CPacketCaptureReader reader(m_fileName);
+	if (!reader.open())
+		return false;
+
+	// Captures are small enough to be held in memory, this keeps file I/O out of the replayed loop
+	bool first = true;
+	uint64_t start = 0U;
+	TCapturedPacket packet;
+	while (reader.read(packet)) {
+		if (packet.direction != CD_INCOMING)
+			continue;
+
+		if (first) {
+			start = packet.time;
+			first = false;
+		}
+
+		// The simulated clock starts at zero with the first datagram
+		packet.time = packet.time >= start ? packet.time - start : 0U;
+		if (packet.time > m_end)
+			m_end = packet.time;
+		m_queues[packet.localPort].push_back(packet);
+		m_pending++;
+	}
+
+	reader.close();
+
+	if (!m_outputFileName.empty()) {
+		m_output = new CPacketCaptureWriter(m_outputFileName);
+		if (!m_output->open()) {
+			delete m_output;
+			m_output = NULL;
+			return false;
+		}
+	}
+
+	m_now       = 0U;
+	m_delivered = 0U;
+
+	CLog::logInfo("Replaying %u datagrams on %u ports from %s", m_pending, (unsigned int)m_queues.size(), m_fileName.c_str());
+
+	return true;
+}
+
+void CPacketReplay::close()
+{
+	if (m_output != NULL) {
+		m_output->close();
+		delete m_output;
+		m_output = NULL;
+	}
+}
+
+void CPacketReplay::clock(unsigned int ms)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_now += uint64_t(ms) * 1000000ULL;
+}
+
+uint64_t CPacketReplay::getTime() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_now;
+}
+
+bool CPacketReplay::isFinished() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_now > m_end + REPLAY_DRAIN_NS;
+}
+
+int CPacketReplay::read(unsigned int localPort, unsigned char* buffer, unsigned int length, struct sockaddr_storage& address)
+{
+	assert(buffer != NULL);
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	auto it = m_queues.find(localPort);
+	if (it == m_queues.end() || it->second.empty())
+		return 0;
+
+	TCapturedPacket& packet = it->second.front();
+	if (packet.time > m_now)
+		return 0;
+
+	// Truncate as recvfrom would
+	unsigned int len = packet.data.size() < length ? packet.data.size() : length;
+	::memcpy(buffer, packet.data.data(), len);
+	address = packet.address;
+
+	it->second.pop_front();
+	m_delivered++;
+
+	return int(len);
+}
+
+bool CPacketReplay::write(unsigned int localPort, const unsigned char* buffer, unsigned int length, const struct sockaddr_storage& address)
+{
+	assert(buffer != NULL);
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if (m_output != NULL)
+		m_output->write(m_now, localPort, CD_OUTGOING, address, buffer, length);
+
+	return true;
+}
+
+unsigned int CPacketReplay::getDelivered() const
+{
+	return m_delivered;
+}
+
+unsigned int CPacketReplay::getUnclaimed() const
+{
+	return m_pending - m_delivered;
+}
+
+unsigned int CPacketReplay::getWritten() const
+{
+	return m_output != NULL ? m_output->getCount() : 0U;
+}
@@ -0,0 +1,63 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <string>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <cstdint>
+
+#include "PacketCapture.h"
+
+// Feeds the incoming datagrams of a capture back to the sockets under a simulated clock.
+// Outgoing datagrams are not sent, they are written to an optional capture file so runs can be compared.
+class CPacketReplay {
+public:
+	CPacketReplay(const std::string& fileName, const std::string& outputFileName);
+	~CPacketReplay();
+
+	bool open();
+	void close();
+
+	// Advances the simulated clock
+	void clock(unsigned int ms);
+	uint64_t getTime() const;
+
+	// True once the simulated clock went past the last captured datagram and the drain period
+	bool isFinished() const;
+
+	int  read(unsigned int localPort, unsigned char* buffer, unsigned int length, struct sockaddr_storage& address);
+	bool write(unsigned int localPort, const unsigned char* buffer, unsigned int length, const struct sockaddr_storage& address);
+
+	unsigned int getDelivered() const;
+	unsigned int getUnclaimed() const;
+	unsigned int getWritten() const;
+
+private:
+	std::string                                                   m_fileName;
+	std::string                                                   m_outputFileName;
+	CPacketCaptureWriter*                                         m_output;
+	std::unordered_map<unsigned int, std::deque<TCapturedPacket>> m_queues;
+	uint64_t                                                      m_now;
+	uint64_t                                                      m_end;
+	unsigned int                                                  m_pending;
+	unsigned int                                                  m_delivered;
+	mutable std::mutex                                            m_mutex;
+};
@@ -21,17 +21,25 @@
 #include <cerrno>
 #include <cassert>
 #include <cstring>
+#include <algorithm>
+#include <climits>
 
 #include "TCPReaderWriterClient.h"
 #include "UDPReaderWriter.h"
 #include "Utils.h"
 #include "Log.h"
 
+// Also the longest line readLine accepts
+#define TCP_READ_BUFFER_SIZE 4096U
+
 CTCPReaderWriterClient::CTCPReaderWriterClient(const std::string& address, unsigned int port, const std::string& localAddress) :
 m_address(address),
 m_port(port),
 m_localAddress(localAddress),
-m_fd(-1)
+m_fd(-1),
+m_readBuffer(TCP_READ_BUFFER_SIZE),
+m_readStart(0U),
+m_readEnd(0U)
 {
 	assert(address.size());
 	assert(port > 0U);
@@ -41,7 +49,10 @@ CTCPReaderWriterClient::CTCPReaderWriterClient(int fd) :
 m_address(),
 m_port(0U),
 m_localAddress(),
-m_fd(fd)
+m_fd(fd),
+m_readBuffer(TCP_READ_BUFFER_SIZE),
+m_readStart(0U),
+m_readEnd(0U)
 {
 	assert(fd >= 0);
 }
@@ -50,7 +61,10 @@ CTCPReaderWriterClient::CTCPReaderWriterClient() :
 m_address(),
 m_port(0U),
 m_localAddress(),
-m_fd(-1)
+m_fd(-1),
+m_readBuffer(TCP_READ_BUFFER_SIZE),
+m_readStart(0U),
+m_readEnd(0U)
 {
 }
 
@@ -133,6 +147,19 @@ int CTCPReaderWriterClient::read(unsigned char* buffer, unsigned int length, uns
 	assert(length > 0U);
 	assert(m_fd != -1);
 
+	// Hand out what readLine already received first
+	if (m_readStart < m_readEnd) {
+		unsigned int len = std::min(length, m_readEnd - m_readStart);
+		::memcpy(buffer, m_readBuffer.data() + m_readStart, len);
+		m_readStart += len;
+		return len;
+	}
+
+	return receive(buffer, length, secs, msecs);
+}
+
+int CTCPReaderWriterClient::receive(unsigned char* buffer, unsigned int length, unsigned int secs, unsigned int msecs)
+{
 	// Check that the recv() won't block
 	fd_set readFds;
 	FD_ZERO(&readFds);
@@ -163,25 +190,66 @@ int CTCPReaderWriterClient::read(unsigned char* buffer, unsigned int length, uns
 	return len;
 }
 
+// Appends whatever the socket has to the read buffer, only waits when nothing is there yet
+int CTCPReaderWriterClient::fillReadBuffer(unsigned int secs)
+{
+	if (m_readStart > 0U) {
+		::memmove(m_readBuffer.data(), m_readBuffer.data() + m_readStart, m_readEnd - m_readStart);
+		m_readEnd -= m_readStart;
+		m_readStart = 0U;
+	}
+
+	// No line is that long, do not let the peer make us buffer without end
+	if (m_readEnd == m_readBuffer.size()) {
+		CLog::logInfo("Line longer than %u bytes received, dropping it\n", TCP_READ_BUFFER_SIZE);
+		m_readEnd = 0U;
+		return -1;
+	}
+
+	unsigned char* buffer = m_readBuffer.data() + m_readEnd;
+	unsigned int length = m_readBuffer.size() - m_readEnd;
+
+	ssize_t len = ::recv(m_fd, (char*)buffer, length, MSG_DONTWAIT);
+	if (len == 0)
+		return -2;
+	if (len < 0) {
+		if (errno != EAGAIN && errno != EWOULDBLOCK) {
+			CLog::logInfo("Error returned from recv, err=%d\n", errno);
+			return -1;
+		}
+
+		len = receive(buffer, length, secs, 0U);
+		if (len <= 0)
+			return len;
+	}
+
+	m_readEnd += len;
+	return len;
+}
+
 int CTCPReaderWriterClient::readLine(std::string& line, unsigned int secs)
 {
-	//maybe there is a better way to do this like reading blocks, pushing them for later calls
-	//Nevermind, we'll read one char at a time for the time being.
-	unsigned char c;
-	int resultCode;
-	int len = 0;
-	line = "";
-
-	do
-	{
-		resultCode = read(&c, 1, secs);
-		if(resultCode == 1) {
-			line.push_back(c);
-			len++;
+	assert(m_fd != -1);
+
+	line.clear();
+
+	for (;;) {
+		const unsigned char* start = m_readBuffer.data() + m_readStart;
+		const unsigned char* end = (const unsigned char*)::memchr(start, '\n', m_readEnd - m_readStart);
+		if (end != NULL) {
+			unsigned int len = end - start + 1U;
+			line.assign((const char*)start, len);
+			m_readStart += len;
+			if (m_readStart == m_readEnd)
+				m_readStart = m_readEnd = 0U;
+			return len;
 		}
-	}while(c != '\n' && resultCode == 1);
 
-	return resultCode <= 0 ? resultCode : len;
+		// An incomplete line stays buffered until the rest of it arrives
+		int ret = fillReadBuffer(secs);
+		if (ret <= 0)
+			return ret;
+	}
 }
 
 bool CTCPReaderWriterClient::write(const unsigned char* buffer, unsigned int length)
@@ -212,10 +280,61 @@ bool CTCPReaderWriterClient::writeLine(const std::string& line)
 	return ret;
 }
 
+bool CTCPReaderWriterClient::writeLines(const std::vector<std::string>& lines)
+{
+	assert(m_fd != -1);
+
+	std::vector<iovec> iov;
+	iov.reserve(lines.size());
+	for (const std::string& line : lines) {
+		if (!line.empty())
+			iov.push_back({ (void*)line.data(), line.length() });
+	}
+
+	unsigned int first = 0U;
+	while (first < iov.size()) {
+		unsigned int count = std::min<size_t>(iov.size() - first, IOV_MAX);
+		ssize_t ret = ::writev(m_fd, iov.data() + first, count);
+		if (ret < 0) {
+			// Interrupted before anything went out, nothing to skip
+			if (errno == EINTR)
+				continue;
+
+			CLog::logInfo("Error returned from writev, err=%d\n", errno);
+			return false;
+		}
+
+		// Skip what went out, a short write resumes in the middle of a line
+		size_t sent = ret;
+		while (first < iov.size() && sent >= iov[first].iov_len) {
+			sent -= iov[first].iov_len;
+			first++;
+		}
+		if (sent > 0U) {
+			iov[first].iov_base = (char*)iov[first].iov_base + sent;
+			iov[first].iov_len -= sent;
+		}
+	}
+
+	return true;
+}
+
+int CTCPReaderWriterClient::getFd() const
+{
+	return m_fd;
+}
+
+bool CTCPReaderWriterClient::hasBufferedData() const
+{
+	return m_readStart < m_readEnd;
+}
+
 void CTCPReaderWriterClient::close()
 {
 	if (m_fd != -1) {
 		::close(m_fd);
 		m_fd = -1;
 	}
+
+	m_readStart = m_readEnd = 0U;
 }
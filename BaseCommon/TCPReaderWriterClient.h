@@ -20,10 +20,12 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include <netdb.h>
 #include <sys/time.h>
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
@@ -44,12 +46,25 @@ public:
 	int readLine(std::string& line, unsigned int secs);
 	bool write(const unsigned char* buffer, unsigned int length);
 	bool writeLine(const std::string& line);
+	// Sends all lines with as few system calls as possible, each line has to carry its own line ending
+	bool writeLines(const std::vector<std::string>& lines);
+
+	// For callers polling the socket themselves, readLine may have data buffered that the socket will not signal
+	int  getFd() const;
+	bool hasBufferedData() const;
 
 	void close();
 
 private:
+	int receive(unsigned char* buffer, unsigned int length, unsigned int secs, unsigned int msecs);
+	int fillReadBuffer(unsigned int secs);
+
 	std::string    m_address;
 	unsigned short m_port;
 	std::string    m_localAddress;
 	int            m_fd;
+	// Received bytes not handed out yet, readLine splits lines out of it
+	std::vector<unsigned char> m_readBuffer;
+	unsigned int   m_readStart;
+	unsigned int   m_readEnd;
 };
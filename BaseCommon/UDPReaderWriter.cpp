@@ -19,15 +19,25 @@
 #include <cerrno>
 #include <cstring>
 #include <string.h>
+#include <chrono>
+#include <ctime>
+#include <algorithm>
 #include "UDPReaderWriter.h"
 #include "Log.h"
 #include "NetUtils.h"
 
+UDP_TIMESTAMPING CUDPReaderWriter::m_timestamping = UTS_NONE;
+CPacketCaptureWriter* CUDPReaderWriter::m_capture = NULL;
+CPacketReplay* CUDPReaderWriter::m_replay = NULL;
+
 CUDPReaderWriter::CUDPReaderWriter(const std::string& address, unsigned int port) :
 m_address(address),
 m_port(port),
 m_addr(),
-m_fd(-1)
+m_fd(-1),
+m_kernelTimestamps(false),
+m_readTime(0U),
+m_replaying(false)
 {
 }
 
@@ -35,7 +45,10 @@ CUDPReaderWriter::CUDPReaderWriter() :
 m_address(),
 m_port(0U),
 m_addr(),
-m_fd(-1)
+m_fd(-1),
+m_kernelTimestamps(false),
+m_readTime(0U),
+m_replaying(false)
 {
 }
 
@@ -66,6 +79,10 @@ in_addr CUDPReaderWriter::lookup(const std::string& hostname)
 
 bool CUDPReaderWriter::open()
 {
+	m_replaying = m_replay != NULL;
+	if (m_replaying)
+		return true;
+
 	m_fd = ::socket(PF_INET, SOCK_DGRAM, 0);
 	if (m_fd < 0) {
 		CLog::logError("Cannot create the UDP socket, err: %s\n", strerror(errno));
@@ -99,11 +116,27 @@ bool CUDPReaderWriter::open()
 		}
 	}
 
+	m_kernelTimestamps = false;
+	if (m_timestamping == UTS_KERNEL) {
+		int enable = 1;
+		if (::setsockopt(m_fd, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable)) == -1)
+			CLog::logWarning("Cannot enable kernel timestamps (port: %u), falling back to user timestamps, err: %s\n", m_port, strerror(errno));
+		else
+			m_kernelTimestamps = true;
+	}
+
 	return true;
 }
 
 int CUDPReaderWriter::read(unsigned char* buffer, unsigned int length, struct sockaddr_storage& addr)
 {
+	if (m_replaying) {
+		int len = m_replay->read(m_port, buffer, length, addr);
+		if (len > 0)
+			m_readTime = m_timestamping == UTS_NONE ? 0U : getMonotonicTime();
+		return len;
+	}
+
 	// Check that the readfrom() won't block
 	fd_set readFds;
 	FD_ZERO(&readFds);
@@ -123,14 +156,69 @@ int CUDPReaderWriter::read(unsigned char* buffer, unsigned int length, struct so
 	if (ret == 0)
 		return 0;
 
-	socklen_t size = sizeof(addr);
+	int len;
+	if (m_kernelTimestamps) {
+		len = readTimestamped(buffer, length, addr);
+	} else {
+		socklen_t size = sizeof(addr);
+
+		len = ::recvfrom(m_fd, (char*)buffer, length, 0, (sockaddr *)&addr, &size);
+		if (len <= 0) {
+			CLog::logError("Error returned from recvfrom (port: %u), err: %s\n", m_port, strerror(errno));
+			return -1;
+		}
 
-	ssize_t len = ::recvfrom(m_fd, (char*)buffer, length, 0, (sockaddr *)&addr, &size);
+		m_readTime = m_timestamping == UTS_NONE ? 0U : getMonotonicTime();
+	}
+
+	if (len > 0 && m_capture != NULL)
+		m_capture->write(m_readTime > 0U ? m_readTime : getMonotonicTime(), m_port, CD_INCOMING, addr, buffer, len);
+
+	return len;
+}
+
+int CUDPReaderWriter::readTimestamped(unsigned char* buffer, unsigned int length, struct sockaddr_storage& addr)
+{
+	iovec iov;
+	iov.iov_base = buffer;
+	iov.iov_len  = length;
+
+	unsigned char control[CMSG_SPACE(sizeof(timespec))];
+
+	msghdr msg;
+	::memset(&msg, 0, sizeof(msghdr));
+	msg.msg_name       = &addr;
+	msg.msg_namelen    = sizeof(addr);
+	msg.msg_iov        = &iov;
+	msg.msg_iovlen     = 1U;
+	msg.msg_control    = control;
+	msg.msg_controllen = sizeof(control);
+
+	ssize_t len = ::recvmsg(m_fd, &msg, 0);
 	if (len <= 0) {
-		CLog::logError("Error returned from recvfrom (port: %u), err: %s\n", m_port, strerror(errno));
+		CLog::logError("Error returned from recvmsg (port: %u), err: %s\n", m_port, strerror(errno));
 		return -1;
 	}
 
+	m_readTime = getMonotonicTime();
+
+	for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+		if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+			timespec kernelTime;
+			::memcpy(&kernelTime, CMSG_DATA(cmsg), sizeof(timespec));
+
+			// The kernel stamps against the real time clock, shift it onto the monotonic clock
+			timespec realTime;
+			::clock_gettime(CLOCK_REALTIME, &realTime);
+
+			int64_t age = (int64_t(realTime.tv_sec) - int64_t(kernelTime.tv_sec)) * 1000000000LL + (int64_t(realTime.tv_nsec) - int64_t(kernelTime.tv_nsec));
+			if (age > 0 && uint64_t(age) < m_readTime)
+				m_readTime -= uint64_t(age);
+
+			break;
+		}
+	}
+
 	return len;
 }
 
@@ -161,6 +249,9 @@ bool CUDPReaderWriter::write(const unsigned char* buffer, unsigned int length, c
 
 bool CUDPReaderWriter::write(const unsigned char* buffer, unsigned int length, const struct sockaddr_storage& addr)
 {
+	if (m_replaying)
+		return m_replay->write(m_port, buffer, length, addr);
+
 	ssize_t ret = ::sendto(m_fd, (char *)buffer, length, 0, (sockaddr *)&addr, sizeof(addr));
 	if (ret < 0) {
 		CLog::logError("Error returned from sendto (port: %u), err: %s\n", m_port, strerror(errno));
@@ -170,13 +261,72 @@ bool CUDPReaderWriter::write(const unsigned char* buffer, unsigned int length, c
 	if (ret != ssize_t(length))
 		return false;
 
+	if (m_capture != NULL)
+		m_capture->write(getMonotonicTime(), m_port, CD_OUTGOING, addr, buffer, length);
+
 	return true;
 }
 
 
+bool CUDPReaderWriter::writeMany(const unsigned char* buffer, unsigned int length, unsigned int count, const in_addr& address, unsigned int port)
+{
+	struct sockaddr_storage addr;
+	::memset(&addr, 0, sizeof(sockaddr_storage));
+
+	addr.ss_family = AF_INET;
+	TOIPV4(addr)->sin_addr = address;
+	TOIPV4(addr)->sin_port = htons(port);
+
+	if (m_replaying) {
+		bool ret = true;
+		for (unsigned int i = 0U; i < count; i++)
+			ret = m_replay->write(m_port, buffer + i * length, length, addr) && ret;
+		return ret;
+	}
+
+	const unsigned int BATCH_SIZE = 16U;
+	struct mmsghdr messages[BATCH_SIZE];
+	struct iovec iovs[BATCH_SIZE];
+
+	unsigned int sent = 0U;
+	while (sent < count) {
+		unsigned int batch = std::min(count - sent, BATCH_SIZE);
+		for (unsigned int i = 0U; i < batch; i++) {
+			iovs[i].iov_base = (void*)(buffer + (sent + i) * length);
+			iovs[i].iov_len  = length;
+
+			::memset(&messages[i], 0, sizeof(struct mmsghdr));
+			messages[i].msg_hdr.msg_name    = &addr;
+			messages[i].msg_hdr.msg_namelen = sizeof(addr);
+			messages[i].msg_hdr.msg_iov     = &iovs[i];
+			messages[i].msg_hdr.msg_iovlen  = 1U;
+		}
+
+		int ret = ::sendmmsg(m_fd, messages, batch, 0);
+		if (ret <= 0) {
+			CLog::logError("Error returned from sendmmsg (port: %u), err: %s\n", m_port, strerror(errno));
+			return false;
+		}
+
+		if (m_capture != NULL) {
+			uint64_t now = getMonotonicTime();
+			for (int i = 0; i < ret; i++)
+				m_capture->write(now, m_port, CD_OUTGOING, addr, buffer + (sent + i) * length, length);
+		}
+
+		sent += ret;
+	}
+
+	return true;
+}
 
 void CUDPReaderWriter::close()
 {
+	if (m_replaying) {
+		m_replaying = false;
+		return;
+	}
+
 	::close(m_fd);
 }
 
@@ -184,3 +334,33 @@ unsigned int CUDPReaderWriter::getPort() const
 {
 	return m_port;
 }
+
+uint64_t CUDPReaderWriter::getReadTime() const
+{
+	return m_readTime;
+}
+
+void CUDPReaderWriter::setTimestamping(UDP_TIMESTAMPING timestamping)
+{
+	m_timestamping = timestamping;
+}
+
+UDP_TIMESTAMPING CUDPReaderWriter::getTimestamping()
+{
+	return m_timestamping;
+}
+
+void CUDPReaderWriter::setCapture(CPacketCaptureWriter* capture)
+{
+	m_capture = capture;
+}
+
+void CUDPReaderWriter::setReplay(CPacketReplay* replay)
+{
+	m_replay = replay;
+}
+
+uint64_t CUDPReaderWriter::getMonotonicTime()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
@@ -29,7 +29,16 @@
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <errno.h>
+#include <cstdint>
 
+#include "PacketCapture.h"
+#include "PacketReplay.h"
+
+enum UDP_TIMESTAMPING {
+	UTS_NONE,		// Do not timestamp incoming datagrams
+	UTS_USER,		// Timestamp from the monotonic clock once recvfrom returns
+	UTS_KERNEL		// Timestamp taken by the kernel (SO_TIMESTAMPNS) and converted to the monotonic clock
+};
 
 class CUDPReaderWriter {
 public:
@@ -45,14 +54,39 @@ public:
 	int read(unsigned char* buffer, unsigned int length, in_addr& address, unsigned int& port);
 	bool write(const unsigned char* buffer, unsigned int length, const in_addr& address, unsigned int port);
 	bool write(const unsigned char* buffer, unsigned int length, const struct sockaddr_storage& addr);
+	// Sends count datagrams of length bytes laid out back to back in buffer, batching them in as few system calls as possible
+	bool writeMany(const unsigned char* buffer, unsigned int length, unsigned int count, const in_addr& address, unsigned int port);
 
 	void close();
 
 	unsigned int getPort() const;
 
+	// Monotonic time in nanoseconds at which the last datagram was received, 0 when timestamping is disabled
+	uint64_t getReadTime() const;
+
+	// Applies to sockets opened after the call
+	static void setTimestamping(UDP_TIMESTAMPING timestamping);
+	static UDP_TIMESTAMPING getTimestamping();
+	static uint64_t getMonotonicTime();
+
+	// Records every datagram read or written by any socket, NULL to stop recording
+	static void setCapture(CPacketCaptureWriter* capture);
+	// Sockets opened after the call read from and write to the replay instead of the network
+	static void setReplay(CPacketReplay* replay);
+
 private:
 	std::string       m_address;
 	unsigned short m_port;
 	in_addr        m_addr;
 	int            m_fd;
+	bool           m_kernelTimestamps;
+	uint64_t       m_readTime;
+
+	bool           m_replaying;
+
+	static UDP_TIMESTAMPING      m_timestamping;
+	static CPacketCaptureWriter* m_capture;
+	static CPacketReplay*        m_replay;
+
+	int readTimestamped(unsigned char* buffer, unsigned int length, struct sockaddr_storage& addr);
 };
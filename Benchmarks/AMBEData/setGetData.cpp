@@ -0,0 +1,235 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstring>
+
+#include "AMBEData.h"
+#include "DStarDefines.h"
+
+namespace AMBEDataBenchmarks
+{
+    // A voice frame in the middle of a transmission, DCS and CCS frames also embed the stream header
+    static CAMBEData makeData()
+    {
+        unsigned char frame[DV_FRAME_LENGTH_BYTES];
+        ::memcpy(frame, NULL_AMBE_DATA_BYTES, VOICE_FRAME_LENGTH_BYTES);
+        ::memcpy(frame + VOICE_FRAME_LENGTH_BYTES, NULL_SLOW_DATA_BYTES, DATA_FRAME_LENGTH_BYTES);
+
+        CAMBEData data;
+        data.setId(0x1234U);
+        data.setBand1(0x00U);
+        data.setBand2(0x02U);
+        data.setBand3(0x01U);
+        data.setRptSeq(0x10U);
+        data.setSeq(5U);
+        data.setData(frame, DV_FRAME_LENGTH_BYTES);
+        data.getHeader() = CHeaderData("F4FXL  B", "ID51", "CQCQCQ  ", "F4FXL  B", "F4FXL  G");
+
+        return data;
+    }
+
+    static void AMBEData_getIcomRepeaterData(benchmark::State& state)
+    {
+        CAMBEData data = makeData();
+        unsigned char buffer[100U];
+
+        for(auto _ : state) {
+            unsigned int length = data.getIcomRepeaterData(buffer, 100U);
+            benchmark::DoNotOptimize(length);
+            benchmark::ClobberMemory();
+        }
+    }
+    BENCHMARK(AMBEData_getIcomRepeaterData);
+
+    static void AMBEData_setIcomRepeaterData(benchmark::State& state)
+    {
+        unsigned char buffer[100U];
+        unsigned int length = makeData().getIcomRepeaterData(buffer, 100U);
+        in_addr address = {0U};
+
+        for(auto _ : state) {
+            CAMBEData data;
+            bool ret = data.setIcomRepeaterData(buffer, length, address, 20000U);
+            benchmark::DoNotOptimize(ret);
+        }
+    }
+    BENCHMARK(AMBEData_setIcomRepeaterData);
+
+    static void AMBEData_getHBRepeaterData(benchmark::State& state)
+    {
+        CAMBEData data = makeData();
+        unsigned char buffer[100U];
+
+        for(auto _ : state) {
+            unsigned int length = data.getHBRepeaterData(buffer, 100U);
+            benchmark::DoNotOptimize(length);
+            benchmark::ClobberMemory();
+        }
+    }
+    BENCHMARK(AMBEData_getHBRepeaterData);
+
+    static void AMBEData_setHBRepeaterData(benchmark::State& state)
+    {
+        unsigned char buffer[100U];
+        unsigned int length = makeData().getHBRepeaterData(buffer, 100U);
+        in_addr address = {0U};
+
+        for(auto _ : state) {
+            CAMBEData data;
+            bool ret = data.setHBRepeaterData(buffer, length, address, 20010U);
+            benchmark::DoNotOptimize(ret);
+        }
+    }
+    BENCHMARK(AMBEData_setHBRepeaterData);
+
+    static void AMBEData_getG2Data(benchmark::State& state)
+    {
+        CAMBEData data = makeData();
+        unsigned char buffer[100U];
+
+        for(auto _ : state) {
+            unsigned int length = data.getG2Data(buffer, 100U);
+            benchmark::DoNotOptimize(length);
+            benchmark::ClobberMemory();
+        }
+    }
+    BENCHMARK(AMBEData_getG2Data);
+
+    static void AMBEData_setG2Data(benchmark::State& state)
+    {
+        unsigned char buffer[100U];
+        unsigned int length = makeData().getG2Data(buffer, 100U);
+        in_addr address = {0U};
+
+        for(auto _ : state) {
+            CAMBEData data;
+            bool ret = data.setG2Data(buffer, length, address, 40000U);
+            benchmark::DoNotOptimize(ret);
+        }
+    }
+    BENCHMARK(AMBEData_setG2Data);
+
+    static void AMBEData_getDExtraData(benchmark::State& state)
+    {
+        CAMBEData data = makeData();
+        unsigned char buffer[100U];
+
+        for(auto _ : state) {
+            unsigned int length = data.getDExtraData(buffer, 100U);
+            benchmark::DoNotOptimize(length);
+            benchmark::ClobberMemory();
+        }
+    }
+    BENCHMARK(AMBEData_getDExtraData);
+
+    static void AMBEData_setDExtraData(benchmark::State& state)
+    {
+        unsigned char buffer[100U];
+        unsigned int length = makeData().getDExtraData(buffer, 100U);
+        in_addr address = {0U};
+
+        for(auto _ : state) {
+            CAMBEData data;
+            bool ret = data.setDExtraData(buffer, length, address, 30001U, 30001U);
+            benchmark::DoNotOptimize(ret);
+        }
+    }
+    BENCHMARK(AMBEData_setDExtraData);
+
+    static void AMBEData_getDPlusData(benchmark::State& state)
+    {
+        CAMBEData data = makeData();
+        unsigned char buffer[100U];
+
+        for(auto _ : state) {
+            unsigned int length = data.getDPlusData(buffer, 100U);
+            benchmark::DoNotOptimize(length);
+            benchmark::ClobberMemory();
+        }
+    }
+    BENCHMARK(AMBEData_getDPlusData);
+
+    static void AMBEData_setDPlusData(benchmark::State& state)
+    {
+        unsigned char buffer[100U];
+        unsigned int length = makeData().getDPlusData(buffer, 100U);
+        in_addr address = {0U};
+
+        for(auto _ : state) {
+            CAMBEData data;
+            bool ret = data.setDPlusData(buffer, length, address, 20001U, 20001U);
+            benchmark::DoNotOptimize(ret);
+        }
+    }
+    BENCHMARK(AMBEData_setDPlusData);
+
+    static void AMBEData_getDCSData(benchmark::State& state)
+    {
+        CAMBEData data = makeData();
+        unsigned char buffer[100U];
+
+        for(auto _ : state) {
+            unsigned int length = data.getDCSData(buffer, 100U);
+            benchmark::DoNotOptimize(length);
+            benchmark::ClobberMemory();
+        }
+    }
+    BENCHMARK(AMBEData_getDCSData);
+
+    static void AMBEData_setDCSData(benchmark::State& state)
+    {
+        unsigned char buffer[100U];
+        unsigned int length = makeData().getDCSData(buffer, 100U);
+        in_addr address = {0U};
+
+        for(auto _ : state) {
+            CAMBEData data;
+            bool ret = data.setDCSData(buffer, length, address, 30051U, 30051U);
+            benchmark::DoNotOptimize(ret);
+        }
+    }
+    BENCHMARK(AMBEData_setDCSData);
+
+    static void AMBEData_getCCSData(benchmark::State& state)
+    {
+        CAMBEData data = makeData();
+        unsigned char buffer[100U];
+
+        for(auto _ : state) {
+            unsigned int length = data.getCCSData(buffer, 100U);
+            benchmark::DoNotOptimize(length);
+            benchmark::ClobberMemory();
+        }
+    }
+    BENCHMARK(AMBEData_getCCSData);
+
+    static void AMBEData_setCCSData(benchmark::State& state)
+    {
+        unsigned char buffer[100U];
+        unsigned int length = makeData().getCCSData(buffer, 100U);
+        in_addr address = {0U};
+
+        for(auto _ : state) {
+            CAMBEData data;
+            bool ret = data.setCCSData(buffer, length, address, 30062U, 30062U);
+            benchmark::DoNotOptimize(ret);
+        }
+    }
+    BENCHMARK(AMBEData_setCCSData);
+}
@@ -0,0 +1,101 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "APRSParser.h"
+#include "StringUtils.h"
+
+namespace APRSParserBenchmarks
+{
+    const unsigned int FEED_LINES = 10000U;
+
+    // Stand-in for a recorded APRS-IS feed, mixed the way a wide filter brings it in
+    static const std::vector<std::string>& getFeed()
+    {
+        static std::vector<std::string> feed;
+
+        if(feed.empty()) {
+            for(unsigned int i = 0U; i < FEED_LINES; i++) {
+                switch(i % 8U) {
+                case 0U:
+                    feed.push_back(CStringUtils::string_format("F%04u-9>APDPRS,DSTAR*,qAR,F4FXL-G:!48%02u.56N/002%02u.14E>/A=000350 DStarGateway", i, i % 60U, i % 60U));
+                    break;
+                case 1U:
+                    feed.push_back(CStringUtils::string_format("F%04u-7>APOTC1,WIDE1-1,WIDE2-1,qAR,F5ABC-10:/092345z4903.50N/07201.75W>088/036/A=001234 mobile %u", i, i));
+                    break;
+                case 2U:
+                    feed.push_back(CStringUtils::string_format("F%04u>APRS,TCPIP*,qAC,T2TEST::F4ABC-%u  :Test Message{%u", i, i % 10U, i % 1000U));
+                    break;
+                case 3U:
+                    feed.push_back(CStringUtils::string_format("F%04u>APRS,TCPIP*,qAC,T2TEST:>Status text number %u", i, i));
+                    break;
+                case 4U:
+                    feed.push_back(CStringUtils::string_format("F%04u>APRS,TCPIP*:;OBJ%06u*092345z4903.50N/07201.75W>Object comment", i, i));
+                    break;
+                case 5U:
+                    feed.push_back(CStringUtils::string_format("F%04u-13>APRS,TCPXX*,qAX,CWOP-5:@092345z4903.50N/07201.75W_220/004g005t077r000p000P000h50b09900", i));
+                    break;
+                case 6U:
+                    feed.push_back(CStringUtils::string_format("F%04u-11>APRS,WIDE2-1,qAR,F1ZZZ:T#%03u,166,010,002,008,000,00000000", i, i % 1000U));
+                    break;
+                default:
+                    feed.push_back("# aprsc 2.1.11-g80df3b4 24 May 2022 10:00:00 GMT T2FRANCE 10.0.0.1:14580");
+                    break;
+                }
+            }
+        }
+
+        return feed;
+    }
+
+    static void APRSParser_parseFeed(benchmark::State& state)
+    {
+        const std::vector<std::string>& feed = getFeed();
+        CAPRSFrame frame;
+
+        for(auto _ : state) {
+            for(const std::string& line : feed) {
+                bool ret = CAPRSParser::parseFrame(line, frame);
+                benchmark::DoNotOptimize(ret);
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * feed.size());
+    }
+    BENCHMARK(APRSParser_parseFeed)->Unit(benchmark::kMicrosecond);
+
+    static void APRSParser_parseFeedView(benchmark::State& state)
+    {
+        const std::vector<std::string>& feed = getFeed();
+        CAPRSFrameView frame;
+
+        for(auto _ : state) {
+            for(const std::string& line : feed) {
+                bool ret = CAPRSParser::parseFrame(std::string_view(line), frame);
+                benchmark::DoNotOptimize(ret);
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * feed.size());
+    }
+    BENCHMARK(APRSParser_parseFeedView)->Unit(benchmark::kMicrosecond);
+}
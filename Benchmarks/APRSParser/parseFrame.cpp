@@ -0,0 +1,48 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+#include "APRSParser.h"
+
+namespace APRSParserBenchmarks
+{
+    static const std::vector<std::string> FRAMES = {
+        "F4FXL-9>APDPRS,DSTAR*,qAR,F4FXL-G:!4848.56N/00222.14E>/A=000350 DStarGateway",
+        "N0CALL>APRS,WIDE1-1,qAR,F4ABC:=4903.50N/07201.75W-Test comment",
+        "N0CALL>APRS,TCPIP*,qAC,T2TEST::F4ABC    :Test Message{123",
+        "N0CALL>APRS,TCPIP*:;OBJECT   *092345z4903.50N/07201.75W>Object comment",
+        "N0CALL>APRS:@092345z/5L!!<*e7>7P[ Compressed position"
+    };
+
+    static void APRSParser_parseFrame(benchmark::State& state)
+    {
+        unsigned int n = 0U;
+        for(auto _ : state) {
+            CAPRSFrame frame;
+            bool ret = CAPRSParser::parseFrame(FRAMES[n], frame);
+            benchmark::DoNotOptimize(ret);
+
+            if(++n == FRAMES.size())
+                n = 0U;
+        }
+    }
+    BENCHMARK(APRSParser_parseFrame);
+}
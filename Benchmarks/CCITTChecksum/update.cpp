@@ -0,0 +1,46 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "CCITTChecksum.h"
+
+namespace CCITTChecksumBenchmarks
+{
+    // Range covers a radio header (39 bytes) up to a full DCS frame, then bulk input
+    static void CCITTChecksum_update(benchmark::State& state)
+    {
+        std::vector<unsigned char> data(state.range(0));
+        for(unsigned int i = 0U; i < data.size(); i++)
+            data[i] = (unsigned char)(i * 31U);
+
+        for(auto _ : state) {
+            CCCITTChecksum checksum;
+            checksum.update(data.data(), data.size());
+
+            unsigned char result[2U];
+            checksum.result(result);
+            benchmark::DoNotOptimize(result);
+        }
+
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(data.size()));
+    }
+    BENCHMARK(CCITTChecksum_update)->Arg(39)->Arg(100)->Arg(1024)->Arg(65536);
+}
@@ -0,0 +1,100 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <vector>
+
+#include "DTMF.h"
+#include "DStarDefines.h"
+
+namespace DTMFBenchmarks
+{
+    // Plain voice, the common case where the signature check fails early
+    static void DTMF_decodeVoice(benchmark::State& state)
+    {
+        CDTMF dtmf;
+
+        for(auto _ : state) {
+            bool ret = dtmf.decode(NULL_AMBE_DATA_BYTES, false);
+            benchmark::DoNotOptimize(ret);
+        }
+    }
+    BENCHMARK(DTMF_decodeVoice);
+
+    // Cycles through every DTMF symbol, resetting the decoder once per pass
+    static void DTMF_decodeTones(benchmark::State& state)
+    {
+        const unsigned char SYMBOLS[16U][4U] = {
+            {0x00U, 0x40U, 0x08U, 0x20U}, {0x00U, 0x00U, 0x00U, 0x00U}, {0x00U, 0x40U, 0x00U, 0x00U}, {0x10U, 0x00U, 0x00U, 0x00U},
+            {0x00U, 0x00U, 0x00U, 0x20U}, {0x00U, 0x40U, 0x00U, 0x20U}, {0x10U, 0x00U, 0x00U, 0x20U}, {0x00U, 0x00U, 0x08U, 0x00U},
+            {0x00U, 0x40U, 0x08U, 0x00U}, {0x10U, 0x00U, 0x08U, 0x00U}, {0x10U, 0x40U, 0x00U, 0x00U}, {0x10U, 0x40U, 0x00U, 0x20U},
+            {0x10U, 0x40U, 0x08U, 0x00U}, {0x10U, 0x40U, 0x08U, 0x20U}, {0x00U, 0x00U, 0x08U, 0x20U}, {0x10U, 0x00U, 0x08U, 0x20U}
+        };
+
+        unsigned char frames[16U][VOICE_FRAME_LENGTH_BYTES];
+        for(unsigned int i = 0U; i < 16U; i++) {
+            unsigned char frame[VOICE_FRAME_LENGTH_BYTES] = {0x82U, 0x08U, 0x20U, 0x82U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U};
+            frame[4U] |= SYMBOLS[i][0U];
+            frame[5U] |= SYMBOLS[i][1U];
+            frame[7U] |= SYMBOLS[i][2U];
+            frame[8U] |= SYMBOLS[i][3U];
+            ::memcpy(frames[i], frame, VOICE_FRAME_LENGTH_BYTES);
+        }
+
+        CDTMF dtmf;
+        unsigned int n = 0U;
+        for(auto _ : state) {
+            bool ret = dtmf.decode(frames[n], false);
+            benchmark::DoNotOptimize(ret);
+
+            if(++n == 16U) {
+                n = 0U;
+                dtmf.reset();
+            }
+        }
+    }
+    BENCHMARK(DTMF_decodeTones);
+
+    // A buffered transmission of 60 voice frames with a four key command in it, scanned in one call
+    static void DTMF_decodeTransmission(benchmark::State& state)
+    {
+        const unsigned char TONES[4U][VOICE_FRAME_LENGTH_BYTES] = {
+            {0x82U, 0x08U, 0x20U, 0x82U, 0x00U, 0x00U, 0x00U, 0x08U, 0x20U}, // *
+            {0x82U, 0x08U, 0x20U, 0x82U, 0x00U, 0x40U, 0x00U, 0x08U, 0x20U}, // 0
+            {0x82U, 0x08U, 0x20U, 0x82U, 0x00U, 0x40U, 0x00U, 0x00U, 0x00U}, // 2
+            {0x82U, 0x08U, 0x20U, 0x82U, 0x10U, 0x40U, 0x00U, 0x00U, 0x00U}  // A
+        };
+
+        std::vector<unsigned char> frames;
+        for(unsigned int i = 0U; i < 60U; i++) {
+            if(i >= 20U && i < 44U && (i % 6U) < 4U)
+                frames.insert(frames.end(), TONES[(i - 20U) / 6U], TONES[(i - 20U) / 6U] + VOICE_FRAME_LENGTH_BYTES);
+            else
+                frames.insert(frames.end(), NULL_AMBE_DATA_BYTES, NULL_AMBE_DATA_BYTES + VOICE_FRAME_LENGTH_BYTES);
+            frames.insert(frames.end(), NULL_SLOW_DATA_BYTES, NULL_SLOW_DATA_BYTES + DATA_FRAME_LENGTH_BYTES);
+        }
+
+        for(auto _ : state) {
+            CDTMF dtmf;
+            bool ret = dtmf.decode(frames.data(), 60U, DV_FRAME_LENGTH_BYTES);
+            benchmark::DoNotOptimize(ret);
+        }
+    }
+    BENCHMARK(DTMF_decodeTransmission);
+}
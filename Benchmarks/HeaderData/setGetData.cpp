@@ -0,0 +1,224 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "HeaderData.h"
+
+namespace HeaderDataBenchmarks
+{
+    // Builds a typical header and serialises it with the given getter, so that setters are fed realistic frames
+    static CHeaderData makeHeader()
+    {
+        CHeaderData header("F4FXL  B", "ID51", "CQCQCQ  ", "F4FXL  B", "F4FXL  G");
+        header.setId(0x1234U);
+        header.setBand1(0x00U);
+        header.setBand2(0x02U);
+        header.setBand3(0x01U);
+        header.setRptSeq(0x10U);
+
+        return header;
+    }
+
+    static void HeaderData_getIcomRepeaterData(benchmark::State& state)
+    {
+        CHeaderData header = makeHeader();
+        unsigned char buffer[100U];
+
+        for(auto _ : state) {
+            unsigned int length = header.getIcomRepeaterData(buffer, 100U, true);
+            benchmark::DoNotOptimize(length);
+            benchmark::ClobberMemory();
+        }
+    }
+    BENCHMARK(HeaderData_getIcomRepeaterData);
+
+    static void HeaderData_setIcomRepeaterData(benchmark::State& state)
+    {
+        unsigned char buffer[100U];
+        unsigned int length = makeHeader().getIcomRepeaterData(buffer, 100U, true);
+        in_addr address = {0U};
+
+        for(auto _ : state) {
+            CHeaderData header;
+            bool ret = header.setIcomRepeaterData(buffer, length, true, address, 20000U);
+            benchmark::DoNotOptimize(ret);
+        }
+    }
+    BENCHMARK(HeaderData_setIcomRepeaterData);
+
+    static void HeaderData_getHBRepeaterData(benchmark::State& state)
+    {
+        CHeaderData header = makeHeader();
+        unsigned char buffer[100U];
+
+        for(auto _ : state) {
+            unsigned int length = header.getHBRepeaterData(buffer, 100U, true);
+            benchmark::DoNotOptimize(length);
+            benchmark::ClobberMemory();
+        }
+    }
+    BENCHMARK(HeaderData_getHBRepeaterData);
+
+    static void HeaderData_setHBRepeaterData(benchmark::State& state)
+    {
+        unsigned char buffer[100U];
+        unsigned int length = makeHeader().getHBRepeaterData(buffer, 100U, true);
+        in_addr address = {0U};
+
+        for(auto _ : state) {
+            CHeaderData header;
+            bool ret = header.setHBRepeaterData(buffer, length, true, address, 20010U);
+            benchmark::DoNotOptimize(ret);
+        }
+    }
+    BENCHMARK(HeaderData_setHBRepeaterData);
+
+    static void HeaderData_getG2Data(benchmark::State& state)
+    {
+        CHeaderData header = makeHeader();
+        unsigned char buffer[100U];
+
+        for(auto _ : state) {
+            unsigned int length = header.getG2Data(buffer, 100U, true);
+            benchmark::DoNotOptimize(length);
+            benchmark::ClobberMemory();
+        }
+    }
+    BENCHMARK(HeaderData_getG2Data);
+
+    static void HeaderData_setG2Data(benchmark::State& state)
+    {
+        unsigned char buffer[100U];
+        unsigned int length = makeHeader().getG2Data(buffer, 100U, true);
+        in_addr address = {0U};
+
+        for(auto _ : state) {
+            CHeaderData header;
+            bool ret = header.setG2Data(buffer, length, true, address, 40000U);
+            benchmark::DoNotOptimize(ret);
+        }
+    }
+    BENCHMARK(HeaderData_setG2Data);
+
+    static void HeaderData_getDExtraData(benchmark::State& state)
+    {
+        CHeaderData header = makeHeader();
+        unsigned char buffer[100U];
+
+        for(auto _ : state) {
+            unsigned int length = header.getDExtraData(buffer, 100U, true);
+            benchmark::DoNotOptimize(length);
+            benchmark::ClobberMemory();
+        }
+    }
+    BENCHMARK(HeaderData_getDExtraData);
+
+    static void HeaderData_setDExtraData(benchmark::State& state)
+    {
+        unsigned char buffer[100U];
+        unsigned int length = makeHeader().getDExtraData(buffer, 100U, true);
+        in_addr address = {0U};
+
+        for(auto _ : state) {
+            CHeaderData header;
+            bool ret = header.setDExtraData(buffer, length, true, address, 30001U, 30001U);
+            benchmark::DoNotOptimize(ret);
+        }
+    }
+    BENCHMARK(HeaderData_setDExtraData);
+
+    static void HeaderData_getDPlusData(benchmark::State& state)
+    {
+        CHeaderData header = makeHeader();
+        unsigned char buffer[100U];
+
+        for(auto _ : state) {
+            unsigned int length = header.getDPlusData(buffer, 100U, true);
+            benchmark::DoNotOptimize(length);
+            benchmark::ClobberMemory();
+        }
+    }
+    BENCHMARK(HeaderData_getDPlusData);
+
+    static void HeaderData_setDPlusData(benchmark::State& state)
+    {
+        unsigned char buffer[100U];
+        unsigned int length = makeHeader().getDPlusData(buffer, 100U, true);
+        in_addr address = {0U};
+
+        for(auto _ : state) {
+            CHeaderData header;
+            bool ret = header.setDPlusData(buffer, length, true, address, 20001U, 20001U);
+            benchmark::DoNotOptimize(ret);
+        }
+    }
+    BENCHMARK(HeaderData_setDPlusData);
+
+    static void HeaderData_getDCSData(benchmark::State& state)
+    {
+        CHeaderData header = makeHeader();
+        unsigned char buffer[100U];
+
+        for(auto _ : state) {
+            header.getDCSData(buffer, 100U);
+            benchmark::ClobberMemory();
+        }
+    }
+    BENCHMARK(HeaderData_getDCSData);
+
+    static void HeaderData_setDCSData(benchmark::State& state)
+    {
+        unsigned char buffer[100U];
+        makeHeader().getDCSData(buffer, 100U);
+        in_addr address = {0U};
+
+        for(auto _ : state) {
+            CHeaderData header;
+            header.setDCSData(buffer, 100U, address, 30051U, 30051U);
+            benchmark::DoNotOptimize(header);
+        }
+    }
+    BENCHMARK(HeaderData_setDCSData);
+
+    static void HeaderData_getCCSData(benchmark::State& state)
+    {
+        CHeaderData header = makeHeader();
+        unsigned char buffer[100U];
+
+        for(auto _ : state) {
+            header.getCCSData(buffer, 100U);
+            benchmark::ClobberMemory();
+        }
+    }
+    BENCHMARK(HeaderData_getCCSData);
+
+    static void HeaderData_setCCSData(benchmark::State& state)
+    {
+        unsigned char buffer[100U];
+        makeHeader().getCCSData(buffer, 100U);
+        in_addr address = {0U};
+
+        for(auto _ : state) {
+            CHeaderData header;
+            header.setCCSData(buffer, 100U, address, 30062U, 30062U);
+            benchmark::DoNotOptimize(header);
+        }
+    }
+    BENCHMARK(HeaderData_setCCSData);
+}
@@ -0,0 +1,70 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <thread>
+#include <string>
+
+#include "IRCDDBApp.h"
+#include "IRCMessage.h"
+#include "IRCMessageQueue.h"
+
+namespace IRCDDBAppBenchmarks
+{
+    // Time from the network becoming available to the end of the initial SENDLIST,
+    // with a fake server answering each SENDLIST straight away
+    static void IRCDDBApp_connectToReady(benchmark::State& state)
+    {
+        for(auto _ : state) {
+            IRCDDBApp app("#dstar");
+            IRCMessageQueue sendQ;
+            app.setCurrentNick("dstargw-1");
+            app.userJoin("s-grp1s1", "s-grp1s1", "ircddb.net");
+            app.userChanOp("s-grp1s1", true);
+            app.startWork();
+
+            auto start = std::chrono::steady_clock::now();
+            app.setSendQ(&sendQ);
+
+            while(app.getConnectionState() < 7) {
+                IRCMessage * m = sendQ.getMessage();
+                if(m == nullptr) {
+                    std::this_thread::sleep_for(std::chrono::microseconds(100));
+                    continue;
+                }
+
+                if(m->getParamCount() == 2 && m->getParam(1).compare(0, 8, "SENDLIST") == 0) {
+                    IRCMessage listEnd("PRIVMSG");
+                    listEnd.m_prefix = "s-grp1s1!s-grp1s1@ircddb.net";
+                    listEnd.addParam("dstargw-1");
+                    listEnd.addParam("LIST_END");
+                    app.msgQuery(&listEnd);
+                }
+                delete m;
+            }
+
+            auto elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start);
+            state.SetIterationTime(elapsed.count());
+
+            app.setSendQ(nullptr);
+            app.stopWork();
+        }
+    }
+    BENCHMARK(IRCDDBApp_connectToReady)->Unit(benchmark::kMillisecond)->UseManualTime()->Iterations(3);
+}
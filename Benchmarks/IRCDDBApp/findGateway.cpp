@@ -0,0 +1,102 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+#include "IRCDDBApp.h"
+#include "IRCMessage.h"
+#include "StringUtils.h"
+
+namespace IRCDDBAppBenchmarks
+{
+    const unsigned int CHANNEL_GATEWAYS = 3000U;
+
+    static std::string makeGateway(unsigned int i)
+    {
+        return CStringUtils::string_format("F%u%c%c%c", i % 10U, 'A' + (i / 10U) % 26U, 'A' + (i / 260U) % 26U, 'A' + (i / 6760U) % 26U);
+    }
+
+    static void drainReplies(IRCDDBApp& app)
+    {
+        IRCMessage * m;
+        while((m = app.getReplyMessage()) != nullptr)
+            delete m;
+    }
+
+    // A busy #dstar channel, two nicks per gateway and a few servers
+    static void fillChannel(IRCDDBApp& app)
+    {
+        app.userJoin("s-grp1s1", "s-grp1s1", "ircddb.net");
+        app.userJoin("s-grp2s1", "s-grp2s1", "ircddb.net");
+
+        for(unsigned int i = 0U; i < CHANNEL_GATEWAYS; i++) {
+            std::string nick = makeGateway(i);
+            std::string host = CStringUtils::string_format("10.%u.%u.%u", i >> 16, (i >> 8) & 0xFFU, i & 0xFFU);
+            app.userJoin(nick + "-1", nick, host);
+            app.userJoin(nick + "-2", nick, host);
+
+            IRCMessage m("PRIVMSG");
+            m.m_prefix = "s-grp1s1!s-grp1s1@ircddb.net";
+            m.addParam("dstargw-1");
+            m.addParam("UPDATE 1 2022-05-24 10:00:00 " + (nick + "___").substr(0, 7) + "B " + (nick + "___").substr(0, 8));
+            app.msgQuery(&m);
+        }
+
+        drainReplies(app);
+    }
+
+    static void IRCDDBApp_findGateway(benchmark::State& state)
+    {
+        IRCDDBApp app("#dstar");
+        fillChannel(app);
+
+        std::vector<std::string> gateways;
+        for(unsigned int i = 0U; i < CHANNEL_GATEWAYS; i += 7U)
+            gateways.push_back((makeGateway(i) + "   ").substr(0, 7) + "G");
+
+        for(auto _ : state) {
+            for(const auto& gateway : gateways)
+                app.findGateway(gateway);
+            drainReplies(app);
+        }
+
+        state.SetItemsProcessed(state.iterations() * gateways.size());
+    }
+    BENCHMARK(IRCDDBApp_findGateway);
+
+    static void IRCDDBApp_findRepeater(benchmark::State& state)
+    {
+        IRCDDBApp app("#dstar");
+        fillChannel(app);
+
+        std::vector<std::string> repeaters;
+        for(unsigned int i = 0U; i < CHANNEL_GATEWAYS; i += 7U)
+            repeaters.push_back((makeGateway(i) + "   ").substr(0, 7) + "B");
+
+        for(auto _ : state) {
+            for(const auto& repeater : repeaters)
+                app.findRepeater(repeater);
+            drainReplies(app);
+        }
+
+        state.SetItemsProcessed(state.iterations() * repeaters.size());
+    }
+    BENCHMARK(IRCDDBApp_findRepeater);
+}
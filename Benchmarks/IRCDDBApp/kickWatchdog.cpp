@@ -0,0 +1,51 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <benchmark/benchmark.h>
+#include <string>
+
+#include "IRCDDBApp.h"
+
+namespace IRCDDBAppBenchmarks
+{
+    static void IRCDDBApp_kickWatchdog(benchmark::State& state)
+    {
+        IRCDDBApp app("#dstar");
+        const std::string callsign("F4FXL  B");
+        const std::string text("linux_DStarGateway-1.0 20220524 F4FXL  B 1 2 3");
+
+        for(auto _ : state) {
+            app.kickWatchdog(callsign, text);
+        }
+    }
+    BENCHMARK(IRCDDBApp_kickWatchdog);
+
+    static void IRCDDBApp_rptrQTH(benchmark::State& state)
+    {
+        IRCDDBApp app("#dstar");
+        const std::string callsign("F4FXL  B");
+        const std::string desc1("Strasbourg, France");
+        const std::string desc2("Cathedral");
+        const std::string url("https://github.com/F4FXL/DStarGateway");
+
+        for(auto _ : state) {
+            app.rptrQTH(callsign, 48.5839, 7.7455, desc1, desc2, url);
+        }
+    }
+    BENCHMARK(IRCDDBApp_rptrQTH);
+}
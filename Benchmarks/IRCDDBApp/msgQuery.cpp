@@ -0,0 +1,70 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+#include <memory>
+
+#include "IRCDDBApp.h"
+#include "IRCMessage.h"
+#include "StringUtils.h"
+
+namespace IRCDDBAppBenchmarks
+{
+    const unsigned int SENDLIST_ROWS = 100000U;
+
+    // Synthetic SENDLIST answer as the ircDDB servers send it, one repeater row for nine user rows
+    static const std::vector<std::unique_ptr<IRCMessage>>& getSendList()
+    {
+        static std::vector<std::unique_ptr<IRCMessage>> messages;
+
+        if(messages.empty()) {
+            for(unsigned int i = 0U; i < SENDLIST_ROWS; i++) {
+                std::string line;
+                unsigned int second = i % 60U, minute = (i / 60U) % 60U, hour = (i / 3600U) % 24U;
+                if(i % 10U == 0U)
+                    line = CStringUtils::string_format("UPDATE 1 2022-05-%02u %02u:%02u:%02u F%04uX_B F%04uX_G", 1U + i % 28U, hour, minute, second, i % 10000U, i % 10000U);
+                else
+                    line = CStringUtils::string_format("UPDATE 2022-05-%02u %02u:%02u:%02u F%05u__ F%04uX_B", 1U + i % 28U, hour, minute, second, i % 100000U, (i / 10U) % 10000U);
+
+                IRCMessage* m = new IRCMessage("PRIVMSG");
+                m->m_prefix = "s-grp1s1!s-grp1s1@ircddb.net";
+                m->addParam("dstargw-1");
+                m->addParam(line);
+                messages.emplace_back(m);
+            }
+        }
+
+        return messages;
+    }
+
+    static void IRCDDBApp_msgQuery_sendList(benchmark::State& state)
+    {
+        const auto& messages = getSendList();
+
+        for(auto _ : state) {
+            IRCDDBApp app("#dstar");
+            for(auto& m : messages)
+                app.msgQuery(m.get());
+        }
+
+        state.SetItemsProcessed(state.iterations() * messages.size());
+    }
+    BENCHMARK(IRCDDBApp_msgQuery_sendList)->Unit(benchmark::kMillisecond);
+}
@@ -0,0 +1,40 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <benchmark/benchmark.h>
+#include <string>
+
+#include "IRCDDBSanitizer.h"
+
+namespace IRCDDBSanitizerBenchmarks
+{
+    // The six callsigns sendHeard reports for every header and every stats message
+    static void IRCDDBSanitizer_appendCallsign(benchmark::State& state)
+    {
+        const std::string callsigns[] = { "F4FXL   ", "ID51", "CQCQCQ  ", "F4FXL  B", "F4FXL  G", "        " };
+        std::string buffer;
+
+        for(auto _ : state) {
+            buffer.clear();
+            for(const auto& callsign : callsigns)
+                IRCDDBSanitizer::appendCallsign(buffer, callsign);
+            benchmark::DoNotOptimize(buffer.data());
+        }
+    }
+    BENCHMARK(IRCDDBSanitizer_appendCallsign);
+}
@@ -0,0 +1,89 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "IRCReceiver.h"
+#include "IRCMessageQueue.h"
+#include "StringUtils.h"
+
+namespace IRCReceiverBenchmarks
+{
+    const unsigned int BURST_LINES = 10000U;
+
+    // A SENDLIST burst as it comes off the wire
+    static const std::string& getBurst()
+    {
+        static std::string burst;
+
+        if(burst.empty()) {
+            for(unsigned int i = 0U; i < BURST_LINES; i++) {
+                unsigned int second = i % 60U, minute = (i / 60U) % 60U;
+                burst.append(CStringUtils::string_format(":s-grp1s1!s-grp1s1@ircddb.net PRIVMSG dstargw-1 :UPDATE 2022-05-24 10:%02u:%02u F%05u__ F%04uX_B\r\n", minute, second, i, i / 10U));
+            }
+        }
+
+        return burst;
+    }
+
+    static void IRCReceiver_sendListBurst(benchmark::State& state)
+    {
+        const std::string& burst = getBurst();
+
+        int socks[2];
+        if(::socketpair(AF_UNIX, SOCK_STREAM, 0, socks) != 0) {
+            state.SkipWithError("socketpair failed");
+            return;
+        }
+
+        IRCMessageQueue queue;
+        IRCReceiver receiver(socks[0], &queue);
+        receiver.startWork();
+
+        for(auto _ : state) {
+            size_t sent = 0U;
+            unsigned int received = 0U;
+
+            // Interleave writing and draining so neither side stalls on a full socket buffer
+            while(received < BURST_LINES) {
+                if(sent < burst.size()) {
+                    ssize_t res = ::send(socks[1], burst.data() + sent, burst.size() - sent, MSG_DONTWAIT);
+                    if(res > 0)
+                        sent += res;
+                }
+
+                while(queue.messageAvailable()) {
+                    queue.recycleMessage(queue.getMessage());
+                    received++;
+                }
+            }
+        }
+
+        receiver.stopWork();
+        ::close(socks[0]);
+        ::close(socks[1]);
+
+        state.SetItemsProcessed(state.iterations() * BURST_LINES);
+        state.SetBytesProcessed(state.iterations() * burst.size());
+    }
+    BENCHMARK(IRCReceiver_sendListBurst)->Unit(benchmark::kMillisecond)->UseRealTime();
+}
@@ -0,0 +1,80 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+#include <cstring>
+
+#include "SlowDataDemux.h"
+#include "SlowDataEncoder.h"
+#include "TextCollector.h"
+#include "APRSCollector.h"
+#include "DStarDefines.h"
+
+namespace SlowDataDemuxBenchmarks
+{
+    // One transmission of a superframe of text and GPS-A slow data through the text and APRS collectors,
+    // the argument is the number of extra consumers registered for the other slow data types
+    static void SlowDataDemux_writeData(benchmark::State& state)
+    {
+        CSlowDataEncoder encoder;
+        encoder.setTextData("Hello from F4FXL");
+        encoder.setGPSData("$$CRC1234,F4FXL>API51:!4898.03N/00844.64E>\r");
+
+        std::vector<CAMBEData> frames(21U);
+        for(unsigned int i = 0U; i < frames.size(); i++) {
+            unsigned char buffer[DV_FRAME_LENGTH_BYTES];
+            ::memcpy(buffer, NULL_AMBE_DATA_BYTES, VOICE_FRAME_LENGTH_BYTES);
+            if(i == 0U)
+                ::memcpy(buffer + VOICE_FRAME_LENGTH_BYTES, DATA_SYNC_BYTES, DATA_FRAME_LENGTH_BYTES);
+            else
+                encoder.getInterleavedData(buffer + VOICE_FRAME_LENGTH_BYTES);
+
+            frames[i].setData(buffer, DV_FRAME_LENGTH_BYTES);
+            frames[i].setSeq(i);
+        }
+
+        CTextCollector text;
+        CAPRSCollector aprs;
+        unsigned int others = 0U;
+
+        CSlowDataDemux demux;
+        demux.addHandler(SLOW_DATA_TYPE_TEXT, [&text](const unsigned char* block) { text.writeBlock(block); });
+        demux.addHandler(SLOW_DATA_TYPE_GPS, [&aprs](const unsigned char* block) { aprs.writeBlock(block); });
+
+        const unsigned char types[] = { SLOW_DATA_TYPE_HEADER, SLOW_DATA_TYPE_FAST_DATA1, SLOW_DATA_TYPE_FAST_DATA2, SLOW_DATA_TYPE_SQUELCH };
+        for(int i = 0; i < state.range(0); i++)
+            demux.addHandler(types[i % 4], [&others](const unsigned char*) { others++; });
+
+        for(auto _ : state) {
+            // As on a new header, the sentence collectors otherwise keep growing
+            demux.reset();
+            text.reset();
+            aprs.reset();
+
+            for(auto& frame : frames)
+                demux.writeData(frame);
+
+            benchmark::DoNotOptimize(text.hasData());
+        }
+
+        state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(frames.size()));
+    }
+    BENCHMARK(SlowDataDemux_writeData)->Arg(0)->Arg(4)->Arg(16);
+}
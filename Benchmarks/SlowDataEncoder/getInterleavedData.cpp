@@ -0,0 +1,59 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "SlowDataEncoder.h"
+#include "HeaderData.h"
+#include "DStarDefines.h"
+
+namespace SlowDataEncoderBenchmarks
+{
+    // Builds the interleaved stream for header, text and GPS data, then fetches it frame by frame as a transmission would
+    static void SlowDataEncoder_buildInterleavedData(benchmark::State& state)
+    {
+        CHeaderData header("F4FXL  B", "ID51", "CQCQCQ  ", "F4FXL  B", "F4FXL  G");
+        unsigned char buffer[DATA_FRAME_LENGTH_BYTES];
+
+        for(auto _ : state) {
+            CSlowDataEncoder encoder;
+            encoder.setHeaderData(header);
+            encoder.setTextData("DStarGateway benchmark");
+            encoder.setGPSData("$GPGGA,092750.000,5321.6802,N,00630.3372,W,1,8,1.03,61.7,M,55.2,M,,*76\r\n");
+            encoder.getInterleavedData(buffer);
+            benchmark::DoNotOptimize(buffer);
+        }
+    }
+    BENCHMARK(SlowDataEncoder_buildInterleavedData);
+
+    static void SlowDataEncoder_getInterleavedData(benchmark::State& state)
+    {
+        CHeaderData header("F4FXL  B", "ID51", "CQCQCQ  ", "F4FXL  B", "F4FXL  G");
+        CSlowDataEncoder encoder;
+        encoder.setHeaderData(header);
+        encoder.setTextData("DStarGateway benchmark");
+        encoder.setGPSData("$GPGGA,092750.000,5321.6802,N,00630.3372,W,1,8,1.03,61.7,M,55.2,M,,*76\r\n");
+
+        unsigned char buffer[DATA_FRAME_LENGTH_BYTES];
+        for(auto _ : state) {
+            encoder.getInterleavedData(buffer);
+            benchmark::DoNotOptimize(buffer);
+        }
+    }
+    BENCHMARK(SlowDataEncoder_getInterleavedData);
+}
@@ -0,0 +1,95 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <vector>
+
+#include "SlowDataEncoder.h"
+#include "HeaderData.h"
+#include "DStarDefines.h"
+
+namespace SlowDataEncoderBenchmarks
+{
+    // Ten superframes, about four seconds of announcement
+    const unsigned int TRANSMISSION_FRAMES = 210U;
+
+    static void setData(CSlowDataEncoder& encoder, const CHeaderData& header)
+    {
+        encoder.setHeaderData(header);
+        encoder.setTextData("DStarGateway benchmark");
+        encoder.setGPSData("$GPGGA,092750.000,5321.6802,N,00630.3372,W,1,8,1.03,61.7,M,55.2,M,,*76\r\n");
+    }
+
+    // The slow data of a whole transmission, three bytes per frame as the announcement paths did it
+    static void SlowDataEncoder_transmissionBlocks(benchmark::State& state)
+    {
+        CHeaderData header("F4FXL  B", "ID51", "CQCQCQ  ", "F4FXL  B", "F4FXL  G");
+        std::vector<unsigned char> frames(TRANSMISSION_FRAMES * DV_FRAME_LENGTH_BYTES);
+
+        for(auto _ : state) {
+            CSlowDataEncoder encoder;
+            setData(encoder, header);
+
+            for(unsigned int i = 0U; i < TRANSMISSION_FRAMES; i++) {
+                unsigned char* buffer = frames.data() + i * DV_FRAME_LENGTH_BYTES;
+                if(i % 21U == 0U) {
+                    ::memcpy(buffer + VOICE_FRAME_LENGTH_BYTES, DATA_SYNC_BYTES, DATA_FRAME_LENGTH_BYTES);
+                    encoder.sync();
+                } else {
+                    encoder.getInterleavedData(buffer + VOICE_FRAME_LENGTH_BYTES);
+                }
+            }
+            benchmark::DoNotOptimize(frames.data());
+        }
+    }
+    BENCHMARK(SlowDataEncoder_transmissionBlocks);
+
+    // Same transmission from the pre-scrambled stream
+    static void SlowDataEncoder_transmissionScrambled(benchmark::State& state)
+    {
+        CHeaderData header("F4FXL  B", "ID51", "CQCQCQ  ", "F4FXL  B", "F4FXL  G");
+        std::vector<unsigned char> frames(TRANSMISSION_FRAMES * DV_FRAME_LENGTH_BYTES);
+
+        for(auto _ : state) {
+            CSlowDataEncoder encoder;
+            setData(encoder, header);
+
+            encoder.getScrambledData(frames.data(), TRANSMISSION_FRAMES);
+            benchmark::DoNotOptimize(frames.data());
+        }
+    }
+    BENCHMARK(SlowDataEncoder_transmissionScrambled);
+
+    // Stream already built, e.g. the same announcement going to another repeater
+    static void SlowDataEncoder_transmissionCached(benchmark::State& state)
+    {
+        CHeaderData header("F4FXL  B", "ID51", "CQCQCQ  ", "F4FXL  B", "F4FXL  G");
+        std::vector<unsigned char> frames(TRANSMISSION_FRAMES * DV_FRAME_LENGTH_BYTES);
+
+        CSlowDataEncoder encoder;
+        setData(encoder, header);
+        encoder.getScrambledData();
+
+        for(auto _ : state) {
+            encoder.getScrambledData(frames.data(), TRANSMISSION_FRAMES);
+            benchmark::DoNotOptimize(frames.data());
+        }
+    }
+    BENCHMARK(SlowDataEncoder_transmissionCached);
+}
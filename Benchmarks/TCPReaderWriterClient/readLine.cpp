@@ -0,0 +1,137 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <dlfcn.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+#include "TCPReaderWriterClient.h"
+#include "StringUtils.h"
+
+// Count the socket reads made by the code under test, the calls go on to the C library
+static std::atomic<unsigned long> g_recvCalls(0UL);
+static std::atomic<unsigned long> g_selectCalls(0UL);
+
+extern "C" ssize_t recv(int fd, void* buffer, size_t length, int flags)
+{
+    static auto next = (ssize_t (*)(int, void*, size_t, int))::dlsym(RTLD_NEXT, "recv");
+    g_recvCalls++;
+    return next(fd, buffer, length, flags);
+}
+
+extern "C" int select(int nfds, fd_set* readFds, fd_set* writeFds, fd_set* exceptFds, struct timeval* timeout)
+{
+    static auto next = (int (*)(int, fd_set*, fd_set*, fd_set*, struct timeval*))::dlsym(RTLD_NEXT, "select");
+    g_selectCalls++;
+    return next(nfds, readFds, writeFds, exceptFds, timeout);
+}
+
+namespace TCPReaderWriterClientBenchmarks
+{
+    const unsigned int BURST_LINES = 10000U;
+
+    // What a wide APRS-IS filter sends our way
+    static const std::string& getBurst()
+    {
+        static std::string burst;
+
+        if(burst.empty()) {
+            for(unsigned int i = 0U; i < BURST_LINES; i++) {
+                if(i % 1000U == 0U)
+                    burst.append("# aprsc 2.1.11-g80df3b4 24 May 2022 10:00:00 GMT T2FRANCE 10.0.0.1:14580\r\n");
+                burst.append(CStringUtils::string_format("F%04u-9>APDPRS,DSTAR*,qAR,F4FXL-B:!4849.%02uN/00220.%02uE>/A=000150 D-Star test %u\r\n", i, i % 100U, (i / 100U) % 100U, i));
+            }
+        }
+
+        return burst;
+    }
+
+    static void TCPReaderWriterClient_readLine(benchmark::State& state)
+    {
+        const std::string& burst = getBurst();
+
+        // Local stand-in for the APRS-IS server
+        int listener = ::socket(PF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t addrLen = sizeof(addr);
+        if(listener < 0 || ::bind(listener, (sockaddr*)&addr, sizeof(addr)) != 0 || ::listen(listener, 1) != 0
+            || ::getsockname(listener, (sockaddr*)&addr, &addrLen) != 0) {
+            state.SkipWithError("Cannot set up the local TCP server");
+            return;
+        }
+
+        CTCPReaderWriterClient client("127.0.0.1", ntohs(addr.sin_port));
+        if(!client.open()) {
+            state.SkipWithError("Cannot connect to the local TCP server");
+            return;
+        }
+        int server = ::accept(listener, NULL, NULL);
+
+        unsigned long recvCalls = 0UL, selectCalls = 0UL, lines = 0UL;
+        std::string line;
+
+        for(auto _ : state) {
+            std::thread writer([&burst, server]() {
+                size_t sent = 0U;
+                while(sent < burst.size()) {
+                    ssize_t res = ::send(server, burst.data() + sent, burst.size() - sent, 0);
+                    if(res <= 0)
+                        break;
+                    sent += res;
+                }
+            });
+
+            unsigned long recvStart = g_recvCalls, selectStart = g_selectCalls;
+            size_t received = 0U;
+            while(received < burst.size()) {
+                int len = client.readLine(line, 1U);
+                if(len <= 0)
+                    break;
+                received += len;
+                lines++;
+            }
+            recvCalls += g_recvCalls - recvStart;
+            selectCalls += g_selectCalls - selectStart;
+
+            writer.join();
+            if(received != burst.size()) {
+                state.SkipWithError("Lines lost");
+                break;
+            }
+        }
+
+        client.close();
+        ::close(server);
+        ::close(listener);
+
+        state.SetItemsProcessed(lines);
+        state.SetBytesProcessed(state.iterations() * burst.size());
+        state.counters["recv_per_line"] = lines > 0UL ? double(recvCalls) / double(lines) : 0.0;
+        state.counters["select_per_line"] = lines > 0UL ? double(selectCalls) / double(lines) : 0.0;
+    }
+    BENCHMARK(TCPReaderWriterClient_readLine)->Unit(benchmark::kMillisecond)->UseRealTime();
+}
@@ -0,0 +1,37 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <benchmark/benchmark.h>
+#include <string>
+
+#include "Utils.h"
+
+namespace UtilsBenchmarks
+{
+    // Typical ircDDB UPDATE line
+    static void Utils_stringTokenizer(benchmark::State& state)
+    {
+        const std::string line("2022-05-24 09:15:32 F4FXL__B 0 F4FXL__G F4FXL  G CQCQCQ   F4FXL__B 00 00 00 0123 0 1 0 0");
+
+        for(auto _ : state) {
+            std::vector<std::string> tokens = CUtils::stringTokenizer(line);
+            benchmark::DoNotOptimize(tokens);
+        }
+    }
+    BENCHMARK(Utils_stringTokenizer);
+}
@@ -62,12 +62,12 @@ void CAPRSCollector::writeHeader(const CHeaderData& header)
 	}
 }
 
-bool CAPRSCollector::writeData(const unsigned char* data)
+bool CAPRSCollector::writeBlock(const unsigned char* block)
 {
 	bool ret = false;
 
 	for(auto collector : m_collectors) {
-		bool ret2 = collector->writeData(data);
+		bool ret2 = collector->writeBlock(block);
 		ret = ret || ret2;
 	}
 	return ret;
@@ -80,13 +80,6 @@ void CAPRSCollector::reset()
 	}
 }
 
-void CAPRSCollector::sync()
-{
-	for(auto collector : m_collectors) {
-		collector->sync();
-	}
-}
-
 unsigned int CAPRSCollector::getData(unsigned char dataType, unsigned char* data, unsigned int length)
 {
 	for(auto collector : m_collectors) {
@@ -42,12 +42,11 @@ public:
 
 	void writeHeader(const CHeaderData& callsign);
 
-	bool writeData(const unsigned char* data);
+	// A complete, descrambled, slow data block
+	bool writeBlock(const unsigned char* block);
 
 	void reset();
 
-	void sync();
-
 	unsigned int getData(unsigned char dataType, unsigned char* data, unsigned int length);
 	
 	void getData(std::function<void(const std::string&, const std::string&)> dataHandler);
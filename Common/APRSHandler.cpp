@@ -80,11 +80,8 @@ void CAPRSHandler::writeHeader(const std::string& callsign, const CHeaderData& h
 	collector->writeHeader(header);
 }
 
-void CAPRSHandler::writeData(const std::string& callsign, const CAMBEData& data)
+void CAPRSHandler::writeBlock(const std::string& callsign, const unsigned char* block)
 {
-	if (data.isEnd())
-		return;
-
 	CAPRSEntry* entry = m_array[callsign];
 	if (entry == NULL) {
 		CLog::logError("Cannot find the callsign \"%s\" in the APRS array", callsign.c_str());
@@ -93,15 +90,7 @@ void CAPRSHandler::writeData(const std::string& callsign, const CAMBEData& data)
 
 	CAPRSCollector* collector = entry->getCollector();
 
-	if (data.isSync()) {
-		collector->sync();
-		return;
-	}
-
-	unsigned char buffer[400U];
-	data.getData(buffer, DV_FRAME_MAX_LENGTH_BYTES);
-
-	bool complete = collector->writeData(buffer + VOICE_FRAME_LENGTH_BYTES);
+	bool complete = collector->writeBlock(block);
 	if (!complete)
 		return;
 
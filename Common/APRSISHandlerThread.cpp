@@ -20,6 +20,8 @@
 #include <sstream>
 #include <iostream>
 #include <boost/algorithm/string.hpp>
+#include <poll.h>
+#include <sys/eventfd.h>
 
 #include "APRSISHandlerThread.h"
 #include "DStarDefines.h"
@@ -35,6 +37,8 @@
 const unsigned int APRS_TIMEOUT = 10U;
 const unsigned int APRS_READ_TIMEOUT = 1U;
 const unsigned int APRS_KEEP_ALIVE_TIMEOUT = 60U;
+// Frames waiting for the APRS-IS server, the oldest are dropped beyond this
+const unsigned int APRS_QUEUE_LENGTH = 100U;
 
 CAPRSISHandlerThread::CAPRSISHandlerThread(const std::string& callsign, const std::string& password, const std::string& address, const std::string& hostname, unsigned int port) :
 CThread("APRS"),
@@ -42,7 +46,12 @@ m_username(callsign),
 m_password(password),
 m_ssid(callsign),
 m_socket(hostname, port, address),
-m_queue(20U),
+m_queue(),
+m_queueMutex(),
+m_sendBuffer(),
+m_dropped(0UL),
+m_droppedReported(0UL),
+m_wakeFd(-1),
 m_exit(false),
 m_connected(false),
 m_reconnectTimer(1000U),
@@ -50,6 +59,8 @@ m_keepAliveTimer(1000U, APRS_KEEP_ALIVE_TIMEOUT),
 m_tries(0U),
 m_APRSReadCallbacks(),
 m_filter(),
+m_readLine(),
+m_readFrame(),
 m_clientName(FULL_PRODUCT_NAME)
 {
 	assert(!callsign.empty());
@@ -62,6 +73,10 @@ m_clientName(FULL_PRODUCT_NAME)
 	boost::to_upper(m_username);
 
 	m_ssid = m_ssid.substr(LONG_CALLSIGN_LENGTH - 1U, 1);
+
+	m_wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (m_wakeFd < 0)
+		CLog::logError("Cannot create the APRS writer event, err=%d", errno);
 }
 
 CAPRSISHandlerThread::CAPRSISHandlerThread(const std::string& callsign, const std::string& password, const std::string& address, const std::string& hostname, unsigned int port, const std::string& filter) :
@@ -70,7 +85,12 @@ m_username(callsign),
 m_password(password),
 m_ssid(callsign),
 m_socket(hostname, port, address),
-m_queue(20U),
+m_queue(),
+m_queueMutex(),
+m_sendBuffer(),
+m_dropped(0UL),
+m_droppedReported(0UL),
+m_wakeFd(-1),
 m_exit(false),
 m_connected(false),
 m_reconnectTimer(1000U),
@@ -78,6 +98,8 @@ m_keepAliveTimer(1000U, APRS_KEEP_ALIVE_TIMEOUT),
 m_tries(0U),
 m_APRSReadCallbacks(),
 m_filter(filter),
+m_readLine(),
+m_readFrame(),
 m_clientName(FULL_PRODUCT_NAME)
 {
 	assert(!callsign.empty());
@@ -90,6 +112,10 @@ m_clientName(FULL_PRODUCT_NAME)
 	boost::to_upper(m_username);
 
 	m_ssid = m_ssid.substr(LONG_CALLSIGN_LENGTH - 1U, 1);
+
+	m_wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (m_wakeFd < 0)
+		CLog::logError("Cannot create the APRS writer event, err=%d", errno);
 }
 
 CAPRSISHandlerThread::~CAPRSISHandlerThread()
@@ -103,6 +129,9 @@ CAPRSISHandlerThread::~CAPRSISHandlerThread()
 
 	m_username.clear();
 	m_password.clear();
+
+	if (m_wakeFd >= 0)
+		::close(m_wakeFd);
 }
 
 bool CAPRSISHandlerThread::start()
@@ -148,43 +177,47 @@ void* CAPRSISHandlerThread::Entry()
 			if (m_connected) {
 				m_tries = 0U;
 
-				if(!m_queue.empty()){
-					auto frameStr = m_queue.getData();
+				// Wait for the server to send something or for frames to be queued, whichever comes first
+				struct pollfd fds[2];
+				fds[0].fd = m_socket.getFd();
+				fds[0].events = POLLIN;
+				fds[0].revents = 0;
+				fds[1].fd = m_wakeFd;
+				fds[1].events = POLLIN;
+				fds[1].revents = 0;
+
+				int timeout = m_socket.hasBufferedData() ? 0 : int(APRS_READ_TIMEOUT * 1000U);
+				int ret = ::poll(fds, m_wakeFd >= 0 ? 2 : 1, timeout);
+				if (ret < 0 && errno != EINTR) {
+					m_connected = false;
+					m_socket.close();
+					CLog::logError("Error when waiting on the APRS server, err=%d", errno);
+					startReconnectionTimer();
+					continue;
+				}
 
-					CLog::logInfo("APRS Frame sent to IS ==> %s", frameStr.c_str());
+				if ((fds[1].revents & POLLIN) != 0) {
+					uint64_t count;
+					if (::read(m_wakeFd, &count, sizeof(count)) < 0 && errno != EAGAIN)
+						CLog::logError("Cannot read the APRS writer event, err=%d", errno);
+				}
 
-					bool ret = m_socket.writeLine(frameStr);
-					if (!ret) {
-						m_connected = false;
-						m_socket.close();
-						CLog::logInfo("Error when writing to the APRS server");
-						startReconnectionTimer();
-					}
+				if (!sendQueue()) {
+					m_connected = false;
+					m_socket.close();
+					CLog::logInfo("Error when writing to the APRS server");
+					startReconnectionTimer();
+					continue;
 				}
-				{
-					std::string line;
-					int length = m_socket.readLine(line, APRS_READ_TIMEOUT);
-
-					if (length < 0 || m_keepAliveTimer.hasExpired()) {
-						m_connected = false;
-						m_socket.close();
-						CLog::logError("Error when reading from the APRS server");
-						startReconnectionTimer();
-					}
-					else if(length > 0 && line[0] == '#') {
-						m_keepAliveTimer.start();
-					}
-					else if(line.length() > 0 && line[0] != '#') {
-						m_keepAliveTimer.start();
-						CLog::logDebug("APRS Frame received from IS <== %s", line.c_str());
-						CAPRSFrame readFrame;
-						if(CAPRSParser::parseFrame(line, readFrame)) {
-							for(auto cb : m_APRSReadCallbacks) {
-								CAPRSFrame f(readFrame);
-								cb->readAPRSFrame(f);
-							}
-						}
-					}
+
+				if ((fds[0].revents & (POLLIN | POLLHUP | POLLERR)) != 0 || m_socket.hasBufferedData())
+					readLines();
+
+				if (m_connected && m_keepAliveTimer.hasExpired()) {
+					m_connected = false;
+					m_socket.close();
+					CLog::logError("Error when reading from the APRS server");
+					startReconnectionTimer();
 				}
 			}
 		}
@@ -192,10 +225,15 @@ void* CAPRSISHandlerThread::Entry()
 		if (m_connected)
 			m_socket.close();
 
-		while (!m_queue.empty()) {
-			auto s = m_queue.getData();
-			s.clear();
+		unsigned long dropped;
+		{
+			std::lock_guard lock(m_queueMutex);
+			m_queue.clear();
+			dropped = m_dropped;
 		}
+
+		if (dropped > 0UL)
+			CLog::logWarning("%lu APRS frames were dropped because the APRS server could not keep up", dropped);
 #ifndef DEBUG_DSTARGW
 	}
 	catch (std::exception& e) {
@@ -231,10 +269,83 @@ void CAPRSISHandlerThread::write(CAPRSFrame& frame)
 		CLog::logTrace("Queued APRS Frame : %s", frameString.c_str());
 		frameString.append("\r\n");
 
-		m_queue.addData(frameString);
+		{
+			std::lock_guard lock(m_queueMutex);
+			if (m_queue.size() >= APRS_QUEUE_LENGTH) {
+				m_queue.pop_front();
+				m_dropped++;
+			}
+			m_queue.push_back(std::move(frameString));
+		}
+
+		wake();
 	}
 }
 
+// Sends every queued frame at once
+bool CAPRSISHandlerThread::sendQueue()
+{
+	m_sendBuffer.clear();
+	unsigned long dropped;
+	{
+		std::lock_guard lock(m_queueMutex);
+		m_sendBuffer.insert(m_sendBuffer.end(), std::make_move_iterator(m_queue.begin()), std::make_move_iterator(m_queue.end()));
+		m_queue.clear();
+		dropped = m_dropped;
+	}
+
+	if (dropped != m_droppedReported) {
+		CLog::logWarning("APRS queue full, %lu frames dropped so far", dropped);
+		m_droppedReported = dropped;
+	}
+
+	if (m_sendBuffer.empty())
+		return true;
+
+	for (const std::string& frame : m_sendBuffer)
+		CLog::logInfo("APRS Frame sent to IS ==> %s", frame.c_str());
+
+	return m_socket.writeLines(m_sendBuffer);
+}
+
+// Handles every complete line received so far
+void CAPRSISHandlerThread::readLines()
+{
+	std::string& line = m_readLine;
+	for (;;) {
+		int length = m_socket.readLine(line, 0U);
+		if (length == 0)
+			return;
+
+		if (length < 0) {
+			m_connected = false;
+			m_socket.close();
+			CLog::logError("Error when reading from the APRS server");
+			startReconnectionTimer();
+			return;
+		}
+
+		m_keepAliveTimer.start();
+		if (line[0] != '#') {
+			CLog::logDebug("APRS Frame received from IS <== %s", line.c_str());
+			if(CAPRSParser::parseFrame(std::string_view(line), m_readFrame)) {
+				for(auto cb : m_APRSReadCallbacks)
+					cb->readAPRSFrame(m_readFrame);
+			}
+		}
+	}
+}
+
+void CAPRSISHandlerThread::wake()
+{
+	if (m_wakeFd < 0)
+		return;
+
+	uint64_t one = 1U;
+	if (::write(m_wakeFd, &one, sizeof(one)) < 0 && errno != EAGAIN)
+		CLog::logError("Cannot signal the APRS writer event, err=%d", errno);
+}
+
 bool CAPRSISHandlerThread::isConnected() const
 {
 	return m_connected;
@@ -243,6 +354,7 @@ bool CAPRSISHandlerThread::isConnected() const
 void CAPRSISHandlerThread::stop()
 {
 	m_exit = true;
+	wake();
 
 	Wait();
 }
@@ -20,13 +20,15 @@
 #define	APRSWriterThread_H
 
 #include <vector>
+#include <deque>
+#include <mutex>
 
 #include "TCPReaderWriterClient.h"
-#include "RingBuffer.h"
 #include "Timer.h"
 #include "Thread.h"
 #include "IAPRSHandlerBackend.h"
 #include "APRSFrame.h"
+#include "APRSFrameView.h"
 
 
 class CAPRSISHandlerThread : public CThread, IAPRSHandlerBackend {
@@ -54,7 +56,12 @@ private:
 	std::string               m_password;
 	std::string	           m_ssid;
 	CTCPReaderWriterClient m_socket;
-	CRingBuffer<std::string>     m_queue;
+	std::deque<std::string>  m_queue;
+	std::mutex             m_queueMutex;
+	std::vector<std::string> m_sendBuffer;
+	unsigned long          m_dropped;
+	unsigned long          m_droppedReported;
+	int                    m_wakeFd;
 	bool                   m_exit;
 	bool                   m_connected;
 	CTimer                 m_reconnectTimer;
@@ -62,10 +69,15 @@ private:
 	unsigned int           m_tries;
 	std::vector<IReadAPRSFrameCallback *>  m_APRSReadCallbacks;
 	std::string               m_filter;
+	std::string               m_readLine;
+	CAPRSFrameView            m_readFrame;
 	std::string               m_clientName;
 
 	bool connect();
 	void startReconnectionTimer();
+	bool sendQueue();
+	void readLines();
+	void wake();
 };
 
 #endif
@@ -29,19 +29,17 @@ m_status(APS_IDLE),
 m_repeaterHandler(repeaterHandler),
 m_headerData(nullptr),
 m_slowData(nullptr),
-m_out(0U),
-m_seq(0U),
-m_totalNeeded(0U),
+m_scrambledData(),
 m_timer(1000U, 2U),
-m_start()
+m_scheduler(repeaterHandler, this, AS_INFO)
 {
     m_timer.start();
 }
 
-void CAPRSUnit::writeFrame(CAPRSFrame& frame)
+void CAPRSUnit::writeFrame(const CAPRSFrameView& frame)
 {
-    auto frameCopy = new CAPRSFrame(frame);
-    frameCopy->getPath().clear();//path is of no use for us, just clear it
+    auto frameCopy = new CAPRSFrame();
+    frame.toFrame(*frameCopy, false);//path is of no use for us, leave it out
 
     m_frameBuffer.push_back(frameCopy);
     m_timer.start();
@@ -57,7 +55,10 @@ void CAPRSUnit::clock(unsigned int ms)
 
         m_headerData = new CHeaderData();
         std::string dprs, text;
-        if(!CAPRSToDPRS::aprsToDPRS(dprs, text, *m_headerData, *frame)) {
+        bool converted = CAPRSToDPRS::aprsToDPRS(dprs, text, *m_headerData, *frame);
+        delete frame;
+
+        if(!converted) {
             delete m_headerData;
             m_headerData = nullptr;
             return;
@@ -68,53 +69,39 @@ void CAPRSUnit::clock(unsigned int ms)
         m_slowData->setHeaderData(*m_headerData);
         m_slowData->setGPSData(dprs);
         m_slowData->setTextData(text);
+        m_scrambledData = m_slowData->getScrambledData();
 
-        m_totalNeeded = (m_slowData->getInterleavedDataLength() / (DATA_FRAME_LENGTH_BYTES)) * 2U;
+        // Every 20 frames of slow data are preceded by a sync frame
+        unsigned int totalNeeded = (m_slowData->getInterleavedDataLength() / (DATA_FRAME_LENGTH_BYTES)) * 2U;
+        unsigned int count = totalNeeded + (totalNeeded + 19U) / 20U;
 
         m_repeaterHandler->process(*m_headerData, DIR_INCOMING, AS_INFO);
 
-        m_out = 0U;
-        m_seq = 0U;
-
-        m_start = std::chrono::high_resolution_clock::now();
+        m_scheduler.start(m_headerData->getId(), count);
         m_status = APS_TRANSMIT;
         return;
     }
 
-    if(m_status == APS_TRANSMIT) {
-        unsigned int needed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - m_start).count();
-		needed /= DSTAR_FRAME_TIME_MS;
-
-        unsigned char buffer[DV_FRAME_LENGTH_BYTES];
-
-        while (m_out < needed && m_out < m_totalNeeded) {
-            CAMBEData data;
-            data.setId(m_headerData->getId());
-            data.setSeq(m_seq);
-            if(m_out == m_totalNeeded - 1U)
-                data.setEnd(true);
-
-            ::memcpy(buffer + 0U, NULL_AMBE_DATA_BYTES, VOICE_FRAME_LENGTH_BYTES);
-
-            // Insert sync bytes when the sequence number is zero, slow data otherwise
-            if (m_seq == 0U) {
-                ::memcpy(buffer + VOICE_FRAME_LENGTH_BYTES, DATA_SYNC_BYTES, DATA_FRAME_LENGTH_BYTES);
-            } else {
-                m_slowData->getInterleavedData(buffer + VOICE_FRAME_LENGTH_BYTES);		
-                m_out++;
-            }
-
-            data.setData(buffer, DV_FRAME_LENGTH_BYTES);
-            m_repeaterHandler->process(data, DIR_INCOMING, AS_INFO);
-
-            m_seq++;
-            if (m_seq == 21U) m_seq = 0U;
-        }
+    if(m_status == APS_TRANSMIT && m_scheduler.clock()) {
+        m_status = APS_IDLE;
+        delete m_headerData;
+        delete m_slowData;
+        m_headerData = nullptr;
+        m_slowData = nullptr;
+        m_scrambledData.reset();
+    }
+}
 
-        if(m_out >= m_totalNeeded) {
-            m_status = APS_IDLE;
-            delete m_headerData;
-            delete m_slowData;
-        }
+void CAPRSUnit::getFrame(unsigned int n, unsigned char* data)
+{
+    ::memcpy(data + 0U, NULL_AMBE_DATA_BYTES, VOICE_FRAME_LENGTH_BYTES);
+
+    // Insert sync bytes when the sequence number is zero, slow data otherwise
+    if (n % 21U == 0U)
+        ::memcpy(data + VOICE_FRAME_LENGTH_BYTES, DATA_SYNC_BYTES, DATA_FRAME_LENGTH_BYTES);
+    else {
+        // The slow data runs on across sync frames, n - n / 21 - 1 data frames went before this one
+        unsigned int offset = ((n - n / 21U - 1U) * DATA_FRAME_LENGTH_BYTES) % m_scrambledData->size();
+        ::memcpy(data + VOICE_FRAME_LENGTH_BYTES, m_scrambledData->data() + offset, DATA_FRAME_LENGTH_BYTES);
     }
-}
\ No newline at end of file
+}
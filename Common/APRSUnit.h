@@ -20,12 +20,13 @@
 
 #include <string>
 #include <boost/circular_buffer.hpp>
-#include <chrono>
 
 #include "APRSFrame.h"
+#include "APRSFrameView.h"
 #include "RepeaterCallback.h"
 #include "Timer.h"
 #include "SlowDataEncoder.h"
+#include "PlayoutScheduler.h"
 
 enum APRSUNIT_STATUS {
     APS_IDLE,
@@ -33,13 +34,15 @@ enum APRSUNIT_STATUS {
     APS_TRANSMIT
 };
 
-class CAPRSUnit
+class CAPRSUnit : public IPlayoutSource
 {
 public:
     CAPRSUnit(IRepeaterCallback * repeaterHandler);
-    void writeFrame(CAPRSFrame& aprsFrame);
+    void writeFrame(const CAPRSFrameView& aprsFrame);
     void clock(unsigned ms);
 
+    virtual void getFrame(unsigned int n, unsigned char* data);
+
 private:
     // CRingBuffer<CAPRSFrame *> m_frameBuffer;
     boost::circular_buffer<CAPRSFrame *> m_frameBuffer;
@@ -47,11 +50,9 @@ private:
     IRepeaterCallback * m_repeaterHandler;
     CHeaderData * m_headerData;
     CSlowDataEncoder *  m_slowData;
-    unsigned int m_out;
-    unsigned int m_seq;
-    unsigned int m_totalNeeded;
+    std::shared_ptr<const std::vector<unsigned char>> m_scrambledData;
     CTimer m_timer;
-    std::chrono::high_resolution_clock::time_point m_start;
+    CPlayoutScheduler m_scheduler;
 };
 
 
@@ -51,6 +51,7 @@ void CAudioUnit::setLanguage(const std::string & dir, TEXT_LANG language)
 	}
 
 	m_language = language;
+	CRenderedAudioCache::clear();
 
 	std::string ambeFileName;
 	std::string indxFileName;
@@ -108,6 +109,9 @@ void CAudioUnit::setLanguage(const std::string & dir, TEXT_LANG language)
 
 void CAudioUnit::finalise()
 {
+	CRenderedAudioCache::logStats();
+	CRenderedAudioCache::clear();
+
 	delete m_ambeFilereader;
 }
 
@@ -123,19 +127,15 @@ m_reflector(),
 m_tempReflector(),
 m_hasTemporary(false),
 m_timer(1000U, REPLY_TIME),
-m_data(),
-m_out(0U)
-//m_time()
+m_audio(),
+m_scheduler(handler, this, AS_INFO),
+m_id(0U)
 {
 	assert(handler != NULL);
 }
 
 CAudioUnit::~CAudioUnit()
 {
-	for (auto item : m_data) {
-		delete item;
-	}
-	m_data.clear();
 }
 
 void CAudioUnit::sendStatus()
@@ -179,45 +179,39 @@ void CAudioUnit::clock(unsigned int ms)
 
 		m_timer.stop();
 
-		m_out    = 0U;
-		m_status = AS_TRANSMIT;
+		if (m_audio == nullptr) {
+			m_status = AS_IDLE;
+			return;
+		}
 
-		m_time = std::chrono::high_resolution_clock::now();
+		m_scheduler.start(m_id, m_audio->getCount());
+		m_status = AS_TRANSMIT;
 
 		return;
 	}
 
-	if (m_status == AS_TRANSMIT) {
-		unsigned int needed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - m_time).count();
-		needed /= DSTAR_FRAME_TIME_MS;
-
-		while (m_out < needed && m_out < m_data.size()) {
-			CAMBEData* data = m_data[m_out];
-			m_out++;
-			// CLog::logTrace("m_out %u, needed %u, m_data %u", m_out, needed, m_data.size());
-			m_handler->process(*data, DIR_INCOMING, AS_INFO);
-		}
-
-		if (m_out >= m_data.size()) {
-			m_out    = 0U;
-			m_status = AS_IDLE;
-			m_timer.stop();
-		}
-
-		return;
+	if (m_status == AS_TRANSMIT && m_scheduler.clock()) {
+		m_status = AS_IDLE;
+		m_timer.stop();
 	}
 }
 
+void CAudioUnit::getFrame(unsigned int n, unsigned char* data)
+{
+	// The rendered frames are shared, the scheduler stamps what is ours
+	::memcpy(data, m_audio->getFrame(n), DV_FRAME_LENGTH_BYTES);
+}
+
 void CAudioUnit::cancel()
 {
 	CLog::logTrace("Audio Unit Cancel");
 	m_status = AS_IDLE;
-	m_out    = 0U;
+	m_scheduler.stop();
 
 	m_timer.stop();
 }
 
-void CAudioUnit::spellReflector(const std::string &reflector)
+void CAudioUnit::spellReflector(LINK_STATUS status, const std::string &reflector, std::vector<unsigned char>& voice)
 {
 	unsigned int length = reflector.size();
 
@@ -225,7 +219,7 @@ void CAudioUnit::spellReflector(const std::string &reflector)
 		std::string c = reflector.substr(i, 1);
 
 		if (c.compare(" "))
-			m_ambeFilereader->lookup(c, m_data);
+			m_ambeFilereader->lookup(c, voice);
 	}
 
 	char c = reflector.at(length - 1);
@@ -234,115 +228,112 @@ void CAudioUnit::spellReflector(const std::string &reflector)
 
 	std::string cstr;
 	cstr.push_back(c);
-	if (m_linkStatus == LS_LINKING_DCS || m_linkStatus == LS_LINKED_DCS ||
-	    m_linkStatus == LS_LINKING_CCS || m_linkStatus == LS_LINKED_CCS) {
-		m_ambeFilereader->lookup(cstr, m_data);
+	if (status == LS_LINKING_DCS || status == LS_LINKED_DCS ||
+	    status == LS_LINKING_CCS || status == LS_LINKED_CCS) {
+		m_ambeFilereader->lookup(cstr, voice);
 		return;
 	}
 
 	switch (c) {
 		case 'A':
-			m_ambeFilereader->lookup("alpha", m_data);
+			m_ambeFilereader->lookup("alpha", voice);
 			break;
 		case 'B':
-			m_ambeFilereader->lookup("bravo", m_data);
+			m_ambeFilereader->lookup("bravo", voice);
 			break;
 		case 'C':
-			m_ambeFilereader->lookup("charlie", m_data);
+			m_ambeFilereader->lookup("charlie", voice);
 			break;
 		case 'D':
-			m_ambeFilereader->lookup("delta", m_data);
+			m_ambeFilereader->lookup("delta", voice);
 			break;
 		default:
-			m_ambeFilereader->lookup(cstr, m_data);
+			m_ambeFilereader->lookup(cstr, voice);
 			break;
 	}
 }
 
-void CAudioUnit::sendStatus(LINK_STATUS status, const std::string& reflector, const std::string &text)
+std::shared_ptr<const CRenderedAudio> CAudioUnit::render(LINK_STATUS status, const std::string& reflector, const std::string &text)
 {
-	CLog::logTrace("Audio Unit sendStatus");
-
-	// do some clean up, delete old message
-	for (auto item : m_data) {
-		delete item;
-	}
-	m_data.clear();
+	std::vector<unsigned char> voice;
 
 	// Create the message
-	m_ambeFilereader->lookup(" ", m_data);
-	m_ambeFilereader->lookup(" ", m_data);
-	m_ambeFilereader->lookup(" ", m_data);
-	m_ambeFilereader->lookup(" ", m_data);
+	m_ambeFilereader->lookup(" ", voice);
+	m_ambeFilereader->lookup(" ", voice);
+	m_ambeFilereader->lookup(" ", voice);
+	m_ambeFilereader->lookup(" ", voice);
 
 	bool found;
 
 	switch (status) {
 		case LS_NONE:
-			m_ambeFilereader->lookup("notlinked", m_data);
+			m_ambeFilereader->lookup("notlinked", voice);
 			break;
 		case LS_LINKED_CCS:
 		case LS_LINKED_DCS:
 		case LS_LINKED_DPLUS:
 		case LS_LINKED_DEXTRA:
 		case LS_LINKED_LOOPBACK:
-			found = m_ambeFilereader->lookup("linkedto", m_data);
+			found = m_ambeFilereader->lookup("linkedto", voice);
 			if (!found) {
-				m_ambeFilereader->lookup("linked", m_data);
-				m_ambeFilereader->lookup("2", m_data);
+				m_ambeFilereader->lookup("linked", voice);
+				m_ambeFilereader->lookup("2", voice);
 			}
-			spellReflector(reflector);
+			spellReflector(status, reflector, voice);
 			break;
 		default:
-			found = m_ambeFilereader->lookup("linkingto", m_data);
+			found = m_ambeFilereader->lookup("linkingto", voice);
 			if (!found) {
-				m_ambeFilereader->lookup("linking", m_data);
-				m_ambeFilereader->lookup("2", m_data);
+				m_ambeFilereader->lookup("linking", voice);
+				m_ambeFilereader->lookup("2", voice);
 			}
-			spellReflector(reflector);
+			spellReflector(status, reflector, voice);
 			break;
 	}
 
-	m_ambeFilereader->lookup(" ", m_data);
-	m_ambeFilereader->lookup(" ", m_data);
-	m_ambeFilereader->lookup(" ", m_data);
-	m_ambeFilereader->lookup(" ", m_data);
+	m_ambeFilereader->lookup(" ", voice);
+	m_ambeFilereader->lookup(" ", voice);
+	m_ambeFilereader->lookup(" ", voice);
+	m_ambeFilereader->lookup(" ", voice);
 
-	unsigned int id = CHeaderData::createId();
-	// RPT1 and RPT2 will be filled in later
-	CHeaderData header;
-	header.setMyCall1(m_callsign);
-	header.setMyCall2("INFO");
-	header.setYourCall("CQCQCQ  ");
-	header.setId(id);
+	unsigned int count = voice.size() / VOICE_FRAME_LENGTH_BYTES;
+	std::vector<unsigned char> frames(count * DV_FRAME_LENGTH_BYTES);
 
 	CSlowDataEncoder slowDataEncoder;
 	slowDataEncoder.setTextData(text);
-	unsigned int seqNo = 0U;
 
-	// add the slow data, id, seq num etc ...
-	for(unsigned int i = 0U; i < m_data.size(); i++) {
-		m_data[i]->setId(id);
-		m_data[i]->setSeq(seqNo);
+	// add the slow data, id and seq num are stamped when playing
+	for (unsigned int i = 0U; i < count; i++)
+		::memcpy(frames.data() + i * DV_FRAME_LENGTH_BYTES, voice.data() + i * VOICE_FRAME_LENGTH_BYTES, VOICE_FRAME_LENGTH_BYTES);
 
-		unsigned char buffer[DV_FRAME_LENGTH_BYTES];
-		m_data[i]->getData(buffer, DV_FRAME_LENGTH_BYTES);
+	slowDataEncoder.getScrambledData(frames.data(), count);
 
-		// Insert sync bytes when the sequence number is zero, slow data otherwise
-		if (seqNo == 0U) {
-			::memcpy(buffer + VOICE_FRAME_LENGTH_BYTES, DATA_SYNC_BYTES, DATA_FRAME_LENGTH_BYTES);
-			slowDataEncoder.sync();
-		} else {
-			slowDataEncoder.getInterleavedData(buffer + VOICE_FRAME_LENGTH_BYTES);
-		}
+	return std::make_shared<const CRenderedAudio>(std::move(frames));
+}
+
+void CAudioUnit::sendStatus(LINK_STATUS status, const std::string& reflector, const std::string &text)
+{
+	CLog::logTrace("Audio Unit sendStatus");
 
-		m_data[i]->setData(buffer, DV_FRAME_LENGTH_BYTES);
+	m_audio = CRenderedAudioCache::find(m_language, status, reflector, text);
+	if (m_audio == nullptr) {
+		m_audio = render(status, reflector, text);
+		CRenderedAudioCache::add(m_language, status, reflector, text, m_audio);
+		CLog::logDebug("Rendered announcement of %u frames, announcement cache using %u bytes", m_audio->getCount(), CRenderedAudioCache::getSize());
+	}
 
-		seqNo++;
-		if(seqNo >= 21U) seqNo = 0U;
+	if (m_audio->getCount() == 0U) {
+		m_audio.reset();
+		return;
 	}
 
-	m_data[m_data.size() - 1]->setEnd(true);
+	m_id = CHeaderData::createId();
+	// RPT1 and RPT2 will be filled in later
+	CHeaderData header;
+	header.setMyCall1(m_callsign);
+	header.setMyCall2("INFO");
+	header.setYourCall("CQCQCQ  ");
+	header.setId(m_id);
 
 	m_handler->process(header, DIR_INCOMING, AS_INFO);
 }
@@ -22,8 +22,8 @@
 
 #include <string>
 #include <map>
-#include <chrono>
 #include <vector>
+#include <memory>
 
 #include "RepeaterCallback.h"
 #include "SlowDataEncoder.h"
@@ -31,6 +31,8 @@
 #include "Timer.h"
 #include "Defs.h"
 #include "AMBEFileReader.h"
+#include "RenderedAudioCache.h"
+#include "PlayoutScheduler.h"
 
 enum AUDIO_STATUS {
 	AS_IDLE,
@@ -38,7 +40,7 @@ enum AUDIO_STATUS {
 	AS_TRANSMIT
 };
 
-class CAudioUnit {
+class CAudioUnit : public IPlayoutSource {
 public:
 	CAudioUnit(IRepeaterCallback* handler, const std::string& callsign);
 	~CAudioUnit();
@@ -58,6 +60,8 @@ public:
 
 	static void finalise();
 
+	virtual void getFrame(unsigned int n, unsigned char* data);
+
 private:
 	static TEXT_LANG      m_language;
 
@@ -72,12 +76,13 @@ private:
 	std::string        m_tempReflector;
 	bool               m_hasTemporary;
 	CTimer             m_timer;
-	std::vector<CAMBEData*>   m_data;
+	std::shared_ptr<const CRenderedAudio> m_audio;
+	CPlayoutScheduler  m_scheduler;
+	unsigned int       m_id;
 	static CAMBEFileReader*   m_ambeFilereader;
-	unsigned int       m_out;
-	std::chrono::high_resolution_clock::time_point m_time;
 
-	void spellReflector(const std::string& reflector);
+	static void spellReflector(LINK_STATUS status, const std::string& reflector, std::vector<unsigned char>& voice);
+	static std::shared_ptr<const CRenderedAudio> render(LINK_STATUS status, const std::string& reflector, const std::string& text);
 	void sendStatus(LINK_STATUS status, const std::string& reflector, const std::string& text);
 };
 
@@ -19,6 +19,7 @@
  */
 
 #include "DCSProtocolHandler.h"
+#include "LatencyTracer.h"
 #include "Utils.h"
 
 // #define	DUMP_TX
@@ -61,7 +62,11 @@ bool CDCSProtocolHandler::writeData(const CAMBEData& data)
 	CUtils::dump("Sending Data", buffer, length);
 #endif
 
-	return m_socket.write(buffer, length, data.getYourAddress(), data.getYourPort());
+	bool res = m_socket.write(buffer, length, data.getYourAddress(), data.getYourPort());
+	if (res)
+		CLatencyTracer::traceEgress(data, FE_REFLECTOR);
+
+	return res;
 }
 
 bool CDCSProtocolHandler::writePoll(const CPollData& poll)
@@ -155,6 +160,8 @@ CAMBEData* CDCSProtocolHandler::readData()
 		return NULL;
 	}
 
+	data->setIngress(m_socket.getReadTime(), FE_REFLECTOR);
+
 	return data;
 }
 
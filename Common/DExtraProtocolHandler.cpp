@@ -19,6 +19,7 @@
  */
 
 #include "DExtraProtocolHandler.h"
+#include "LatencyTracer.h"
 #include "Log.h"
 #include "Utils.h"
 
@@ -66,6 +67,9 @@ bool CDExtraProtocolHandler::writeHeader(const CHeaderData& header)
 		bool res = m_socket.write(buffer, length, header.getYourAddress(), header.getYourPort());
 		if (!res)
 			return false;
+
+		if (i == 0U)
+			CLatencyTracer::traceEgress(header, FE_REFLECTOR);
 	}
 
 	return true;
@@ -80,7 +84,11 @@ bool CDExtraProtocolHandler::writeAMBE(const CAMBEData& data)
 	CUtils::dump("Sending Data", buffer, length);
 #endif
 
-	return m_socket.write(buffer, length, data.getYourAddress(), data.getYourPort());
+	bool res = m_socket.write(buffer, length, data.getYourAddress(), data.getYourPort());
+	if (res)
+		CLatencyTracer::traceEgress(data, FE_REFLECTOR);
+
+	return res;
 }
 
 bool CDExtraProtocolHandler::writePoll(const CPollData& poll)
@@ -183,6 +191,8 @@ CHeaderData* CDExtraProtocolHandler::readHeader()
 		return NULL;
 	}
 
+	header->setIngress(m_socket.getReadTime(), FE_REFLECTOR);
+
 	return header;
 }
 
@@ -199,6 +209,8 @@ CAMBEData* CDExtraProtocolHandler::readAMBE()
 		return NULL;
 	}
 
+	data->setIngress(m_socket.getReadTime(), FE_REFLECTOR);
+
 	return data;
 }
 
@@ -18,6 +18,7 @@
  */
 
 #include "DPlusProtocolHandler.h"
+#include "LatencyTracer.h"
 #include "Log.h"
 #include "DStarDefines.h"
 #include "Utils.h"
@@ -66,6 +67,9 @@ bool CDPlusProtocolHandler::writeHeader(const CHeaderData& header)
 		bool res = m_socket.write(buffer, length, header.getYourAddress(), header.getYourPort());
 		if (!res)
 			return false;
+
+		if (i == 0U)
+			CLatencyTracer::traceEgress(header, FE_REFLECTOR);
 	}
 
 	return true;
@@ -80,7 +84,11 @@ bool CDPlusProtocolHandler::writeAMBE(const CAMBEData& data)
 	CUtils::dump("Sending Data", buffer, length);
 #endif
 
-	return m_socket.write(buffer, length, data.getYourAddress(), data.getYourPort());
+	bool res = m_socket.write(buffer, length, data.getYourAddress(), data.getYourPort());
+	if (res)
+		CLatencyTracer::traceEgress(data, FE_REFLECTOR);
+
+	return res;
 }
 
 bool CDPlusProtocolHandler::writePoll(const CPollData& poll)
@@ -188,6 +196,8 @@ CHeaderData* CDPlusProtocolHandler::readHeader()
 		return NULL;
 	}
 
+	header->setIngress(m_socket.getReadTime(), FE_REFLECTOR);
+
 	return header;
 }
 
@@ -204,6 +214,8 @@ CAMBEData* CDPlusProtocolHandler::readAMBE()
 		return NULL;
 	}
 
+	data->setIngress(m_socket.getReadTime(), FE_REFLECTOR);
+
 	return data;
 }
 
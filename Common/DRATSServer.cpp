@@ -134,15 +134,20 @@ void CDRATSServer::writeData(const CAMBEData& data)
 			break;
 	}
 
-	if ((m_writeText[0U] & SLOW_DATA_TYPE_MASK) != SLOW_DATA_TYPE_GPS)
+	writeBlock(m_writeText);
+}
+
+void CDRATSServer::writeBlock(const unsigned char* block)
+{
+	if ((block[0U] & SLOW_DATA_TYPE_MASK) != SLOW_DATA_TYPE_GPS)
 		return;
 
-	length = m_writeText[0U] & 0x07;	// Maximum value of 5
+	unsigned int length = block[0U] & 0x07;	// Maximum value of 5
 	if (length > 5U)
 		length = 5U;
 
 	for (unsigned int i = 0U; i < length; i++) {
-		m_writeBuffer[m_writeLength++] = m_writeText[i + 1U];
+		m_writeBuffer[m_writeLength++] = block[i + 1U];
 
 		// Check for [EOB] in the buffer to signal the end of the D-RATS data.
 		// To allow strstr() to run correctly
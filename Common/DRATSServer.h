@@ -37,6 +37,8 @@ public:
 
 	virtual void writeHeader(const CHeaderData& header);
 	virtual void writeData(const CAMBEData& data);
+	// A complete, descrambled, GPS slow data block
+	virtual void writeBlock(const unsigned char* block);
 	virtual void writeEnd();
 
 	virtual void close();
@@ -19,6 +19,7 @@
  */
 
 #include <cassert>
+#include <cstring>
 
 #include "DStarDefines.h"
 #include "EchoUnit.h"
@@ -27,29 +28,73 @@
 #include "Log.h"
 
 const unsigned int MAX_FRAMES = 60U * DSTAR_FRAMES_PER_SEC;
+const unsigned int BUFFER_LENGTH = MAX_FRAMES * DV_FRAME_LENGTH_BYTES;
+
+std::vector<unsigned char>  CEchoUnit::m_pool;
+std::vector<unsigned char*> CEchoUnit::m_freeBuffers;
+
+void CEchoUnit::setSharedBuffers(unsigned int count)
+{
+	m_freeBuffers.clear();
+	m_pool.assign(size_t(count) * BUFFER_LENGTH, 0U);
+
+	for (unsigned int i = 0U; i < count; i++)
+		m_freeBuffers.push_back(m_pool.data() + size_t(i) * BUFFER_LENGTH);
+
+	if (count > 0U)
+		CLog::logInfo("Echo limited to %u simultaneous recordings, using %u bytes", count, (unsigned int)m_pool.size());
+}
 
 CEchoUnit::CEchoUnit(IRepeaterCallback* handler, const std::string& callsign) :
 m_handler(handler),
 m_callsign(callsign),
 m_status(ES_IDLE),
 m_timer(1000U, REPLY_TIME),
-m_header(NULL),
+m_header(),
 m_data(NULL),
+m_ownsData(false),
 m_in(0U),
-m_out(0U),
-m_time()
+m_scheduler(handler, this, AS_ECHO)
 {
 	assert(handler != NULL);
+}
+
+CEchoUnit::~CEchoUnit()
+{
+	releaseBuffer();
+
+	if (m_ownsData)
+		delete[] m_data;
+}
 
-	m_data = new CAMBEData*[MAX_FRAMES];
+bool CEchoUnit::acquireBuffer()
+{
+	if (m_data != NULL)
+		return true;
+
+	if (m_pool.empty()) {
+		// Not sharing, the buffer is allocated on first use and kept
+		m_data = new unsigned char[BUFFER_LENGTH];
+		m_ownsData = true;
+		return true;
+	}
 
-	for (unsigned int i = 0U; i < MAX_FRAMES; i++)
-		m_data[i] = NULL;
+	if (m_freeBuffers.empty())
+		return false;
+
+	m_data = m_freeBuffers.back();
+	m_freeBuffers.pop_back();
+
+	return true;
 }
 
-CEchoUnit::~CEchoUnit()
+void CEchoUnit::releaseBuffer()
 {
-	delete[] m_data;
+	if (m_data == NULL || m_ownsData)
+		return;
+
+	m_freeBuffers.push_back(m_data);
+	m_data = NULL;
 }
 
 void CEchoUnit::writeHeader(const CHeaderData& header)
@@ -57,7 +102,12 @@ void CEchoUnit::writeHeader(const CHeaderData& header)
 	if (m_status != ES_IDLE)
 		return;
 
-	m_header = new CHeaderData(header);
+	if (!acquireBuffer()) {
+		CLog::logWarning("No echo buffer free, ignoring the echo request from %s", header.getMyCall1().c_str());
+		return;
+	}
+
+	m_header = header;
 
 	m_in     = 0U;		
 	m_status = ES_RECEIVE;
@@ -69,12 +119,12 @@ void CEchoUnit::writeData(const CAMBEData& data)
 		return;
 
 	if (m_in < MAX_FRAMES) {
-		m_data[m_in] = new CAMBEData(data);
+		data.getData(m_data + m_in * DV_FRAME_LENGTH_BYTES, DV_FRAME_LENGTH_BYTES);
 		m_in++;
 	}
 
 	if (data.isEnd()) {
-		CLog::logInfo("Received %.1f secs of audio from %s for echoing\n", float(m_in) / float(DSTAR_FRAMES_PER_SEC), m_header->getMyCall1().c_str());
+		CLog::logInfo("Received %.1f secs of audio from %s for echoing\n", float(m_in) / float(DSTAR_FRAMES_PER_SEC), m_header.getMyCall1().c_str());
 
 		m_timer.start();
 		m_status = ES_WAIT;
@@ -86,7 +136,7 @@ void CEchoUnit::end()
 	if (m_status != ES_RECEIVE)
 		return;
 
-	CLog::logInfo("Received %.1f secs of audio from %s for echoing\n", float(m_in) / float(DSTAR_FRAMES_PER_SEC), m_header->getMyCall1().c_str());
+	CLog::logInfo("Received %.1f secs of audio from %s for echoing\n", float(m_in) / float(DSTAR_FRAMES_PER_SEC), m_header.getMyCall1().c_str());
 
 	m_timer.start();
 	m_status = ES_WAIT;
@@ -100,63 +150,32 @@ void CEchoUnit::clock(unsigned int ms)
 		m_timer.stop();
 
 		// RPT1 and RPT2 will be filled in later
-		m_header->setMyCall1(m_callsign);
-		m_header->setMyCall2("ECHO");
-		m_header->setYourCall("CQCQCQ  ");
-
-		m_handler->process(*m_header, DIR_INCOMING, AS_ECHO);
+		m_header.setMyCall1(m_callsign);
+		m_header.setMyCall2("ECHO");
+		m_header.setYourCall("CQCQCQ  ");
 
-		delete m_header;
+		m_handler->process(m_header, DIR_INCOMING, AS_ECHO);
 
-		m_out    = 0U;
+		m_scheduler.start(m_header.getId(), m_in);
 		m_status = ES_TRANSMIT;
-
-		m_time = std::chrono::high_resolution_clock::now();
-
-		return;
 	}
 
-	if (m_status == ES_TRANSMIT) {
-		auto now = std::chrono::high_resolution_clock::now();
-		auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - m_time);
-		unsigned int needed = elapsed.count() / DSTAR_FRAME_TIME_MS;
-
-		while (m_out < needed) {
-			CAMBEData* data = m_data[m_out];
-			m_data[m_out] = NULL;
-			m_out++;
-
-			if (m_in == m_out)
-				data->setEnd(true);
-
-			m_handler->process(*data, DIR_INCOMING, AS_ECHO);
-
-			delete data;
-
-			if (m_in == m_out) {
-				m_in     = 0U;
-				m_out    = 0U;
-				m_status = ES_IDLE;
-				return;
-			}
-		}
+	if (m_status == ES_TRANSMIT && (m_scheduler.clock() || !m_scheduler.isPlaying()))
+		cancel();
+}
 
-		return;
-	}
+void CEchoUnit::getFrame(unsigned int n, unsigned char* data)
+{
+	::memcpy(data, m_data + n * DV_FRAME_LENGTH_BYTES, DV_FRAME_LENGTH_BYTES);
 }
 
 void CEchoUnit::cancel()
 {
-	for (unsigned int i = 0U; i < MAX_FRAMES; i++) {
-		if (m_data[i] != NULL) {
-			delete m_data[i];
-			m_data[i] = NULL;
-		}
-	}
+	releaseBuffer();
 
 	m_status = ES_IDLE;
-	m_out    = 0U;
 	m_in     = 0U;
+	m_scheduler.stop();
 
 	m_timer.stop();
 }
@@ -21,12 +21,13 @@
 #pragma once
 
 #include <string>
-#include <chrono>
+#include <vector>
 
 #include "RepeaterCallback.h"
 #include "HeaderData.h"
 #include "AMBEData.h"
 #include "Timer.h"
+#include "PlayoutScheduler.h"
 
 enum ECHO_STATUS {
 	ES_IDLE,
@@ -35,7 +36,7 @@ enum ECHO_STATUS {
 	ES_TRANSMIT
 };
 
-class CEchoUnit {
+class CEchoUnit : public IPlayoutSource {
 public:
 	CEchoUnit(IRepeaterCallback* handler, const std::string& callsign);
 	~CEchoUnit();
@@ -50,15 +51,26 @@ public:
 
 	void clock(unsigned int ms);
 
+	virtual void getFrame(unsigned int n, unsigned char* data);
+
+	// Shares count recording buffers between all the repeaters, 0 to give each repeater its own
+	static void setSharedBuffers(unsigned int count);
+
 private:
 	IRepeaterCallback* m_handler;
 	std::string           m_callsign;
 	ECHO_STATUS        m_status;
 	CTimer             m_timer;
-	CHeaderData*       m_header;
-	CAMBEData**        m_data;
+	CHeaderData        m_header;
+	unsigned char*     m_data;
+	bool               m_ownsData;
 	unsigned int       m_in;
-	unsigned int       m_out;
-	std::chrono::high_resolution_clock::time_point m_time;
+	CPlayoutScheduler  m_scheduler;
+
+	static std::vector<unsigned char>  m_pool;
+	static std::vector<unsigned char*> m_freeBuffers;
+
+	bool acquireBuffer();
+	void releaseBuffer();
 };
 
@@ -21,6 +21,7 @@
 #include <cstring>
 
 #include "G2ProtocolHandler.h"
+#include "LatencyTracer.h"
 #include "Utils.h"
 #include "Log.h"
 
@@ -35,7 +36,8 @@ m_buffer(nullptr),
 m_length(0U),
 m_address(destination),
 m_inactivityTimer(1000U, 29U),
-m_id(0U)
+m_id(0U),
+m_readTime(0U)
 {
 	m_inactivityTimer.start();
 	m_buffer = new unsigned char[bufferSize];
@@ -65,6 +67,9 @@ bool CG2ProtocolHandler::writeHeader(const CHeaderData& header)
 		bool res = m_socket->write(buffer, length, m_address);
 		if (!res)
 			return false;
+
+		if (i == 0U)
+			CLatencyTracer::traceEgress(header, FE_G2);
 	}
 
 	return true;
@@ -82,7 +87,11 @@ bool CG2ProtocolHandler::writeAMBE(const CAMBEData& data)
 
 	assert(CNetUtils::match(data.getDestination(), m_address, IMT_ADDRESS_ONLY));
 	//CLog::logTrace("Write ambe to %s:%u", inet_ntoa(addr), ntohs(TOIPV4(m_address)->sin_port));
-	return m_socket->write(buffer, length, m_address);
+	bool res = m_socket->write(buffer, length, m_address);
+	if (res)
+		CLatencyTracer::traceEgress(data, FE_G2);
+
+	return res;
 }
 
 bool CG2ProtocolHandler::setBuffer(unsigned char * buffer, int length)
@@ -95,6 +104,9 @@ bool CG2ProtocolHandler::setBuffer(unsigned char * buffer, int length)
 	if(length <= 0)
 		return false;
 
+	// The pool has just read this datagram from the shared socket
+	m_readTime = m_socket->getReadTime();
+
 	m_length = length;
 
 	if (m_buffer[0] != 'D' || m_buffer[1] != 'S' || m_buffer[2] != 'V' || m_buffer[3] != 'T') {
@@ -131,6 +143,8 @@ CHeaderData* CG2ProtocolHandler::readHeader()
 
 	m_id = header->getId();// remember the id so we do not read it duplicate
 
+	header->setIngress(m_readTime, FE_G2);
+
 	return header;
 }
 
@@ -152,6 +166,8 @@ CAMBEData* CG2ProtocolHandler::readAMBE()
 	if(data->isEnd())
 		m_id = 0U;
 
+	data->setIngress(m_readTime, FE_G2);
+
 	return data;
 }
 
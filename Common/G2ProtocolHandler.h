@@ -64,6 +64,7 @@ private:
 	struct sockaddr_storage m_address;
 	CTimer m_inactivityTimer;
 	unsigned int m_id;
+	uint64_t m_readTime;
 
 	bool readPackets();
 };
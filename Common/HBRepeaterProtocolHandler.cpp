@@ -20,6 +20,7 @@
 #include <cassert>
 
 #include "HBRepeaterProtocolHandler.h"
+#include "LatencyTracer.h"
 #include "CCITTChecksum.h"
 #include "DStarDefines.h"
 #include "Utils.h"
@@ -60,7 +61,11 @@ bool CHBRepeaterProtocolHandler::writeHeader(CHeaderData& header)
 	CUtils::dump("Sending Header", buffer, length);
 	return true;
 #else
-	return m_socket.write(buffer, length, header.getYourAddress(), header.getYourPort());
+	bool res = m_socket.write(buffer, length, header.getYourAddress(), header.getYourPort());
+	if (res)
+		CLatencyTracer::traceEgress(header, FE_REPEATER);
+
+	return res;
 #endif
 }
 
@@ -73,7 +78,11 @@ bool CHBRepeaterProtocolHandler::writeAMBE(CAMBEData& data)
 	CUtils::dump("Sending Data", buffer, length);
 	return true;
 #else
-	return m_socket.write(buffer, length, data.getYourAddress(), data.getYourPort());
+	bool res = m_socket.write(buffer, length, data.getYourAddress(), data.getYourPort());
+	if (res)
+		CLatencyTracer::traceEgress(data, FE_REPEATER);
+
+	return res;
 #endif
 }
 
@@ -206,6 +215,8 @@ CHeaderData* CHBRepeaterProtocolHandler::readHeader()
 		return NULL;
 	}
 
+	header->setIngress(m_socket.getReadTime(), FE_REPEATER);
+
 	return header;
 }
 
@@ -223,6 +234,8 @@ CAMBEData* CHBRepeaterProtocolHandler::readAMBE()
 		return NULL;
 	}
 
+	data->setIngress(m_socket.getReadTime(), FE_REPEATER);
+
 	return data;
 }
 
@@ -240,6 +253,8 @@ CHeaderData* CHBRepeaterProtocolHandler::readBusyHeader()
 		return NULL;
 	}
 
+	header->setIngress(m_socket.getReadTime(), FE_REPEATER);
+
 	return header;
 }
 
@@ -257,6 +272,8 @@ CAMBEData* CHBRepeaterProtocolHandler::readBusyAMBE()
 		return NULL;
 	}
 
+	data->setIngress(m_socket.getReadTime(), FE_REPEATER);
+
 	return data;
 }
 
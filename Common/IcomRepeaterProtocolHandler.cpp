@@ -18,6 +18,7 @@
  */
 
 #include "IcomRepeaterProtocolHandler.h"
+#include "LatencyTracer.h"
 #include "CCITTChecksum.h"
 #include "DStarDefines.h"
 #include "Utils.h"
@@ -55,9 +56,6 @@ m_retryTimer(LOOP_TICKS, 0U, 200U)		// 200ms
 	m_icomAddress.s_addr = ::inet_addr(icomAddress.c_str());
 
 	m_buffer = new unsigned char[BUFFER_LENGTH];
-
-	auto now = ::time(NULL);
-	::srand(now);
 }
 
 CIcomRepeaterProtocolHandler::~CIcomRepeaterProtocolHandler()
@@ -174,6 +172,9 @@ bool CIcomRepeaterProtocolHandler::writeHeader(CHeaderData& header)
 
 	m_gwyQueue.addData(dq);
 
+	// The actual send happens in our own thread, trace the hand over to it
+	CLatencyTracer::traceEgress(header, FE_REPEATER);
+
 	return true;
 }
 
@@ -183,6 +184,8 @@ bool CIcomRepeaterProtocolHandler::writeAMBE(CAMBEData& data)
 
 	m_gwyQueue.addData(dq);
 
+	CLatencyTracer::traceEgress(data, FE_REPEATER);
+
 	return true;
 }
 
@@ -294,6 +297,8 @@ void CIcomRepeaterProtocolHandler::readIcomPackets()
 					continue;
 				}
 
+				header->setIngress(m_socket.getReadTime(), FE_REPEATER);
+
 				if (m_over1)
 					sendMultiReply(*header);
 				else
@@ -310,6 +315,8 @@ void CIcomRepeaterProtocolHandler::readIcomPackets()
 					continue;
 				}
 
+				data->setIngress(m_socket.getReadTime(), FE_REPEATER);
+
 				m_rptrQueue.addData(new CDataQueue(data));
 				continue;
 			}
@@ -555,7 +562,7 @@ bool CIcomRepeaterProtocolHandler::sendAck(uint16_t seqNo)
 
 void CIcomRepeaterProtocolHandler::sendSingleReply(const CHeaderData& header)
 {
-	unsigned int id = ::rand() % 0xFFFF;
+	unsigned int id = CHeaderData::createId();
 
 	CHeaderData replyHdr;
 	replyHdr.setId(id);
@@ -588,7 +595,7 @@ void CIcomRepeaterProtocolHandler::sendSingleReply(const CHeaderData& header)
 
 void CIcomRepeaterProtocolHandler::sendMultiReply(const CHeaderData& header)
 {
-	unsigned int id = ::rand() % 0xFFFF;
+	unsigned int id = CHeaderData::createId();
 
 	CHeaderData replyHdr;
 	replyHdr.setId(id);
@@ -0,0 +1,93 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "LatencyTracer.h"
+#include "UDPReaderWriter.h"
+
+bool       CLatencyTracer::m_enabled = false;
+CHistogram CLatencyTracer::m_routes[FRAME_ENDPOINT_COUNT][FRAME_ENDPOINT_COUNT];
+
+void CLatencyTracer::setEnabled(bool enabled)
+{
+	m_enabled = enabled;
+}
+
+bool CLatencyTracer::isEnabled()
+{
+	return m_enabled;
+}
+
+void CLatencyTracer::traceEgress(const CHeaderData& header, FRAME_ENDPOINT destination)
+{
+	if (m_enabled)
+		trace(header.getIngressTime(), header.getIngressEndpoint(), destination);
+}
+
+void CLatencyTracer::traceEgress(const CAMBEData& data, FRAME_ENDPOINT destination)
+{
+	if (m_enabled)
+		trace(data.getIngressTime(), data.getIngressEndpoint(), destination);
+}
+
+void CLatencyTracer::trace(uint64_t ingressTime, FRAME_ENDPOINT source, FRAME_ENDPOINT destination)
+{
+	// Locally generated frames (echo, announcements, version...) have no ingress time
+	if (ingressTime == 0U || source == FE_NONE)
+		return;
+
+	uint64_t now = CUDPReaderWriter::getMonotonicTime();
+	uint64_t micros = now > ingressTime ? (now - ingressTime) / 1000U : 0U;
+
+	m_routes[source][destination].add(micros);
+}
+
+void CLatencyTracer::getMetrics(std::vector<std::string>& metrics)
+{
+	for (unsigned int source = 0U; source < FRAME_ENDPOINT_COUNT; source++) {
+		for (unsigned int destination = 0U; destination < FRAME_ENDPOINT_COUNT; destination++) {
+			const CHistogram& histogram = m_routes[source][destination];
+			if (histogram.getCount() == 0U)
+				continue;
+
+			std::string name = "latency." + getEndpointName(FRAME_ENDPOINT(source)) + "_to_" + getEndpointName(FRAME_ENDPOINT(destination));
+			metrics.push_back(name + " " + histogram.toString("us"));
+		}
+	}
+}
+
+void CLatencyTracer::reset()
+{
+	for (unsigned int source = 0U; source < FRAME_ENDPOINT_COUNT; source++) {
+		for (unsigned int destination = 0U; destination < FRAME_ENDPOINT_COUNT; destination++)
+			m_routes[source][destination].reset();
+	}
+}
+
+std::string CLatencyTracer::getEndpointName(FRAME_ENDPOINT endpoint)
+{
+	switch (endpoint) {
+		case FE_REPEATER:
+			return "repeater";
+		case FE_REFLECTOR:
+			return "reflector";
+		case FE_G2:
+			return "g2";
+		default:
+			return "none";
+	}
+}
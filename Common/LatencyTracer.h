@@ -0,0 +1,52 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "DStarDefines.h"
+#include "HeaderData.h"
+#include "AMBEData.h"
+#include "Histogram.h"
+
+const unsigned int FRAME_ENDPOINT_COUNT = FE_G2 + 1U;
+
+// Records, per route, the time a frame spent inside the gateway between the datagram carrying it being
+// received and the datagram forwarding it being sent. Only frames stamped at ingress are accounted.
+// Must only be used from the gateway thread.
+class CLatencyTracer {
+public:
+	static void setEnabled(bool enabled);
+	static bool isEnabled();
+
+	static void traceEgress(const CHeaderData& header, FRAME_ENDPOINT destination);
+	static void traceEgress(const CAMBEData& data, FRAME_ENDPOINT destination);
+
+	static void getMetrics(std::vector<std::string>& metrics);
+	static void reset();
+
+	static std::string getEndpointName(FRAME_ENDPOINT endpoint);
+
+private:
+	static void trace(uint64_t ingressTime, FRAME_ENDPOINT source, FRAME_ENDPOINT destination);
+
+	static bool       m_enabled;
+	static CHistogram m_routes[FRAME_ENDPOINT_COUNT][FRAME_ENDPOINT_COUNT];
+};
@@ -0,0 +1,157 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "LoopProfiler.h"
+#include "UDPReaderWriter.h"
+#include "Log.h"
+
+bool       CLoopProfiler::m_enabled = false;
+uint64_t   CLoopProfiler::m_summaryInterval = 0U;
+uint64_t   CLoopProfiler::m_tickInterval = 0U;
+uint64_t   CLoopProfiler::m_windowStart = 0U;
+uint64_t   CLoopProfiler::m_iterationStart = 0U;
+uint64_t   CLoopProfiler::m_lastIterationStart = 0U;
+uint64_t   CLoopProfiler::m_lastMark = 0U;
+CHistogram CLoopProfiler::m_stages[LOOP_STAGE_COUNT];
+CHistogram CLoopProfiler::m_busy;
+CHistogram CLoopProfiler::m_lag;
+
+void CLoopProfiler::setEnabled(bool enabled)
+{
+	m_enabled = enabled;
+	m_lastIterationStart = 0U;
+}
+
+bool CLoopProfiler::isEnabled()
+{
+	return m_enabled;
+}
+
+void CLoopProfiler::setSummaryInterval(unsigned int seconds)
+{
+	m_summaryInterval = uint64_t(seconds) * 1000000000ULL;
+}
+
+void CLoopProfiler::setTickInterval(unsigned int ms)
+{
+	m_tickInterval = uint64_t(ms) * 1000000ULL;
+}
+
+void CLoopProfiler::doBeginIteration()
+{
+	uint64_t now = CUDPReaderWriter::getMonotonicTime();
+
+	if (m_windowStart == 0U)
+		m_windowStart = now;
+
+	// The lag is the part of the time between two iteration starts that exceeds the intended tick
+	if (m_lastIterationStart != 0U) {
+		uint64_t interval = now - m_lastIterationStart;
+		m_lag.add(interval > m_tickInterval ? (interval - m_tickInterval) / 1000U : 0U);
+	}
+
+	m_lastIterationStart = now;
+	m_iterationStart     = now;
+	m_lastMark           = now;
+}
+
+void CLoopProfiler::doMark(LOOP_STAGE stage)
+{
+	uint64_t now = CUDPReaderWriter::getMonotonicTime();
+
+	m_stages[stage].add((now - m_lastMark) / 1000U);
+
+	m_lastMark = now;
+}
+
+void CLoopProfiler::doEndIteration()
+{
+	uint64_t now = CUDPReaderWriter::getMonotonicTime();
+
+	m_busy.add((now - m_iterationStart) / 1000U);
+
+	if (m_summaryInterval > 0U && (now - m_windowStart) >= m_summaryInterval) {
+		logSummary();
+		reset();
+		m_windowStart = now;
+	}
+}
+
+void CLoopProfiler::logSummary()
+{
+	std::vector<std::string> metrics;
+	getMetrics(metrics);
+
+	CLog::logInfo("Main loop profile over the last %llu seconds", (unsigned long long)(m_summaryInterval / 1000000000ULL));
+	for (const std::string& metric : metrics)
+		CLog::logInfo("%s", metric.c_str());
+}
+
+void CLoopProfiler::getMetrics(std::vector<std::string>& metrics)
+{
+	if (m_busy.getCount() == 0U)
+		return;
+
+	metrics.push_back("loop.busy " + m_busy.toString("us"));
+	metrics.push_back("loop.lag " + m_lag.toString("us"));
+
+	for (unsigned int stage = 0U; stage < LOOP_STAGE_COUNT; stage++) {
+		const CHistogram& histogram = m_stages[stage];
+		if (histogram.getCount() == 0U)
+			continue;
+
+		metrics.push_back("loop." + getStageName(LOOP_STAGE(stage)) + " " + histogram.toString("us"));
+	}
+}
+
+void CLoopProfiler::reset()
+{
+	for (unsigned int stage = 0U; stage < LOOP_STAGE_COUNT; stage++)
+		m_stages[stage].reset();
+
+	m_busy.reset();
+	m_lag.reset();
+}
+
+std::string CLoopProfiler::getStageName(LOOP_STAGE stage)
+{
+	switch (stage) {
+		case LS_REPEATER:
+			return "repeater";
+		case LS_IRCDDB:
+			return "ircddb";
+		case LS_DEXTRA:
+			return "dextra";
+		case LS_DPLUS:
+			return "dplus";
+		case LS_DCS:
+			return "dcs";
+		case LS_G2:
+			return "g2";
+		case LS_CCS:
+			return "ccs";
+		case LS_DD:
+			return "dd";
+		case LS_REMOTE:
+			return "remote";
+		case LS_CLOCK:
+			return "clock";
+		default:
+			return "unknown";
+	}
+}
@@ -0,0 +1,94 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Histogram.h"
+
+enum LOOP_STAGE {
+	LS_REPEATER,
+	LS_IRCDDB,
+	LS_DEXTRA,
+	LS_DPLUS,
+	LS_DCS,
+	LS_G2,
+	LS_CCS,
+	LS_DD,
+	LS_REMOTE,
+	LS_CLOCK
+};
+
+const unsigned int LOOP_STAGE_COUNT = LS_CLOCK + 1U;
+
+// Accounts the time spent in each stage of the gateway main loop, the busy time of every iteration and
+// how late each iteration starts compared to the intended tick. Histograms are rolled over, and optionally
+// logged, every summary interval. When disabled every call boils down to a test of a static flag.
+// Must only be used from the gateway thread.
+class CLoopProfiler {
+public:
+	static void setEnabled(bool enabled);
+	static bool isEnabled();
+
+	static void setSummaryInterval(unsigned int seconds);
+	static void setTickInterval(unsigned int ms);
+
+	static void beginIteration()
+	{
+		if (m_enabled)
+			doBeginIteration();
+	}
+
+	// Charges the time elapsed since the previous mark (or the start of the iteration) to the given stage
+	static void mark(LOOP_STAGE stage)
+	{
+		if (m_enabled)
+			doMark(stage);
+	}
+
+	static void endIteration()
+	{
+		if (m_enabled)
+			doEndIteration();
+	}
+
+	static void getMetrics(std::vector<std::string>& metrics);
+	static void reset();
+
+	static std::string getStageName(LOOP_STAGE stage);
+
+private:
+	static void doBeginIteration();
+	static void doMark(LOOP_STAGE stage);
+	static void doEndIteration();
+	static void logSummary();
+
+	static bool       m_enabled;
+	static uint64_t   m_summaryInterval;
+	static uint64_t   m_tickInterval;
+	static uint64_t   m_windowStart;
+	static uint64_t   m_iterationStart;
+	static uint64_t   m_lastIterationStart;
+	static uint64_t   m_lastMark;
+	static CHistogram m_stages[LOOP_STAGE_COUNT];
+	static CHistogram m_busy;
+	static CHistogram m_lag;
+};
@@ -0,0 +1,212 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <cassert>
+#include <cerrno>
+#include <ctime>
+
+#include "PlayoutScheduler.h"
+#include "UDPReaderWriter.h"
+#include "DStarDefines.h"
+#include "Defs.h"
+#include "Log.h"
+
+const uint64_t FRAME_TIME_NS = uint64_t(DSTAR_FRAME_TIME_MS) * 1000000ULL;
+const uint64_t LATE_NS       = uint64_t(TIME_PER_TIC_MS) * 1000000ULL;
+
+CPacketReplay* CPlayoutScheduler::m_replay = NULL;
+unsigned int   CPlayoutScheduler::m_playing = 0U;
+uint64_t   CPlayoutScheduler::m_wakeUp = UINT64_MAX;
+uint64_t   CPlayoutScheduler::m_totalLate = 0U;
+uint64_t   CPlayoutScheduler::m_totalBursts = 0U;
+CHistogram CPlayoutScheduler::m_lateness;
+
+CPlayoutScheduler::CPlayoutScheduler(IRepeaterCallback* handler, IPlayoutSource* source, AUDIO_SOURCE type) :
+m_handler(handler),
+m_source(source),
+m_type(type),
+m_frame(),
+m_id(0U),
+m_count(0U),
+m_out(0U),
+m_start(0U),
+m_late(0U),
+m_bursts(0U)
+{
+	assert(handler != nullptr);
+	assert(source != nullptr);
+}
+
+CPlayoutScheduler::~CPlayoutScheduler()
+{
+	if (isPlaying())
+		finished();
+}
+
+void CPlayoutScheduler::start(unsigned int id, unsigned int count)
+{
+	if (isPlaying())
+		finished();
+
+	m_id     = id;
+	m_count  = count;
+	m_out    = 0U;
+	m_late   = 0U;
+	m_bursts = 0U;
+	m_start  = getTime();
+
+	if (isPlaying())
+		m_playing++;
+
+	// The first frame follows the header by one frame time
+	if (m_start + FRAME_TIME_NS < m_wakeUp)
+		m_wakeUp = m_start + FRAME_TIME_NS;
+}
+
+void CPlayoutScheduler::stop()
+{
+	if (isPlaying())
+		finished();
+
+	m_count = 0U;
+	m_out   = 0U;
+}
+
+bool CPlayoutScheduler::isPlaying() const
+{
+	return m_out < m_count;
+}
+
+bool CPlayoutScheduler::clock()
+{
+	if (!isPlaying())
+		return false;
+
+	uint64_t now = getTime();
+	unsigned int released = 0U;
+
+	while (m_out < m_count) {
+		uint64_t deadline = m_start + uint64_t(m_out + 1U) * FRAME_TIME_NS;
+		if (deadline > now) {
+			if (deadline < m_wakeUp)
+				m_wakeUp = deadline;
+			break;
+		}
+
+		uint64_t lateness = now - deadline;
+		m_lateness.add(lateness / 1000U);
+		if (lateness > LATE_NS) {
+			m_late++;
+			m_totalLate++;
+		}
+
+		unsigned char buffer[DV_FRAME_LENGTH_BYTES];
+		m_source->getFrame(m_out, buffer);
+
+		m_frame.setData(buffer, DV_FRAME_LENGTH_BYTES);
+		m_frame.setId(m_id);
+		m_frame.setSeq(m_out % 21U);
+		m_frame.setEnd(m_out == m_count - 1U);
+
+		m_out++;
+		released++;
+
+		m_handler->process(m_frame, DIR_INCOMING, m_type);
+	}
+
+	if (released > 1U) {
+		m_bursts++;
+		m_totalBursts++;
+	}
+
+	if (m_out < m_count)
+		return false;
+
+	finished();
+
+	if (m_late > 0U || m_bursts > 0U)
+		CLog::logDebug("Played %u frames, %u late, %u bursts", m_count, m_late, m_bursts);
+
+	return true;
+}
+
+unsigned int CPlayoutScheduler::getLate() const
+{
+	return m_late;
+}
+
+unsigned int CPlayoutScheduler::getBursts() const
+{
+	return m_bursts;
+}
+
+void CPlayoutScheduler::sleep(unsigned int ms)
+{
+	uint64_t wakeUp = CUDPReaderWriter::getMonotonicTime() + uint64_t(ms) * 1000000ULL;
+	if (m_wakeUp < wakeUp)
+		wakeUp = m_wakeUp;
+
+	// Deadlines still pending are registered again by the next clock()
+	m_wakeUp = UINT64_MAX;
+
+	timespec ts;
+	ts.tv_sec  = wakeUp / 1000000000ULL;
+	ts.tv_nsec = wakeUp % 1000000000ULL;
+
+	while (::clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR)
+		;
+}
+
+bool CPlayoutScheduler::isAnyPlaying()
+{
+	return m_playing > 0U;
+}
+
+void CPlayoutScheduler::setReplay(CPacketReplay* replay)
+{
+	m_replay = replay;
+}
+
+void CPlayoutScheduler::finished()
+{
+	assert(m_playing > 0U);
+
+	m_playing--;
+}
+
+uint64_t CPlayoutScheduler::getTime()
+{
+	return m_replay != NULL ? m_replay->getTime() : CUDPReaderWriter::getMonotonicTime();
+}
+
+void CPlayoutScheduler::getMetrics(std::vector<std::string>& metrics)
+{
+	if (m_lateness.getCount() == 0U)
+		return;
+
+	metrics.push_back("playout.lateness " + m_lateness.toString("us"));
+	metrics.push_back("playout.late count=" + std::to_string(m_totalLate));
+	metrics.push_back("playout.bursts count=" + std::to_string(m_totalBursts));
+}
+
+void CPlayoutScheduler::reset()
+{
+	m_lateness.reset();
+	m_totalLate   = 0U;
+	m_totalBursts = 0U;
+}
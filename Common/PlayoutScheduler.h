@@ -0,0 +1,92 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "RepeaterCallback.h"
+#include "AMBEData.h"
+#include "Histogram.h"
+#include "PacketReplay.h"
+
+// Implemented by the units generating audio, fills the voice and slow data of frame n of the playout
+class IPlayoutSource {
+public:
+	virtual ~IPlayoutSource() {}
+
+	virtual void getFrame(unsigned int n, unsigned char* data) = 0;
+};
+
+// Releases the frames of a playout to the repeater on exact 20ms deadlines counted on the monotonic clock
+// from its start, so their spacing does not depend on when the main loop gets round to calling clock().
+// The scheduler owns the frame handed to the repeater and stamps its id, sequence and end flag, the source
+// only fills the payload. A frame released more than a main loop tick after its deadline is counted late,
+// a clock() releasing more than one frame is counted as a burst.
+// Under replay the deadlines are counted on the simulated clock instead, so replays release the same frames.
+// Must only be used from the gateway thread.
+class CPlayoutScheduler {
+public:
+	CPlayoutScheduler(IRepeaterCallback* handler, IPlayoutSource* source, AUDIO_SOURCE type);
+	~CPlayoutScheduler();
+
+	void start(unsigned int id, unsigned int count);
+	void stop();
+	bool isPlaying() const;
+
+	// Returns true when the last frame of the playout has been released
+	bool clock();
+
+	unsigned int getLate() const;
+	unsigned int getBursts() const;
+
+	// Sleeps for at most ms, waking up in time for the next deadline of any playing scheduler
+	static void sleep(unsigned int ms);
+
+	// True while any playout has frames left, a replay is not over before they are released
+	static bool isAnyPlaying();
+
+	static void setReplay(CPacketReplay* replay);
+
+	static void getMetrics(std::vector<std::string>& metrics);
+	static void reset();
+
+private:
+	IRepeaterCallback* m_handler;
+	IPlayoutSource*    m_source;
+	AUDIO_SOURCE       m_type;
+	CAMBEData          m_frame;
+	unsigned int       m_id;
+	unsigned int       m_count;
+	unsigned int       m_out;
+	uint64_t           m_start;
+	unsigned int       m_late;
+	unsigned int       m_bursts;
+
+	void finished();
+	static uint64_t getTime();
+
+	static CPacketReplay* m_replay;
+	static unsigned int   m_playing;
+	static uint64_t    m_wakeUp;
+	static uint64_t    m_totalLate;
+	static uint64_t    m_totalBursts;
+	static CHistogram  m_lateness;
+};
@@ -103,7 +103,7 @@ bool CPollData::setDCSData(const unsigned char* data, unsigned int length, const
 	assert(data != NULL);
 	assert(yourPort > 0U);
 
-	std::string sdata((const char *)data);
+	std::string sdata((const char *)data, length);
 
 	switch (length) {
 		case 17U:
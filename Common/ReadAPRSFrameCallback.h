@@ -21,11 +21,12 @@
 #include <string>
 #include <functional>
 
-#include "APRSFrame.h"
+#include "APRSFrameView.h"
 
 class IReadAPRSFrameCallback
 {
 public:
-	virtual void readAPRSFrame(CAPRSFrame& aprsFrame) = 0;
+	// The frame points into the received data, copy it out to keep it
+	virtual void readAPRSFrame(const CAPRSFrameView& aprsFrame) = 0;
 };
 
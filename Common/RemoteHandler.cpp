@@ -29,6 +29,9 @@
 #include "DPlusHandler.h"
 #include "DStarDefines.h"
 #include "DCSHandler.h"
+#include "LatencyTracer.h"
+#include "LoopProfiler.h"
+#include "PlayoutScheduler.h"
 #include "Log.h"
 
 CRemoteHandler::CRemoteHandler(const std::string& password, unsigned int port, const std::string& address) :
@@ -83,6 +86,9 @@ void CRemoteHandler::process()
 				sendRepeater(callsign);
 			}
 			break;
+		case RPHT_METRICS:
+			sendMetrics();
+			break;
 #ifdef USE_STARNET
 		case RPHT_STARNET: {
 				std::string callsign = m_handler.readStarNetGroup();
@@ -174,6 +180,17 @@ void CRemoteHandler::sendRepeater(const std::string& callsign)
 	delete data;
 }
 
+void CRemoteHandler::sendMetrics()
+{
+	std::vector<std::string> metrics;
+
+	CLatencyTracer::getMetrics(metrics);
+	CLoopProfiler::getMetrics(metrics);
+	CPlayoutScheduler::getMetrics(metrics);
+
+	m_handler.sendMetrics(metrics);
+}
+
 #ifdef USE_STARNET
 void CRemoteHandler::sendStarNetGroup(const std::string& callsign)
 {
@@ -44,6 +44,7 @@ private:
 
 	void sendCallsigns();
 	void sendRepeater(const std::string& callsign);
+	void sendMetrics();
 #if USE_STARNET
 	void sendStarNetGroup(const std::string& callsign);
 #endif
@@ -143,6 +143,13 @@ RPH_TYPE CRemoteProtocolHandler::readType()
 		}
 		m_type = RPHT_LOGOFF;
 		return m_type;
+	} else if (::memcmp(m_inBuffer, "GMT", 3U) == 0) {
+		if (!m_loggedIn) {
+			sendNAK("You are not logged in");
+			return m_type;
+		}
+		m_type = RPHT_METRICS;
+		return m_type;
 	} else if (::memcmp(m_inBuffer, "LOG", 3U) == 0) {
 		if (!m_loggedIn)
 			return m_type;
@@ -355,6 +362,34 @@ bool CRemoteProtocolHandler::sendRepeater(const CRemoteRepeaterData& data)
 	return m_socket.write(m_outBuffer, p - m_outBuffer, m_address, m_port);
 }
 
+bool CRemoteProtocolHandler::sendMetrics(const std::vector<std::string>& metrics)
+{
+	unsigned char* p = m_outBuffer;
+
+	::memcpy(p, "MET", 3U);
+	p += 3U;
+
+	// One metric per line, whatever does not fit is dropped
+	for (auto& metric : metrics) {
+		unsigned int length = metric.length();
+		if (length == 0U)
+			continue;
+
+		if ((p - m_outBuffer) + length + 2U > BUFFER_LENGTH)
+			break;
+
+		::memcpy(p, metric.c_str(), length);
+		p += length;
+		*p++ = '\n';
+	}
+
+	*p++ = 0x00U;
+
+	// CUtils::dump("Outgoing", m_outBuffer, p - m_outBuffer);
+
+	return m_socket.write(m_outBuffer, p - m_outBuffer, m_address, m_port);
+}
+
 #if USE_STARNET
 bool CRemoteProtocolHandler::sendStarNetGroup(const CRemoteStarNetGroup& data)
 {
@@ -43,6 +43,7 @@ enum RPH_TYPE {
 	RPHT_LINKSCR,
 	RPHT_LOGOFF,
 	RPHT_LOGOUT,
+	RPHT_METRICS,
 	RPHT_UNKNOWN
 };
 
@@ -68,6 +69,7 @@ public:
 	bool     sendRandom(uint32_t random);
 	bool     sendCallsigns(const std::vector<std::string> & repeaters, const std::vector<std::string>& starNets);
 	bool     sendRepeater(const CRemoteRepeaterData& data);
+	bool     sendMetrics(const std::vector<std::string>& metrics);
 #ifdef USE_STARNET
 	bool     sendStarNetGroup(const CRemoteStarNetGroup& data);
 #endif
@@ -0,0 +1,132 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <cassert>
+
+#include "RenderedAudioCache.h"
+#include "DStarDefines.h"
+#include "Log.h"
+
+// Oldest announcements are dropped beyond this, repeaters still playing them keep their copy
+const unsigned int RENDERED_AUDIO_MAX_ENTRIES = 64U;
+
+std::map<CRenderedAudioKey, std::shared_ptr<const CRenderedAudio>> CRenderedAudioCache::m_cache;
+std::deque<CRenderedAudioKey> CRenderedAudioCache::m_order;
+std::mutex CRenderedAudioCache::m_mutex;
+unsigned long CRenderedAudioCache::m_hits = 0UL;
+unsigned long CRenderedAudioCache::m_misses = 0UL;
+unsigned int CRenderedAudioCache::m_size = 0U;
+
+CRenderedAudio::CRenderedAudio(std::vector<unsigned char>&& frames) :
+m_frames(std::move(frames))
+{
+	assert(m_frames.size() % DV_FRAME_LENGTH_BYTES == 0U);
+}
+
+unsigned int CRenderedAudio::getCount() const
+{
+	return m_frames.size() / DV_FRAME_LENGTH_BYTES;
+}
+
+const unsigned char* CRenderedAudio::getFrame(unsigned int n) const
+{
+	assert(n < getCount());
+
+	return m_frames.data() + n * DV_FRAME_LENGTH_BYTES;
+}
+
+unsigned int CRenderedAudio::getSize() const
+{
+	return m_frames.size();
+}
+
+std::shared_ptr<const CRenderedAudio> CRenderedAudioCache::find(TEXT_LANG language, LINK_STATUS status, const std::string& reflector, const std::string& text)
+{
+	std::lock_guard lock(m_mutex);
+
+	auto it = m_cache.find(std::make_tuple(language, status, reflector, text));
+	if (it == m_cache.end()) {
+		m_misses++;
+		return nullptr;
+	}
+
+	m_hits++;
+	return it->second;
+}
+
+void CRenderedAudioCache::add(TEXT_LANG language, LINK_STATUS status, const std::string& reflector, const std::string& text, std::shared_ptr<const CRenderedAudio> audio)
+{
+	assert(audio != nullptr);
+
+	std::lock_guard lock(m_mutex);
+
+	auto key = std::make_tuple(language, status, reflector, text);
+	auto it = m_cache.find(key);
+	if (it != m_cache.end()) {
+		m_size -= it->second->getSize();
+		it->second = audio;
+	}
+	else {
+		while (m_order.size() >= RENDERED_AUDIO_MAX_ENTRIES) {
+			auto oldest = m_cache.find(m_order.front());
+			m_size -= oldest->second->getSize();
+			m_cache.erase(oldest);
+			m_order.pop_front();
+		}
+
+		m_cache[key] = audio;
+		m_order.push_back(key);
+	}
+
+	m_size += audio->getSize();
+}
+
+void CRenderedAudioCache::clear()
+{
+	std::lock_guard lock(m_mutex);
+
+	m_cache.clear();
+	m_order.clear();
+	m_size = 0U;
+}
+
+unsigned long CRenderedAudioCache::getHits()
+{
+	std::lock_guard lock(m_mutex);
+	return m_hits;
+}
+
+unsigned long CRenderedAudioCache::getMisses()
+{
+	std::lock_guard lock(m_mutex);
+	return m_misses;
+}
+
+unsigned int CRenderedAudioCache::getSize()
+{
+	std::lock_guard lock(m_mutex);
+	return m_size;
+}
+
+void CRenderedAudioCache::logStats()
+{
+	std::lock_guard lock(m_mutex);
+
+	if (m_hits > 0UL || m_misses > 0UL)
+		CLog::logInfo("Announcement cache: %lu hits, %lu misses, %u announcements using %u bytes", m_hits, m_misses, (unsigned int)m_cache.size(), m_size);
+}
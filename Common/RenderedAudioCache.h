@@ -0,0 +1,66 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <string>
+#include <map>
+#include <deque>
+#include <tuple>
+#include <mutex>
+#include <memory>
+#include <vector>
+
+#include "Defs.h"
+
+// An announcement ready to be played, DV_FRAME_LENGTH_BYTES per frame with the slow data already in
+class CRenderedAudio {
+public:
+	CRenderedAudio(std::vector<unsigned char>&& frames);
+
+	unsigned int getCount() const;
+	const unsigned char* getFrame(unsigned int n) const;
+	unsigned int getSize() const;
+
+private:
+	std::vector<unsigned char> m_frames;
+};
+
+typedef std::tuple<TEXT_LANG, LINK_STATUS, std::string, std::string> CRenderedAudioKey;
+
+// Announcements are the same for every repeater, render them once and share them
+class CRenderedAudioCache {
+public:
+	static std::shared_ptr<const CRenderedAudio> find(TEXT_LANG language, LINK_STATUS status, const std::string& reflector, const std::string& text);
+	static void add(TEXT_LANG language, LINK_STATUS status, const std::string& reflector, const std::string& text, std::shared_ptr<const CRenderedAudio> audio);
+
+	static void clear();
+
+	static unsigned long getHits();
+	static unsigned long getMisses();
+	static unsigned int getSize();
+	static void logStats();
+
+private:
+	static std::map<CRenderedAudioKey, std::shared_ptr<const CRenderedAudio>> m_cache;
+	static std::deque<CRenderedAudioKey> m_order;
+	static std::mutex m_mutex;
+	static unsigned long m_hits;
+	static unsigned long m_misses;
+	static unsigned int m_size;
+};
@@ -107,6 +107,9 @@ m_silence(0U),
 m_errors(0U),
 m_textCollector(),
 m_text(),
+m_rfSlowData(),
+m_netSlowData(),
+m_netSlowDataText(false),
 m_xBandRptr(NULL),
 #ifdef USE_STARNET
 m_starNet(NULL),
@@ -224,6 +227,23 @@ m_heardTimer(1000U, 0U, 100U)		// 100ms
 	m_version   = new CVersionUnit(this, callsign);
 	m_aprsUnit = new CAPRSUnit(this);
 
+	// Every slow data block only goes to the consumers of its type
+	m_rfSlowData.addHandler(SLOW_DATA_TYPE_TEXT, [this](const unsigned char* block) { m_textCollector.writeBlock(block); });
+	m_rfSlowData.addHandler(SLOW_DATA_TYPE_GPS, [this](const unsigned char* block) {
+		if (m_drats != NULL)
+			m_drats->writeBlock(block);
+		if (m_outgoingAprsHandler != NULL)
+			m_outgoingAprsHandler->writeBlock(m_rptCallsign, block);
+	});
+
+	m_netSlowData.addHandler(SLOW_DATA_TYPE_TEXT, [this](const unsigned char* block) {
+		if (m_netSlowDataText)
+			m_textCollector.writeBlock(block);
+	});
+	m_netSlowData.addHandler(SLOW_DATA_TYPE_GPS, [this](const unsigned char* block) {
+		if (m_incomingAprsHandler != NULL)
+			m_incomingAprsHandler->writeBlock(m_rptCallsign, block);
+	});
 
 	if (dratsEnabled) {
 		m_drats = new CDRATSServer(m_localAddress, port, callsign, this);
@@ -611,6 +631,7 @@ void CRepeaterHandler::processRepeater(CHeaderData& header)
 	sendToIncoming(header);
 
 	// Reset the slow data text collector
+	m_rfSlowData.reset();
 	m_textCollector.reset();
 	m_text.clear();
 
@@ -822,20 +843,15 @@ void CRepeaterHandler::processRepeater(CAMBEData& data)
 	m_ccsHandler->writeAMBE(data);
 #endif
 
-	if (m_drats != NULL)
-		m_drats->writeData(data);
-
-	if (m_outgoingAprsHandler != NULL)
-		m_outgoingAprsHandler->writeData(m_rptCallsign, data);
+	// D-RATS, APRS and the text collector
+	m_rfSlowData.writeData(data);
 
-	if (m_text.empty() && !data.isEnd()) {
-		m_textCollector.writeData(data);
+	if (m_drats != NULL && data.isEnd())
+		m_drats->writeEnd();
 
-		bool hasText = m_textCollector.hasData();
-		if (hasText) {
-			m_text = m_textCollector.getData();
-			sendHeard(m_text);
-		}
+	if (m_text.empty() && m_textCollector.hasData()) {
+		m_text = m_textCollector.getData();
+		sendHeard(m_text);
 	}
 
 	data.setText(m_text);
@@ -1178,6 +1194,8 @@ bool CRepeaterHandler::process(CHeaderData& header, DIRECTION, AUDIO_SOURCE sour
 	if(m_incomingAprsHandler != nullptr)
 		m_incomingAprsHandler->writeHeader(m_rptCallsign, header);
 
+	m_netSlowData.reset();
+
 	sendToIncoming(header);
 
 #ifdef USE_CCS
@@ -1217,8 +1235,9 @@ bool CRepeaterHandler::process(CAMBEData& data, DIRECTION, AUDIO_SOURCE source)
 
 	m_repeaterHandler->writeAMBE(data);
 
-	if(m_incomingAprsHandler != nullptr)
-		m_incomingAprsHandler->writeData(m_rptCallsign, data);
+	// APRS and, for the streams passed on to the outgoing links, the text collector
+	m_netSlowDataText = !(source == AS_G2 || source == AS_INFO || source == AS_VERSION || source == AS_XBAND || source == AS_ECHO);
+	m_netSlowData.writeData(data);
 
 	sendToIncoming(data);
 
@@ -1231,13 +1250,8 @@ bool CRepeaterHandler::process(CAMBEData& data, DIRECTION, AUDIO_SOURCE source)
 		return true;
 
 	// Collect the text from the slow data for DCS
-	if (m_text.empty() && !data.isEnd()) {
-		m_textCollector.writeData(data);
-
-		bool hasText = m_textCollector.hasData();
-		if (hasText)
-			m_text = m_textCollector.getData();
-	}
+	if (m_text.empty() && m_textCollector.hasData())
+		m_text = m_textCollector.getData();
 
 	data.setText(m_text);
 
@@ -3078,7 +3092,7 @@ void CRepeaterHandler::triggerInfo()
 	}
 }
 
-void CRepeaterHandler::readAPRSFrame(CAPRSFrame& frame)
+void CRepeaterHandler::readAPRSFrame(const CAPRSFrameView& frame)
 {
 	if(m_aprsUnit != nullptr) {
 		m_aprsUnit->writeFrame(frame);
@@ -32,6 +32,7 @@
 #include "StarNetHandler.h"
 #endif
 #include "TextCollector.h"
+#include "SlowDataDemux.h"
 #include "CacheManager.h"
 #include "HeaderLogger.h"
 #include "CallsignList.h"
@@ -134,7 +135,7 @@ public:
 	virtual void ccsLinkFailed(const std::string& dtmf, DIRECTION direction);
 	virtual void ccsLinkEnded(const std::string& callsign, DIRECTION direction);
 
-	virtual void readAPRSFrame(CAPRSFrame& frame);
+	virtual void readAPRSFrame(const CAPRSFrameView& frame);
 
 protected:
 	CRepeaterHandler(const std::string& callsign, const std::string& band, const std::string& address, unsigned int port, HW_TYPE hwType, const std::string& reflector, bool atStartup, RECONNECT reconnect, bool dratsEnabled, double frequency, double offset, double range, double latitude, double longitude, double agl, const std::string& description1, const std::string& description2, const std::string& url, IRepeaterProtocolHandler* handler, unsigned char band1, unsigned char band2, unsigned char band3);
@@ -224,6 +225,9 @@ private:
 	// Slow data handling
 	CTextCollector            m_textCollector;
 	std::string                  m_text;
+	CSlowDataDemux            m_rfSlowData;
+	CSlowDataDemux            m_netSlowData;
+	bool                      m_netSlowDataText;
 
 	// Cross-band repeating
 	CRepeaterHandler*         m_xBandRptr;
@@ -79,9 +79,16 @@ bool CSlowDataCollector::writeData(const unsigned char* data)
         break;
 	}
 
-    if((m_buffer[0] & SLOW_DATA_TYPE_MASK) == m_slowDataType)
-        return addData(m_buffer + 1U);
-    
+    return writeBlock(m_buffer);
+}
+
+bool CSlowDataCollector::writeBlock(const unsigned char* block)
+{
+    assert(block != nullptr);
+
+    if((block[0] & SLOW_DATA_TYPE_MASK) == m_slowDataType)
+        return addData(block + 1U);
+
     return false;
 }
 
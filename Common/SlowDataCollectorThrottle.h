@@ -33,6 +33,7 @@ public:
     std::string getMyCall2() const;
     void setMyCall2(const std::string& mycall);
     bool writeData(const unsigned char* data);
+    bool writeBlock(const unsigned char* block);
     void sync();
     unsigned int getData(unsigned char* data, unsigned int length);
     bool getData(std::string& data);
@@ -45,4 +46,6 @@ private:
     CTimer m_timer;
     bool m_isFirst;
     bool m_isComplete;
+
+    bool throttle(bool complete);
 };
\ No newline at end of file
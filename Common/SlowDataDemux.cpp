@@ -0,0 +1,91 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <cassert>
+#include <cstring>
+
+#include "SlowDataDemux.h"
+#include "DStarDefines.h"
+
+CSlowDataDemux::CSlowDataDemux() :
+m_handlers(),
+m_state(SS_FIRST)
+{
+	::memset(m_block, 0, sizeof(m_block));
+}
+
+CSlowDataDemux::~CSlowDataDemux()
+{
+}
+
+void CSlowDataDemux::addHandler(unsigned char type, std::function<void(const unsigned char*)> handler)
+{
+	m_handlers[(type & SLOW_DATA_TYPE_MASK) >> 4].push_back(handler);
+}
+
+void CSlowDataDemux::writeData(const CAMBEData& data)
+{
+	if (data.isEnd())
+		return;
+
+	if (data.isSync()) {
+		sync();
+		return;
+	}
+
+	unsigned char buffer[DV_FRAME_MAX_LENGTH_BYTES];
+	unsigned int length = data.getData(buffer, DV_FRAME_MAX_LENGTH_BYTES);
+	if (length < DV_FRAME_LENGTH_BYTES)
+		return;
+
+	writeData(buffer + VOICE_FRAME_LENGTH_BYTES);
+}
+
+void CSlowDataDemux::writeData(const unsigned char* data)
+{
+	assert(data != nullptr);
+
+	switch (m_state) {
+		case SS_FIRST:
+			m_block[0U] = data[0U] ^ SCRAMBLER_BYTE1;
+			m_block[1U] = data[1U] ^ SCRAMBLER_BYTE2;
+			m_block[2U] = data[2U] ^ SCRAMBLER_BYTE3;
+			m_state = SS_SECOND;
+			return;
+
+		case SS_SECOND:
+			m_block[3U] = data[0U] ^ SCRAMBLER_BYTE1;
+			m_block[4U] = data[1U] ^ SCRAMBLER_BYTE2;
+			m_block[5U] = data[2U] ^ SCRAMBLER_BYTE3;
+			m_state = SS_FIRST;
+			break;
+	}
+
+	for (auto& handler : m_handlers[(m_block[0U] & SLOW_DATA_TYPE_MASK) >> 4])
+		handler(m_block);
+}
+
+void CSlowDataDemux::sync()
+{
+	m_state = SS_FIRST;
+}
+
+void CSlowDataDemux::reset()
+{
+	m_state = SS_FIRST;
+}
@@ -0,0 +1,49 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "AMBEData.h"
+#include "Defs.h"
+
+// Descrambles the slow data of a stream once and hands every complete block only to the handlers
+// registered for its type, consumers no longer each descramble and reassemble every frame themselves
+class CSlowDataDemux {
+public:
+	CSlowDataDemux();
+	~CSlowDataDemux();
+
+	// type is one of the SLOW_DATA_TYPE_ values, handlers get the descrambled six byte block
+	void addHandler(unsigned char type, std::function<void(const unsigned char*)> handler);
+
+	// Sync frames realign on the block boundary, end frames carry no slow data
+	void writeData(const CAMBEData& data);
+	// The three scrambled slow data bytes of a frame
+	void writeData(const unsigned char* data);
+
+	void sync();
+	void reset();
+
+private:
+	std::vector<std::function<void(const unsigned char*)>> m_handlers[16U];
+	unsigned char  m_block[6U];
+	SLOWDATA_STATE m_state;
+};
@@ -70,37 +70,42 @@ void CTextCollector::writeData(const CAMBEData& data)
 			break;
 	}
 
-	switch (m_buffer[0U]) {
+	writeBlock(m_buffer);
+}
+
+void CTextCollector::writeBlock(const unsigned char* block)
+{
+	switch (block[0U]) {
 		case SLOW_DATA_TYPE_TEXT | 0U:
-			m_data[0U] = m_buffer[1U] & 0x7FU;
-			m_data[1U] = m_buffer[2U] & 0x7FU;
-			m_data[2U] = m_buffer[3U] & 0x7FU;
-			m_data[3U] = m_buffer[4U] & 0x7FU;
-			m_data[4U] = m_buffer[5U] & 0x7FU;
+			m_data[0U] = block[1U] & 0x7FU;
+			m_data[1U] = block[2U] & 0x7FU;
+			m_data[2U] = block[3U] & 0x7FU;
+			m_data[3U] = block[4U] & 0x7FU;
+			m_data[4U] = block[5U] & 0x7FU;
 			m_has0 = true;
 			break;
 		case SLOW_DATA_TYPE_TEXT | 1U:
-			m_data[5U] = m_buffer[1U] & 0x7FU;
-			m_data[6U] = m_buffer[2U] & 0x7FU;
-			m_data[7U] = m_buffer[3U] & 0x7FU;
-			m_data[8U] = m_buffer[4U] & 0x7FU;
-			m_data[9U] = m_buffer[5U] & 0x7FU;
+			m_data[5U] = block[1U] & 0x7FU;
+			m_data[6U] = block[2U] & 0x7FU;
+			m_data[7U] = block[3U] & 0x7FU;
+			m_data[8U] = block[4U] & 0x7FU;
+			m_data[9U] = block[5U] & 0x7FU;
 			m_has1 = true;
 			break;
 		case SLOW_DATA_TYPE_TEXT | 2U:
-			m_data[10U] = m_buffer[1U] & 0x7FU;
-			m_data[11U] = m_buffer[2U] & 0x7FU;
-			m_data[12U] = m_buffer[3U] & 0x7FU;
-			m_data[13U] = m_buffer[4U] & 0x7FU;
-			m_data[14U] = m_buffer[5U] & 0x7FU;
+			m_data[10U] = block[1U] & 0x7FU;
+			m_data[11U] = block[2U] & 0x7FU;
+			m_data[12U] = block[3U] & 0x7FU;
+			m_data[13U] = block[4U] & 0x7FU;
+			m_data[14U] = block[5U] & 0x7FU;
 			m_has2 = true;
 			break;
 		case SLOW_DATA_TYPE_TEXT | 3U:
-			m_data[15U] = m_buffer[1U] & 0x7FU;
-			m_data[16U] = m_buffer[2U] & 0x7FU;
-			m_data[17U] = m_buffer[3U] & 0x7FU;
-			m_data[18U] = m_buffer[4U] & 0x7FU;
-			m_data[19U] = m_buffer[5U] & 0x7FU;
+			m_data[15U] = block[1U] & 0x7FU;
+			m_data[16U] = block[2U] & 0x7FU;
+			m_data[17U] = block[3U] & 0x7FU;
+			m_data[18U] = block[4U] & 0x7FU;
+			m_data[19U] = block[5U] & 0x7FU;
 			m_has3 = true;
 			break;
 		default:
@@ -30,6 +30,8 @@ public:
 	~CTextCollector();
 
 	void writeData(const CAMBEData& data);
+	// A complete, descrambled, slow data block
+	void writeBlock(const unsigned char* block);
 
 	void sync();
 
@@ -39,11 +39,11 @@ m_status(VS_IDLE),
 m_timer(1000U, REPLY_TIME),
 m_data(NULL),
 m_id(0U),
-m_out(0U)
+m_scheduler(handler, this, AS_VERSION)
 {
 	assert(handler != NULL);
 
-	m_data = new CAMBEData*[NUM_FRAMES];
+	m_data = new unsigned char[NUM_FRAMES * DV_FRAME_LENGTH_BYTES];
 
 	auto vstr = SHORT_PRODUCT_NAME;
 	vstr.resize(NUM_FRAMES, ' ');
@@ -53,9 +53,9 @@ m_out(0U)
 	CSlowDataEncoder encoder;
 	encoder.setTextData(vstr);
 
-	// Seq No and end
+	// Seq No and end are stamped when playing
 	for (unsigned int i = 0U; i < NUM_FRAMES; i++) {
-		unsigned char buffer[DV_FRAME_LENGTH_BYTES];
+		unsigned char* buffer = m_data + i * DV_FRAME_LENGTH_BYTES;
 		memcpy(buffer + 0U, NULL_AMBE_DATA_BYTES, VOICE_FRAME_LENGTH_BYTES);
 
 		// Insert sync bytes when the sequence number is zero, slow data otherwise
@@ -65,21 +65,11 @@ m_out(0U)
 		} else {
 			encoder.getTextData(buffer + VOICE_FRAME_LENGTH_BYTES);
 		}
-
-		m_data[i] = new CAMBEData;
-		m_data[i]->setData(buffer, DV_FRAME_LENGTH_BYTES);
-		m_data[i]->setSeq(i);
-
-		if (i == (NUM_FRAMES - 1U))
-			m_data[i]->setEnd(true);
 	}
 }
 
 CVersionUnit::~CVersionUnit()
 {
-	for (unsigned int i = 0U; i < NUM_FRAMES; i++)
-		delete m_data[i];
-
 	delete[] m_data;
 }
 
@@ -110,42 +100,25 @@ void CVersionUnit::clock(unsigned int ms)
 
 		m_handler->process(header, DIR_INCOMING, AS_VERSION);
 
-		m_out    = 0U;
+		m_scheduler.start(m_id, NUM_FRAMES);
 		m_status = VS_TRANSMIT;
 
-		m_time = std::chrono::high_resolution_clock::now();
-
 		return;
 	}
 
-	if (m_status == VS_TRANSMIT) {
-		auto hrct = std::chrono::high_resolution_clock::now();
-		auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(hrct - m_time);
-		unsigned int needed = elapsed.count() / DSTAR_FRAME_TIME_MS;
-
-		while (m_out < needed) {
-			CAMBEData* data = m_data[m_out];
-			data->setId(m_id);
-
-			m_out++;
-
-			m_handler->process(*data, DIR_INCOMING, AS_VERSION);
-
-			if (m_out == NUM_FRAMES) {
-				m_out    = 0U;
-				m_status = VS_IDLE;
-				return;
-			}
-		}
+	if (m_status == VS_TRANSMIT && m_scheduler.clock())
+		m_status = VS_IDLE;
+}
 
-		return;
-	}
+void CVersionUnit::getFrame(unsigned int n, unsigned char* data)
+{
+	memcpy(data, m_data + n * DV_FRAME_LENGTH_BYTES, DV_FRAME_LENGTH_BYTES);
 }
 
 void CVersionUnit::cancel()
 {
 	m_status = VS_IDLE;
-	m_out    = 0U;
+	m_scheduler.stop();
 
 	m_timer.stop();
 }
@@ -21,11 +21,11 @@
 #pragma once
 
 #include <string>
-#include <chrono>
 
 #include "RepeaterCallback.h"
 #include "AMBEData.h"
 #include "Timer.h"
+#include "PlayoutScheduler.h"
 #include "Defs.h"
 
 enum VERSION_STATUS {
@@ -34,7 +34,7 @@ enum VERSION_STATUS {
 	VS_TRANSMIT
 };
 
-class CVersionUnit {
+class CVersionUnit : public IPlayoutSource {
 public:
 	CVersionUnit(IRepeaterCallback* handler, const std::string& callsign);
 	~CVersionUnit();
@@ -45,13 +45,14 @@ public:
 
 	void clock(unsigned int ms);
 
+	virtual void getFrame(unsigned int n, unsigned char* data);
+
 private:
 	IRepeaterCallback* m_handler;
 	std::string        m_callsign;
 	VERSION_STATUS     m_status;
 	CTimer             m_timer;
-	CAMBEData**        m_data;
+	unsigned char*     m_data;
 	unsigned int       m_id;
-	unsigned int       m_out;
-	std::chrono::high_resolution_clock::time_point  m_time;
+	CPlayoutScheduler  m_scheduler;
 };
@@ -0,0 +1,53 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "AMBEFileReader.h"
+#include "ProgramArgs.h"
+
+int main(int argc, const char * argv[])
+{
+	std::unordered_map<std::string, std::string> namedArgs;
+	std::vector<std::string> positionalArgs;
+
+	CProgramArgs::eatArguments(argc, argv, namedArgs, positionalArgs);
+
+	if (positionalArgs.size() < 2U || positionalArgs.size() > 3U) {
+		::fprintf(stderr, "dgwambeconvert: invalid command line usage: dgwambeconvert <indx file> <ambe file> [ambx file], exiting\n");
+		return 1;
+	}
+
+	std::string outFile = positionalArgs.size() == 3U ? positionalArgs[2] : CAMBEFileReader::getCompiledFileName(positionalArgs[1]);
+
+	CAMBEFileReader reader(positionalArgs[0], positionalArgs[1]);
+	if (!reader.readSource()) {
+		::fprintf(stderr, "dgwambeconvert: unable to read %s and %s, exiting\n", positionalArgs[0].c_str(), positionalArgs[1].c_str());
+		return 1;
+	}
+
+	if (!reader.compile(outFile)) {
+		::fprintf(stderr, "dgwambeconvert: unable to write %s, exiting\n", outFile.c_str());
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,90 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <arpa/inet.h>
+
+#include "PacketCapture.h"
+#include "ProgramArgs.h"
+#include "NetUtils.h"
+
+static void dump(const TCapturedPacket& packet);
+
+int main(int argc, const char * argv[])
+{
+	std::unordered_map<std::string, std::string> namedArgs;
+	std::vector<std::string> positionalArgs;
+
+	CProgramArgs::eatArguments(argc, argv, namedArgs, positionalArgs);
+
+	if (positionalArgs.size() < 2U || positionalArgs.size() > 3U || positionalArgs[0] != "dump") {
+		::fprintf(stderr, "dgwcapture: invalid command line usage: dgwcapture dump <file> [in|out], exiting\n");
+		return 1;
+	}
+
+	bool incoming = true, outgoing = true;
+	if (positionalArgs.size() == 3U) {
+		incoming = positionalArgs[2] == "in";
+		outgoing = positionalArgs[2] == "out";
+		if (!incoming && !outgoing) {
+			::fprintf(stderr, "dgwcapture: direction has to be in or out, exiting\n");
+			return 1;
+		}
+	}
+
+	CPacketCaptureReader reader(positionalArgs[1]);
+	if (!reader.open()) {
+		::fprintf(stderr, "dgwcapture: unable to open %s, exiting\n", positionalArgs[1].c_str());
+		return 1;
+	}
+
+	TCapturedPacket packet;
+	while (reader.read(packet)) {
+		if ((packet.direction == CD_INCOMING && incoming) || (packet.direction == CD_OUTGOING && outgoing))
+			dump(packet);
+	}
+
+	reader.close();
+
+	return 0;
+}
+
+static void dump(const TCapturedPacket& packet)
+{
+	char address[INET6_ADDRSTRLEN] = "-";
+	unsigned int port = 0U;
+
+	if (packet.address.ss_family == AF_INET) {
+		::inet_ntop(AF_INET, &TOIPV4(packet.address)->sin_addr, address, sizeof(address));
+		port = ntohs(TOIPV4(packet.address)->sin_port);
+	} else if (packet.address.ss_family == AF_INET6) {
+		::inet_ntop(AF_INET6, &TOIPV6(packet.address)->sin6_addr, address, sizeof(address));
+		port = ntohs(TOIPV6(packet.address)->sin6_port);
+	}
+
+	::fprintf(stdout, "%.3f %s %u %s %s:%u %u ", double(packet.time) / 1.0e6, packet.direction == CD_INCOMING ? "in" : "out",
+		packet.localPort, packet.direction == CD_INCOMING ? "<" : ">", address, port, (unsigned int)packet.data.size());
+
+	for (unsigned char c : packet.data)
+		::fprintf(stdout, "%02X", c);
+
+	::fprintf(stdout, "\n");
+}
@@ -0,0 +1,120 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "DCSLoadGenEndpoint.h"
+#include "LoadGenDefs.h"
+
+CDCSLoadGenEndpoint::CDCSLoadGenEndpoint(unsigned int index, const std::string& callsign, const std::string& module, const in_addr& address) :
+CLoadGenEndpoint("dcs", index, callsign, module),
+m_handler(0U),
+m_address(address),
+m_linked(false),
+m_nextLink(0U),
+m_nextPoll(0U)
+{
+}
+
+CDCSLoadGenEndpoint::~CDCSLoadGenEndpoint()
+{
+}
+
+bool CDCSLoadGenEndpoint::open()
+{
+	return m_handler.open();
+}
+
+void CDCSLoadGenEndpoint::close()
+{
+	if (m_linked) {
+		CConnectData unlink(m_callsign, m_module, CT_UNLINK, m_address, DCS_PORT);
+		m_handler.writeConnect(unlink);
+		m_linked = false;
+	}
+
+	m_handler.close();
+}
+
+void CDCSLoadGenEndpoint::clock(uint64_t now)
+{
+	if (!m_linked && now >= m_nextLink) {
+		CConnectData connect(m_callsign, m_module, CT_LINK1, m_address, DCS_PORT);
+		m_handler.writeConnect(connect);
+		m_nextLink = now + LOADGEN_LINK_RETRY_NS;
+	}
+
+	if (m_linked && now >= m_nextPoll) {
+		CPollData poll(m_callsign, m_module, DIR_OUTGOING, m_address, DCS_PORT);
+		m_handler.writePoll(poll);
+		m_nextPoll = now + LOADGEN_POLL_INTERVAL_NS;
+	}
+}
+
+bool CDCSLoadGenEndpoint::isLinked() const
+{
+	return m_linked;
+}
+
+void CDCSLoadGenEndpoint::read()
+{
+	for (;;) {
+		DCS_TYPE type = m_handler.read();
+
+		switch (type) {
+			case DC_NONE:
+				return;
+
+			case DC_CONNECT: {
+					CConnectData* connect = m_handler.readConnect();
+					if (connect != NULL) {
+						if (connect->getType() == CT_ACK)
+							m_linked = true;
+						else if (connect->getType() == CT_NAK)
+							::fprintf(stderr, "dgwloadgen: %s link refused by the gateway\n", getName().c_str());
+						delete connect;
+					}
+				}
+				break;
+
+			case DC_DATA: {
+					CAMBEData* data = m_handler.readData();
+					if (data != NULL) {
+						receive(*data);
+						delete data;
+					}
+				}
+				break;
+
+			case DC_POLL:
+				delete m_handler.readPoll();
+				break;
+		}
+	}
+}
+
+bool CDCSLoadGenEndpoint::writeHeader(CHeaderData&)
+{
+	// DCS has no header packet, every voice frame carries it
+	return true;
+}
+
+bool CDCSLoadGenEndpoint::writeAMBE(CAMBEData& data)
+{
+	data.setDestination(m_address, DCS_PORT);
+
+	return m_handler.writeData(data);
+}
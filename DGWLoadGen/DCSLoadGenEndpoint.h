@@ -0,0 +1,50 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <netinet/in.h>
+
+#include "LoadGenEndpoint.h"
+#include "DCSProtocolHandler.h"
+
+// Incoming DCS link to one of the gateway modules
+class CDCSLoadGenEndpoint : public CLoadGenEndpoint {
+public:
+	CDCSLoadGenEndpoint(unsigned int index, const std::string& callsign, const std::string& module, const in_addr& address);
+	virtual ~CDCSLoadGenEndpoint();
+
+	virtual bool open();
+	virtual void close();
+
+	virtual void clock(uint64_t now);
+	virtual bool isLinked() const;
+
+	virtual void read();
+
+protected:
+	virtual bool writeHeader(CHeaderData& header);
+	virtual bool writeAMBE(CAMBEData& data);
+
+private:
+	CDCSProtocolHandler m_handler;
+	in_addr             m_address;
+	bool                m_linked;
+	uint64_t            m_nextLink;
+	uint64_t            m_nextPoll;
+};
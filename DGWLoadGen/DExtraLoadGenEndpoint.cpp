@@ -0,0 +1,125 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "DExtraLoadGenEndpoint.h"
+#include "LoadGenDefs.h"
+
+CDExtraLoadGenEndpoint::CDExtraLoadGenEndpoint(unsigned int index, const std::string& callsign, const std::string& module, const in_addr& address) :
+CLoadGenEndpoint("dextra", index, callsign, module),
+m_handler(0U),
+m_address(address),
+m_linked(false),
+m_nextLink(0U),
+m_nextPoll(0U)
+{
+}
+
+CDExtraLoadGenEndpoint::~CDExtraLoadGenEndpoint()
+{
+}
+
+bool CDExtraLoadGenEndpoint::open()
+{
+	return m_handler.open();
+}
+
+void CDExtraLoadGenEndpoint::close()
+{
+	if (m_linked) {
+		CConnectData unlink(m_callsign, m_address, DEXTRA_PORT);
+		m_handler.writeConnect(unlink);
+		m_linked = false;
+	}
+
+	m_handler.close();
+}
+
+void CDExtraLoadGenEndpoint::clock(uint64_t now)
+{
+	if (!m_linked && now >= m_nextLink) {
+		CConnectData connect(m_callsign, m_module, CT_LINK1, m_address, DEXTRA_PORT);
+		m_handler.writeConnect(connect);
+		m_nextLink = now + LOADGEN_LINK_RETRY_NS;
+	}
+
+	if (m_linked && now >= m_nextPoll) {
+		CPollData poll(m_callsign, m_address, DEXTRA_PORT);
+		m_handler.writePoll(poll);
+		m_nextPoll = now + LOADGEN_POLL_INTERVAL_NS;
+	}
+}
+
+bool CDExtraLoadGenEndpoint::isLinked() const
+{
+	return m_linked;
+}
+
+void CDExtraLoadGenEndpoint::read()
+{
+	for (;;) {
+		DEXTRA_TYPE type = m_handler.read();
+
+		switch (type) {
+			case DE_NONE:
+				return;
+
+			case DE_CONNECT: {
+					CConnectData* connect = m_handler.readConnect();
+					if (connect != NULL) {
+						if (connect->getType() == CT_ACK)
+							m_linked = true;
+						else if (connect->getType() == CT_NAK)
+							::fprintf(stderr, "dgwloadgen: %s link refused by the gateway\n", getName().c_str());
+						delete connect;
+					}
+				}
+				break;
+
+			case DE_HEADER:
+				delete m_handler.readHeader();
+				break;
+
+			case DE_AMBE: {
+					CAMBEData* data = m_handler.readAMBE();
+					if (data != NULL) {
+						receive(*data);
+						delete data;
+					}
+				}
+				break;
+
+			case DE_POLL:
+				delete m_handler.readPoll();
+				break;
+		}
+	}
+}
+
+bool CDExtraLoadGenEndpoint::writeHeader(CHeaderData& header)
+{
+	header.setDestination(m_address, DEXTRA_PORT);
+
+	return m_handler.writeHeader(header);
+}
+
+bool CDExtraLoadGenEndpoint::writeAMBE(CAMBEData& data)
+{
+	data.setDestination(m_address, DEXTRA_PORT);
+
+	return m_handler.writeAMBE(data);
+}
@@ -0,0 +1,140 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <unordered_map>
+#include <boost/algorithm/string.hpp>
+
+#include "DGWLoadGenApp.h"
+#include "LoadGenerator.h"
+#include "HBLoadGenEndpoint.h"
+#include "DExtraLoadGenEndpoint.h"
+#include "DPlusLoadGenEndpoint.h"
+#include "DCSLoadGenEndpoint.h"
+#include "LoadGenDefs.h"
+#include "ProgramArgs.h"
+#include "DStarDefines.h"
+#include "UDPReaderWriter.h"
+#include "HeaderData.h"
+#include "StringUtils.h"
+
+const unsigned int LOADGEN_MAX_ENDPOINTS = 256U;
+
+int main(int argc, const char * argv[])
+{
+	TLoadGenOptions options;
+	if (!parseCLIArgs(argc, argv, options)) {
+		::fprintf(stderr, "dgwloadgen: invalid command line usage: dgwloadgen -gateway <callsign> [-modules B] [-hb 1] [-hbport 20011] [-gwhbport 20010] "
+			"[-dextra 0] [-dplus 0] [-dcs 0] [-talkers n] [-duration 30] [-streamlen 100] [-gap 500], exiting\n");
+		return 1;
+	}
+
+	CHeaderData::initialise();
+
+	in_addr address = CUDPReaderWriter::lookup(LOADGEN_ADDRESS);
+
+	CLoadGenerator generator(options.duration, options.streamLength, options.gap);
+
+	unsigned int index = 0U;
+	auto add = [&](CLoadGenEndpoint* endpoint) {
+		generator.addEndpoint(endpoint, index < options.talkers);
+		index++;
+	};
+
+	// Each homebrew repeater is a module of its own, the links spread round robin over the modules
+	for (unsigned int i = 0U; i < options.hbRepeaters; i++)
+		add(new CHBLoadGenEndpoint(i, makeCallsign('H', i), makeModule(options.gateway, options.modules[i]), makeModule(options.gateway, 'G'),
+			address, options.hbPort + i, options.gatewayHBPort));
+
+	for (unsigned int i = 0U; i < options.dextraLinks; i++)
+		add(new CDExtraLoadGenEndpoint(i, makeCallsign('X', i), makeModule(options.gateway, options.modules[i % options.modules.length()]), address));
+
+	for (unsigned int i = 0U; i < options.dcsLinks; i++)
+		add(new CDCSLoadGenEndpoint(i, makeCallsign('C', i), makeModule(options.gateway, options.modules[i % options.modules.length()]), address));
+
+	for (unsigned int i = 0U; i < options.dplusLinks; i++)
+		add(new CDPlusLoadGenEndpoint(i, makeCallsign('P', i), makeModule(options.gateway, options.modules[i % options.modules.length()]), address));
+
+	bool ret = generator.run();
+
+	return ret ? 0 : 1;
+}
+
+bool parseCLIArgs(int argc, const char * argv[], TLoadGenOptions& options)
+{
+	std::unordered_map<std::string, std::string> namedArgs;
+	std::vector<std::string> positionalArgs;
+
+	CProgramArgs::eatArguments(argc, argv, namedArgs, positionalArgs);
+
+	if (namedArgs.count("gateway") == 0U || !positionalArgs.empty())
+		return false;
+
+	auto getUInt = [&namedArgs](const std::string& name, unsigned int defaultValue) -> unsigned int {
+		return namedArgs.count(name) > 0U ? (unsigned int)::strtoul(namedArgs[name].c_str(), NULL, 10) : defaultValue;
+	};
+
+	options.gateway       = boost::to_upper_copy(namedArgs["gateway"]);
+	options.modules       = boost::to_upper_copy(namedArgs.count("modules") > 0U ? namedArgs["modules"] : std::string("B"));
+	options.hbRepeaters   = getUInt("hb", 1U);
+	options.hbPort        = getUInt("hbport", 20011U);
+	options.gatewayHBPort = getUInt("gwhbport", 20010U);
+	options.dextraLinks   = getUInt("dextra", 0U);
+	options.dplusLinks    = getUInt("dplus", 0U);
+	options.dcsLinks      = getUInt("dcs", 0U);
+	options.duration      = getUInt("duration", 30U);
+	options.streamLength  = getUInt("streamlen", 100U);
+	options.gap           = getUInt("gap", 500U);
+
+	unsigned int total = options.hbRepeaters + options.dextraLinks + options.dplusLinks + options.dcsLinks;
+	options.talkers       = getUInt("talkers", total);
+
+	if (options.gateway.empty() || options.gateway.length() > LONG_CALLSIGN_LENGTH - 1U)
+		return false;
+
+	if (options.modules.empty() || options.hbRepeaters > options.modules.length())
+		return false;
+
+	if (total == 0U || total > LOADGEN_MAX_ENDPOINTS || options.talkers > total)
+		return false;
+
+	if (options.duration == 0U || options.streamLength == 0U || options.streamLength > LOADGEN_MAX_STREAM_LEN)
+		return false;
+
+	return true;
+}
+
+std::string makeCallsign(char type, unsigned int index)
+{
+	std::string callsign = CStringUtils::string_format("LG%c%03u", type, index);
+	callsign.resize(LONG_CALLSIGN_LENGTH - 1U, ' ');
+	callsign.push_back('A');
+
+	return callsign;
+}
+
+std::string makeModule(const std::string& gateway, char module)
+{
+	std::string callsign(gateway);
+	callsign.resize(LONG_CALLSIGN_LENGTH - 1U, ' ');
+	callsign.push_back(module);
+
+	return callsign;
+}
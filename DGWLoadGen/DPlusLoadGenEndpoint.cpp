@@ -0,0 +1,138 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "DPlusLoadGenEndpoint.h"
+#include "LoadGenDefs.h"
+
+CDPlusLoadGenEndpoint::CDPlusLoadGenEndpoint(unsigned int index, const std::string& callsign, const std::string& module, const in_addr& address) :
+CLoadGenEndpoint("dplus", index, callsign, module),
+m_handler(0U),
+m_address(address),
+m_linked(false),
+m_nextLink(0U),
+m_nextPoll(0U)
+{
+}
+
+CDPlusLoadGenEndpoint::~CDPlusLoadGenEndpoint()
+{
+}
+
+bool CDPlusLoadGenEndpoint::open()
+{
+	return m_handler.open();
+}
+
+void CDPlusLoadGenEndpoint::close()
+{
+	if (m_linked) {
+		CConnectData unlink(CT_UNLINK, m_address, DPLUS_PORT);
+		m_handler.writeConnect(unlink);
+		m_linked = false;
+	}
+
+	m_handler.close();
+}
+
+void CDPlusLoadGenEndpoint::clock(uint64_t now)
+{
+	if (!m_linked && now >= m_nextLink) {
+		CConnectData connect(CT_LINK1, m_address, DPLUS_PORT);
+		m_handler.writeConnect(connect);
+		m_nextLink = now + LOADGEN_LINK_RETRY_NS;
+	}
+
+	if (m_linked && now >= m_nextPoll) {
+		CPollData poll(m_address, DPLUS_PORT);
+		m_handler.writePoll(poll);
+		m_nextPoll = now + LOADGEN_POLL_INTERVAL_NS;
+	}
+}
+
+bool CDPlusLoadGenEndpoint::isLinked() const
+{
+	return m_linked;
+}
+
+void CDPlusLoadGenEndpoint::read()
+{
+	for (;;) {
+		DPLUS_TYPE type = m_handler.read();
+
+		switch (type) {
+			case DP_NONE:
+				return;
+
+			case DP_CONNECT: {
+					CConnectData* connect = m_handler.readConnect();
+					if (connect != NULL) {
+						switch (connect->getType()) {
+							case CT_LINK1: {
+									// The gateway accepted the connection, now log in
+									std::string login = m_callsign.substr(0U, LONG_CALLSIGN_LENGTH - 1U);
+									CConnectData reply(login, CT_LINK2, m_address, DPLUS_PORT);
+									m_handler.writeConnect(reply);
+								}
+								break;
+							case CT_ACK:
+								m_linked = true;
+								break;
+							case CT_NAK:
+								::fprintf(stderr, "dgwloadgen: %s login refused by the gateway\n", getName().c_str());
+								break;
+							default:
+								break;
+						}
+						delete connect;
+					}
+				}
+				break;
+
+			case DP_HEADER:
+				delete m_handler.readHeader();
+				break;
+
+			case DP_AMBE: {
+					CAMBEData* data = m_handler.readAMBE();
+					if (data != NULL) {
+						receive(*data);
+						delete data;
+					}
+				}
+				break;
+
+			case DP_POLL:
+				delete m_handler.readPoll();
+				break;
+		}
+	}
+}
+
+bool CDPlusLoadGenEndpoint::writeHeader(CHeaderData& header)
+{
+	header.setDestination(m_address, DPLUS_PORT);
+
+	return m_handler.writeHeader(header);
+}
+
+bool CDPlusLoadGenEndpoint::writeAMBE(CAMBEData& data)
+{
+	data.setDestination(m_address, DPLUS_PORT);
+
+	return m_handler.writeAMBE(data);
+}
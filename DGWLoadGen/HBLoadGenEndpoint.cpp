@@ -0,0 +1,107 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "HBLoadGenEndpoint.h"
+#include "LoadGenDefs.h"
+
+CHBLoadGenEndpoint::CHBLoadGenEndpoint(unsigned int index, const std::string& callsign, const std::string& module, const std::string& gateway, const in_addr& address, unsigned int port, unsigned int gatewayPort) :
+CLoadGenEndpoint("hb", index, callsign, module),
+m_handler(LOADGEN_ADDRESS, port),
+m_gateway(gateway),
+m_address(address),
+m_gatewayPort(gatewayPort)
+{
+}
+
+CHBLoadGenEndpoint::~CHBLoadGenEndpoint()
+{
+}
+
+bool CHBLoadGenEndpoint::open()
+{
+	return m_handler.open();
+}
+
+void CHBLoadGenEndpoint::close()
+{
+	m_handler.close();
+}
+
+void CHBLoadGenEndpoint::clock(uint64_t)
+{
+}
+
+bool CHBLoadGenEndpoint::isLinked() const
+{
+	// The gateway knows the repeater from its configuration, there is nothing to link
+	return true;
+}
+
+void CHBLoadGenEndpoint::read()
+{
+	for (;;) {
+		REPEATER_TYPE type = m_handler.read();
+
+		switch (type) {
+			case RT_NONE:
+				return;
+
+			case RT_HEADER:
+				delete m_handler.readHeader();
+				break;
+
+			case RT_BUSY_HEADER:
+				delete m_handler.readBusyHeader();
+				break;
+
+			case RT_AMBE: {
+					CAMBEData* data = m_handler.readAMBE();
+					if (data != NULL) {
+						receive(*data);
+						delete data;
+					}
+				}
+				break;
+
+			case RT_BUSY_AMBE:
+				delete m_handler.readBusyAMBE();
+				break;
+
+			default:
+				break;
+		}
+	}
+}
+
+bool CHBLoadGenEndpoint::writeHeader(CHeaderData& header)
+{
+	// Traffic originating from the repeater is routed through the gateway
+	CHeaderData rfHeader(header);
+	rfHeader.setRptCall1(m_module);
+	rfHeader.setRptCall2(m_gateway);
+	rfHeader.setDestination(m_address, m_gatewayPort);
+
+	return m_handler.writeHeader(rfHeader);
+}
+
+bool CHBLoadGenEndpoint::writeAMBE(CAMBEData& data)
+{
+	data.setDestination(m_address, m_gatewayPort);
+
+	return m_handler.writeAMBE(data);
+}
@@ -0,0 +1,31 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+// Everything runs over the loopback interface
+const char* const   LOADGEN_ADDRESS = "127.0.0.1";
+
+const uint64_t      LOADGEN_LINK_RETRY_NS    = 1000000000ULL;	// 1s
+const uint64_t      LOADGEN_POLL_INTERVAL_NS = 1000000000ULL;	// 1s, D-Plus dongles time out after 10s
+const unsigned int  LOADGEN_LINK_TIMEOUT_S   = 10U;
+const unsigned int  LOADGEN_DRAIN_MS         = 500U;
+const uint64_t      LOADGEN_STREAM_TIMEOUT_NS = 1000000000ULL;	// 1s without a frame ends a stream whose end was lost
+const unsigned int  LOADGEN_REPORT_S         = 5U;
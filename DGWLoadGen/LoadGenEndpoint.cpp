@@ -0,0 +1,315 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <cassert>
+#include <cstring>
+
+#include "LoadGenEndpoint.h"
+#include "UDPReaderWriter.h"
+#include "DStarDefines.h"
+#include "StringUtils.h"
+#include "LoadGenDefs.h"
+
+const uint64_t FRAME_TIME_NS = uint64_t(DSTAR_FRAME_TIME_MS) * 1000000ULL;
+
+CLoadGenEndpoint::CLoadGenEndpoint(const std::string& type, unsigned int index, const std::string& callsign, const std::string& module) :
+m_type(type),
+m_index(index),
+m_callsign(callsign),
+m_module(module),
+m_talker(false),
+m_source(0U),
+m_streamLength(0U),
+m_gap(0U),
+m_nextStream(0U),
+m_transmitting(false),
+m_streamStart(0U),
+m_streamId(0U),
+m_streamNumber(0U),
+m_frame(0U),
+m_rptSeq(0U),
+m_header(),
+m_sent(0U),
+m_received(0U),
+m_lost(0U),
+m_reordered(0U),
+m_duplicates(0U),
+m_streams(0U),
+m_latency(),
+m_sources()
+{
+}
+
+CLoadGenEndpoint::~CLoadGenEndpoint()
+{
+}
+
+void CLoadGenEndpoint::setStreamLength(unsigned int streamLength)
+{
+	assert(streamLength > 0U && streamLength <= LOADGEN_MAX_STREAM_LEN);
+
+	m_streamLength = streamLength;
+}
+
+void CLoadGenEndpoint::setTalker(unsigned int source, unsigned int gapMs, uint64_t start)
+{
+	assert(source <= 0xFFU);
+	assert(m_streamLength > 0U);
+
+	m_talker       = true;
+	m_source       = source;
+	m_gap          = uint64_t(gapMs) * 1000000ULL;
+	m_nextStream   = start;
+}
+
+void CLoadGenEndpoint::transmit(uint64_t now)
+{
+	if (!m_talker || !isLinked())
+		return;
+
+	if (!m_transmitting) {
+		if (now < m_nextStream)
+			return;
+
+		std::string myCall(m_callsign);
+		myCall.resize(LONG_CALLSIGN_LENGTH, ' ');
+
+		m_header = CHeaderData(myCall, "LOAD", "CQCQCQ  ", m_module, m_module);
+		m_streamId = CHeaderData::createId();
+		m_header.setId(m_streamId);
+
+		writeHeader(m_header);
+
+		m_transmitting = true;
+		m_streamStart  = now;
+		m_streamNumber = (m_streamNumber + 1U) & 0xFFU;
+		m_frame        = 0U;
+	}
+
+	// Catch up with every frame due since the last tick, the final one is the end of stream marker
+	while (m_transmitting && now >= m_streamStart + uint64_t(m_frame) * FRAME_TIME_NS)
+		sendFrame(now);
+}
+
+void CLoadGenEndpoint::sendFrame(uint64_t now)
+{
+	unsigned char buffer[DV_FRAME_LENGTH_BYTES];
+	bool end = m_frame >= m_streamLength;
+
+	if (end) {
+		::memcpy(buffer, END_PATTERN_BYTES, DV_FRAME_LENGTH_BYTES);
+	} else {
+		uint32_t sentMicros = uint32_t(CUDPReaderWriter::getMonotonicTime() / 1000U);
+		encodePayload(buffer, m_source, m_streamNumber, m_frame, sentMicros);
+
+		if ((m_frame % 21U) == 0U)
+			::memcpy(buffer + VOICE_FRAME_LENGTH_BYTES, DATA_SYNC_BYTES, DATA_FRAME_LENGTH_BYTES);
+		else
+			::memcpy(buffer + VOICE_FRAME_LENGTH_BYTES, NULL_SLOW_DATA_BYTES, DATA_FRAME_LENGTH_BYTES);
+	}
+
+	CAMBEData data;
+	data.setId(m_streamId);
+	data.setSeq(m_frame % 21U);
+	data.setRptSeq(m_rptSeq);
+	data.setEnd(end);
+	data.setData(buffer, DV_FRAME_LENGTH_BYTES);
+	data.getHeader() = m_header;
+
+	if (writeAMBE(data) && !end)
+		m_sent++;
+
+	m_rptSeq = (m_rptSeq + 1U) & 0xFFU;
+	m_frame++;
+
+	if (end) {
+		m_transmitting = false;
+		m_nextStream   = now + m_gap;
+	}
+}
+
+void CLoadGenEndpoint::receive(const CAMBEData& data)
+{
+	uint64_t now = CUDPReaderWriter::getMonotonicTime();
+
+	// The end of stream marker carries no payload, the stream id tells which source it ends
+	if (data.isEnd()) {
+		for (auto& it : m_sources) {
+			if (!it.second.ended && it.second.id == data.getId())
+				endStream(it.second);
+		}
+		return;
+	}
+
+	unsigned char buffer[DV_FRAME_LENGTH_BYTES];
+	data.getData(buffer, DV_FRAME_LENGTH_BYTES);
+
+	unsigned int source, stream, frame;
+	uint32_t sentMicros;
+	if (!decodePayload(buffer, source, stream, frame, sentMicros))
+		return;
+
+	uint32_t nowMicros = uint32_t(now / 1000U);
+	m_latency.add(uint32_t(nowMicros - sentMicros));
+
+	auto it = m_sources.find(source);
+	if (it != m_sources.end() && it->second.stream == stream && it->second.frame == frame) {
+		// The same frame again, it says nothing about the frames lost
+		it->second.lastSeen = now;
+		m_duplicates++;
+		return;
+	}
+
+	m_received++;
+
+	if (it == m_sources.end() || it->second.stream != stream) {
+		// The previous stream of this source lost its end, anything it did not deliver is lost too
+		if (it != m_sources.end() && !it->second.ended)
+			endStream(it->second);
+
+		// First frame of a new stream, any frame before it never made it
+		m_sources[source] = { stream, frame, data.getId(), now, false };
+		m_lost += frame;
+		m_streams++;
+		return;
+	}
+
+	CSourceState& state = it->second;
+	state.lastSeen = now;
+
+	if (!state.ended && frame > state.frame) {
+		m_lost += frame - state.frame - 1U;
+		state.frame = frame;
+	} else {
+		// Arrived after a later frame or after the end, it has been accounted as lost already
+		m_reordered++;
+		if (m_lost > 0U)
+			m_lost--;
+	}
+}
+
+void CLoadGenEndpoint::expireStreams(uint64_t now)
+{
+	for (auto& it : m_sources) {
+		if (!it.second.ended && now >= it.second.lastSeen + LOADGEN_STREAM_TIMEOUT_NS)
+			endStream(it.second);
+	}
+}
+
+void CLoadGenEndpoint::endStream(CSourceState& state)
+{
+	if (m_streamLength > state.frame + 1U)
+		m_lost += m_streamLength - state.frame - 1U;
+
+	state.ended = true;
+}
+
+void CLoadGenEndpoint::encodePayload(unsigned char* ambe, unsigned int source, unsigned int stream, unsigned int frame, uint32_t sentMicros)
+{
+	assert(ambe != NULL);
+
+	ambe[0U] = LOADGEN_MAGIC;
+	ambe[1U] = source & 0xFFU;
+	ambe[2U] = stream & 0xFFU;
+	ambe[3U] = frame & 0xFFU;
+	ambe[4U] = (sentMicros >> 24) & 0xFFU;
+	ambe[5U] = (sentMicros >> 16) & 0xFFU;
+	ambe[6U] = (sentMicros >> 8) & 0xFFU;
+	ambe[7U] = sentMicros & 0xFFU;
+
+	unsigned char check = 0xA5U;
+	for (unsigned int i = 0U; i < 8U; i++)
+		check ^= ambe[i];
+	ambe[8U] = check;
+}
+
+bool CLoadGenEndpoint::decodePayload(const unsigned char* ambe, unsigned int& source, unsigned int& stream, unsigned int& frame, uint32_t& sentMicros)
+{
+	assert(ambe != NULL);
+
+	if (ambe[0U] != LOADGEN_MAGIC)
+		return false;
+
+	unsigned char check = 0xA5U;
+	for (unsigned int i = 0U; i < 8U; i++)
+		check ^= ambe[i];
+	if (ambe[8U] != check)
+		return false;
+
+	source     = ambe[1U];
+	stream     = ambe[2U];
+	frame      = ambe[3U];
+	sentMicros = (uint32_t(ambe[4U]) << 24) | (uint32_t(ambe[5U]) << 16) | (uint32_t(ambe[6U]) << 8) | uint32_t(ambe[7U]);
+
+	return true;
+}
+
+std::string CLoadGenEndpoint::getType() const
+{
+	return m_type;
+}
+
+std::string CLoadGenEndpoint::getName() const
+{
+	return CStringUtils::string_format("%s#%u (%s)", m_type.c_str(), m_index, m_callsign.c_str());
+}
+
+bool CLoadGenEndpoint::isTransmitting() const
+{
+	return m_transmitting;
+}
+
+bool CLoadGenEndpoint::isTalker() const
+{
+	return m_talker;
+}
+
+uint64_t CLoadGenEndpoint::getSentFrames() const
+{
+	return m_sent;
+}
+
+uint64_t CLoadGenEndpoint::getReceivedFrames() const
+{
+	return m_received;
+}
+
+uint64_t CLoadGenEndpoint::getLostFrames() const
+{
+	return m_lost;
+}
+
+uint64_t CLoadGenEndpoint::getReorderedFrames() const
+{
+	return m_reordered;
+}
+
+uint64_t CLoadGenEndpoint::getDuplicateFrames() const
+{
+	return m_duplicates;
+}
+
+uint64_t CLoadGenEndpoint::getStreams() const
+{
+	return m_streams;
+}
+
+const CHistogram& CLoadGenEndpoint::getLatency() const
+{
+	return m_latency;
+}
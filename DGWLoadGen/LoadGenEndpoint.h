@@ -0,0 +1,120 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+
+#include "HeaderData.h"
+#include "AMBEData.h"
+#include "Histogram.h"
+
+// Voice frames generated by dgwloadgen carry their origin in the 9 AMBE bytes:
+// magic, source endpoint, stream number, frame number in stream, 32 bits of send time in microseconds and a checksum
+const unsigned char LOADGEN_MAGIC          = 0x5AU;	// Must not look like a DTMF frame, the gateway would blank it
+const unsigned int  LOADGEN_MAX_STREAM_LEN = 255U;
+
+class CLoadGenEndpoint {
+public:
+	CLoadGenEndpoint(const std::string& type, unsigned int index, const std::string& callsign, const std::string& module);
+	virtual ~CLoadGenEndpoint();
+
+	virtual bool open() = 0;
+	virtual void close() = 0;
+
+	// Sends link requests and keep alives, has to be called every tick
+	virtual void clock(uint64_t now) = 0;
+	virtual bool isLinked() const = 0;
+
+	// Drains the socket, feeding received voice frames to the statistics
+	virtual void read() = 0;
+
+	// Number of voice frames in every stream, sent or expected when receiving
+	void setStreamLength(unsigned int streamLength);
+
+	// The source identifies the talker in the payload, it has to be unique across all the endpoints
+	void setTalker(unsigned int source, unsigned int gapMs, uint64_t start);
+
+	// Sends all the frames due at the 20ms D-Star cadence
+	void transmit(uint64_t now);
+	bool isTransmitting() const;
+
+	// Ends the received streams idle since before now, counting their missing trailing frames as lost
+	void expireStreams(uint64_t now);
+
+	std::string  getType() const;
+	std::string  getName() const;
+	bool         isTalker() const;
+	uint64_t     getSentFrames() const;
+	uint64_t     getReceivedFrames() const;
+	uint64_t     getLostFrames() const;
+	uint64_t     getReorderedFrames() const;
+	uint64_t     getDuplicateFrames() const;
+	uint64_t     getStreams() const;
+	const CHistogram& getLatency() const;
+
+	static bool decodePayload(const unsigned char* ambe, unsigned int& source, unsigned int& stream, unsigned int& frame, uint32_t& sentMicros);
+	static void encodePayload(unsigned char* ambe, unsigned int source, unsigned int stream, unsigned int frame, uint32_t sentMicros);
+
+protected:
+	std::string  m_type;
+	unsigned int m_index;
+	std::string  m_callsign;
+	std::string  m_module;
+
+	virtual bool writeHeader(CHeaderData& header) = 0;
+	virtual bool writeAMBE(CAMBEData& data) = 0;
+
+	void receive(const CAMBEData& data);
+
+private:
+	struct CSourceState {
+		unsigned int stream;
+		unsigned int frame;
+		unsigned int id;
+		uint64_t     lastSeen;
+		bool         ended;
+	};
+
+	bool         m_talker;
+	unsigned int m_source;
+	unsigned int m_streamLength;
+	uint64_t     m_gap;
+	uint64_t     m_nextStream;
+	bool         m_transmitting;
+	uint64_t     m_streamStart;
+	unsigned int m_streamId;
+	unsigned int m_streamNumber;
+	unsigned int m_frame;
+	unsigned int m_rptSeq;
+	CHeaderData  m_header;
+
+	uint64_t     m_sent;
+	uint64_t     m_received;
+	uint64_t     m_lost;
+	uint64_t     m_reordered;
+	uint64_t     m_duplicates;
+	uint64_t     m_streams;
+	CHistogram   m_latency;
+	std::unordered_map<unsigned int, CSourceState> m_sources;
+
+	void sendFrame(uint64_t now);
+	void endStream(CSourceState& state);
+};
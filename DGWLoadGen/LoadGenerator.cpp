@@ -0,0 +1,243 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <cassert>
+#include <cstdio>
+#include <cstdint>
+#include <thread>
+#include <chrono>
+#include <map>
+
+#include "LoadGenerator.h"
+#include "LoadGenDefs.h"
+#include "UDPReaderWriter.h"
+#include "DStarDefines.h"
+#include "Histogram.h"
+
+const uint64_t NS_PER_S = 1000000000ULL;
+
+CLoadGenerator::CLoadGenerator(unsigned int duration, unsigned int streamLength, unsigned int gapMs) :
+m_endpoints(),
+m_talkers(),
+m_duration(duration),
+m_streamLength(streamLength),
+m_gapMs(gapMs)
+{
+	assert(duration > 0U);
+	assert(streamLength > 0U && streamLength <= LOADGEN_MAX_STREAM_LEN);
+}
+
+CLoadGenerator::~CLoadGenerator()
+{
+	for (CLoadGenEndpoint* endpoint : m_endpoints)
+		delete endpoint;
+}
+
+void CLoadGenerator::addEndpoint(CLoadGenEndpoint* endpoint, bool talker)
+{
+	assert(endpoint != NULL);
+
+	m_endpoints.push_back(endpoint);
+	m_talkers.push_back(talker);
+}
+
+bool CLoadGenerator::run()
+{
+	for (CLoadGenEndpoint* endpoint : m_endpoints) {
+		if (!endpoint->open()) {
+			::fprintf(stderr, "dgwloadgen: unable to open %s\n", endpoint->getName().c_str());
+			return false;
+		}
+	}
+
+	if (!link()) {
+		for (CLoadGenEndpoint* endpoint : m_endpoints)
+			endpoint->close();
+		return false;
+	}
+
+	for (CLoadGenEndpoint* endpoint : m_endpoints)
+		endpoint->setStreamLength(m_streamLength);
+
+	uint64_t start = CUDPReaderWriter::getMonotonicTime();
+	uint64_t end   = start + uint64_t(m_duration) * NS_PER_S;
+	// Streams under way at the end are completed, so that their frames are not taken for losses
+	uint64_t drain = end + uint64_t(m_streamLength + 1U) * DSTAR_FRAME_TIME_MS * 1000000ULL + uint64_t(LOADGEN_DRAIN_MS) * 1000000ULL;
+	uint64_t nextProgress = start + uint64_t(LOADGEN_REPORT_S) * NS_PER_S;
+
+	startTalkers(start);
+
+	::fprintf(stdout, "dgwloadgen: running for %u seconds\n", m_duration);
+
+	for (;;) {
+		uint64_t now = CUDPReaderWriter::getMonotonicTime();
+		if (now >= drain)
+			break;
+
+		for (CLoadGenEndpoint* endpoint : m_endpoints) {
+			endpoint->clock(now);
+			endpoint->read();
+
+			// Stop starting streams at the end of the run but keep collecting frames still in flight
+			if (now < end || endpoint->isTransmitting())
+				endpoint->transmit(now);
+
+			endpoint->expireStreams(now);
+		}
+
+		if (now >= nextProgress && now < end) {
+			progress(now - start);
+			nextProgress += uint64_t(LOADGEN_REPORT_S) * NS_PER_S;
+		}
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(1U));
+	}
+
+	// Whatever did not arrive by now never will
+	for (CLoadGenEndpoint* endpoint : m_endpoints)
+		endpoint->expireStreams(UINT64_MAX);
+
+	report(end - start);
+
+	for (CLoadGenEndpoint* endpoint : m_endpoints)
+		endpoint->close();
+
+	return true;
+}
+
+bool CLoadGenerator::link()
+{
+	uint64_t timeout = CUDPReaderWriter::getMonotonicTime() + uint64_t(LOADGEN_LINK_TIMEOUT_S) * NS_PER_S;
+
+	for (;;) {
+		uint64_t now = CUDPReaderWriter::getMonotonicTime();
+
+		bool linked = true;
+		for (CLoadGenEndpoint* endpoint : m_endpoints) {
+			endpoint->clock(now);
+			endpoint->read();
+			linked = linked && endpoint->isLinked();
+		}
+
+		if (linked)
+			return true;
+
+		if (now >= timeout)
+			break;
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(10U));
+	}
+
+	for (CLoadGenEndpoint* endpoint : m_endpoints) {
+		if (!endpoint->isLinked())
+			::fprintf(stderr, "dgwloadgen: %s did not link within %u seconds, check the gateway configuration\n", endpoint->getName().c_str(), LOADGEN_LINK_TIMEOUT_S);
+	}
+
+	return false;
+}
+
+void CLoadGenerator::startTalkers(uint64_t start)
+{
+	unsigned int count = 0U;
+	for (bool talker : m_talkers) {
+		if (talker)
+			count++;
+	}
+
+	if (count == 0U)
+		return;
+
+	// Spread the stream starts over one stream period so that the talkers do not all key up at once
+	uint64_t period = uint64_t(m_streamLength + 1U) * DSTAR_FRAME_TIME_MS * 1000000ULL + uint64_t(m_gapMs) * 1000000ULL;
+
+	unsigned int n = 0U;
+	for (unsigned int i = 0U; i < m_endpoints.size(); i++) {
+		if (m_talkers[i]) {
+			m_endpoints[i]->setTalker(i, m_gapMs, start + (period * n) / count);
+			n++;
+		}
+	}
+}
+
+void CLoadGenerator::progress(uint64_t elapsed) const
+{
+	uint64_t sent = 0U, received = 0U, lost = 0U;
+	for (CLoadGenEndpoint* endpoint : m_endpoints) {
+		sent     += endpoint->getSentFrames();
+		received += endpoint->getReceivedFrames();
+		lost     += endpoint->getLostFrames();
+	}
+
+	double seconds = double(elapsed) / double(NS_PER_S);
+	::fprintf(stdout, "%6.1fs sent=%llu (%.1f fps) received=%llu (%.1f fps) lost=%llu\n", seconds,
+		(unsigned long long)sent, double(sent) / seconds, (unsigned long long)received, double(received) / seconds, (unsigned long long)lost);
+}
+
+void CLoadGenerator::report(uint64_t elapsed) const
+{
+	double seconds = double(elapsed) / double(NS_PER_S);
+
+	::fprintf(stdout, "\n%-22s %5s %9s %8s %9s %8s %7s %7s %7s %7s %10s %10s %10s\n", "endpoint", "talk", "sent", "tx fps", "received", "rx fps",
+		"streams", "lost", "reorder", "dup", "p50", "p99", "max");
+
+	struct CTotals {
+		uint64_t   sent;
+		uint64_t   received;
+		uint64_t   lost;
+		uint64_t   reordered;
+		uint64_t   duplicates;
+		CHistogram latency;
+	};
+
+	std::map<std::string, CTotals> totals;
+	CTotals all = { 0U, 0U, 0U, 0U, 0U, CHistogram() };
+
+	for (CLoadGenEndpoint* endpoint : m_endpoints) {
+		const CHistogram& latency = endpoint->getLatency();
+
+		::fprintf(stdout, "%-22s %5s %9llu %8.1f %9llu %8.1f %7llu %7llu %7llu %7llu %8lluus %8lluus %8lluus\n", endpoint->getName().c_str(),
+			endpoint->isTalker() ? "yes" : "no",
+			(unsigned long long)endpoint->getSentFrames(), double(endpoint->getSentFrames()) / seconds,
+			(unsigned long long)endpoint->getReceivedFrames(), double(endpoint->getReceivedFrames()) / seconds,
+			(unsigned long long)endpoint->getStreams(), (unsigned long long)endpoint->getLostFrames(), (unsigned long long)endpoint->getReorderedFrames(),
+			(unsigned long long)endpoint->getDuplicateFrames(), (unsigned long long)latency.getPercentile(50.0), (unsigned long long)latency.getPercentile(99.0), (unsigned long long)latency.getMax());
+
+		CTotals& type = totals[endpoint->getType()];
+		for (CTotals* total : { &type, &all }) {
+			total->sent       += endpoint->getSentFrames();
+			total->received   += endpoint->getReceivedFrames();
+			total->lost       += endpoint->getLostFrames();
+			total->reordered  += endpoint->getReorderedFrames();
+			total->duplicates += endpoint->getDuplicateFrames();
+			total->latency.merge(latency);
+		}
+	}
+
+	::fprintf(stdout, "\n");
+
+	totals["all"] = all;
+	for (auto& it : totals) {
+		const CTotals& total = it.second;
+		uint64_t expected = total.received + total.lost;
+		double loss = expected > 0U ? 100.0 * double(total.lost) / double(expected) : 0.0;
+
+		::fprintf(stdout, "%-8s sent %.1f fps, received %.1f fps, loss %.2f%%, reordered %llu, duplicated %llu, latency %s\n", it.first.c_str(),
+			double(total.sent) / seconds, double(total.received) / seconds, loss, (unsigned long long)total.reordered, (unsigned long long)total.duplicates,
+			total.latency.toString("us").c_str());
+	}
+}
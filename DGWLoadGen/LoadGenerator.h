@@ -0,0 +1,47 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "LoadGenEndpoint.h"
+
+class CLoadGenerator {
+public:
+	CLoadGenerator(unsigned int duration, unsigned int streamLength, unsigned int gapMs);
+	~CLoadGenerator();
+
+	// Takes ownership of the endpoint
+	void addEndpoint(CLoadGenEndpoint* endpoint, bool talker);
+
+	bool run();
+
+private:
+	std::vector<CLoadGenEndpoint*> m_endpoints;
+	std::vector<bool>              m_talkers;
+	unsigned int                   m_duration;
+	unsigned int                   m_streamLength;
+	unsigned int                   m_gapMs;
+
+	bool link();
+	void startTalkers(uint64_t start);
+	void report(uint64_t elapsed) const;
+	void progress(uint64_t elapsed) const;
+};
@@ -49,7 +49,8 @@ int main(int argc, const char* argv[])
         ::fprintf(stderr, "\t\tdgwremotecontrol [-name <name>] <repeater> link <reconnect> <reflector>\n");
 		::fprintf(stderr, "\t\tdgwremotecontrol [-name <name>] <repeater> unlink\n");
 		::fprintf(stderr, "\t\tdgwremotecontrol [-name <name>] <starnet> drop <user>\n");
-		::fprintf(stderr, "\t\tdgwremotecontrol [-name <name>] <starnet> drop all\n\n");
+		::fprintf(stderr, "\t\tdgwremotecontrol [-name <name>] <starnet> drop all\n");
+		::fprintf(stderr, "\t\tdgwremotecontrol [-name <name>] metrics\n\n");
         return 1;
     }
 
@@ -129,6 +130,9 @@ int main(int argc, const char* argv[])
 
 	handler.setLoggedIn(true);
 
+	if (actionText == "metrics")
+		return getMetrics(handler);
+
 	if (actionText == "drop")
 		handler.logoff(repeater, user);
 	else
@@ -216,6 +220,14 @@ bool getCLIParams(int argc, const char* argv[], std::string& name, std::string&
         reflector = boost::to_upper_copy(positionalArgs[3]);
         boost::replace_all(reflector, "_", " ");
     }
+    // dgwremotecontrol [-name <name>] metrics
+    else if(positionalArgs.size() == 1U) {
+        actionText = boost::to_lower_copy(positionalArgs[0]);
+        if(actionText != "metrics") {
+            ::fprintf(stderr, "Invalid action %s. Expected metrics\n", positionalArgs[0].c_str());
+            ret = false;
+        }
+    }
     // dgwremotecontrol [-name <name>] <repeater> unlink
     else if(positionalArgs.size() == 2U) {
         repeater = positionalArgs[0];
@@ -255,6 +267,48 @@ bool getCLIParams(int argc, const char* argv[], std::string& name, std::string&
     return ret;
 }
 
+int getMetrics(CRemoteControlRemoteControlHandler& handler)
+{
+	handler.getMetrics();
+
+	unsigned int count = 0U;
+	while (count < 10U) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(100U));
+
+		RC_TYPE type = handler.readType();
+		if (type == RCT_METRICS)
+			break;
+
+		if (type == RCT_NAK) {
+			handler.close();
+			::fprintf(stderr, "dgwremotecontrol: metrics command rejected by the gateway\n");
+			return 1;
+		}
+
+		if (type == RCT_NONE)
+			handler.retry();
+
+		count++;
+	}
+
+	if (count >= 10U) {
+		handler.close();
+		::fprintf(stderr, "dgwremotecontrol: unable to get a response from the gateway\n");
+		return 1;
+	}
+
+	std::string metrics = handler.readMetrics();
+	if (metrics.empty())
+		::fprintf(stdout, "No metrics available, are they enabled in the gateway configuration ?\n");
+	else
+		::fprintf(stdout, "%s", metrics.c_str());
+
+	handler.logout();
+	handler.close();
+
+	return 0;
+}
+
 void sendHash(CRemoteControlRemoteControlHandler* handler, const std::string& password, unsigned int rnd)
 {
 	assert(handler != NULL);
@@ -24,4 +24,5 @@
 #include "RemoteControlRemoteControlHandler.h"
 
 bool getCLIParams(int argc, const char* argv[], std::string& name, std::string& repeater, std::string& actionText, RECONNECT& reconnect, std::string& user, std::string& reflector);
-void sendHash(CRemoteControlRemoteControlHandler* handler, const std::string& password, unsigned int rnd);
\ No newline at end of file
+void sendHash(CRemoteControlRemoteControlHandler* handler, const std::string& password, unsigned int rnd);
+int getMetrics(CRemoteControlRemoteControlHandler& handler);
\ No newline at end of file
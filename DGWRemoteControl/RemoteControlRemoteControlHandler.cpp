@@ -96,6 +96,10 @@ RC_TYPE CRemoteControlRemoteControlHandler::readType()
 		m_retryCount = 0U;
 		m_type = RCT_STARNET;
 		return m_type;
+	} else if (::memcmp(m_inBuffer, "MET", 3U) == 0) {
+		m_retryCount = 0U;
+		m_type = RCT_METRICS;
+		return m_type;
 	}
 
 	return m_type;
@@ -257,6 +261,20 @@ CRemoteControlStarNetGroup* CRemoteControlRemoteControlHandler::readStarNetGroup
 	return group;
 }
 
+std::string CRemoteControlRemoteControlHandler::readMetrics()
+{
+	if (m_type != RCT_METRICS)
+		return "";
+
+	std::string text((char*)(m_inBuffer + 3U), m_inLength - 3U);
+
+	auto end = text.find('\0');
+	if (end != std::string::npos)
+		text.resize(end);
+
+	return text;
+}
+
 bool CRemoteControlRemoteControlHandler::login()
 {
 	if (m_loggedIn)
@@ -301,6 +319,24 @@ bool CRemoteControlRemoteControlHandler::getCallsigns()
 	}
 }
 
+bool CRemoteControlRemoteControlHandler::getMetrics()
+{
+	if (!m_loggedIn || m_retryCount > 0U)
+		return false;
+
+	::memcpy(m_outBuffer, "GMT", 3U);
+	m_outLength = 3U;
+
+	bool ret = m_socket.write(m_outBuffer, m_outLength, m_address, m_port);
+	if (!ret) {
+		m_retryCount = 0U;
+		return false;
+	} else {
+		m_retryCount = 1U;
+		return true;
+	}
+}
+
 bool CRemoteControlRemoteControlHandler::sendHash(const unsigned char* hash, unsigned int length)
 {
 	assert(hash != NULL);
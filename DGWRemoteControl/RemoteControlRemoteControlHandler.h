@@ -31,7 +31,8 @@ enum RC_TYPE {
 	RCT_RANDOM,
 	RCT_CALLSIGNS,
 	RCT_REPEATER,
-	RCT_STARNET
+	RCT_STARNET,
+	RCT_METRICS
 };
 
 class CRemoteControlRemoteControlHandler {
@@ -48,6 +49,7 @@ public:
 	CRemoteControlCallsignData* readCallsigns();
 	CRemoteControlRepeaterData* readRepeater();
 	CRemoteControlStarNetGroup* readStarNetGroup();
+	std::string                    readMetrics();
 
 	bool login();
 	bool sendHash(const unsigned char* hash, unsigned int length);
@@ -57,6 +59,7 @@ public:
 	bool getCallsigns();
 	bool getRepeater(const std::string& callsign);
 	bool getStarNet(const std::string& callsign);
+	bool getMetrics();
 
 	bool link(const std::string& callsign, RECONNECT reconnect, const std::string& reflector);
 	bool unlink(const std::string& callsign, PROTOCOL protocol, const std::string& reflector);
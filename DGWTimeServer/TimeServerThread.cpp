@@ -23,7 +23,8 @@
 #include <stdio.h>
 #include <vector>
 #include <boost/algorithm/string.hpp>
-#include <chrono>
+#include <sys/timerfd.h>
+#include <unistd.h>
 
 #include "TimeServerThread.h"
 #include "DStarDefines.h"
@@ -36,6 +37,10 @@ const unsigned int MAX_FRAMES = 60U * DSTAR_FRAMES_PER_SEC;
 
 const unsigned int SILENCE_LENGTH = 10U;
 
+const unsigned int G2_HEADER_LENGTH = 56U;
+const unsigned int G2_DATA_LENGTH   = 15U + DV_FRAME_LENGTH_BYTES;
+const unsigned int HEADER_REPEATS   = 5U;
+
 CTimeServerThread::CTimeServerThread() :
 CThread("Time Server"),
 m_callsign(),
@@ -46,10 +51,11 @@ m_addressStr(),
 m_language(LANG_ENGLISH_UK_1),
 m_format(FORMAT_VOICE_TIME),
 m_interval(INTERVAL_15MINS),
-m_data(),
 m_killed(false),
 m_dataPath(""),
-m_ambeFileReader(nullptr)
+m_ambeFileReader(nullptr),
+m_socket("", 0U),
+m_announcements()
 {
 	CHeaderData::initialise();
 	m_address.s_addr = INADDR_NONE; 
@@ -57,12 +63,7 @@ m_ambeFileReader(nullptr)
 
 CTimeServerThread::~CTimeServerThread()
 {
-	for(auto d : m_data)
-		delete d;
-
-	m_data.clear();
-
-	delete[] m_ambeFileReader;
+	delete m_ambeFileReader;
 }
 
 void * CTimeServerThread::Entry()
@@ -82,6 +83,13 @@ void * CTimeServerThread::Entry()
 		}
 	}
 
+	if (!m_socket.open()) {
+		CLog::logError("Cannot open the Time Server socket");
+		return nullptr;
+	}
+
+	renderAnnouncements();
+
 	CLog::logInfo(("Starting the Time Server thread"));
 
 	unsigned int lastMin = 0U;
@@ -112,6 +120,8 @@ void * CTimeServerThread::Entry()
 		Sleep(450UL);
 	}
 
+	m_socket.close();
+
 	CLog::logInfo(("Stopping the Time Server thread"));
 
 	return nullptr;
@@ -163,6 +173,22 @@ void CTimeServerThread::setAnnouncements(LANGUAGE language, FORMAT format, INTER
 }
 
 void CTimeServerThread::sendTime(unsigned int hour, unsigned int min)
+{
+	unsigned int slot = hour * 60U + min;
+
+	auto it = m_announcements.find(slot);
+	if (it == m_announcements.end()) {
+		TTimeAnnouncement announcement;
+		if (!render(hour, min, announcement))
+			return;
+
+		it = m_announcements.emplace(slot, std::move(announcement)).first;
+	}
+
+	send(it->second);
+}
+
+std::vector<std::string> CTimeServerThread::getWords(unsigned int hour, unsigned int min)
 {
 	std::vector<std::string> words;
 
@@ -207,7 +233,7 @@ void CTimeServerThread::sendTime(unsigned int hour, unsigned int min)
 			break;
 	}
 
-	send(words, hour, min);
+	return words;
 }
 
 std::vector<std::string> CTimeServerThread::sendTimeEnGB1(unsigned int hour, unsigned int min)
@@ -983,7 +1009,7 @@ bool CTimeServerThread::loadAMBE()
 	bool ret = m_ambeFileReader->read();
 
 	if (!ret) {
-		delete[] m_ambeFileReader;
+		delete m_ambeFileReader;
 		m_ambeFileReader = nullptr;
 		return false;
 	}
@@ -991,60 +1017,43 @@ bool CTimeServerThread::loadAMBE()
 	return true;
 }
 
-void CTimeServerThread::buildAudio(const std::vector<std::string>& words, CSlowDataEncoder& slowDataEncoder)
+void CTimeServerThread::buildAudio(const std::vector<std::string>& words, CSlowDataEncoder& slowDataEncoder, std::vector<unsigned char>& frames)
 {
-	unsigned int seqNo = 0U;
-
-	m_data.clear();
+	frames.clear();
 
-	if(words.size() == 0U || m_ambeFileReader == nullptr)
+	if(m_format == FORMAT_VOICE_TIME && words.size() == 0U)
 		CLog::logWarning("No words, falling back to text only");
 
 	if(m_format == FORMAT_VOICE_TIME && words.size() != 0U) {
 		// Build the audio
-		m_ambeFileReader->lookup(" ", m_data);
-		m_ambeFileReader->lookup(" ", m_data);
-		m_ambeFileReader->lookup(" ", m_data);
-		m_ambeFileReader->lookup(" ", m_data);
+		std::vector<unsigned char> voice;
+		m_ambeFileReader->lookup(" ", voice);
+		m_ambeFileReader->lookup(" ", voice);
+		m_ambeFileReader->lookup(" ", voice);
+		m_ambeFileReader->lookup(" ", voice);
 
 		for (unsigned int i = 0U; i < words.size(); i++)
-			m_ambeFileReader->lookup(words.at(i), m_data);
+			m_ambeFileReader->lookup(words.at(i), voice);
 
-		m_ambeFileReader->lookup(" ", m_data);
-		m_ambeFileReader->lookup(" ", m_data);
-		m_ambeFileReader->lookup(" ", m_data);
-		m_ambeFileReader->lookup(" ", m_data);
+		m_ambeFileReader->lookup(" ", voice);
+		m_ambeFileReader->lookup(" ", voice);
+		m_ambeFileReader->lookup(" ", voice);
+		m_ambeFileReader->lookup(" ", voice);
 
+		unsigned int count = voice.size() / VOICE_FRAME_LENGTH_BYTES;
+		frames.resize(count * DV_FRAME_LENGTH_BYTES);
 
 		// add the slow data
-		for(unsigned int i = 0U; i < m_data.size(); i++) {
-			m_data[i]->setDestination(m_address, G2_DV_PORT);
-			m_data[i]->setSeq(seqNo);
+		for(unsigned int i = 0U; i < count; i++)
+			::memcpy(frames.data() + i * DV_FRAME_LENGTH_BYTES, voice.data() + i * VOICE_FRAME_LENGTH_BYTES, VOICE_FRAME_LENGTH_BYTES);
 
-			unsigned char buffer[DV_FRAME_LENGTH_BYTES];
-			m_data[i]->getData(buffer, DV_FRAME_LENGTH_BYTES);
-
-			// Insert sync bytes when the sequence number is zero, slow data otherwise
-			if (seqNo == 0U) {
-				::memcpy(buffer + VOICE_FRAME_LENGTH_BYTES, DATA_SYNC_BYTES, DATA_FRAME_LENGTH_BYTES);
-				slowDataEncoder.sync();
-			} else {
-				slowDataEncoder.getInterleavedData(buffer + VOICE_FRAME_LENGTH_BYTES);
-			}
-
-			m_data[i]->setData(buffer, DV_FRAME_LENGTH_BYTES);
-
-			seqNo++;
-			if(seqNo >= 21U) seqNo = 0U;
-		}
+		slowDataEncoder.getScrambledData(frames.data(), count);
 	}
 	else {
-		for (unsigned int i = 0U; i < 21U; i++, seqNo++) {
-			CAMBEData* dataOut = new CAMBEData;
-			unsigned char buffer[DV_FRAME_LENGTH_BYTES];
-			dataOut->setDestination(m_address, G2_DV_PORT);
-			dataOut->setSeq(i);
+		frames.resize(21U * DV_FRAME_LENGTH_BYTES);
 
+		for (unsigned int i = 0U; i < 21U; i++) {
+			unsigned char* buffer = frames.data() + i * DV_FRAME_LENGTH_BYTES;
 			::memcpy(buffer + 0U, NULL_AMBE_DATA_BYTES, VOICE_FRAME_LENGTH_BYTES);
 
 			// Insert sync bytes when the sequence number is zero, slow data otherwise
@@ -1054,28 +1063,35 @@ void CTimeServerThread::buildAudio(const std::vector<std::string>& words, CSlowD
 			} else {
 				slowDataEncoder.getTextData(buffer + VOICE_FRAME_LENGTH_BYTES);
 			}
-
-			dataOut->setData(buffer, DV_FRAME_LENGTH_BYTES);
-
-			m_data.push_back(dataOut);
 		}
 	}
 
-	if(seqNo >= 21U) {
-		seqNo = 0U;
-	}
+	frames.insert(frames.end(), END_PATTERN_BYTES, END_PATTERN_BYTES + DV_FRAME_LENGTH_BYTES);
+}
 
-	CAMBEData* dataOut = new CAMBEData;
-	dataOut->setData(END_PATTERN_BYTES, DV_FRAME_LENGTH_BYTES);
-	dataOut->setDestination(m_address, G2_DV_PORT);
-	dataOut->setSeq(seqNo);
-	dataOut->setEnd(true);
+void CTimeServerThread::renderAnnouncements()
+{
+	unsigned int step = m_interval == INTERVAL_60MINS ? 60U : (m_interval == INTERVAL_30MINS ? 30U : 15U);
+	size_t bytes = 0U;
+
+	for (unsigned int hour = 0U; hour < 24U; hour++) {
+		for (unsigned int min = 0U; min < 60U; min += step) {
+			TTimeAnnouncement announcement;
+			if (!render(hour, min, announcement))
+				continue;
 
-	m_data.push_back(dataOut);
+			bytes += announcement.headers.size() + announcement.frames.size();
+			m_announcements[hour * 60U + min] = std::move(announcement);
+		}
+	}
+
+	CLog::logInfo("Rendered %u announcements, using %u bytes", (unsigned int)m_announcements.size(), (unsigned int)bytes);
 }
 
-bool CTimeServerThread::send(const std::vector<std::string> &words, unsigned int hour, unsigned int min)
+bool CTimeServerThread::render(unsigned int hour, unsigned int min, TTimeAnnouncement& announcement)
 {
+	std::vector<std::string> words = getWords(hour, min);
+
 	CSlowDataEncoder encoder;
 
 	CHeaderData header;
@@ -1143,111 +1159,117 @@ bool CTimeServerThread::send(const std::vector<std::string> &words, unsigned int
 	encoder.setHeaderData(header);
 	encoder.setTextData(slowData);
 
-	buildAudio(words, encoder);
+	std::vector<unsigned char> frames;
+	buildAudio(words, encoder, frames);
 
-	if (m_data.size() == 0U) {
+	if (frames.size() == 0U) {
 		CLog::logWarning(("Not sending, no audio files loaded"));
 		return false;
 	}
 
 	if(m_format == FORMAT_VOICE_TIME) {
-		std::string text = boost::algorithm::join(words, " ");
-		boost::replace_all(text, "_", " ");
-		CLog::logInfo("Sending voice \"%s\", sending text \"%s\"", text.c_str(), slowData.c_str());
-	}
-	else {
-		CLog::logInfo("Sending text \"%s\"", slowData.c_str());
+		announcement.voiceText = boost::algorithm::join(words, " ");
+		boost::replace_all(announcement.voiceText, "_", " ");
 	}
 
-	// Build id and socket lists
-	std::vector<unsigned int> ids;
-	std::vector<CUDPReaderWriter *> sockets;
-	for(auto rpt : m_repeaters) {
-		auto socket = new CUDPReaderWriter("", 0U);
-		sockets.push_back(socket);
-		ids.push_back(CHeaderData::createId());
-	}
+	announcement.slowDataText = slowData;
+	announcement.count = frames.size() / DV_FRAME_LENGTH_BYTES;
 
-	// open them all
-	bool allOpen = std::all_of(sockets.begin(), sockets.end(), [](CUDPReaderWriter* s) { return s->open(); });
-	if(allOpen) {
-		//send headers
-		for(unsigned int i = 0; i < m_repeaters.size(); i++) {
-			CHeaderData headerCopy(header);
-			headerCopy.setId(ids[i]);
-			headerCopy.setRptCall2(m_repeaters[i]);
-			sendHeader(*(sockets[i]), headerCopy);
-			Sleep(5);
-		}
+	unsigned int repeaters = m_repeaters.size();
+	announcement.headers.resize(repeaters * G2_HEADER_LENGTH);
+	announcement.frames.resize(announcement.count * repeaters * G2_DATA_LENGTH);
 
-		// send audio
-		bool loop = true;
-		unsigned int out = 0U;
-		auto start = std::chrono::high_resolution_clock::now();
-
-		while(loop) {
-			unsigned int needed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start).count();
-			needed /= DSTAR_FRAME_TIME_MS;
-
-			while (out < needed) {
-				for(unsigned int i = 0; i < m_repeaters.size(); i++) {
-					CAMBEData data(*(m_data[out]));
-					data.setId(ids[i]);
-					sendData(*(sockets[i]), data);
-					Sleep(5);
-				}
-
-				delete m_data[out];
-				m_data[out] = nullptr;
-				out++;
-
-				if (out >= m_data.size()) {
-					loop = false;
-					break;
-				}
-			}
-		}
+	for(unsigned int i = 0U; i < repeaters; i++) {
+		CHeaderData headerCopy(header);
+		headerCopy.setRptCall2(m_repeaters[i]);
+		headerCopy.getG2Data(announcement.headers.data() + i * G2_HEADER_LENGTH, G2_HEADER_LENGTH, true);
 	}
 
-	m_data.clear();
+	CAMBEData data;
+	for(unsigned int out = 0U; out < announcement.count; out++) {
+		data.setData(frames.data() + out * DV_FRAME_LENGTH_BYTES, DV_FRAME_LENGTH_BYTES);
+		data.setSeq(out % 21U);
+		data.setEnd(out == announcement.count - 1U);
 
-	for(auto socket : sockets) {
-		socket->close();
-		delete socket;
+		for(unsigned int i = 0U; i < repeaters; i++)
+			data.getG2Data(announcement.frames.data() + (out * repeaters + i) * G2_DATA_LENGTH, G2_DATA_LENGTH);
 	}
 
 	return true;
 }
 
-
-bool CTimeServerThread::sendHeader(CUDPReaderWriter& socket, const CHeaderData &header)
+bool CTimeServerThread::send(TTimeAnnouncement& announcement)
 {
-	unsigned char buffer[60U];
-	unsigned int length = header.getG2Data(buffer, 60U, true);
+	if(m_format == FORMAT_VOICE_TIME)
+		CLog::logInfo("Sending voice \"%s\", sending text \"%s\"", announcement.voiceText.c_str(), announcement.slowDataText.c_str());
+	else
+		CLog::logInfo("Sending text \"%s\"", announcement.slowDataText.c_str());
 
-#if defined(DUMP_TX)
-	CUtils::dump(("Sending Header"), buffer, length);
-	return true;
-#else
-	for (unsigned int i = 0U; i < 5U; i++) {
-		bool res = socket.write(buffer, length, header.getYourAddress(), header.getYourPort());
-		if (!res)
-			return false;
+	unsigned int repeaters = m_repeaters.size();
+	if (repeaters == 0U)
+		return false;
+
+	// Fresh session ids, they are outside of the header checksum
+	for(unsigned int i = 0U; i < repeaters; i++) {
+		unsigned int id = CHeaderData::createId();
+
+		unsigned char* header = announcement.headers.data() + i * G2_HEADER_LENGTH;
+		header[12] = id / 256U;
+		header[13] = id % 256U;
+
+		for(unsigned int out = 0U; out < announcement.count; out++) {
+			unsigned char* data = announcement.frames.data() + (out * repeaters + i) * G2_DATA_LENGTH;
+			data[12] = id / 256U;
+			data[13] = id % 256U;
+		}
 	}
 
-	return true;
-#endif
+	int timerFd = ::timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+	if (timerFd < 0) {
+		CLog::logError("Cannot create the Time Server timer, err=%d", errno);
+		return false;
+	}
+
+	for(unsigned int i = 0U; i < HEADER_REPEATS; i++)
+		sendPackets(announcement.headers.data(), G2_HEADER_LENGTH, repeaters);
+
+	// The first frame follows the headers by one frame time, then one frame every frame time
+	struct itimerspec period;
+	period.it_interval.tv_sec  = 0;
+	period.it_interval.tv_nsec = DSTAR_FRAME_TIME_MS * 1000000L;
+	period.it_value = period.it_interval;
+	::timerfd_settime(timerFd, 0, &period, nullptr);
+
+	unsigned int out = 0U;
+	while (out < announcement.count) {
+		uint64_t expirations;
+		ssize_t len = ::read(timerFd, &expirations, sizeof(expirations));
+		if (len != ssize_t(sizeof(expirations))) {
+			if (len < 0 && errno == EINTR)
+				continue;
+
+			CLog::logError("Cannot read the Time Server timer, err=%d", errno);
+			break;
+		}
+
+		// Catch up on the deadlines missed, if any, every frame of all the repeaters in one go
+		unsigned int due = std::min<uint64_t>(expirations, announcement.count - out);
+		sendPackets(announcement.frames.data() + out * repeaters * G2_DATA_LENGTH, G2_DATA_LENGTH, due * repeaters);
+		out += due;
+	}
+
+	::close(timerFd);
+
+	return out == announcement.count;
 }
 
-bool CTimeServerThread::sendData(CUDPReaderWriter& socket, const CAMBEData& data)
+bool CTimeServerThread::sendPackets(const unsigned char* buffer, unsigned int length, unsigned int count)
 {
-	unsigned char buffer[40U];
-	unsigned int length = data.getG2Data(buffer, 40U);
-
 #if defined(DUMP_TX)
-	CUtils::dump(("Sending Data"), buffer, length);
+	for(unsigned int i = 0U; i < count; i++)
+		CUtils::dump(("Sending"), buffer + i * length, length);
 	return true;
 #else
-	return socket.write(buffer, length, data.getYourAddress(), data.getYourPort());
+	return m_socket.writeMany(buffer, length, count, m_address, G2_DV_PORT);
 #endif
 }
@@ -29,6 +29,15 @@
 #include "Thread.h"
 #include "AMBEFileReader.h"
 
+// Ready to send G2 packets of one announcement, only the session ids are stamped when sending
+typedef struct {
+	std::vector<unsigned char> headers;		// one header per repeater
+	std::vector<unsigned char> frames;		// for each frame, one data packet per repeater
+	unsigned int count;
+	std::string  voiceText;
+	std::string  slowDataText;
+} TTimeAnnouncement;
+
 class CTimeServerThread : public CThread
 {
 public:
@@ -50,13 +59,14 @@ private:
 	LANGUAGE         		 m_language;
 	FORMAT           		 m_format;
 	INTERVAL         		 m_interval;
-	CSlowDataEncoder 		 m_encoder;
-	std::vector<CAMBEData*>  m_data;
 	bool             		 m_killed;
 	std::string		 		 m_dataPath;
 	CAMBEFileReader * 		 m_ambeFileReader;
+	CUDPReaderWriter 		 m_socket;
+	std::unordered_map<unsigned int, TTimeAnnouncement> m_announcements;
 
 	void sendTime(unsigned int hour, unsigned int min);
+	std::vector<std::string> getWords(unsigned int hour, unsigned int min);
 
 	std::vector<std::string> sendTimeEnGB1(unsigned int hour, unsigned int min);
 	std::vector<std::string> sendTimeEnGB2(unsigned int hour, unsigned int min);
@@ -71,13 +81,14 @@ private:
 	std::vector<std::string> sendTimeNoNO(unsigned int hour, unsigned int min);
 	std::vector<std::string> sendTimePtPT(unsigned int hour, unsigned int min);
 
-	bool send(const std::vector<std::string>& words, unsigned int hour, unsigned int min);
-	bool sendHeader(CUDPReaderWriter& socket, const CHeaderData& header);
-	bool sendData(CUDPReaderWriter& socket, const CAMBEData& data);
+	void renderAnnouncements();
+	bool render(unsigned int hour, unsigned int min, TTimeAnnouncement& announcement);
+	bool send(TTimeAnnouncement& announcement);
+	bool sendPackets(const unsigned char* buffer, unsigned int length, unsigned int count);
 
 	bool loadAMBE();
 
 	bool lookup(const std::string& id);
 
-	void buildAudio(const std::vector<std::string>& words, CSlowDataEncoder& slowDataEncoder);
+	void buildAudio(const std::vector<std::string>& words, CSlowDataEncoder& slowDataEncoder, std::vector<unsigned char>& frames);
 };
@@ -17,6 +17,8 @@
  *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
  */
 
+#include <cstring>
+
 #include "DStarDefines.h"
 #include "VoiceStore.h"
 
@@ -65,56 +67,39 @@ CHeaderData* CVoiceStore::getHeader()
 	return header;
 }
 
-CAMBEData* CVoiceStore::getAMBE()
+bool CVoiceStore::getAMBE(unsigned char* data)
 {
-	DVTFR_TYPE type = m_file.read();
-	if (type == DVTFR_DATA) {
-		CAMBEData* ambe = m_file.readData();
-		if (ambe != NULL)
-			return ambe;
-	}
-
 	for (;;) {
+		DVTFR_TYPE type = m_file.read();
+
+		if (type == DVTFR_DATA) {
+			unsigned int length;
+			const unsigned char* ambe = m_file.getData(length);
+			if (length >= DV_FRAME_LENGTH_BYTES) {
+				::memcpy(data, ambe, DV_FRAME_LENGTH_BYTES);
+				return true;
+			}
+
+			continue;
+		}
+
+		// Throw away the headers of the following files
+		if (type == DVTFR_HEADER)
+			continue;
+
+		// The end of this file, move to the next one
 		m_file.close();
 		m_fileNumber++;
 
 		// The end of the last file?
-		if (m_fileNumber == m_filenames.size())
-			return NULL;
+		if (m_fileNumber >= m_filenames.size())
+			return false;
 
 		std::string filename = m_filenames.at(m_fileNumber);
 
 		bool ret = m_file.open(filename);
 		if (!ret)
-			return NULL;
-
-		// This should get the header
-		type = m_file.read();
-
-		if (type == DVTFR_HEADER) {
-			// Throw the header away
-			CHeaderData* header = m_file.readHeader();
-			delete header;
-		} else if (type == DVTFR_DATA) {
-			// Shouldn't usually happen
-			CAMBEData* ambe = m_file.readData();
-			if (ambe != NULL)
-				return ambe;
-			else
-				continue;
-		} else {
-			// !!!!
-			continue;
-		}
-
-		// This should get the first data record
-		type = m_file.read();
-
-		if (type == DVTFR_DATA) {
-			CAMBEData* ambe = m_file.readData();
-			if (ambe != NULL)
-				return ambe;
-		}
+			return false;
 	}
 }
 
@@ -25,7 +25,6 @@
 
 #include "DVTOOLFileReader.h"
 #include "HeaderData.h"
-#include "AMBEData.h"
 
 
 class CVoiceStore {
@@ -37,7 +36,8 @@ public:
 
 	CHeaderData* getHeader();
 
-	CAMBEData* getAMBE();
+	// Copies the next frame, DV_FRAME_LENGTH_BYTES, returns false after the last frame of the last file
+	bool getAMBE(unsigned char* data);
 
 	void close();
 
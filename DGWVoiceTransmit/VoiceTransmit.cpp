@@ -18,28 +18,60 @@
  */
 
 #include <cassert>
+#include <cstring>
 #include <boost/algorithm/string.hpp>
-#include <thread>
-#include <chrono>
+#include <sys/timerfd.h>
+#include <unistd.h>
 
 #include "ProgramArgs.h"
 #include "DStarDefines.h"
 #include "VoiceTransmit.h"
-#include "SlowDataEncoder.h"
+#include "VoiceTransmitDaemon.h"
+#include "AMBEData.h"
 #include "APRSUtils.h"
 #include "StringUtils.h"
+#include "Log.h"
+#include "LogConsoleTarget.h"
+
+const unsigned int G2_HEADER_LENGTH = 56U;
+const unsigned int G2_DATA_LENGTH   = 15U + DV_FRAME_LENGTH_BYTES;
+const unsigned int HEADER_REPEATS   = 2U;
 
 int main(int argc, const char * argv[])
 {
-	std::string repeater, text, dprs;
-	std::vector<std::string> filenames;
+	std::unordered_map<std::string, std::string> namedArgs;
+	std::vector<std::string> positionalArgs;
+
+	CProgramArgs::eatArguments(argc, argv, namedArgs, positionalArgs);
+
+	CHeaderData::initialise();
+
+	if (namedArgs.count("daemon") > 0U && positionalArgs.empty()) {
+		CLog::addTarget(new CLogConsoleTarget(LOG_INFO));
 
-	if (!parseCLIArgs(argc, argv, repeater, filenames, text, dprs)) {
-		::fprintf(stderr, "dgwvoicetransmit: invalid command line usage: dgwvoicetransmit [-text text] [-dprs dprs] <repeater> <file1> <file2> ..., exiting\n");
+		CVoiceTransmitDaemon daemon(namedArgs["daemon"]);
+		bool ret = daemon.run();
+
+		CLog::finalise();
+
+		return ret ? 0 : 1;
+	}
+
+	std::string text, dprs;
+	std::vector<std::string> repeaters, filenames;
+
+	if (!parseCLIArgs(argc, argv, repeaters, filenames, text, dprs)) {
+		::fprintf(stderr, "dgwvoicetransmit: invalid command line usage: dgwvoicetransmit [-text text] [-dprs dprs] [-submit socket] <repeater>[,<repeater>...] <file1> <file2> ..., or dgwvoicetransmit -daemon socket, exiting\n");
 		return 1;
 	}
 
-	CHeaderData::initialise();
+	if (namedArgs.count("submit") > 0U) {
+		bool ret = CVoiceTransmitDaemon::submit(namedArgs["submit"], repeaters, filenames, text, dprs);
+		if (!ret)
+			::fprintf(stderr, "dgwvoicetransmit: unable to submit the transmission to %s, exiting\n", namedArgs["submit"].c_str());
+
+		return ret ? 0 : 1;
+	}
 
 	CVoiceStore store(filenames);
 	bool opened = store.open();
@@ -48,7 +80,7 @@ int main(int argc, const char * argv[])
 		return 1;
 	}
 
-	CVoiceTransmit tt(repeater, &store, text, dprs);
+	CVoiceTransmit tt(repeaters, &store, text, dprs);
 	bool ret = tt.run();
 
 	store.close();
@@ -57,7 +89,7 @@ int main(int argc, const char * argv[])
 	return ret ? 0 : 1;
 }
 
-bool parseCLIArgs(int argc, const char * argv[], std::string& repeater, std::vector<std::string>& files, std::string& text, std::string& dprs)
+bool parseCLIArgs(int argc, const char * argv[], std::vector<std::string>& repeaters, std::vector<std::string>& files, std::string& text, std::string& dprs)
 {
 	if(argc < 3)
 		return false;
@@ -70,7 +102,17 @@ bool parseCLIArgs(int argc, const char * argv[], std::string& repeater, std::vec
 	if(positionalArgs.size() < 2U)
 		return false;
 
-	repeater.assign(boost::replace_all_copy(boost::to_upper_copy(positionalArgs[0]), "_", " "));
+	repeaters.clear();
+	std::vector<std::string> callsigns;
+	boost::split(callsigns, positionalArgs[0], boost::is_any_of(","));
+	for(auto& callsign : callsigns) {
+		if(!callsign.empty())
+			repeaters.push_back(boost::replace_all_copy(boost::to_upper_copy(callsign), "_", " "));
+	}
+
+	if(repeaters.empty())
+		return false;
+
 	files.assign(positionalArgs.begin() + 1, positionalArgs.end());
 
 	if(namedArgs.count("text") > 0U) {
@@ -81,10 +123,7 @@ bool parseCLIArgs(int argc, const char * argv[], std::string& repeater, std::vec
 	}
 
 	if(namedArgs.count("dprs") > 0U) {
-		std::string dprsRepeater(repeater);
-		CAPRSUtils::dstarCallsignToAPRS(dprsRepeater);
-		std::string dprsnoCrc = CStringUtils::string_format("%s>DPRS:%s\r", dprsRepeater.c_str(), namedArgs["dprs"].c_str());
-		dprs = CStringUtils::string_format("$$CRC%04X,%s", CAPRSUtils::calcGPSAIcomCRC(dprsnoCrc), dprsnoCrc.c_str());
+		dprs.assign(namedArgs["dprs"]);
 	}
 	else {
 		dprs.assign("");
@@ -93,14 +132,23 @@ bool parseCLIArgs(int argc, const char * argv[], std::string& repeater, std::vec
 	return true;
 }
 
-CVoiceTransmit::CVoiceTransmit(const std::string& callsign, CVoiceStore* store, const std::string& text, const std::string& dprs) :
-m_socket("", 0U),
-m_callsign(callsign),
+CVoiceTransmit::CVoiceTransmit(const std::vector<std::string>& callsigns, CVoiceStore* store, const std::string& text, const std::string& dprs) :
+m_callsigns(callsigns),
 m_text(text),
 m_dprs(dprs),
-m_store(store)
+m_store(store),
+m_address(),
+m_ids(),
+m_slowData(),
+m_packets(),
+m_seqNo(0U),
+m_slowDataPtr(0U),
+m_ended(false)
 {
 	assert(store != NULL);
+	assert(!callsigns.empty());
+
+	m_address = CUDPReaderWriter::lookup("127.0.0.1");
 }
 
 CVoiceTransmit::~CVoiceTransmit()
@@ -109,124 +157,164 @@ CVoiceTransmit::~CVoiceTransmit()
 
 bool CVoiceTransmit::run()
 {
-	CSlowDataEncoder * slowData = nullptr;
-	bool opened = m_socket.open();
+	CUDPReaderWriter socket("", 0U);
+	bool opened = socket.open();
 	if (!opened)
 		return false;
 
-	in_addr address = CUDPReaderWriter::lookup("127.0.0.1");
+	if (!start(socket)) {
+		socket.close();
+		return false;
+	}
+
+	int timerFd = ::timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+	if (timerFd < 0) {
+		socket.close();
+		return false;
+	}
+
+	// The first frame follows the headers by one frame time, then one frame every frame time
+	struct itimerspec period;
+	period.it_interval.tv_sec  = 0;
+	period.it_interval.tv_nsec = DSTAR_FRAME_TIME_MS * 1000000L;
+	period.it_value = period.it_interval;
+	::timerfd_settime(timerFd, 0, &period, nullptr);
+
+	bool ended = false;
+	while (!ended) {
+		uint64_t expirations;
+		ssize_t len = ::read(timerFd, &expirations, sizeof(expirations));
+		if (len != ssize_t(sizeof(expirations))) {
+			if (len < 0 && errno == EINTR)
+				continue;
+
+			break;
+		}
+
+		ended = clock(socket, expirations);
+	}
 
-	unsigned int id = CHeaderData::createId();
+	::close(timerFd);
+	socket.close();
 
-	std::string callsignG = m_callsign.substr(0U, LONG_CALLSIGN_LENGTH - 1U);
-	callsignG.push_back('G');
+	return ended;
+}
 
+bool CVoiceTransmit::start(CUDPReaderWriter& socket)
+{
 	CHeaderData* header = m_store->getHeader();
-	if (header == NULL) {
-		m_socket.close();
+	if (header == NULL)
 		return false;
-	}
 
-	header->setId(id);
-	header->setRptCall1(callsignG);
-	header->setRptCall2(m_callsign);
-	header->setDestination(address, G2_DV_PORT);
+	unsigned int repeaters = m_callsigns.size();
+	m_packets.resize(repeaters * G2_HEADER_LENGTH);
 
-	bool overrideSlowData = !m_text.empty();
+	bool overrideSlowData = !m_text.empty() || !m_dprs.empty();
 
-	if(overrideSlowData) {
-		slowData = new CSlowDataEncoder();
-		slowData->setHeaderData(*header);
-		if(!m_text.empty()) slowData->setTextData(m_text);
-		if(!m_dprs.empty()) slowData->setGPSData(m_dprs);
-	}
+	for (unsigned int i = 0U; i < repeaters; i++) {
+		std::string callsignG = m_callsigns[i].substr(0U, LONG_CALLSIGN_LENGTH - 1U);
+		callsignG.push_back('G');
+
+		unsigned int id = CHeaderData::createId();
+		m_ids.push_back(id);
 
-	sendHeader(header);
+		header->setId(id);
+		header->setRptCall1(callsignG);
+		header->setRptCall2(m_callsigns[i]);
+		header->setDestination(m_address, G2_DV_PORT);
+		header->getG2Data(m_packets.data() + i * G2_HEADER_LENGTH, G2_HEADER_LENGTH, true);
+
+		if (overrideSlowData) {
+			CSlowDataEncoder slowData;
+			slowData.setHeaderData(*header);
+			if(!m_text.empty()) slowData.setTextData(m_text);
+			if(!m_dprs.empty()) slowData.setGPSData(formatDPRS(m_callsigns[i], m_dprs));
+			m_slowData.push_back(slowData.getScrambledData());
+		}
+	}
 
 	delete header;
 
-	auto start = std::chrono::high_resolution_clock::now();
+	for (unsigned int i = 0U; i < HEADER_REPEATS; i++) {
+		if (!sendPackets(socket, G2_HEADER_LENGTH, repeaters))
+			return false;
+	}
 
-	unsigned int out   = 0U;
-	unsigned int seqNo = 0U;
-	bool loop = true;
+	m_seqNo = 0U;
+	m_slowDataPtr = 0U;
+	m_ended = false;
 
-	while (loop) {
-		unsigned int needed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start).count();
-		needed /= DSTAR_FRAME_TIME_MS;
+	return true;
+}
+
+bool CVoiceTransmit::clock(CUDPReaderWriter& socket, unsigned int frames)
+{
+	if (m_ended)
+		return true;
+
+	m_packets.clear();
+
+	// Catch up on the deadlines missed, if any, every frame of all the repeaters in one go
+	for (unsigned int i = 0U; i < frames && !m_ended; i++) {
 		unsigned char buffer[DV_FRAME_LENGTH_BYTES];
+		m_ended = !m_store->getAMBE(buffer);
 
-		while (out < needed) {
-			CAMBEData* ambe = m_store->getAMBE();
+		addFrame(m_ended ? END_PATTERN_BYTES : buffer, m_ended);
+	}
 
-			if (ambe == NULL) {
-				CAMBEData data;
-				data.setData(END_PATTERN_BYTES, DV_FRAME_LENGTH_BYTES);
-				data.setDestination(address, G2_DV_PORT);
-				data.setId(id);
-				data.setSeq(seqNo);
-				data.setEnd(true);
+	sendPackets(socket, G2_DATA_LENGTH, m_packets.size() / G2_DATA_LENGTH);
 
-				sendData(&data);
+	return m_ended;
+}
 
-				m_socket.close();
+void CVoiceTransmit::addFrame(const unsigned char* frame, bool end)
+{
+	unsigned int repeaters = m_callsigns.size();
+	size_t offset = m_packets.size();
+	m_packets.resize(offset + repeaters * G2_DATA_LENGTH);
+
+	CAMBEData data;
+	data.setSeq(m_seqNo);
+	data.setEnd(end);
+	data.setDestination(m_address, G2_DV_PORT);
 
-				loop = false;
-				break;
-			}
+	for (unsigned int i = 0U; i < repeaters; i++) {
+		unsigned char buffer[DV_FRAME_LENGTH_BYTES];
+		::memcpy(buffer, frame, DV_FRAME_LENGTH_BYTES);
 
-			ambe->getData(buffer, DV_FRAME_LENGTH_BYTES);
-			// Insert sync bytes when the sequence number is zero, slow data otherwise
-			if (seqNo == 0U) {
+		// Insert sync bytes when the sequence number is zero, slow data otherwise
+		if (!end) {
+			if (m_seqNo == 0U)
 				::memcpy(buffer + VOICE_FRAME_LENGTH_BYTES, DATA_SYNC_BYTES, DATA_FRAME_LENGTH_BYTES);
-			} else if (overrideSlowData) {
-				slowData->getInterleavedData(buffer + VOICE_FRAME_LENGTH_BYTES);
-			}
-			ambe->setData(buffer, DV_FRAME_LENGTH_BYTES);
-		
-			ambe->setSeq(seqNo);
-			ambe->setDestination(address, G2_DV_PORT);
-			ambe->setEnd(false);
-			ambe->setId(id);
-
-			sendData(ambe);
-			delete ambe;
-
-			out++;
-			seqNo++;
-			if(seqNo >= 21U) seqNo = 0U;
+			else if (!m_slowData.empty())
+				::memcpy(buffer + VOICE_FRAME_LENGTH_BYTES, m_slowData[i]->data() + m_slowDataPtr % m_slowData[i]->size(), DATA_FRAME_LENGTH_BYTES);
 		}
 
-		std::this_thread::sleep_for(std::chrono::milliseconds(10U));
+		data.setId(m_ids[i]);
+		data.setData(buffer, DV_FRAME_LENGTH_BYTES);
+		data.getG2Data(m_packets.data() + offset + i * G2_DATA_LENGTH, G2_DATA_LENGTH);
 	}
 
-	if(slowData != nullptr) delete slowData;
+	if (!end && m_seqNo != 0U)
+		m_slowDataPtr += DATA_FRAME_LENGTH_BYTES;
 
-	return true;
+	m_seqNo++;
+	if (m_seqNo >= 21U) m_seqNo = 0U;
 }
 
-bool CVoiceTransmit::sendHeader(CHeaderData* header)
+bool CVoiceTransmit::sendPackets(CUDPReaderWriter& socket, unsigned int length, unsigned int count)
 {
-	assert(header != NULL);
-
-	unsigned char buffer[60U];
-	unsigned int length = header->getG2Data(buffer, 60U, true);
+	if (count == 0U)
+		return true;
 
-	for (unsigned int i = 0U; i < 2U; i++) {
-		bool res = m_socket.write(buffer, length, header->getYourAddress(), header->getYourPort());
-		if (!res)
-			return false;
-	}
-
-	return true;
+	return socket.writeMany(m_packets.data(), length, count, m_address, G2_DV_PORT);
 }
 
-bool CVoiceTransmit::sendData(CAMBEData* data)
+std::string CVoiceTransmit::formatDPRS(const std::string& repeater, const std::string& dprs)
 {
-	assert(data != NULL);
-
-	unsigned char buffer[40U];
-	unsigned int length = data->getG2Data(buffer, 40U);
+	std::string dprsRepeater(repeater);
+	CAPRSUtils::dstarCallsignToAPRS(dprsRepeater);
+	std::string dprsnoCrc = CStringUtils::string_format("%s>DPRS:%s\r", dprsRepeater.c_str(), dprs.c_str());
 
-	return m_socket.write(buffer, length, data->getYourAddress(), data->getYourPort());
+	return CStringUtils::string_format("$$CRC%04X,%s", CAPRSUtils::calcGPSAIcomCRC(dprsnoCrc), dprsnoCrc.c_str());
 }
@@ -20,32 +20,47 @@
 #ifndef	VoiceTransmit_H
 #define	VoiceTransmit_H
 
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "UDPReaderWriter.h"
 #include "VoiceStore.h"
+#include "SlowDataEncoder.h"
 #include "HeaderData.h"
-#include "AMBEData.h"
 
-bool parseCLIArgs(int argc, const char * argv[], std::string& repeater, std::vector<std::string>& vector, std::string& text, std::string& dprs);
+bool parseCLIArgs(int argc, const char * argv[], std::vector<std::string>& repeaters, std::vector<std::string>& files, std::string& text, std::string& dprs);
 
+// Plays one set of files to one or more repeaters, every repeater gets the same frame in the same datagram batch
 class CVoiceTransmit {
 public:
-	CVoiceTransmit(const std::string& callsign, CVoiceStore* store, const std::string& text, const std::string& dprs);
+	CVoiceTransmit(const std::vector<std::string>& callsigns, CVoiceStore* store, const std::string& text, const std::string& dprs);
 	~CVoiceTransmit();
 
+	// Standalone transmission on its own socket, returns once the end of the transmission is sent
 	bool run();
 
+	// Sends the headers, then each clock sends the frames falling due, returns true once the end has been sent
+	bool start(CUDPReaderWriter& socket);
+	bool clock(CUDPReaderWriter& socket, unsigned int frames);
+
 private:
-	CUDPReaderWriter m_socket;
-	std::string         m_callsign;
-	std::string			m_text;
-	std::string			m_dprs;
-	CVoiceStore*        m_store;
-
-	bool sendHeader(CHeaderData* header);
-	bool sendData(CAMBEData* data);
+	std::vector<std::string>        m_callsigns;
+	std::string                     m_text;
+	std::string                     m_dprs;
+	CVoiceStore*                    m_store;
+	in_addr                         m_address;
+	std::vector<unsigned int>       m_ids;
+	std::vector<std::shared_ptr<const std::vector<unsigned char>>> m_slowData;
+	std::vector<unsigned char>      m_packets;
+	unsigned int                    m_seqNo;
+	unsigned int                    m_slowDataPtr;
+	bool                            m_ended;
+
+	void addFrame(const unsigned char* frame, bool end);
+	bool sendPackets(CUDPReaderWriter& socket, unsigned int length, unsigned int count);
+
+	static std::string formatDPRS(const std::string& repeater, const std::string& dprs);
 };
 
 #endif
@@ -0,0 +1,263 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <cstring>
+#include <algorithm>
+#include <filesystem>
+#include <boost/algorithm/string.hpp>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/timerfd.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include "VoiceTransmitDaemon.h"
+#include "DStarDefines.h"
+#include "Log.h"
+
+// A job is one datagram of NUL separated fields: repeaters (comma separated), text, dprs, then the files
+const unsigned int MAX_JOB_LENGTH = 8192U;
+const unsigned int JOB_FIXED_FIELDS = 3U;
+
+volatile sig_atomic_t CVoiceTransmitDaemon::m_killed = 0;
+
+CVoiceTransmitDaemon::CVoiceTransmitDaemon(const std::string& socketPath) :
+m_socketPath(socketPath),
+m_jobFd(-1),
+m_timerFd(-1),
+m_socket("", 0U),
+m_jobs()
+{
+}
+
+CVoiceTransmitDaemon::~CVoiceTransmitDaemon()
+{
+	for (auto& job : m_jobs)
+		deleteJob(job);
+
+	m_jobs.clear();
+}
+
+bool CVoiceTransmitDaemon::run()
+{
+	struct sockaddr_un addr;
+	::memset(&addr, 0, sizeof(addr));
+	if (m_socketPath.empty() || m_socketPath.length() >= sizeof(addr.sun_path)) {
+		CLog::logError("Invalid job socket path \"%s\"", m_socketPath.c_str());
+		return false;
+	}
+
+	addr.sun_family = AF_UNIX;
+	::strncpy(addr.sun_path, m_socketPath.c_str(), sizeof(addr.sun_path) - 1U);
+
+	m_jobFd = ::socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+	if (m_jobFd < 0) {
+		CLog::logError("Cannot create the job socket, err=%d", errno);
+		return false;
+	}
+
+	::unlink(m_socketPath.c_str());
+	if (::bind(m_jobFd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+		CLog::logError("Cannot bind the job socket to %s, err=%d", m_socketPath.c_str(), errno);
+		::close(m_jobFd);
+		return false;
+	}
+
+	m_timerFd = ::timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+	if (m_timerFd < 0 || !m_socket.open()) {
+		CLog::logError("Cannot create the transmit timer or socket");
+		if (m_timerFd >= 0)
+			::close(m_timerFd);
+		::close(m_jobFd);
+		::unlink(m_socketPath.c_str());
+		return false;
+	}
+
+	::signal(SIGTERM, sigHandler);
+	::signal(SIGINT, sigHandler);
+
+	CLog::logInfo("Waiting for transmissions on %s", m_socketPath.c_str());
+
+	while (m_killed == 0) {
+		struct pollfd fds[2];
+		fds[0].fd = m_jobFd;
+		fds[0].events = POLLIN;
+		fds[1].fd = m_timerFd;
+		fds[1].events = POLLIN;
+
+		int ret = ::poll(fds, 2, -1);
+		if (ret < 0) {
+			if (errno == EINTR)
+				continue;
+
+			CLog::logError("Error returned from poll, err=%d", errno);
+			break;
+		}
+
+		// Frames first, a new job only ever sends headers
+		if ((fds[1].revents & POLLIN) != 0) {
+			uint64_t expirations;
+			if (::read(m_timerFd, &expirations, sizeof(expirations)) == ssize_t(sizeof(expirations)))
+				clock(expirations);
+		}
+
+		if ((fds[0].revents & POLLIN) != 0)
+			readJob();
+	}
+
+	CLog::logInfo("Stopping, %u transmission(s) interrupted", (unsigned int)m_jobs.size());
+
+	m_socket.close();
+	::close(m_timerFd);
+	::close(m_jobFd);
+	::unlink(m_socketPath.c_str());
+
+	return true;
+}
+
+void CVoiceTransmitDaemon::readJob()
+{
+	char buffer[MAX_JOB_LENGTH];
+	ssize_t len = ::recv(m_jobFd, buffer, MAX_JOB_LENGTH, 0);
+	if (len <= 0)
+		return;
+
+	std::vector<std::string> fields;
+	for (const char* p = buffer; p < buffer + len; p += ::strnlen(p, buffer + len - p) + 1U)
+		fields.push_back(std::string(p, ::strnlen(p, buffer + len - p)));
+
+	if (fields.size() <= JOB_FIXED_FIELDS) {
+		CLog::logWarning("Ignoring an invalid transmission request of %d bytes", (int)len);
+		return;
+	}
+
+	std::vector<std::string> repeaters;
+	boost::split(repeaters, fields[0], boost::is_any_of(","));
+	repeaters.erase(std::remove(repeaters.begin(), repeaters.end(), ""), repeaters.end());
+	if (repeaters.empty()) {
+		CLog::logWarning("Ignoring a transmission request without repeater");
+		return;
+	}
+
+	std::vector<std::string> files(fields.begin() + JOB_FIXED_FIELDS, fields.end());
+
+	TVoiceJob job;
+	job.store = new CVoiceStore(files);
+	job.transmit = NULL;
+
+	if (!job.store->open()) {
+		CLog::logWarning("Unable to open %s", files[0].c_str());
+		deleteJob(job);
+		return;
+	}
+
+	job.transmit = new CVoiceTransmit(repeaters, job.store, fields[1], fields[2]);
+	if (!job.transmit->start(m_socket)) {
+		CLog::logWarning("Unable to start the transmission of %s", files[0].c_str());
+		deleteJob(job);
+		return;
+	}
+
+	CLog::logInfo("Transmitting %s to %s", files[0].c_str(), fields[0].c_str());
+
+	if (m_jobs.empty())
+		setTimer(true);
+
+	m_jobs.push_back(job);
+}
+
+void CVoiceTransmitDaemon::clock(unsigned int frames)
+{
+	for (auto it = m_jobs.begin(); it != m_jobs.end();) {
+		if (it->transmit->clock(m_socket, frames)) {
+			deleteJob(*it);
+			it = m_jobs.erase(it);
+		} else {
+			it++;
+		}
+	}
+
+	// No need to wake up every frame time when idle
+	if (m_jobs.empty())
+		setTimer(false);
+}
+
+void CVoiceTransmitDaemon::setTimer(bool running)
+{
+	struct itimerspec period;
+	::memset(&period, 0, sizeof(period));
+
+	if (running) {
+		period.it_interval.tv_nsec = DSTAR_FRAME_TIME_MS * 1000000L;
+		period.it_value = period.it_interval;
+	}
+
+	::timerfd_settime(m_timerFd, 0, &period, nullptr);
+}
+
+void CVoiceTransmitDaemon::deleteJob(TVoiceJob& job)
+{
+	delete job.transmit;
+
+	if (job.store != NULL)
+		job.store->close();
+	delete job.store;
+
+	job.transmit = NULL;
+	job.store = NULL;
+}
+
+bool CVoiceTransmitDaemon::submit(const std::string& socketPath, const std::vector<std::string>& repeaters, const std::vector<std::string>& files, const std::string& text, const std::string& dprs)
+{
+	struct sockaddr_un addr;
+	::memset(&addr, 0, sizeof(addr));
+	if (socketPath.empty() || socketPath.length() >= sizeof(addr.sun_path))
+		return false;
+
+	addr.sun_family = AF_UNIX;
+	::strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1U);
+
+	std::string job = boost::join(repeaters, ",");
+	job.push_back('\0');
+	job.append(text);
+	job.push_back('\0');
+	job.append(dprs);
+
+	// The daemon does not share our working directory
+	for (auto& file : files) {
+		job.push_back('\0');
+		job.append(std::filesystem::absolute(file).string());
+	}
+
+	if (job.length() > MAX_JOB_LENGTH)
+		return false;
+
+	int fd = ::socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+	if (fd < 0)
+		return false;
+
+	ssize_t len = ::sendto(fd, job.data(), job.length(), 0, (struct sockaddr*)&addr, sizeof(addr));
+	::close(fd);
+
+	return len == ssize_t(job.length());
+}
+
+void CVoiceTransmitDaemon::sigHandler(int)
+{
+	m_killed = 1;
+}
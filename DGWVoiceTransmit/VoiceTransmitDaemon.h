@@ -0,0 +1,61 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <list>
+#include <csignal>
+
+#include "UDPReaderWriter.h"
+#include "VoiceStore.h"
+#include "VoiceTransmit.h"
+
+typedef struct {
+	CVoiceStore*    store;
+	CVoiceTransmit* transmit;
+} TVoiceJob;
+
+// Long lived player, transmissions are submitted as datagrams on a local socket and all of them
+// are paced by the same timer and sent from the same socket
+class CVoiceTransmitDaemon {
+public:
+	CVoiceTransmitDaemon(const std::string& socketPath);
+	~CVoiceTransmitDaemon();
+
+	bool run();
+
+	static bool submit(const std::string& socketPath, const std::vector<std::string>& repeaters, const std::vector<std::string>& files, const std::string& text, const std::string& dprs);
+
+private:
+	std::string          m_socketPath;
+	int                  m_jobFd;
+	int                  m_timerFd;
+	CUDPReaderWriter     m_socket;
+	std::list<TVoiceJob> m_jobs;
+
+	static volatile sig_atomic_t m_killed;
+
+	void readJob();
+	void clock(unsigned int frames);
+	void setTimer(bool running);
+	void deleteJob(TVoiceJob& job);
+
+	static void sigHandler(int sig);
+};
@@ -39,7 +39,9 @@ m_yourPort(0U),
 m_myPort(0U),
 m_errors(0U),
 m_text(),
-m_header()
+m_header(),
+m_ingressTime(0U),
+m_ingressEndpoint(FE_NONE)
 {
 	m_data = new unsigned char[DV_FRAME_LENGTH_BYTES];
 }
@@ -57,7 +59,9 @@ m_yourPort(data.m_yourPort),
 m_myPort(data.m_myPort),
 m_errors(data.m_errors),
 m_text(data.m_text),
-m_header(data.m_header)
+m_header(data.m_header),
+m_ingressTime(data.m_ingressTime),
+m_ingressEndpoint(data.m_ingressEndpoint)
 {
 	m_data = new unsigned char[DV_FRAME_LENGTH_BYTES];
 	::memcpy(m_data, data.m_data, DV_FRAME_LENGTH_BYTES);
@@ -292,7 +296,7 @@ unsigned int CAMBEData::getHBRepeaterData(unsigned char *data, unsigned int leng
 unsigned int CAMBEData::getG2Data(unsigned char *data, unsigned int length) const
 {
 	assert(data != NULL);
-	assert(length >= 30U);
+	assert(length >= 15U + DV_FRAME_LENGTH_BYTES);
 
 	data[0] = 'D';
 	data[1] = 'S';
@@ -622,6 +626,24 @@ unsigned int CAMBEData::getData(unsigned char *data, unsigned int length) const
 	return DV_FRAME_LENGTH_BYTES;
 }
 
+void CAMBEData::setIngress(uint64_t time, FRAME_ENDPOINT endpoint)
+{
+	m_ingressTime     = time;
+	m_ingressEndpoint = endpoint;
+
+	m_header.setIngress(time, endpoint);
+}
+
+uint64_t CAMBEData::getIngressTime() const
+{
+	return m_ingressTime;
+}
+
+FRAME_ENDPOINT CAMBEData::getIngressEndpoint() const
+{
+	return m_ingressEndpoint;
+}
+
 CAMBEData& CAMBEData::operator=(const CAMBEData& data)
 {
 	if (&data != this) {
@@ -637,6 +659,8 @@ CAMBEData& CAMBEData::operator=(const CAMBEData& data)
 		m_errors      = data.m_errors;
 		m_text        = data.m_text;
 		m_header      = data.m_header;
+		m_ingressTime     = data.m_ingressTime;
+		m_ingressEndpoint = data.m_ingressEndpoint;
 
 		::memcpy(m_data, data.m_data, DV_FRAME_LENGTH_BYTES);
 	}
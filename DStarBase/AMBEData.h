@@ -82,6 +82,11 @@ public:
 
 	unsigned int getErrors() const;
 
+	// Also stamps the embedded header so that headers rebuilt from DCS data keep their ingress time
+	void setIngress(uint64_t time, FRAME_ENDPOINT endpoint);
+	uint64_t getIngressTime() const;
+	FRAME_ENDPOINT getIngressEndpoint() const;
+
 	CHeaderData& getHeader();
 
 	CAMBEData& operator=(const CAMBEData& data);
@@ -100,4 +105,6 @@ private:
 	unsigned int   m_errors;
 	std::string       m_text;
 	CHeaderData    m_header;
+	uint64_t       m_ingressTime;
+	FRAME_ENDPOINT m_ingressEndpoint;
 };
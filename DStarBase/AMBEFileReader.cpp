@@ -31,7 +31,8 @@ m_indexFile(indexFile),
 m_ambeFile(ambeFile),
 m_ambe(nullptr),
 m_ambeLength(0U),
-m_index()
+m_index(),
+m_store()
 {
 
 }
@@ -44,11 +45,55 @@ CAMBEFileReader::~CAMBEFileReader()
 }
 
 bool CAMBEFileReader::read()
+{
+	if (readCompiled())
+		return true;
+
+	return readSource();
+}
+
+bool CAMBEFileReader::readSource()
 {
     bool ret = readAmbe() && readIndex();
     return ret;
 }
 
+std::string CAMBEFileReader::getCompiledFileName(const std::string& ambeFile)
+{
+	std::string::size_type pos = ambeFile.rfind('.');
+	if (pos == std::string::npos || ambeFile.find('/', pos) != std::string::npos)
+		return ambeFile + ".ambx";
+
+	return ambeFile.substr(0U, pos) + ".ambx";
+}
+
+bool CAMBEFileReader::readCompiled()
+{
+	std::string compiledFile = getCompiledFileName(m_ambeFile);
+
+	struct stat compiled;
+	if (::stat(compiledFile.c_str(), &compiled) != 0)
+		return false;
+
+	// A source edited after the compilation wins, it will be picked up again once recompiled
+	struct stat source;
+	if ((::stat(m_ambeFile.c_str(), &source) == 0 && source.st_mtime > compiled.st_mtime)
+	 || (::stat(m_indexFile.c_str(), &source) == 0 && source.st_mtime > compiled.st_mtime)) {
+		CLog::logWarning("%s is older than its sources, ignoring it", compiledFile.c_str());
+		return false;
+	}
+
+	return m_store.open(compiledFile);
+}
+
+bool CAMBEFileReader::compile(const std::string& fileName) const
+{
+	if (m_ambe == nullptr)
+		return false;
+
+	return CAMBEVoiceStore::write(fileName, m_index, m_ambe, m_ambeLength + SILENCE_LENGTH);
+}
+
 bool CAMBEFileReader::readAmbe()
 {
     struct stat sbuf;
@@ -125,7 +170,7 @@ bool CAMBEFileReader::readIndex()
 	}
 
 	// Add a silence entry at the beginning
-	m_index[" "] = new CIndexRecord(" ", 0, SILENCE_LENGTH);
+	m_index[" "] = std::make_pair(0U, SILENCE_LENGTH);
 
 	CLog::logInfo("Reading %s\n", m_indexFile.c_str());
 
@@ -144,7 +189,7 @@ bool CAMBEFileReader::readIndex()
 				if (start >= m_ambeLength || (start + length) >= m_ambeLength)
 					CLog::logInfo("The start or end for *%s* is out of range, start: %lu, end: %lu\n", name.c_str(), start, start + length);
 				else
-					m_index[name] = new CIndexRecord(name, start + SILENCE_LENGTH, length);
+					m_index[name] = std::make_pair(start + SILENCE_LENGTH, length);
 			}
 		}
 	}
@@ -154,19 +199,32 @@ bool CAMBEFileReader::readIndex()
 	return true;
 }
 
+bool CAMBEFileReader::lookup(const std::string &id, const unsigned char*& voice, unsigned int& frames) const
+{
+	if (m_store.isOpen())
+		return m_store.lookup(id, voice, frames);
+
+	auto it = m_index.find(id);
+	if (it == m_index.end())
+		return false;
+
+	voice = m_ambe + it->second.first * VOICE_FRAME_LENGTH_BYTES;
+	frames = it->second.second;
+
+	return true;
+}
+
 bool CAMBEFileReader::lookup(const std::string &id, std::vector<CAMBEData *>& data)
 {
-	if(m_index.count(id) == 0U) {
+	const unsigned char* voice;
+	unsigned int length;
+	if(!lookup(id, voice, length)) {
 		CLog::logError("Cannot find the AMBE index for *%s*", id.c_str());
 		return false;
 	}
 
-	CIndexRecord* info = m_index[id];
-	unsigned int  start = info->getStart();
-	unsigned int length = info->getLength();
-
 	for (unsigned int i = 0U; i < length; i++) {
-		unsigned char* dataIn = m_ambe + (start + i) * VOICE_FRAME_LENGTH_BYTES;
+		const unsigned char* dataIn = voice + i * VOICE_FRAME_LENGTH_BYTES;
 		unsigned char buffer[DV_FRAME_LENGTH_BYTES];
 		::memcpy(buffer + 0U, dataIn, VOICE_FRAME_LENGTH_BYTES);
 
@@ -176,4 +234,18 @@ bool CAMBEFileReader::lookup(const std::string &id, std::vector<CAMBEData *>& da
 	}
 
 	return true;
-}
\ No newline at end of file
+}
+
+bool CAMBEFileReader::lookup(const std::string &id, std::vector<unsigned char>& voice)
+{
+	const unsigned char* dataIn;
+	unsigned int length;
+	if(!lookup(id, dataIn, length)) {
+		CLog::logError("Cannot find the AMBE index for *%s*", id.c_str());
+		return false;
+	}
+
+	voice.insert(voice.end(), dataIn, dataIn + length * VOICE_FRAME_LENGTH_BYTES);
+
+	return true;
+}
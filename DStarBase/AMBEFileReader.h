@@ -19,50 +19,32 @@
 #pragma once
 
 #include <string>
-#include <unordered_map>
+#include <map>
+#include <utility>
 #include <vector>
 
 #include "AMBEData.h"
-
-class CIndexRecord {
-public:
-	CIndexRecord(const std::string& name, unsigned int start, unsigned int length) :
-	m_name(name),
-	m_start(start),
-	m_length(length)
-	{
-	}
-
-	std::string getName() const
-	{
-		return m_name;
-	}
-
-	unsigned int getStart() const
-	{
-		return m_start;
-	}
-
-	unsigned int getLength() const
-	{
-		return m_length;
-	}
-
-private:
-	std::string     m_name;
-	unsigned int m_start;
-	unsigned int m_length;
-};
+#include "AMBEVoiceStore.h"
 
 class CAMBEFileReader
 {
 public:
     CAMBEFileReader(const std::string& indexFile, const std::string& ambeFile);
     ~CAMBEFileReader();
+    // Maps the compiled voice file when it is at least as recent as the sources, parses the sources otherwise
     bool read();
+    bool readSource();
+    bool compile(const std::string& fileName) const;
     bool lookup(const std::string &id, std::vector<CAMBEData *>& data);
+    // Appends the raw voice frames, VOICE_FRAME_LENGTH_BYTES each
+    bool lookup(const std::string &id, std::vector<unsigned char>& voice);
+    // voice points at frames * VOICE_FRAME_LENGTH_BYTES owned by the reader
+    bool lookup(const std::string &id, const unsigned char*& voice, unsigned int& frames) const;
+
+    static std::string getCompiledFileName(const std::string& ambeFile);
 
 private:
+    bool readCompiled();
     bool readAmbe();
     bool readIndex();
 
@@ -70,5 +52,6 @@ private:
     std::string      m_ambeFile;
     unsigned char*   m_ambe;
     unsigned int     m_ambeLength;
-    std::unordered_map<std::string, CIndexRecord*> m_index;
-};
\ No newline at end of file
+    std::map<std::string, std::pair<unsigned int, unsigned int>> m_index;
+    CAMBEVoiceStore  m_store;
+};
@@ -0,0 +1,220 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <endian.h>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include "AMBEVoiceStore.h"
+#include "DStarDefines.h"
+#include "Log.h"
+
+const unsigned int AMBX_VERSION = 1U;
+const unsigned int AMBX_HEADER_LENGTH = 24U;
+const unsigned int AMBX_ENTRY_LENGTH = 16U;
+
+static unsigned int getUInt32(const unsigned char* p)
+{
+	uint32_t value;
+	::memcpy(&value, p, sizeof(value));
+	return le32toh(value);
+}
+
+static void putUInt32(std::vector<unsigned char>& buffer, unsigned int value)
+{
+	uint32_t le = htole32(value);
+	const unsigned char* p = (const unsigned char*)&le;
+	buffer.insert(buffer.end(), p, p + sizeof(le));
+}
+
+CAMBEVoiceStore::CAMBEVoiceStore() :
+m_map(nullptr),
+m_mapLength(0U),
+m_count(0U),
+m_entries(nullptr),
+m_names(nullptr),
+m_voice(nullptr),
+m_frames(0U)
+{
+}
+
+CAMBEVoiceStore::~CAMBEVoiceStore()
+{
+	close();
+}
+
+bool CAMBEVoiceStore::open(const std::string& fileName)
+{
+	close();
+
+	int fd = ::open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		CLog::logError("Cannot open %s for reading", fileName.c_str());
+		return false;
+	}
+
+	struct stat sbuf;
+	if (::fstat(fd, &sbuf) != 0 || sbuf.st_size < (off_t)AMBX_HEADER_LENGTH) {
+		CLog::logError("%s is too short to be a voice file", fileName.c_str());
+		::close(fd);
+		return false;
+	}
+
+	void* map = ::mmap(nullptr, sbuf.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (map == MAP_FAILED) {
+		CLog::logError("Cannot map %s, err=%d", fileName.c_str(), errno);
+		return false;
+	}
+
+	m_map = (unsigned char*)map;
+	m_mapLength = sbuf.st_size;
+
+	unsigned int count = getUInt32(m_map + 8U);
+	unsigned int namesOffset = getUInt32(m_map + 12U);
+	unsigned int voiceOffset = getUInt32(m_map + 16U);
+	unsigned int frames = getUInt32(m_map + 20U);
+
+	bool valid = ::memcmp(m_map, "AMBX", 4U) == 0 && getUInt32(m_map + 4U) == AMBX_VERSION
+		&& AMBX_HEADER_LENGTH + (size_t)count * AMBX_ENTRY_LENGTH <= namesOffset
+		&& namesOffset <= voiceOffset
+		&& voiceOffset + (size_t)frames * VOICE_FRAME_LENGTH_BYTES <= m_mapLength;
+
+	// Check once here so lookups can trust the table
+	for (unsigned int i = 0U; valid && i < count; i++) {
+		const unsigned char* entry = m_map + AMBX_HEADER_LENGTH + i * AMBX_ENTRY_LENGTH;
+		valid = (size_t)namesOffset + getUInt32(entry) + getUInt32(entry + 4U) <= voiceOffset
+			&& (size_t)getUInt32(entry + 8U) + getUInt32(entry + 12U) <= frames;
+	}
+
+	if (!valid) {
+		CLog::logError("%s is not a valid voice file", fileName.c_str());
+		close();
+		return false;
+	}
+
+	m_count = count;
+	m_entries = m_map + AMBX_HEADER_LENGTH;
+	m_names = (const char*)m_map + namesOffset;
+	m_voice = m_map + voiceOffset;
+	m_frames = frames;
+
+	CLog::logInfo("Mapped %s, %u entries", fileName.c_str(), m_count);
+
+	return true;
+}
+
+void CAMBEVoiceStore::close()
+{
+	if (m_map != nullptr)
+		::munmap(m_map, m_mapLength);
+
+	m_map = nullptr;
+	m_mapLength = 0U;
+	m_count = 0U;
+	m_entries = nullptr;
+	m_names = nullptr;
+	m_voice = nullptr;
+	m_frames = 0U;
+}
+
+bool CAMBEVoiceStore::isOpen() const
+{
+	return m_map != nullptr;
+}
+
+bool CAMBEVoiceStore::lookup(const std::string& id, const unsigned char*& voice, unsigned int& frames) const
+{
+	unsigned int low = 0U, high = m_count;
+	while (low < high) {
+		unsigned int mid = low + (high - low) / 2U;
+		const unsigned char* entry = m_entries + mid * AMBX_ENTRY_LENGTH;
+		std::string_view name(m_names + getUInt32(entry), getUInt32(entry + 4U));
+
+		int cmp = name.compare(id);
+		if (cmp == 0) {
+			voice = m_voice + getUInt32(entry + 8U) * VOICE_FRAME_LENGTH_BYTES;
+			frames = getUInt32(entry + 12U);
+			return true;
+		}
+
+		if (cmp < 0)
+			low = mid + 1U;
+		else
+			high = mid;
+	}
+
+	return false;
+}
+
+unsigned int CAMBEVoiceStore::getEntryCount() const
+{
+	return m_count;
+}
+
+bool CAMBEVoiceStore::write(const std::string& fileName, const std::map<std::string, std::pair<unsigned int, unsigned int>>& index, const unsigned char* voice, unsigned int frames)
+{
+	std::vector<unsigned char> table;
+	std::string names;
+	for (const auto& entry : index) {
+		putUInt32(table, names.length());
+		putUInt32(table, entry.first.length());
+		putUInt32(table, entry.second.first);
+		putUInt32(table, entry.second.second);
+		names.append(entry.first);
+	}
+
+	unsigned int namesOffset = AMBX_HEADER_LENGTH + table.size();
+	unsigned int voiceOffset = namesOffset + names.length();
+
+	std::vector<unsigned char> header;
+	header.insert(header.end(), { 'A', 'M', 'B', 'X' });
+	putUInt32(header, AMBX_VERSION);
+	putUInt32(header, index.size());
+	putUInt32(header, namesOffset);
+	putUInt32(header, voiceOffset);
+	putUInt32(header, frames);
+
+	// Write aside and rename, a running gateway keeps its mapping of the old file
+	std::string tempName = fileName + ".tmp";
+	FILE* file = ::fopen(tempName.c_str(), "wb");
+	if (file == nullptr) {
+		CLog::logError("Cannot open %s for writing", tempName.c_str());
+		return false;
+	}
+
+	bool ok = ::fwrite(header.data(), 1U, header.size(), file) == header.size()
+		&& (table.empty() || ::fwrite(table.data(), 1U, table.size(), file) == table.size())
+		&& (names.empty() || ::fwrite(names.data(), 1U, names.length(), file) == names.length())
+		&& (frames == 0U || ::fwrite(voice, VOICE_FRAME_LENGTH_BYTES, frames, file) == frames);
+	ok = ::fclose(file) == 0 && ok;
+
+	if (!ok || ::rename(tempName.c_str(), fileName.c_str()) != 0) {
+		CLog::logError("Cannot write %s", fileName.c_str());
+		::unlink(tempName.c_str());
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,56 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <string>
+#include <map>
+#include <utility>
+
+// Compiled voice file, mapped read-only so every process using it shares the same pages.
+// Layout, all numbers little endian 32 bits:
+//   header  "AMBX", version, entry count, names offset, voice offset, voice frame count
+//   entries name offset (from names offset), name length, start frame, frame count, sorted by name
+//   names   the entry names, back to back
+//   voice   VOICE_FRAME_LENGTH_BYTES per frame
+class CAMBEVoiceStore
+{
+public:
+	CAMBEVoiceStore();
+	~CAMBEVoiceStore();
+
+	bool open(const std::string& fileName);
+	void close();
+	bool isOpen() const;
+
+	// voice points into the mapped file and stays valid until the store is closed
+	bool lookup(const std::string& id, const unsigned char*& voice, unsigned int& frames) const;
+	unsigned int getEntryCount() const;
+
+	// index maps each name to its start frame and frame count in voice
+	static bool write(const std::string& fileName, const std::map<std::string, std::pair<unsigned int, unsigned int>>& index, const unsigned char* voice, unsigned int frames);
+
+private:
+	unsigned char* m_map;
+	size_t         m_mapLength;
+	unsigned int   m_count;
+	const unsigned char* m_entries;
+	const char*    m_names;
+	const unsigned char* m_voice;
+	unsigned int   m_frames;
+};
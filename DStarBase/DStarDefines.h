@@ -150,6 +150,14 @@ enum AUDIO_SOURCE {
 	AS_CCS
 };
 
+// Where a frame entered or leaves the gateway, used for latency tracing
+enum FRAME_ENDPOINT {
+	FE_NONE,
+	FE_REPEATER,
+	FE_REFLECTOR,
+	FE_G2
+};
+
 enum DSTAR_RX_STATE {
 	DSRXS_LISTENING,
 	DSRXS_PROCESS_HEADER,
@@ -20,28 +20,71 @@
  */
 
 #include <cstdio>
+#include <cstdint>
+#include <array>
+
 #include "DTMF.h"
 
-const unsigned char DTMF_MASK[] = {0x82U, 0x08U, 0x20U, 0x82U, 0x00U, 0x00U, 0x82U, 0x00U, 0x00U};
-const unsigned char DTMF_SIG[]  = {0x82U, 0x08U, 0x20U, 0x82U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U};
-
-const unsigned char DTMF_SYM_MASK[] = {0x10U, 0x40U, 0x08U, 0x20U};
-const unsigned char DTMF_SYM0[]     = {0x00U, 0x40U, 0x08U, 0x20U};
-const unsigned char DTMF_SYM1[]     = {0x00U, 0x00U, 0x00U, 0x00U};
-const unsigned char DTMF_SYM2[]     = {0x00U, 0x40U, 0x00U, 0x00U};
-const unsigned char DTMF_SYM3[]     = {0x10U, 0x00U, 0x00U, 0x00U};
-const unsigned char DTMF_SYM4[]     = {0x00U, 0x00U, 0x00U, 0x20U};
-const unsigned char DTMF_SYM5[]     = {0x00U, 0x40U, 0x00U, 0x20U};
-const unsigned char DTMF_SYM6[]     = {0x10U, 0x00U, 0x00U, 0x20U};
-const unsigned char DTMF_SYM7[]     = {0x00U, 0x00U, 0x08U, 0x00U};
-const unsigned char DTMF_SYM8[]     = {0x00U, 0x40U, 0x08U, 0x00U};
-const unsigned char DTMF_SYM9[]     = {0x10U, 0x00U, 0x08U, 0x00U};
-const unsigned char DTMF_SYMA[]     = {0x10U, 0x40U, 0x00U, 0x00U};
-const unsigned char DTMF_SYMB[]     = {0x10U, 0x40U, 0x00U, 0x20U};
-const unsigned char DTMF_SYMC[]     = {0x10U, 0x40U, 0x08U, 0x00U};
-const unsigned char DTMF_SYMD[]     = {0x10U, 0x40U, 0x08U, 0x20U};
-const unsigned char DTMF_SYMS[]     = {0x00U, 0x00U, 0x08U, 0x20U};
-const unsigned char DTMF_SYMH[]     = {0x10U, 0x00U, 0x08U, 0x20U};
+constexpr unsigned char DTMF_MASK[] = {0x82U, 0x08U, 0x20U, 0x82U, 0x00U, 0x00U, 0x82U, 0x00U, 0x00U};
+constexpr unsigned char DTMF_SIG[]  = {0x82U, 0x08U, 0x20U, 0x82U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U};
+
+constexpr unsigned char DTMF_SYM_MASK[] = {0x10U, 0x40U, 0x08U, 0x20U};
+constexpr unsigned char DTMF_SYM0[]     = {0x00U, 0x40U, 0x08U, 0x20U};
+constexpr unsigned char DTMF_SYM1[]     = {0x00U, 0x00U, 0x00U, 0x00U};
+constexpr unsigned char DTMF_SYM2[]     = {0x00U, 0x40U, 0x00U, 0x00U};
+constexpr unsigned char DTMF_SYM3[]     = {0x10U, 0x00U, 0x00U, 0x00U};
+constexpr unsigned char DTMF_SYM4[]     = {0x00U, 0x00U, 0x00U, 0x20U};
+constexpr unsigned char DTMF_SYM5[]     = {0x00U, 0x40U, 0x00U, 0x20U};
+constexpr unsigned char DTMF_SYM6[]     = {0x10U, 0x00U, 0x00U, 0x20U};
+constexpr unsigned char DTMF_SYM7[]     = {0x00U, 0x00U, 0x08U, 0x00U};
+constexpr unsigned char DTMF_SYM8[]     = {0x00U, 0x40U, 0x08U, 0x00U};
+constexpr unsigned char DTMF_SYM9[]     = {0x10U, 0x00U, 0x08U, 0x00U};
+constexpr unsigned char DTMF_SYMA[]     = {0x10U, 0x40U, 0x00U, 0x00U};
+constexpr unsigned char DTMF_SYMB[]     = {0x10U, 0x40U, 0x00U, 0x20U};
+constexpr unsigned char DTMF_SYMC[]     = {0x10U, 0x40U, 0x08U, 0x00U};
+constexpr unsigned char DTMF_SYMD[]     = {0x10U, 0x40U, 0x08U, 0x20U};
+constexpr unsigned char DTMF_SYMS[]     = {0x00U, 0x00U, 0x08U, 0x20U};
+constexpr unsigned char DTMF_SYMH[]     = {0x10U, 0x00U, 0x08U, 0x20U};
+
+// The symbol bytes 4, 5, 7 and 8 take no part in the signature, only bytes 0 to 3 and 6 do
+static_assert(DTMF_MASK[4] == 0U && DTMF_MASK[5] == 0U && DTMF_MASK[7] == 0U && DTMF_MASK[8] == 0U, "DTMF signature overlaps the symbols");
+
+// The four symbol bits sit at distinct positions, OR-ed together they form a 4 bit index
+static_assert((DTMF_SYM_MASK[0] | DTMF_SYM_MASK[1] | DTMF_SYM_MASK[2] | DTMF_SYM_MASK[3]) == 0x78U, "DTMF symbol bits do not pack into bits 3 to 6");
+
+constexpr uint32_t pack(const unsigned char* bytes)
+{
+	return uint32_t(bytes[0]) | (uint32_t(bytes[1]) << 8) | (uint32_t(bytes[2]) << 16) | (uint32_t(bytes[3]) << 24);
+}
+
+constexpr uint32_t DTMF_MASK_PACKED = pack(DTMF_MASK);
+constexpr uint32_t DTMF_SIG_PACKED  = pack(DTMF_SIG);
+
+constexpr unsigned int symbolIndex(unsigned char sym0, unsigned char sym1, unsigned char sym2, unsigned char sym3)
+{
+	return ((sym0 & DTMF_SYM_MASK[0]) | (sym1 & DTMF_SYM_MASK[1]) | (sym2 & DTMF_SYM_MASK[2]) | (sym3 & DTMF_SYM_MASK[3])) >> 3;
+}
+
+constexpr std::array<char, 16U> buildSymbolTable()
+{
+	const unsigned char* symbols[] = { DTMF_SYM0, DTMF_SYM1, DTMF_SYM2, DTMF_SYM3, DTMF_SYM4, DTMF_SYM5, DTMF_SYM6, DTMF_SYM7,
+					   DTMF_SYM8, DTMF_SYM9, DTMF_SYMA, DTMF_SYMB, DTMF_SYMC, DTMF_SYMD, DTMF_SYMS, DTMF_SYMH };
+	const char chars[] = "0123456789ABCD*#";
+
+	std::array<char, 16U> table = {};
+	for (unsigned int i = 0U; i < 16U; i++)
+		table[i] = ' ';
+
+	// Backwards so that, as with the former comparison chain, the first matching symbol wins
+	for (unsigned int i = 16U; i > 0U; i--) {
+		const unsigned char* sym = symbols[i - 1U];
+		table[symbolIndex(sym[0], sym[1], sym[2], sym[3])] = chars[i - 1U];
+	}
+
+	return table;
+}
+
+constexpr std::array<char, 16U> DTMF_SYMBOLS = buildSymbolTable();
 
 CDTMF::CDTMF() :
 m_data(),
@@ -60,49 +103,8 @@ CDTMF::~CDTMF()
 bool CDTMF::decode(const unsigned char* ambe, bool end)
 {
 	// DTMF begins with these byte values
-	if (!end && (ambe[0] & DTMF_MASK[0]) == DTMF_SIG[0] && (ambe[1] & DTMF_MASK[1]) == DTMF_SIG[1] &&
-				(ambe[2] & DTMF_MASK[2]) == DTMF_SIG[2] && (ambe[3] & DTMF_MASK[3]) == DTMF_SIG[3] &&
-				(ambe[4] & DTMF_MASK[4]) == DTMF_SIG[4] && (ambe[5] & DTMF_MASK[5]) == DTMF_SIG[5] &&
-				(ambe[6] & DTMF_MASK[6]) == DTMF_SIG[6] && (ambe[7] & DTMF_MASK[7]) == DTMF_SIG[7] &&
-				(ambe[8] & DTMF_MASK[8]) == DTMF_SIG[8]) {
-		unsigned char sym0 = ambe[4] & DTMF_SYM_MASK[0];
-		unsigned char sym1 = ambe[5] & DTMF_SYM_MASK[1];
-		unsigned char sym2 = ambe[7] & DTMF_SYM_MASK[2];
-		unsigned char sym3 = ambe[8] & DTMF_SYM_MASK[3];
-
-		char c = ' ';
-		if (sym0 == DTMF_SYM0[0] && sym1 == DTMF_SYM0[1] && sym2 == DTMF_SYM0[2] && sym3 == DTMF_SYM0[3])
-			c = '0';
-		else if (sym0 == DTMF_SYM1[0] && sym1 == DTMF_SYM1[1] && sym2 == DTMF_SYM1[2] && sym3 == DTMF_SYM1[3])
-			c = '1';
-		else if (sym0 == DTMF_SYM2[0] && sym1 == DTMF_SYM2[1] && sym2 == DTMF_SYM2[2] && sym3 == DTMF_SYM2[3])
-			c = '2';
-		else if (sym0 == DTMF_SYM3[0] && sym1 == DTMF_SYM3[1] && sym2 == DTMF_SYM3[2] && sym3 == DTMF_SYM3[3])
-			c = '3';
-		else if (sym0 == DTMF_SYM4[0] && sym1 == DTMF_SYM4[1] && sym2 == DTMF_SYM4[2] && sym3 == DTMF_SYM4[3])
-			c = '4';
-		else if (sym0 == DTMF_SYM5[0] && sym1 == DTMF_SYM5[1] && sym2 == DTMF_SYM5[2] && sym3 == DTMF_SYM5[3])
-			c = '5';
-		else if (sym0 == DTMF_SYM6[0] && sym1 == DTMF_SYM6[1] && sym2 == DTMF_SYM6[2] && sym3 == DTMF_SYM6[3])
-			c = '6';
-		else if (sym0 == DTMF_SYM7[0] && sym1 == DTMF_SYM7[1] && sym2 == DTMF_SYM7[2] && sym3 == DTMF_SYM7[3])
-			c = '7';
-		else if (sym0 == DTMF_SYM8[0] && sym1 == DTMF_SYM8[1] && sym2 == DTMF_SYM8[2] && sym3 == DTMF_SYM8[3])
-			c = '8';
-		else if (sym0 == DTMF_SYM9[0] && sym1 == DTMF_SYM9[1] && sym2 == DTMF_SYM9[2] && sym3 == DTMF_SYM9[3])
-			c = '9';
-		else if (sym0 == DTMF_SYMA[0] && sym1 == DTMF_SYMA[1] && sym2 == DTMF_SYMA[2] && sym3 == DTMF_SYMA[3])
-			c = 'A';
-		else if (sym0 == DTMF_SYMB[0] && sym1 == DTMF_SYMB[1] && sym2 == DTMF_SYMB[2] && sym3 == DTMF_SYMB[3])
-			c = 'B';
-		else if (sym0 == DTMF_SYMC[0] && sym1 == DTMF_SYMC[1] && sym2 == DTMF_SYMC[2] && sym3 == DTMF_SYMC[3])
-			c = 'C';
-		else if (sym0 == DTMF_SYMD[0] && sym1 == DTMF_SYMD[1] && sym2 == DTMF_SYMD[2] && sym3 == DTMF_SYMD[3])
-			c = 'D';
-		else if (sym0 == DTMF_SYMS[0] && sym1 == DTMF_SYMS[1] && sym2 == DTMF_SYMS[2] && sym3 == DTMF_SYMS[3])
-			c = '*';
-		else if (sym0 == DTMF_SYMH[0] && sym1 == DTMF_SYMH[1] && sym2 == DTMF_SYMH[2] && sym3 == DTMF_SYMH[3])
-			c = '#';
+	if (!end && (pack(ambe) & DTMF_MASK_PACKED) == DTMF_SIG_PACKED && (ambe[6] & DTMF_MASK[6]) == DTMF_SIG[6]) {
+		char c = DTMF_SYMBOLS[symbolIndex(ambe[4], ambe[5], ambe[7], ambe[8])];
 
 		if (c == m_lastChar) {
 			m_pressCount++;
@@ -135,6 +137,17 @@ bool CDTMF::decode(const unsigned char* ambe, bool end)
 	}
 }
 
+bool CDTMF::decode(const unsigned char* frames, unsigned int count, unsigned int stride)
+{
+	for (unsigned int i = 0U; i < count; i++)
+		decode(frames + i * stride, false);
+
+	// The end of the transmission, ambe is not looked at
+	decode(frames, true);
+
+	return hasCommand();
+}
+
 bool CDTMF::hasCommand() const
 {
 	return m_command.size() > 0;
@@ -27,6 +27,8 @@ public:
 	~CDTMF();
 
 	bool decode(const unsigned char* ambe, bool end);
+	// A whole buffered transmission in one pass, frames are stride bytes apart, true when it holds a command
+	bool decode(const unsigned char* frames, unsigned int count, unsigned int stride);
 
 	bool hasCommand() const;
 
@@ -19,7 +19,10 @@
  */
 
 #include <cstring>
-#include <arpa/inet.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 #include "DVTOOLFileReader.h"
 #include "DStarDefines.h"
@@ -39,25 +42,28 @@ static const unsigned char DATA_FLAG     = 0x20;
 static const unsigned char HEADER_MASK   = 0x80;
 static const unsigned char TRAILER_MASK  = 0x40;
 
-const unsigned int BUFFER_LENGTH = 255U;
+// Signature plus the record count
+static const unsigned int FILE_HEADER_LENGTH = DVTOOL_SIGNATURE_LENGTH + 4U;
+// Signature, flag, fixed data and sequence number, following the record length
+static const unsigned int RECORD_HEADER_LENGTH = DSVT_SIGNATURE_LENGTH + 1U + FIXED_DATA_LENGTH + 1U;
 
 
 CDVTOOLFileReader::CDVTOOLFileReader() :
 m_fileName(),
-m_file(NULL),
+m_map(NULL),
+m_mapLength(0U),
+m_offset(0U),
 m_records(0U),
 m_type(DVTFR_NONE),
-m_buffer(NULL),
+m_data(NULL),
 m_length(0U),
-m_seqNo(0U),
-m_closed(true)
+m_seqNo(0U)
 {
-	m_buffer = new unsigned char[BUFFER_LENGTH];
 }
 
 CDVTOOLFileReader::~CDVTOOLFileReader()
 {
-	delete[] m_buffer;
+	close();
 }
 
 std::string CDVTOOLFileReader::getFileName() const
@@ -72,94 +78,95 @@ unsigned int CDVTOOLFileReader::getRecords() const
 
 bool CDVTOOLFileReader::open(const std::string& fileName)
 {
+	close();
+
 	m_fileName = fileName;
 
-	m_file = fopen(fileName.c_str(), "rb");
-	if (NULL == m_file)
+	int fd = ::open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
 		return false;
 
-	unsigned char buffer[DVTOOL_SIGNATURE_LENGTH];
-	size_t n = fread(buffer, 1, DVTOOL_SIGNATURE_LENGTH, m_file);
-	if (n != DVTOOL_SIGNATURE_LENGTH) {
-		fclose(m_file);
+	struct stat sbuf;
+	if (::fstat(fd, &sbuf) != 0 || sbuf.st_size < (off_t)FILE_HEADER_LENGTH) {
+		::close(fd);
 		return false;
 	}
 
-	if (::memcmp(buffer, DVTOOL_SIGNATURE, DVTOOL_SIGNATURE_LENGTH) != 0) {
-		fclose(m_file);
+	void* map = ::mmap(NULL, sbuf.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (map == MAP_FAILED)
 		return false;
-	}
 
-	uint32_t uint32;
-	n = fread(&uint32, sizeof(uint32_t), 1, m_file);
-	if (n != 1) {
-		fclose(m_file);
+	// Records are only ever read front to back
+	::madvise(map, sbuf.st_size, MADV_SEQUENTIAL);
+
+	m_map = (unsigned char*)map;
+	m_mapLength = sbuf.st_size;
+
+	if (::memcmp(m_map, DVTOOL_SIGNATURE, DVTOOL_SIGNATURE_LENGTH) != 0) {
+		close();
 		return false;
 	}
 
+	uint32_t uint32;
+	::memcpy(&uint32, m_map + DVTOOL_SIGNATURE_LENGTH, sizeof(uint32_t));
+
 	m_records = CUtils::swap_endian_le(uint32);
+	m_offset  = FILE_HEADER_LENGTH;
 	m_seqNo   = 0U;
-	m_closed = false;
 
 	return true;
 }
 
 DVTFR_TYPE CDVTOOLFileReader::read()
 {
-	uint16_t uint16;
-	size_t n = fread(&uint16, sizeof(uint16_t), 1, m_file);
-	if (n != 1)
-		return DVTFR_NONE;
+	m_type = DVTFR_NONE;
+	m_data = NULL;
+	m_length = 0U;
 
-	m_length = CUtils::swap_endian_be(uint16) - 15U;
-
-	unsigned char bytes[FIXED_DATA_LENGTH];
-	n = fread(bytes, 1, DSVT_SIGNATURE_LENGTH, m_file);
-	if (n != DSVT_SIGNATURE_LENGTH)
+	if (m_map == NULL || m_mapLength - m_offset < sizeof(uint16_t) + RECORD_HEADER_LENGTH)
 		return DVTFR_NONE;
 
-	if (::memcmp(bytes, DSVT_SIGNATURE, DSVT_SIGNATURE_LENGTH) != 0)
-		return DVTFR_NONE;
+	const unsigned char* record = m_map + m_offset;
 
-	char flag;
-	n = fread(&flag, 1, 1, m_file);
-	if (n != 1)
+	uint16_t uint16;
+	::memcpy(&uint16, record, sizeof(uint16_t));
+	unsigned int length = CUtils::swap_endian_be(uint16);
+	if (length < RECORD_HEADER_LENGTH || m_mapLength - m_offset - sizeof(uint16_t) < length)
 		return DVTFR_NONE;
 
-	m_type = (flag == HEADER_FLAG) ? DVTFR_HEADER : DVTFR_DATA;
+	record += sizeof(uint16_t);
 
-	n = fread(bytes, 1, FIXED_DATA_LENGTH, m_file);
-	if (n != FIXED_DATA_LENGTH)
+	if (::memcmp(record, DSVT_SIGNATURE, DSVT_SIGNATURE_LENGTH) != 0)
 		return DVTFR_NONE;
 
-	n = fread(&flag, 1, 1, m_file);
-	if (n != 1)
-		return DVTFR_NONE;
+	DVTFR_TYPE type = (record[DSVT_SIGNATURE_LENGTH] == HEADER_FLAG) ? DVTFR_HEADER : DVTFR_DATA;
 
-	if (m_type == DVTFR_DATA)
-		m_seqNo = flag;
+	if (type == DVTFR_DATA)
+		m_seqNo = record[RECORD_HEADER_LENGTH - 1U];
 
-	n = fread(m_buffer, 1, m_length, m_file);
-	if (n != m_length)
-		return DVTFR_NONE;
+	m_type   = type;
+	m_data   = record + RECORD_HEADER_LENGTH;
+	m_length = length - RECORD_HEADER_LENGTH;
+	m_offset += sizeof(uint16_t) + length;
 
 	return m_type;
 }
 
 CHeaderData* CDVTOOLFileReader::readHeader()
 {
-	if (m_type != DVTFR_HEADER)
+	if (m_type != DVTFR_HEADER || m_length < RADIO_HEADER_LENGTH_BYTES)
 		return NULL;
 
 	CHeaderData* header = new CHeaderData;
 
-	if (m_buffer[39U] == 0xFFU && m_buffer[40U] == 0xFFU) {
-		header->setDVTOOLData(m_buffer, RADIO_HEADER_LENGTH_BYTES, false);
+	if (m_data[39U] == 0xFFU && m_data[40U] == 0xFFU) {
+		header->setDVTOOLData(m_data, RADIO_HEADER_LENGTH_BYTES, false);
 		return header;
 	}
 
 	// Header checksum testing is enabled
-	bool valid = header->setDVTOOLData(m_buffer, RADIO_HEADER_LENGTH_BYTES, true);
+	bool valid = header->setDVTOOLData(m_data, RADIO_HEADER_LENGTH_BYTES, true);
 	if (!valid) {
 		delete header;
 		return NULL;
@@ -175,16 +182,31 @@ CAMBEData* CDVTOOLFileReader::readData()
 
 	CAMBEData* data = new CAMBEData;
 
-	data->setData(m_buffer, m_length);
+	data->setData(m_data, m_length);
 	data->setSeq(m_seqNo);
 
 	return data;
 }
 
+const unsigned char* CDVTOOLFileReader::getData(unsigned int& length) const
+{
+	if (m_type != DVTFR_DATA)
+		return NULL;
+
+	length = m_length;
+
+	return m_data;
+}
+
 void CDVTOOLFileReader::close()
 {
-	if(!m_closed)
-		fclose(m_file);
-		
-	m_closed = true;
+	if (m_map != NULL)
+		::munmap(m_map, m_mapLength);
+
+	m_map = NULL;
+	m_mapLength = 0U;
+	m_offset = 0U;
+	m_type = DVTFR_NONE;
+	m_data = NULL;
+	m_length = 0U;
 }
@@ -22,7 +22,7 @@
 
 #include <string>
 #include <cstdint>
-#include <cstdio>
+#include <cstddef>
 
 #include "HeaderData.h"
 #include "AMBEData.h"
@@ -33,6 +33,7 @@ enum DVTFR_TYPE {
 	DVTFR_DATA
 };
 
+// Maps the whole file read-only, records are parsed one at a time as they are read
 class CDVTOOLFileReader {
 public:
 	CDVTOOLFileReader();
@@ -48,15 +49,19 @@ public:
 	CHeaderData* readHeader();
 	CAMBEData*   readData();
 
+	// Points into the mapped file, valid until the next read or close
+	const unsigned char* getData(unsigned int& length) const;
+
 	void         close();
 
 private:
 	std::string    m_fileName;
-	FILE          *m_file;
+	unsigned char* m_map;
+	size_t         m_mapLength;
+	size_t         m_offset;
 	uint32_t       m_records;
 	DVTFR_TYPE     m_type;
-	unsigned char* m_buffer;
+	const unsigned char* m_data;
 	unsigned int   m_length;
 	unsigned char  m_seqNo;
-	bool 		   m_closed;
 };
@@ -23,6 +23,8 @@
 #include <cassert>
 #include <cstring>
 #include <unistd.h>
+#include <random>
+#include <mutex>
 
 #include "HeaderData.h"
 #include "NetUtils.h"
@@ -30,9 +32,14 @@
 #include "DStarDefines.h"
 #include "Utils.h"
 
+// Stream ids have their own generator, seeding rand() elsewhere does not change them
+static std::minstd_rand s_idGenerator;
+static std::mutex       s_idMutex;
+
 void CHeaderData::initialise()
 {
 	srand(time(NULL) + getpid());
+	setIdSeed(time(NULL) + getpid());
 }
 
 void CHeaderData::finalise()
@@ -41,7 +48,14 @@ void CHeaderData::finalise()
 
 unsigned int CHeaderData::createId()
 {
-	return (::rand() % 65535U) + 1U;
+	std::lock_guard lock(s_idMutex);
+	return (s_idGenerator() % 65535U) + 1U;
+}
+
+void CHeaderData::setIdSeed(unsigned int seed)
+{
+	std::lock_guard lock(s_idMutex);
+	s_idGenerator.seed(seed);
 }
 
 CHeaderData::CHeaderData() :
@@ -61,7 +75,9 @@ m_rptCall2(NULL),
 m_yourAddress(),
 m_yourPort(0U),
 m_myPort(0U),
-m_errors(0U)
+m_errors(0U),
+m_ingressTime(0U),
+m_ingressEndpoint(FE_NONE)
 {
 	m_myCall1  = new unsigned char[LONG_CALLSIGN_LENGTH];
 	m_myCall2  = new unsigned char[SHORT_CALLSIGN_LENGTH];
@@ -93,7 +109,9 @@ m_rptCall2(NULL),
 m_yourAddress(header.m_yourAddress),
 m_yourPort(header.m_yourPort),
 m_myPort(header.m_myPort),
-m_errors(header.m_errors)
+m_errors(header.m_errors),
+m_ingressTime(header.m_ingressTime),
+m_ingressEndpoint(header.m_ingressEndpoint)
 {
 	m_myCall1  = new unsigned char[LONG_CALLSIGN_LENGTH];
 	m_myCall2  = new unsigned char[SHORT_CALLSIGN_LENGTH];
@@ -127,7 +145,9 @@ m_rptCall2(NULL),
 m_yourAddress(),
 m_yourPort(0U),
 m_myPort(0U),
-m_errors(0U)
+m_errors(0U),
+m_ingressTime(0U),
+m_ingressEndpoint(FE_NONE)
 {
 	m_myCall1  = new unsigned char[LONG_CALLSIGN_LENGTH];
 	m_myCall2  = new unsigned char[SHORT_CALLSIGN_LENGTH];
@@ -940,6 +960,22 @@ unsigned int CHeaderData::getMyPort() const
 	return m_myPort;
 }
 
+void CHeaderData::setIngress(uint64_t time, FRAME_ENDPOINT endpoint)
+{
+	m_ingressTime     = time;
+	m_ingressEndpoint = endpoint;
+}
+
+uint64_t CHeaderData::getIngressTime() const
+{
+	return m_ingressTime;
+}
+
+FRAME_ENDPOINT CHeaderData::getIngressEndpoint() const
+{
+	return m_ingressEndpoint;
+}
+
 CHeaderData& CHeaderData::operator =(const CHeaderData& header)
 {
 	if (&header != this) {
@@ -955,6 +991,8 @@ CHeaderData& CHeaderData::operator =(const CHeaderData& header)
 		m_yourPort    = header.m_yourPort;
 		m_myPort      = header.m_myPort;
 		m_errors      = header.m_errors;
+		m_ingressTime     = header.m_ingressTime;
+		m_ingressEndpoint = header.m_ingressEndpoint;
 
 		::memcpy(m_myCall1,  header.m_myCall1,  LONG_CALLSIGN_LENGTH);
 		::memcpy(m_myCall2,  header.m_myCall2,  SHORT_CALLSIGN_LENGTH);
@@ -21,9 +21,12 @@
 #pragma once
 
 #include <string>
+#include <cstdint>
 
 #include <netinet/in.h>
 
+#include "DStarDefines.h"
+
 class CHeaderData {
 public:
 	CHeaderData();
@@ -99,10 +102,17 @@ public:
 
 	unsigned int getErrors() const;
 
+	void setIngress(uint64_t time, FRAME_ENDPOINT endpoint);
+	uint64_t getIngressTime() const;
+	FRAME_ENDPOINT getIngressEndpoint() const;
+
 	static void initialise();
 	static void finalise();
 	static unsigned int createId();
 
+	// Replays draw the same stream ids every time, whatever else seeds rand()
+	static void setIdSeed(unsigned int seed);
+
 	CHeaderData& operator=(const CHeaderData& header);
 
 private:
@@ -123,4 +133,6 @@ private:
 	unsigned int   m_yourPort;
 	unsigned int   m_myPort;
 	unsigned int   m_errors;
+	uint64_t       m_ingressTime;
+	FRAME_ENDPOINT m_ingressEndpoint;
 };
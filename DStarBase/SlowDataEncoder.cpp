@@ -41,7 +41,8 @@ m_gpsPtr(0U),
 m_interleavedPtr(0U),
 m_gpsDataSize(0U),
 m_gpsDataFullSize(0U),
-m_interleavedDataFullSize(0U)
+m_interleavedDataFullSize(0U),
+m_scrambledData()
 {
 }
 
@@ -52,6 +53,8 @@ CSlowDataEncoder::~CSlowDataEncoder()
 
 void CSlowDataEncoder::clearHeaderData()
 {
+	m_scrambledData.reset();
+
 	if(m_headerData)
 	{
 		delete[] m_headerData;
@@ -62,6 +65,8 @@ void CSlowDataEncoder::clearHeaderData()
 
 void CSlowDataEncoder::clearTextData()
 {
+	m_scrambledData.reset();
+
 	if(m_textData)
 	{
 		delete[] m_textData;
@@ -72,6 +77,8 @@ void CSlowDataEncoder::clearTextData()
 
 void CSlowDataEncoder::clearGPSData()
 {
+	m_scrambledData.reset();
+
 	if(m_gpsData)
 	{
 		delete[] m_gpsData;
@@ -82,6 +89,8 @@ void CSlowDataEncoder::clearGPSData()
 
 void CSlowDataEncoder::clearInterleavedData()
 {
+	m_scrambledData.reset();
+
 	if(m_interleavedData)
 	{
 		delete[] m_interleavedData;
@@ -184,6 +193,85 @@ void CSlowDataEncoder::buildInterleavedData()
 	}
 }
 
+std::shared_ptr<const std::vector<unsigned char>> CSlowDataEncoder::getScrambledData()
+{
+	if(m_scrambledData == nullptr)
+		buildScrambledData();
+
+	return m_scrambledData;
+}
+
+void CSlowDataEncoder::getScrambledData(unsigned char* frames, unsigned int count)
+{
+	assert(frames != NULL);
+
+	auto scrambled = getScrambledData();
+	const unsigned char* source = scrambled->data();
+
+	// Each superframe starts again at the beginning of the cycle, as after sync(), so only its first block is ever sent
+	unsigned char* data = frames + VOICE_FRAME_LENGTH_BYTES;
+	for(unsigned int i = 0U; i < count; i += 21U) {
+		::memcpy(data, DATA_SYNC_BYTES, DATA_FRAME_LENGTH_BYTES);
+		data += DV_FRAME_LENGTH_BYTES;
+
+		unsigned int n = count - i < 21U ? count - i : 21U;
+		for(unsigned int j = 1U; j < n; j++, data += DV_FRAME_LENGTH_BYTES)
+			::memcpy(data, source + (j - 1U) * DATA_FRAME_LENGTH_BYTES, DATA_FRAME_LENGTH_BYTES);
+	}
+}
+
+void CSlowDataEncoder::buildScrambledData()
+{
+	const unsigned char* source = nullptr;
+	unsigned int length = 0U;
+
+	// Same selection as getInterleavedData
+	if(m_textData && !m_gpsData && !m_headerData) {
+		source = m_textData;
+		length = SLOW_DATA_FULL_BLOCK_SIZE;
+	}
+	else if(!m_textData && m_gpsData && !m_headerData) {
+		source = m_gpsData;
+		length = m_gpsDataFullSize;
+	}
+	else if(!m_textData && !m_gpsData && m_headerData) {
+		source = m_headerData;
+		length = SLOW_DATA_FULL_BLOCK_SIZE;
+	}
+	else if(m_textData || m_gpsData || m_headerData) {
+		buildInterleavedData();
+		source = m_interleavedData;
+		length = m_interleavedDataFullSize;
+	}
+
+	// Without any data send one block of filler bytes
+	std::vector<unsigned char> filler;
+	if(length == 0U) {
+		filler.assign(SLOW_DATA_FULL_BLOCK_SIZE, 'f');
+		source = filler.data();
+		length = SLOW_DATA_FULL_BLOCK_SIZE;
+	}
+
+	assert((length % SLOW_DATA_FULL_BLOCK_SIZE) == 0U);
+
+	// Whole blocks against a whole block of scrambler bytes, so the compiler can vectorise the loop
+	unsigned char scrambler[SLOW_DATA_FULL_BLOCK_SIZE];
+	for(unsigned int i = 0U; i < SLOW_DATA_FULL_BLOCK_SIZE; i += DATA_FRAME_LENGTH_BYTES) {
+		scrambler[i + 0U] = SCRAMBLER_BYTE1;
+		scrambler[i + 1U] = SCRAMBLER_BYTE2;
+		scrambler[i + 2U] = SCRAMBLER_BYTE3;
+	}
+
+	auto scrambled = std::make_shared<std::vector<unsigned char>>(length);
+	unsigned char* out = scrambled->data();
+	for(unsigned int block = 0U; block < length; block += SLOW_DATA_FULL_BLOCK_SIZE) {
+		for(unsigned int i = 0U; i < SLOW_DATA_FULL_BLOCK_SIZE; i++)
+			out[block + i] = source[block + i] ^ scrambler[i];
+	}
+
+	m_scrambledData = scrambled;
+}
+
 unsigned int CSlowDataEncoder::getInterleavedDataLength()
 {
 	//calculate size (including filler bytes);
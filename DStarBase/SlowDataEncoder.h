@@ -14,6 +14,9 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "HeaderData.h"
 
 #ifdef __UNIT_TEST__
@@ -43,12 +46,18 @@ public:
 
 	unsigned int getInterleavedDataLength();
 
+	// The whole cycle of slow data getInterleavedData walks through, already scrambled. Built once and kept until the data changes
+	std::shared_ptr<const std::vector<unsigned char>> getScrambledData();
+	// Fills the slow data of count DV frames starting at sequence 0, sync bytes every 21 frames
+	void getScrambledData(unsigned char* frames, unsigned int count);
+
 	void reset();
 	void sync();
 
 private:
 	void getData(unsigned char* source, unsigned char* data, unsigned int &sourcePtr, unsigned int sourceLength);
 	void buildInterleavedData();
+	void buildScrambledData();
 
 	unsigned char* m_headerData;
 	unsigned char* m_textData;
@@ -65,6 +74,8 @@ private:
 
 	unsigned int   m_interleavedDataFullSize; //size of interleaved data including filler bytes
 
+	std::shared_ptr<const std::vector<unsigned char>> m_scrambledData;
+
 #ifdef __UNIT_TEST__
 	friend SlowDataEncoderTests;
 #endif
@@ -50,6 +50,11 @@
 #include "Daemon.h"
 #include "APRSISHandlerThread.h"
 #include "DummyAPRSHandlerThread.h"
+#include "LatencyTracer.h"
+#include "LoopProfiler.h"
+#include "UDPReaderWriter.h"
+#include "PlayoutScheduler.h"
+#include "EchoUnit.h"
 
 CDStarGatewayApp * CDStarGatewayApp::g_app = nullptr;
 const std::string BANNER_1 = CStringUtils::string_format("%s Copyright (C) %s\n", FULL_PRODUCT_NAME.c_str(), VENDOR_NAME.c_str());
@@ -144,7 +149,9 @@ int main(int argc, char *argv[])
 
 CDStarGatewayApp::CDStarGatewayApp(CDStarGatewayConfig * config) :
 m_config(config),
-m_thread(NULL)
+m_thread(NULL),
+m_capture(NULL),
+m_replay(NULL)
 {
 	assert(config != nullptr);
 	g_app = this;
@@ -163,6 +170,23 @@ void CDStarGatewayApp::run()
 {
 	m_thread->Run();
 	m_thread->Wait();
+
+	if(m_capture != NULL) {
+		CUDPReaderWriter::setCapture(NULL);
+		CLog::logInfo("Recorded %u datagrams", m_capture->getCount());
+		m_capture->close();
+		delete m_capture;
+		m_capture = NULL;
+	}
+
+	if(m_replay != NULL) {
+		CUDPReaderWriter::setReplay(NULL);
+		CPlayoutScheduler::setReplay(NULL);
+		m_replay->close();
+		delete m_replay;
+		m_replay = NULL;
+	}
+
 	CLog::logInfo("exiting\n");
 	CLog::finalise();
 }
@@ -178,12 +202,50 @@ bool CDStarGatewayApp::createThread()
 	m_config->getPaths(paths);
 	m_thread = new CDStarGatewayThread(log.logDir, paths.dataDir, "");
 
+	// Metrics, must be set before any socket is opened
+	TMetrics metrics;
+	m_config->getMetrics(metrics);
+	CLatencyTracer::setEnabled(metrics.latencyTracing);
+	if(metrics.latencyTracing)
+		CUDPReaderWriter::setTimestamping(metrics.kernelTimestamps ? UTS_KERNEL : UTS_USER);
+
+	CLoopProfiler::setTickInterval(TIME_PER_TIC_MS);
+	CLoopProfiler::setSummaryInterval(metrics.loopSummaryInterval);
+	CLoopProfiler::setEnabled(metrics.loopProfiling);
+
+	// Capture, must also be set before any socket is opened
+	TCapture capture;
+	m_config->getCapture(capture);
+	if(capture.mode == CM_RECORD) {
+		m_capture = new CPacketCaptureWriter(capture.file);
+		if(!m_capture->open()) {
+			delete m_capture;
+			m_capture = NULL;
+			return false;
+		}
+		CUDPReaderWriter::setCapture(m_capture);
+		CLog::logInfo("Recording datagrams to %s", capture.file.c_str());
+	}
+	else if(capture.mode == CM_REPLAY) {
+		m_replay = new CPacketReplay(capture.file, capture.replayOutput);
+		if(!m_replay->open()) {
+			delete m_replay;
+			m_replay = NULL;
+			return false;
+		}
+		CUDPReaderWriter::setReplay(m_replay);
+		CPlayoutScheduler::setReplay(m_replay);
+		m_thread->setReplay(m_replay);
+		CLog::logInfo("Replay mode, ircDDB and APRS-IS are disabled");
+	}
+
 	// Setup the gateway
 	TGateway gatewayConfig;
 	m_config->getGateway(gatewayConfig);
 	m_thread->setGateway(gatewayConfig.type, gatewayConfig.callsign, gatewayConfig.address);
 	m_thread->setLanguage(gatewayConfig.language);
 	m_thread->setLocation(gatewayConfig.latitude, gatewayConfig.longitude);
+	CEchoUnit::setSharedBuffers(gatewayConfig.echoBuffers);
 
 #ifdef USE_GPSD
 	// Setup GPSD
@@ -196,7 +258,7 @@ bool CDStarGatewayApp::createThread()
 	m_config->getAPRS(aprsConfig);
 	CAPRSHandler * outgoingAprsWriter = nullptr;
 	CAPRSHandler * incomingAprsWriter = nullptr;
-	if(aprsConfig.enabled && !aprsConfig.password.empty()) {
+	if(aprsConfig.enabled && !aprsConfig.password.empty() && m_replay == NULL) {
 		CAPRSISHandlerThread* aprsisthread = new CAPRSISHandlerThread(gatewayConfig.callsign, aprsConfig.password, gatewayConfig.address, aprsConfig.hostname, aprsConfig.port);
 		outgoingAprsWriter = new CAPRSHandler((IAPRSHandlerBackend *)aprsisthread);
 
@@ -304,7 +366,7 @@ bool CDStarGatewayApp::createThread()
 	// Setup ircddb
 	auto ircddbVersionInfo = "linux_" + PRODUCT_NAME + "-" + VERSION;
 	std::vector<CIRCDDB *> clients;
-	for(unsigned int i=0; i < m_config->getIrcDDBCount(); i++) {
+	for(unsigned int i=0; i < m_config->getIrcDDBCount() && m_replay == NULL; i++) {
 		TircDDB ircDDBConfig;
 		m_config->getIrcDDB(i, ircDDBConfig);
 		CLog::logInfo("ircDDB Network %d set to %s user: %s, Quadnet %d", i + 1,ircDDBConfig.hostname.c_str(), ircDDBConfig.username.c_str(), ircDDBConfig.isQuadNet);
@@ -312,7 +374,9 @@ bool CDStarGatewayApp::createThread()
 		clients.push_back(ircDDB);
 	}
 	if(clients.size() > 0U) {
-		CIRCDDBMultiClient* multiClient = new CIRCDDBMultiClient(clients);
+		TircDDBQueries ircDDBQueries;
+		m_config->getIrcDDBQueries(ircDDBQueries);
+		CIRCDDBMultiClient* multiClient = new CIRCDDBMultiClient(clients, ircDDBQueries.racing, ircDDBQueries.graceWindow, ircDDBQueries.notFoundTTL);
 		bool res = multiClient->open();
 		if (!res) {
 			CLog::logInfo("Cannot initialise the ircDDB protocol handler\n");
@@ -27,6 +27,8 @@ class CDStarGatewayApp
 private:
 	CDStarGatewayConfig * m_config;
 	CDStarGatewayThread * m_thread;
+	CPacketCaptureWriter * m_capture;
+	CPacketReplay * m_replay;
 	bool createThread();
 	static CDStarGatewayApp * g_app;
 
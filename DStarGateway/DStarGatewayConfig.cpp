@@ -58,6 +58,8 @@ bool CDStarGatewayConfig::load()
 		ret = loadDaemon(cfg) && ret;
 		ret = loadAccessControl(cfg) && ret;
 		ret = loadDRats(cfg) && ret;
+		ret = loadMetrics(cfg) && ret;
+		ret = loadCapture(cfg) && ret;
 	}
 
 	if(ret) {
@@ -277,7 +279,12 @@ bool CDStarGatewayConfig::loadRepeaters(const CConfig & cfg)
 
 bool CDStarGatewayConfig::loadIrcDDB(const CConfig & cfg)
 {
-	bool ret = true;
+	std::string queryMode;
+	bool ret = cfg.getValue("ircddb", "queryMode", queryMode, "all", {"all", "racing"});
+	m_ircDDBQueries.racing = queryMode == "racing";
+	ret = cfg.getValue("ircddb", "graceWindow", m_ircDDBQueries.graceWindow, 0U, 5000U, 150U) && ret;
+	ret = cfg.getValue("ircddb", "notFoundTTL", m_ircDDBQueries.notFoundTTL, 0U, 3600U, 30U) && ret;
+
 	for(unsigned int i = 0; i < 4; i++) {
 		std::string section = CStringUtils::string_format("ircddb_%d", i + 1);
 		bool ircEnabled;
@@ -315,6 +322,7 @@ bool CDStarGatewayConfig::loadGateway(const CConfig & cfg)
 	ret = cfg.getValue("gateway", "description1", m_gateway.description1, 0, 1024, "") && ret;
 	ret = cfg.getValue("gateway", "description2", m_gateway.description2, 0, 1024, "") && ret;
 	ret = cfg.getValue("gateway", "url", m_gateway.url, 0, 1024, "") && ret;
+	ret = cfg.getValue("gateway", "echoBuffers", m_gateway.echoBuffers, 0U, 1000U, 0U) && ret;
 	
 	std::string type;
 	ret = cfg.getValue("gateway", "type", type, "repeater", {"repeater", "hotspot"}) && ret;
@@ -373,6 +381,35 @@ bool CDStarGatewayConfig::loadDRats(const CConfig & cfg)
 	return ret;
 }
 
+bool CDStarGatewayConfig::loadMetrics(const CConfig & cfg)
+{
+	bool ret = cfg.getValue("Metrics", "latencyTracing", m_metrics.latencyTracing, false);
+	ret = cfg.getValue("Metrics", "kernelTimestamps", m_metrics.kernelTimestamps, false) && ret;
+	ret = cfg.getValue("Metrics", "loopProfiling", m_metrics.loopProfiling, false) && ret;
+	ret = cfg.getValue("Metrics", "loopSummaryInterval", m_metrics.loopSummaryInterval, 0U, 86400U, 300U) && ret;
+
+	return ret;
+}
+
+bool CDStarGatewayConfig::loadCapture(const CConfig & cfg)
+{
+	std::string mode;
+	bool ret = cfg.getValue("Capture", "mode", mode, "none", {"none", "record", "replay"});
+	if(mode == "record")		m_capture.mode = CM_RECORD;
+	else if(mode == "replay")	m_capture.mode = CM_REPLAY;
+	else						m_capture.mode = CM_NONE;
+
+	ret = cfg.getValue("Capture", "file", m_capture.file, 0, 2048, "") && ret;
+	ret = cfg.getValue("Capture", "replayOutput", m_capture.replayOutput, 0, 2048, "") && ret;
+
+	if(ret && m_capture.mode != CM_NONE && m_capture.file.empty()) {
+		CLog::logError("Capture file has to be set when capture mode is %s", mode.c_str());
+		ret = false;
+	}
+
+	return ret;
+}
+
 bool CDStarGatewayConfig::open(CConfig & cfg)
 {
 	try {
@@ -418,6 +455,11 @@ unsigned int CDStarGatewayConfig::getIrcDDBCount() const
 	return m_ircDDB.size();
 }
 
+void CDStarGatewayConfig::getIrcDDBQueries(TircDDBQueries & queries) const
+{
+	queries = m_ircDDBQueries;
+}
+
 void CDStarGatewayConfig::getRepeater(unsigned int index, TRepeater & repeater) const
 {
 	repeater = *(m_repeaters[index]);
@@ -483,4 +525,14 @@ void CDStarGatewayConfig::getAccessControl(TAccessControl & accessControl) const
 void CDStarGatewayConfig::getDRats(TDRats & drats) const
 {
 	drats = m_drats;
+}
+
+void CDStarGatewayConfig::getMetrics(TMetrics & metrics) const
+{
+	metrics = m_metrics;
+}
+
+void CDStarGatewayConfig::getCapture(TCapture & capture) const
+{
+	capture = m_capture;
 }
\ No newline at end of file
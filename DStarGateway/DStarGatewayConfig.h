@@ -45,6 +45,7 @@ typedef struct {
 	std::string description2;
 	std::string url; 
 	TEXT_LANG language;
+	unsigned int echoBuffers;
 } TGateway;
 
 typedef struct {
@@ -78,6 +79,12 @@ typedef struct {
 	bool isQuadNet;
 } TircDDB;
 
+typedef struct {
+	bool racing;
+	unsigned int graceWindow;
+	unsigned int notFoundTTL;
+} TircDDBQueries;
+
 typedef struct {
 	std::string dataDir;
 } Tpaths;
@@ -143,6 +150,25 @@ typedef struct {
 	std::string restrictList;
 } TAccessControl;
 
+typedef struct {
+	bool latencyTracing;
+	bool kernelTimestamps;
+	bool loopProfiling;
+	unsigned int loopSummaryInterval;
+} TMetrics;
+
+typedef enum {
+	CM_NONE,
+	CM_RECORD,
+	CM_REPLAY
+} CAPTURE_MODE;
+
+typedef struct {
+	CAPTURE_MODE mode;
+	std::string file;
+	std::string replayOutput;
+} TCapture;
+
 class CDStarGatewayConfig {
 public:
 	CDStarGatewayConfig(const std::string &pathname);
@@ -152,6 +178,7 @@ public:
 	void getGateway(TGateway & gateway) const;
 	void getIrcDDB(unsigned int ircddbIndex, TircDDB & ircddb) const;
 	unsigned int getIrcDDBCount() const;
+	void getIrcDDBQueries(TircDDBQueries & queries) const;
 	void getRepeater(unsigned int repeaterIndex, TRepeater & repeater) const;
 	unsigned int getRepeaterCount() const;
 	void getLog(TLog& log) const;
@@ -168,6 +195,8 @@ public:
 	void getDaemon(TDaemon & gen) const;
 	void getAccessControl(TAccessControl & accessControl) const;
 	void getDRats(TDRats & drats) const;
+	void getMetrics(TMetrics & metrics) const;
+	void getCapture(TCapture & capture) const;
 
 private:
 	bool open(CConfig & cfg);
@@ -188,6 +217,8 @@ private:
 	bool loadDaemon(const CConfig & cfg);
 	bool loadAccessControl(const CConfig & cfg);
 	bool loadDRats(const CConfig & cfg);
+	bool loadMetrics(const CConfig & cfg);
+	bool loadCapture(const CConfig & cfg);
 
 	std::string m_fileName;
 	TGateway m_gateway;
@@ -205,6 +236,9 @@ private:
 	TDaemon m_daemon;
 	TAccessControl m_accessControl;
 	TDRats m_drats;
+	TMetrics m_metrics;
+	TCapture m_capture;
+	TircDDBQueries m_ircDDBQueries;
 
 	std::vector<TRepeater *> m_repeaters;
 	std::vector<TircDDB *> m_ircDDB;
@@ -35,6 +35,8 @@
 #include "DExtraHandler.h"
 #include "DPlusHandler.h"
 #include "HeaderLogger.h"
+#include "LoopProfiler.h"
+#include "PlayoutScheduler.h"
 #include "ConnectData.h"
 #ifdef USE_CCS
 #include "CCSHandler.h"
@@ -103,6 +105,7 @@ m_remoteEnabled(false),
 m_remotePassword(),
 m_remotePort(0U),
 m_remote(NULL),
+m_replay(NULL),
 m_statusFileTimer(1000U, 2U * 60U),		// 2 minutes
 m_status1(),
 m_status2(),
@@ -328,6 +331,8 @@ void* CDStarGatewayThread::Entry()
 	try {
 #endif
 		while (!m_killed) {
+			CLoopProfiler::beginIteration();
+
 			if (m_icomRepeaterHandler != NULL)
 				processRepeater(m_icomRepeaterHandler);
 
@@ -337,25 +342,46 @@ void* CDStarGatewayThread::Entry()
 			if (m_dummyRepeaterHandler != NULL)
 				processRepeater(m_dummyRepeaterHandler);
 
+			CLoopProfiler::mark(LS_REPEATER);
+
 			if (m_irc != NULL)
 				processIrcDDB();
 
+			CLoopProfiler::mark(LS_IRCDDB);
+
 			processDExtra();
+			CLoopProfiler::mark(LS_DEXTRA);
 			processDPlus();
+			CLoopProfiler::mark(LS_DPLUS);
 			processDCS();
+			CLoopProfiler::mark(LS_DCS);
 			processG2();
+			CLoopProfiler::mark(LS_G2);
 #ifdef USE_CCS
 			CCCSHandler::process();
+			CLoopProfiler::mark(LS_CCS);
 #endif
 
 			if (m_ddModeEnabled)
 				processDD();
 
+			CLoopProfiler::mark(LS_DD);
+
 			if (m_remote != NULL)
 				m_remote->process();
 
-			unsigned long ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now()- timePoint).count();
-			timePoint = std::chrono::steady_clock::now();
+			CLoopProfiler::mark(LS_REMOTE);
+
+			unsigned long ms;
+			if (m_replay != NULL) {
+				// Simulated clock, every iteration is one tick
+				ms = TIME_PER_TIC_MS;
+				m_replay->clock(ms);
+			} else {
+				// Carry the sub millisecond remainder over, the loop wakes up early for playout deadlines
+				ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now()- timePoint).count();
+				timePoint += std::chrono::milliseconds(ms);
+			}
 
 			CRepeaterHandler::clock(ms);
 			CG2Handler::clock(ms);
@@ -400,7 +426,16 @@ void* CDStarGatewayThread::Entry()
 				}
 			}
 
-			::std::this_thread::sleep_for(std::chrono::milliseconds(TIME_PER_TIC_MS));
+			CLoopProfiler::mark(LS_CLOCK);
+			CLoopProfiler::endIteration();
+
+			if (m_replay != NULL) {
+				// Playouts run on the simulated clock, let them complete
+				if (m_replay->isFinished() && !CPlayoutScheduler::isAnyPlaying())
+					m_killed = true;
+			} else {
+				CPlayoutScheduler::sleep(TIME_PER_TIC_MS);
+			}
 		}
 #ifndef DEBUG_DSTARGW
 	}
@@ -415,6 +450,10 @@ void* CDStarGatewayThread::Entry()
 	}
 #endif
 
+	if (m_replay != NULL)
+		CLog::logInfo("Replay finished after %.3fs of simulated time, %u datagrams delivered, %u not claimed by any socket, %u written",
+					double(m_replay->getTime()) / 1.0e9, m_replay->getDelivered(), m_replay->getUnclaimed(), m_replay->getWritten());
+
 	CLog::logInfo("Stopping the ircDDB Gateway thread");
 
 	// Unlink from all reflectors
@@ -669,6 +708,17 @@ void CDStarGatewayThread::setLocation(double latitude, double longitude)
 	m_longitude = longitude;
 }
 
+void CDStarGatewayThread::setReplay(CPacketReplay* replay)
+{
+	m_replay = replay;
+
+	// Fixed seeds make replays comparable, rand() is seeded once by CHeaderData::initialise() and not again
+	if (replay != NULL) {
+		CHeaderData::setIdSeed(1U);
+		::srand(1U);
+	}
+}
+
 void CDStarGatewayThread::setRemote(bool enabled, const std::string& password, unsigned int port)
 {
 	if (enabled) {
@@ -745,6 +795,7 @@ void CDStarGatewayThread::processIrcDDB()
 					if (!res)
 						break;
 
+					CRepeaterHandler::resolveUser(user, repeater, gateway, address);
 					if (!address.empty()) {
 						CLog::logDebug("USER: %s %s %s %s", user.c_str(), repeater.c_str(), gateway.c_str(), address.c_str());
 						m_cache.updateUser(user, repeater, gateway, address, timestamp, DP_DEXTRA, false, false);
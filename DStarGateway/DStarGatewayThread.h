@@ -34,6 +34,7 @@
 #include "CallsignList.h"
 #include "APRSHandler.h"
 #include "IRCDDB.h"
+#include "PacketReplay.h"
 #include "Timer.h"
 #include "Defs.h"
 #include "Thread.h"
@@ -76,6 +77,7 @@ public:
 	virtual void setWhiteList(CCallsignList* list);
 	virtual void setBlackList(CCallsignList* list);
 	virtual void setRestrictList(CCallsignList* list);
+	virtual void setReplay(CPacketReplay* replay);
 
 	virtual CDStarGatewayStatusData* getStatus() const;
 
@@ -127,6 +129,7 @@ private:
 	std::string                  m_remotePassword;
 	unsigned int              m_remotePort;
 	CRemoteHandler*           m_remote;
+	CPacketReplay*            m_replay;
 	CTimer                    m_statusFileTimer;
 	std::string                  m_status1;
 	std::string                  m_status2;
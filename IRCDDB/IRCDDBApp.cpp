@@ -22,14 +22,17 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <netdb.h>
 #include <map>
+#include <unordered_map>
 #include <mutex>
-#include <regex>
+#include <condition_variable>
 #include <cstdio>
 #include <chrono>
 #include <thread>
 #include <boost/algorithm/string.hpp>
 
 #include "IRCDDBApp.h"
+#include "IRCDDBUpdateParser.h"
+#include "IRCDDBSanitizer.h"
 #include "Utils.h"
 #include "Log.h"
 
@@ -79,22 +82,113 @@ public:
 	}
 };
 
-class IRCDDBAppPrivate
+#define IRCDDB_GATEWAY_NICKS 4U
+
+// The nicks <gateway>-1 to <gateway>-4 of one gateway, pointing into the user map
+class IRCDDBAppGatewayObject
 {
 public:
-	IRCDDBAppPrivate()
-	: m_tablePattern("^[0-9]$")
-	, m_datePattern("^20[0-9][0-9]-((1[0-2])|(0[1-9]))-((3[01])|([12][0-9])|(0[1-9]))$")
-	, m_timePattern("^((2[0-3])|([01][0-9])):[0-5][0-9]:[0-5][0-9]$")
-	, m_dbPattern("^[0-9A-Z_]{8}$")
-	, m_fromPattern("\\(from: (.*)\\)")
+	IRCDDBAppUserObject * m_users[IRCDDB_GATEWAY_NICKS];
+	// The one with the highest USN, its host is the address of the gateway
+	IRCDDBAppUserObject * m_best;
+
+	IRCDDBAppGatewayObject()
+	{
+		for (unsigned int i = 0U; i < IRCDDB_GATEWAY_NICKS; i++)
+			m_users[i] = NULL;
+		m_best = NULL;
+	}
+
+	bool isEmpty() const
+	{
+		for (unsigned int i = 0U; i < IRCDDB_GATEWAY_NICKS; i++) {
+			if (m_users[i] != NULL)
+				return false;
+		}
+		return true;
+	}
+
+	void updateBest()
 	{
+		// On equal USNs the highest nick number wins
+		unsigned int maxUsn = 0U;
+		m_best = NULL;
+		for (unsigned int i = 0U; i < IRCDDB_GATEWAY_NICKS; i++) {
+			if (m_users[i] != NULL && m_users[i]->m_usn >= maxUsn) {
+				maxUsn = m_users[i]->m_usn;
+				m_best = m_users[i];
+			}
+		}
 	}
+};
 
+typedef std::chrono::steady_clock IRCDDBAppClock;
+
+class IRCDDBAppPrivate
+{
+public:
 	int m_state;
-	int m_timer;
-	int m_infoTimer;
-	int m_wdTimer;
+
+	// Wakes the state machine up, the timers are deadlines and guarded by m_eventMutex
+	std::mutex m_eventMutex;
+	std::condition_variable m_eventCondition;
+	bool m_eventPending;
+	IRCDDBAppClock::time_point m_timer;		// state timeout, stopped when at max()
+	IRCDDBAppClock::time_point m_infoTimer;	// sends QTH, URL and QRG, stopped when at max()
+	IRCDDBAppClock::time_point m_wdTimer;	// sends the watchdogs, stopped when at max()
+
+	void signalEvent()
+	{
+		std::lock_guard lockEvent(m_eventMutex);
+		m_eventPending = true;
+		m_eventCondition.notify_one();
+	}
+
+	void startTimer(IRCDDBAppClock::time_point& timer, unsigned int seconds)
+	{
+		std::lock_guard lockEvent(m_eventMutex);
+		timer = IRCDDBAppClock::now() + std::chrono::seconds(seconds);
+		m_eventPending = true;
+		m_eventCondition.notify_one();
+	}
+
+	void stopTimer(IRCDDBAppClock::time_point& timer)
+	{
+		std::lock_guard lockEvent(m_eventMutex);
+		timer = IRCDDBAppClock::time_point::max();
+	}
+
+	bool hasExpired(const IRCDDBAppClock::time_point& timer)
+	{
+		std::lock_guard lockEvent(m_eventMutex);
+		return IRCDDBAppClock::now() >= timer;
+	}
+
+	// True once when the timer expires, it is then stopped
+	bool takeExpired(IRCDDBAppClock::time_point& timer)
+	{
+		std::lock_guard lockEvent(m_eventMutex);
+		if (IRCDDBAppClock::now() < timer)
+			return false;
+
+		timer = IRCDDBAppClock::time_point::max();
+		return true;
+	}
+
+	// Sleeps until signalled or until the next timer expires, at most one second
+	void waitEvent()
+	{
+		std::unique_lock lockEvent(m_eventMutex);
+		auto now = IRCDDBAppClock::now();
+		auto deadline = now + std::chrono::seconds(1);
+		for (auto timer : { m_timer, m_infoTimer, m_wdTimer }) {
+			if (timer > now && timer < deadline)
+				deadline = timer;
+		}
+
+		m_eventCondition.wait_until(lockEvent, deadline, [this] { return m_eventPending; });
+		m_eventPending = false;
+	}
 
 	IRCMessageQueue *m_sendQ;
 	IRCMessageQueue m_replyQ;
@@ -105,19 +199,15 @@ public:
 	std::string m_channelTopic;
 	std::string m_bestServer;
 
-	std::regex m_tablePattern;
-	std::regex m_datePattern;
-	std::regex m_timePattern;
-	std::regex m_dbPattern;
-	std::regex m_fromPattern;
-
 	bool m_initReady;
 	bool m_terminateThread;
 
-	std::map<std::string, IRCDDBAppUserObject> m_userMap;
+	// Both guarded by m_userMapMutex, the gateway map is keyed on the lower case gateway callsign
+	std::unordered_map<std::string, IRCDDBAppUserObject> m_userMap;
+	std::unordered_map<std::string, IRCDDBAppGatewayObject> m_gatewayMap;
 	std::mutex m_userMapMutex;
 
-	std::map<std::string, IRCDDBAppRptrObject> m_rptrMap;
+	std::unordered_map<std::string, IRCDDBAppRptrObject> m_rptrMap;
 	std::mutex m_rptrMapMutex;
 
 	std::map<std::string, std::string> m_moduleQRG;
@@ -129,6 +219,9 @@ public:
 
 	std::map<std::string, std::string> m_moduleWD;
 	std::mutex m_moduleWDMutex;
+
+	std::string m_heardBuffer;
+	std::mutex m_heardMutex;
 };
 
 IRCDDBApp::IRCDDBApp(const std::string& u_chan)
@@ -141,7 +234,10 @@ IRCDDBApp::IRCDDBApp(const std::string& u_chan)
 	userListReset();
 
 	m_d->m_state = 0;
-	m_d->m_timer = 0;
+	m_d->m_eventPending = false;
+	m_d->m_timer = IRCDDBAppClock::time_point::max();
+	m_d->m_infoTimer = IRCDDBAppClock::time_point::max();
+	m_d->m_wdTimer = IRCDDBAppClock::time_point::max();
 	m_d->m_myNick = std::string("none");
 
 	m_d->m_updateChannel = u_chan;
@@ -168,12 +264,8 @@ void IRCDDBApp::rptrQTH(const std::string& callsign, double latitude, double lon
 	d1.resize(20, '_');
 	d2.resize(20, '_');
 
-	std::regex nonValid("[^a-zA-Z0-9 +&(),./'-]");
-	std::smatch sm;
-	while (std::regex_search(d1, sm, nonValid))
-		d1.erase(sm.position(0), sm.length());
-	while (std::regex_search(d2, sm, nonValid))
-		d2.erase(sm.position(0), sm.length());
+	IRCDDBSanitizer::removeNonDescription(d1);
+	IRCDDBSanitizer::removeNonDescription(d2);
 
 	CUtils::ReplaceChar(pos, ',', '.');
 	CUtils::ReplaceChar(d1, ' ', '_');
@@ -188,16 +280,14 @@ void IRCDDBApp::rptrQTH(const std::string& callsign, double latitude, double lon
 
 	std::string url = infoURL;
 
-	std::regex urlNonValid("[^[:graph:]]");
-	while (std::regex_search(url, sm, urlNonValid))
-		url.erase(sm.position(0), sm.length());
+	IRCDDBSanitizer::removeNonGraph(url);
 
 	if (url.size()) {
 		m_d->m_moduleURL[cs] = cs + std::string(" ") + url;
 		CLog::logInfo("URL: %s\n", m_d->m_moduleURL[cs].c_str());
 	}
 
-	m_d->m_infoTimer = 5; // send info in 5 seconds
+	m_d->startTimer(m_d->m_infoTimer, 5U); // send info in 5 seconds
 }
 
 void IRCDDBApp::rptrQRG(const std::string& callsign, double txFrequency, double duplexShift, double range, double agl)
@@ -214,17 +304,14 @@ void IRCDDBApp::rptrQRG(const std::string& callsign, double txFrequency, double
 	m_d->m_moduleQRG[cs] = cs + std::string(" ") + f;
 	CLog::logInfo("QRG: %s\n", m_d->m_moduleQRG[cs].c_str());
 
-	m_d->m_infoTimer = 5; // send info in 5 seconds
+	m_d->startTimer(m_d->m_infoTimer, 5U); // send info in 5 seconds
 }
 
 void IRCDDBApp::kickWatchdog(const std::string& callsign, const std::string& s)
 {
 	std::string text = s;
 
-	std::regex nonValid("[^[:graph:]]");
-	std::smatch sm;
-	while (std::regex_search(text, sm, nonValid))
-		text.erase(sm.position(0), sm.length());
+	IRCDDBSanitizer::removeNonGraph(text);
 
 	if (text.size()) {
 		std::string cs = callsign;
@@ -232,7 +319,7 @@ void IRCDDBApp::kickWatchdog(const std::string& callsign, const std::string& s)
 
 		std::lock_guard lockModuleWD(m_d->m_moduleWDMutex);
 		m_d->m_moduleWD[cs] = cs + std::string(" ") + text;
-		m_d->m_wdTimer = 60;
+		m_d->startTimer(m_d->m_wdTimer, 60U);
 	}
 }
 
@@ -285,23 +372,45 @@ void IRCDDBApp::startWork()
 
 void IRCDDBApp::stopWork()
 {
-    m_d->m_terminateThread = true;
+	m_d->m_terminateThread = true;
+	m_d->signalEvent();
 	m_future.get();
 }
 
+// Splits a lower case nick such as f4fxl-1 into its gateway and nick number, false for any other nick
+static bool getGatewayNick(const std::string& lnick, std::string& gateway, unsigned int& index)
+{
+	std::string::size_type pos = lnick.find_last_of('-');
+	if (std::string::npos == pos || pos + 2U != lnick.size() || lnick[pos + 1U] < '1' || lnick[pos + 1U] > '4')
+		return false;
+
+	gateway.assign(lnick, 0U, pos);
+	index = lnick[pos + 1U] - '1';
+	return true;
+}
+
+// Turns a zone repeater callsign into the key of the gateway map
+static std::string getGatewayKey(const std::string& zonerp_cs)
+{
+	std::string gw;
+	for (char c : zonerp_cs)
+		gw.push_back(c == '_' ? ' ' : char(std::tolower(c)));
+	CUtils::Trim(gw);
+
+	return gw;
+}
+
 unsigned int IRCDDBApp::calculateUsn(const std::string& nick)
 {
 	std::string::size_type pos = nick.find_last_of('-');
 	std::string lnick = std::string::npos==pos ? nick : nick.substr(0, pos);
-	lnick.push_back('-');
 	unsigned int maxUsn = 0;
-	for (int i = 1; i <= 4; i++) {
-		std::string ircUser = lnick + std::to_string(i);
 
-		if (m_d->m_userMap.count(ircUser) == 1) {
-			IRCDDBAppUserObject obj = m_d->m_userMap[ircUser];
-			if (obj.m_usn > maxUsn)
-				maxUsn = obj.m_usn;
+	auto it = m_d->m_gatewayMap.find(lnick);
+	if (it != m_d->m_gatewayMap.end()) {
+		for (auto user : it->second.m_users) {
+			if (user != NULL && user->m_usn > maxUsn)
+				maxUsn = user->m_usn;
 		}
 	}
 	return maxUsn + 1;
@@ -317,7 +426,19 @@ void IRCDDBApp::userJoin(const std::string& nick, const std::string& name, const
 	IRCDDBAppUserObject u(lnick, name, host);
 	u.m_usn = calculateUsn(lnick);
 
-	m_d->m_userMap[lnick] = u;
+	IRCDDBAppUserObject& user = (m_d->m_userMap[lnick] = u);
+
+	std::string gateway;
+	unsigned int index;
+	if (getGatewayNick(lnick, gateway, index)) {
+		IRCDDBAppGatewayObject& gw = m_d->m_gatewayMap[gateway];
+		gw.m_users[index] = &user;
+		gw.updateBest();
+	}
+
+	// Only servers matter to the state machine, do not wake it for every user of the channel
+	if (0 == lnick.compare(0, 2, "s-"))
+		m_d->signalEvent();
 
 	/*if (m_d->m_initReady)*/ {
 		std::string::size_type hyphenPos = nick.find('-');
@@ -342,23 +463,36 @@ void IRCDDBApp::userLeave(const std::string& nick)
 	CUtils::ToLower(lnick);
 
 	std::lock_guard lockUserMap(m_d->m_userMapMutex);
+
+	std::string gateway;
+	unsigned int index;
+	if (getGatewayNick(lnick, gateway, index)) {
+		auto gw = m_d->m_gatewayMap.find(gateway);
+		if (gw != m_d->m_gatewayMap.end()) {
+			gw->second.m_users[index] = NULL;
+			if (gw->second.isEmpty())
+				m_d->m_gatewayMap.erase(gw);
+			else
+				gw->second.updateBest();
+		}
+	}
+
 	m_d->m_userMap.erase(lnick);
 
 	if (m_d->m_currentServer.size()) {
-		if (m_d->m_userMap.count(m_d->m_myNick) != 1) {
+		auto me = m_d->m_userMap.find(m_d->m_myNick);
+		if (me == m_d->m_userMap.end()) {
 			CLog::logInfo("IRCDDBApp::userLeave: could not find own nick\n");
 			return;
 		}
 
-		IRCDDBAppUserObject me = m_d->m_userMap[m_d->m_myNick];
-
-		if (me.m_op == false) {
+		if (me->second.m_op == false) {
 			// if I am not op, then look for new server
 
 			if (0 == m_d->m_currentServer.compare(lnick)) {
 				// m_currentServer = null;
 				m_d->m_state = 2;  // choose new server
-				m_d->m_timer = 200;
+				m_d->startTimer(m_d->m_timer, 200U);
 				m_d->m_initReady = false;
 			}
 		}
@@ -368,6 +502,7 @@ void IRCDDBApp::userLeave(const std::string& nick)
 void IRCDDBApp::userListReset()
 {
   std::lock_guard lockUserMap(m_d->m_userMapMutex);
+  m_d->m_gatewayMap.clear();
   m_d->m_userMap.clear();
 }
 
@@ -390,50 +525,42 @@ void IRCDDBApp::setTopic(const std::string& topic)
 
 bool IRCDDBApp::findServerUser()
 {
-	bool found = false;
 	std::lock_guard lockUserMap(m_d->m_userMapMutex);
 
-	std::map<std::string, IRCDDBAppUserObject>::iterator it;
-
-	for (it = m_d->m_userMap.begin(); it != m_d->m_userMap.end(); ++it) {
-		IRCDDBAppUserObject u = it->second;
+	for (const auto& it : m_d->m_userMap) {
+		const IRCDDBAppUserObject& u = it.second;
 
 		if (0==u.m_nick.compare(0, 2, "s-") && u.m_op && m_d->m_myNick.compare(u.m_nick) && 0==u.m_nick.compare(m_d->m_bestServer)) {
 			m_d->m_currentServer = u.m_nick;
-			found = true;
-			break;
+			return true;
 		}
 	}
 
-	if (found) {
-		return true;
-	}
-
 	if (8 == m_d->m_bestServer.size()) {
-		for (it = m_d->m_userMap.begin(); it != m_d->m_userMap.end(); ++it) {
-			IRCDDBAppUserObject u = it->second;
+		for (const auto& it : m_d->m_userMap) {
+			const IRCDDBAppUserObject& u = it.second;
 
 			if (0==u.m_nick.compare(m_d->m_bestServer.substr(0,7)) && u.m_op && m_d->m_myNick.compare(u.m_nick) ) {
 				m_d->m_currentServer = u.m_nick;
-				found = true;
-				break;
+				return true;
 			}
 		}
 	}
 
-	if (found) {
-		return true;
+	// Any other server will do, take the lowest nick so the choice does not depend on the hashing
+	const IRCDDBAppUserObject * server = NULL;
+	for (const auto& it : m_d->m_userMap) {
+		const IRCDDBAppUserObject& u = it.second;
+		if (0==u.m_nick.compare(0, 2, "s-") && u.m_op && m_d->m_myNick.compare(u.m_nick) && (server == NULL || u.m_nick < server->m_nick))
+			server = &u;
 	}
 
-	for (it = m_d->m_userMap.begin(); it != m_d->m_userMap.end(); ++it) {
-		IRCDDBAppUserObject u = it->second;
-		if (0==u.m_nick.compare(0, 2, "s-") && u.m_op && m_d->m_myNick.compare(u.m_nick)) {
-			m_d->m_currentServer = u.m_nick;
-			found = true;
-			break;
-		}
+	if (server != NULL) {
+		m_d->m_currentServer = server->m_nick;
+		return true;
 	}
-	return found;
+
+	return false;
 }
 
 void IRCDDBApp::userChanOp(const std::string& nick, bool op)
@@ -443,46 +570,38 @@ void IRCDDBApp::userChanOp(const std::string& nick, bool op)
 	std::string lnick = nick;
 	CUtils::ToLower(lnick);
 
-	if (m_d->m_userMap.count(lnick) == 1)
-		m_d->m_userMap[lnick].m_op = op;
+	auto it = m_d->m_userMap.find(lnick);
+	if (it != m_d->m_userMap.end())
+		it->second.m_op = op;
+
+	if (0 == lnick.compare(0, 2, "s-"))
+		m_d->signalEvent();
 }
 
 static const int numberOfTables = 2;
 
-std::string IRCDDBApp::getIPAddressFromCall(std::string& zonerp_cs)
+std::string IRCDDBApp::getIPAddressFromCall(const std::string& zonerp_cs)
 {
-	unsigned int max_usn = 0;
-	std::string ipAddr;
-	std::string gw = zonerp_cs;
-	CUtils::ReplaceChar(gw, '_', ' ');
-	CUtils::ToLower(gw);
-	CUtils::Trim(gw);
+	std::string gw = getGatewayKey(zonerp_cs);
 
 	std::lock_guard lockUserMap(m_d->m_userMapMutex);
-	for (int j=1; j <= 4; j++) {
-		std::string ircUser = gw + std::string("-") + std::to_string(j);
 
-		if (m_d->m_userMap.count(ircUser) == 1) {
-			IRCDDBAppUserObject o = m_d->m_userMap[ircUser];
+	auto it = m_d->m_gatewayMap.find(gw);
+	if (it == m_d->m_gatewayMap.end() || it->second.m_best == NULL)
+		return std::string();
 
-			if (o.m_usn >= max_usn) {
-				max_usn = o.m_usn;
-				ipAddr = o.m_host.c_str();
-			}
-		}
-	}
-	return ipAddr;
+	return it->second.m_best->m_host;
 }
 
-std::string IRCDDBApp::getIPAddressFromNick(std::string& ircUser)
+std::string IRCDDBApp::getIPAddressFromNick(const std::string& ircUser)
 {
-	std::string ipAddress;
+	std::lock_guard lockUserMap(m_d->m_userMapMutex);
 
-	if (m_d->m_userMap.count(ircUser) == 1) {
-		ipAddress.assign(m_d->m_userMap[ircUser].m_host);
-	}
+	auto it = m_d->m_userMap.find(ircUser);
+	if (it == m_d->m_userMap.end())
+		return std::string();
 
-	return ipAddress;
+	return it->second.m_host;
 }
 
 bool IRCDDBApp::findGateway(const std::string& gwCall)
@@ -544,8 +663,9 @@ bool IRCDDBApp::findRepeater(const std::string& rptrCall)
 	std::string zonerp_cs;
 	std::lock_guard lockRptrMap(m_d->m_rptrMapMutex);
 
-	if (1 == m_d->m_rptrMap.count(arearp_cs)) {
-		IRCDDBAppRptrObject o = m_d->m_rptrMap[arearp_cs];
+	auto it = m_d->m_rptrMap.find(arearp_cs);
+	if (it != m_d->m_rptrMap.end()) {
+		const IRCDDBAppRptrObject& o = it->second;
 		zonerp_cs = o.m_zonerp_cs;
 		CUtils::ReplaceChar(zonerp_cs, '_', ' ');
 		zonerp_cs.resize(7, ' ');
@@ -581,55 +701,53 @@ void IRCDDBApp::sendDStarGatewayInfo(const std::string &subcommand, const std::v
 bool IRCDDBApp::sendHeard(const std::string& myCall, const std::string& myCallExt, const std::string& yourCall, const std::string& rpt1, const std::string& rpt2, unsigned char flag1,
 													unsigned char flag2, unsigned char flag3, const std::string& destination, const std::string& tx_msg, const std::string& tx_stats)
 {
-	std::string my(myCall);
-	std::string myext(myCallExt);
-	std::string ur(yourCall);
-	std::string r1(rpt1);
-	std::string r2(rpt2);
-	std::string dest(destination);
-	std::regex nonValid("[^A-Z0-9/_]");
-	std::smatch sm;
-	char underScore = '_';
-	while (std::regex_search(my, sm, nonValid))
-		my[sm.position(0)] = underScore;
-	while (std::regex_search(myext, sm, nonValid))
-		myext[sm.position(0)] = underScore;
-	while (std::regex_search(ur, sm, nonValid))
-		ur[sm.position(0)] = underScore;
-	while (std::regex_search(r1, sm, nonValid))
-		r1[sm.position(0)] = underScore;
-	while (std::regex_search(r2, sm, nonValid))
-		r2[sm.position(0)] = underScore;
-	while (std::regex_search(dest, sm, nonValid))
-		dest[sm.position(0)] = underScore;
-
-	bool statsMsg = (tx_stats.size() > 0);
-
 	std::string srv(m_d->m_currentServer);
 	IRCMessageQueue *q = getSendQ();
 
 	if (srv.size() && m_d->m_state>=6 && q) {
-		std::string cmd("UPDATE ");
+		bool statsMsg = (tx_stats.size() > 0);
 
-		cmd += CUtils::getCurrentTime();
-		cmd += std::string(" ") + my + std::string(" ") + r1 + std::string(" ");
-		if (!statsMsg)
-			cmd.append("0 ");
-		cmd += r2 + std::string(" ") + ur + std::string(" ");
+		time_t now = time(NULL);
+		struct tm tm_buf;
+		char timeStr[25];
+		strftime(timeStr, 25, "%Y-%m-%d %H:%M:%S", gmtime_r(&now, &tm_buf));
 
 		char flags[10];
 		snprintf(flags, 10, "%02X %02X %02X", flag1, flag2, flag3);
-		cmd.append(flags);
-		
-		cmd += std::string(" ") + myext;
 
-		if (statsMsg)
-			cmd += std::string(" # ") + tx_stats;
-		else {
-			cmd += std::string(" 00 ") + dest;
-			if (20 == tx_msg.size())
-				cmd += std::string(" ") + tx_msg;
+		std::lock_guard lockHeard(m_d->m_heardMutex);
+
+		// Reused from one call to the next, it only grows to the size of the longest command
+		std::string& cmd = m_d->m_heardBuffer;
+		cmd.assign("UPDATE ");
+		cmd.append(timeStr);
+		cmd.push_back(' ');
+		IRCDDBSanitizer::appendCallsign(cmd, myCall);
+		cmd.push_back(' ');
+		IRCDDBSanitizer::appendCallsign(cmd, rpt1);
+		cmd.push_back(' ');
+		if (!statsMsg)
+			cmd.append("0 ");
+		IRCDDBSanitizer::appendCallsign(cmd, rpt2);
+		cmd.push_back(' ');
+		IRCDDBSanitizer::appendCallsign(cmd, yourCall);
+		cmd.push_back(' ');
+		cmd.append(flags);
+		cmd.push_back(' ');
+		IRCDDBSanitizer::appendCallsign(cmd, myCallExt);
+
+		if (statsMsg) {
+			cmd.append(" # ");
+			cmd.append(tx_stats);
+		} else {
+			cmd.append(" 00 ");
+			IRCDDBSanitizer::appendCallsign(cmd, destination);
+			if (20 == tx_msg.size()) {
+				cmd.push_back(' ');
+				cmd.append(tx_msg);
+			}
 		}
+
 		IRCMessage *m = new IRCMessage(srv, cmd);
 		q->putMessage(m);
 		return true;
@@ -708,11 +826,14 @@ bool IRCDDBApp::getNickForRepeater(const std::string& repeater, std::string& nic
 
 	auto lrepeater = repeater.substr(0, firstSpacePos);
 	CUtils::ToLower(lrepeater);
-	
-	for(unsigned int i = 1; i <= 4U; i++) {
-		nick = lrepeater + "-" + std::to_string(i);
-		if(m_d->m_userMap.count(nick) == 1) {
-			return true;
+
+	auto it = m_d->m_gatewayMap.find(lrepeater);
+	if(it != m_d->m_gatewayMap.end()) {
+		for(auto user : it->second.m_users) {
+			if(user != NULL) {
+				nick = user->m_nick;
+				return true;
+			}
 		}
 	}
 
@@ -727,157 +848,113 @@ void IRCDDBApp::msgChannel(IRCMessage *m)
 		doUpdate(m->m_params[1]);
 }
 
-void IRCDDBApp::doNotFound(std::string& msg, std::string& retval)
+void IRCDDBApp::doNotFound(std::string_view msg, std::string& retval)
 {
-	int tableID = 0;
-	std::vector<std::string> tkz = CUtils::stringTokenizer(msg);
-
-	if (tkz.empty())
+	std::string_view tk = IRCDDBUpdateParser::nextToken(msg);
+	if (tk.empty())
 		return;  // no text in message
 
-	std::string tk = tkz.front();
-	tkz.erase(tkz.begin());
-	
-	if (std::regex_match(tk, m_d->m_tablePattern)) {
-		tableID = std::stoi(tk);
+	int tableID = 0;
+	if (IRCDDBUpdateParser::isTableID(tk)) {
+		tableID = tk[0] - '0';
 
-		if (tableID<0 || tableID>=numberOfTables) {
+		if (tableID >= numberOfTables) {
 			CLog::logInfo("invalid table ID %d\n", tableID);
 			return;
 		}
 
-		if (tkz.empty())
+		tk = IRCDDBUpdateParser::nextToken(msg);
+		if (tk.empty())
 			return;  // received nothing but the tableID
-
-		tk = tkz.front();
-		tk.erase(tk.begin());
 	}
 
 	if (0 == tableID) {
-		if (! std::regex_match(tk, m_d->m_dbPattern))
+		if (! IRCDDBUpdateParser::isKey(tk))
 			return; // no valid key
-		retval = tk;
+		retval.assign(tk);
 	}
 }
 
-void IRCDDBApp::doUpdate(std::string& msg)
+void IRCDDBApp::doUpdate(std::string_view msg)
 {
-	int tableID = 0;
-	std::vector<std::string> tkz = CUtils::stringTokenizer(msg);
-	if (tkz.empty())
-		return;  // no text in message
-
-	std::string tk = tkz.front();
-	tkz.erase(tkz.begin());
-
-	if (std::regex_match(tk, m_d->m_tablePattern)) {
-		tableID = std::stoi(tk);
-		if ((tableID < 0) || (tableID >= numberOfTables)) {
-			CLog::logInfo("invalid table ID %d\n", tableID);
+	TIRCDDBUpdate update;
+	switch (IRCDDBUpdateParser::parse(msg, numberOfTables, update)) {
+		case IUR_INVALID_TABLE:
+			CLog::logInfo("invalid table ID %d\n", update.tableID);
 			return;
-		}
-
-		if (tkz.empty())
-			return;  // received nothing but the tableID
-
-		tk = tkz.front();
-		tkz.erase(tkz.begin());
+		case IUR_INVALID:
+			return;
+		default:
+			break;
 	}
 
-	if (std::regex_match(tk, m_d->m_datePattern)) {
-		if (tkz.empty())
-			return;  // nothing after date string
-
-		std::string timeToken = tkz.front();	// time token
-		tkz.erase(tkz.begin());
-		if (! std::regex_match(timeToken, m_d->m_timePattern))
-			return; // no time string after date string
-
-		time_t dt = CUtils::parseTime(tk + std::string(" ") + timeToken);
-
-		if (0==tableID || 1==tableID) {
-			if (tkz.empty())
-				return;  // nothing after time string
-
-			std::string key = tkz.front();
-			tkz.erase(tkz.begin());
-
-			if (! std::regex_match(key, m_d->m_dbPattern))
-				return; // no valid key
-
-			if (tkz.empty())
-				return;  // nothing after time string
-
-			std::string value = tkz.front();
-			tkz.erase(tkz.begin());
-
-			if (! std::regex_match(value, m_d->m_dbPattern))
-				return; // no valid key
-
-			if (tableID == 1) {
-				std::lock_guard lockRptrMap(m_d->m_rptrMapMutex);
-				IRCDDBAppRptrObject newRptr(dt, key, value, m_maxTime);
-				m_d->m_rptrMap[key] = newRptr;
-
-				if (m_d->m_initReady) {
-					std::string arearp_cs(key);
-					std::string zonerp_cs(value);
-					CUtils::ReplaceChar(arearp_cs, '_', ' ');
-					CUtils::ReplaceChar(zonerp_cs, '_', ' ');
-					zonerp_cs.resize(7, ' ');
-					zonerp_cs.push_back('G');
-
-					IRCMessage *m2 = new IRCMessage("IDRT_REPEATER");
-					m2->addParam(arearp_cs);
-					m2->addParam(zonerp_cs);
-					m2->addParam(getIPAddressFromCall(value));
-					m_d->m_replyQ.putMessage(m2);
-				}
-			} else if (0==tableID && m_d->m_initReady) {
-				std::lock_guard lockRptrMap(m_d->m_rptrMapMutex);
-				std::string userCallsign(key);
-				std::string arearp_cs(value);
-				std::string zonerp_cs;
-				std::string ip_addr;
-				CUtils::ReplaceChar(userCallsign, '_', ' ');
-				CUtils::ReplaceChar(arearp_cs, '_', ' ');
-
-				std::smatch sm1;
-				std::string nick;
-				if(std::regex_search(msg, sm1, m_d->m_fromPattern))
-					nick = sm1[1];
-
-				if (1 == m_d->m_rptrMap.count(value)) {
-					// CLog::logTrace("doUptate RPTR already present");
-					IRCDDBAppRptrObject o = m_d->m_rptrMap[value];
-					zonerp_cs = o.m_zonerp_cs;
-					CUtils::ReplaceChar(zonerp_cs, '_', ' ');
-					zonerp_cs.resize(7, ' ');
-					ip_addr = nick.empty() ? getIPAddressFromCall(zonerp_cs) : getIPAddressFromNick(nick);
-					zonerp_cs.push_back('G');
-				}
-				else {
-					// CLog::logTrace("doUptate RPTR not present");
-					zonerp_cs = arearp_cs.substr(0, arearp_cs.length() - 1U);
-					ip_addr = nick.empty() ? getIPAddressFromCall(zonerp_cs) : getIPAddressFromNick(nick);
-					zonerp_cs.push_back('G');
-
-					if(!ip_addr.empty()) {
-						auto tmp = boost::replace_all_copy(zonerp_cs, " ", "_");
-						IRCDDBAppRptrObject newRptr(dt, value, tmp, m_maxTime);
-						m_d->m_rptrMap[value] = newRptr;
-					}
-				}
-
-				IRCMessage *m2 = new IRCMessage("IDRT_USER");
-				m2->addParam(userCallsign);
-				m2->addParam(arearp_cs);
-				m2->addParam(zonerp_cs);
-				m2->addParam(ip_addr);
-				m2->addParam(tk + std::string(" ") + timeToken);
-				m_d->m_replyQ.putMessage(m2);
+	// Users are only forwarded once the initial SENDLIST is complete, nothing to do for them before
+	if (0 == update.tableID && !m_d->m_initReady)
+		return;
+
+	time_t dt = IRCDDBUpdateParser::parseTime(update.date, update.time);
+	std::string key(update.key);
+	std::string value(update.value);
+
+	if (update.tableID == 1) {
+		std::lock_guard lockRptrMap(m_d->m_rptrMapMutex);
+		IRCDDBAppRptrObject newRptr(dt, key, value, m_maxTime);
+		m_d->m_rptrMap[key] = newRptr;
+
+		if (m_d->m_initReady) {
+			std::string arearp_cs(key);
+			std::string zonerp_cs(value);
+			CUtils::ReplaceChar(arearp_cs, '_', ' ');
+			CUtils::ReplaceChar(zonerp_cs, '_', ' ');
+			zonerp_cs.resize(7, ' ');
+			zonerp_cs.push_back('G');
+
+			IRCMessage *m2 = new IRCMessage("IDRT_REPEATER");
+			m2->addParam(arearp_cs);
+			m2->addParam(zonerp_cs);
+			m2->addParam(getIPAddressFromCall(value));
+			m_d->m_replyQ.putMessage(m2);
+		}
+	} else if (0 == update.tableID) {
+		std::lock_guard lockRptrMap(m_d->m_rptrMapMutex);
+		std::string userCallsign(key);
+		std::string arearp_cs(value);
+		std::string zonerp_cs;
+		std::string ip_addr;
+		CUtils::ReplaceChar(userCallsign, '_', ' ');
+		CUtils::ReplaceChar(arearp_cs, '_', ' ');
+
+		std::string nick(IRCDDBUpdateParser::getFromNick(msg));
+
+		auto it = m_d->m_rptrMap.find(value);
+		if (it != m_d->m_rptrMap.end()) {
+			// CLog::logTrace("doUptate RPTR already present");
+			zonerp_cs = it->second.m_zonerp_cs;
+			CUtils::ReplaceChar(zonerp_cs, '_', ' ');
+			zonerp_cs.resize(7, ' ');
+			ip_addr = nick.empty() ? getIPAddressFromCall(zonerp_cs) : getIPAddressFromNick(nick);
+			zonerp_cs.push_back('G');
+		}
+		else {
+			// CLog::logTrace("doUptate RPTR not present");
+			zonerp_cs = arearp_cs.substr(0, arearp_cs.length() - 1U);
+			ip_addr = nick.empty() ? getIPAddressFromCall(zonerp_cs) : getIPAddressFromNick(nick);
+			zonerp_cs.push_back('G');
+
+			if(!ip_addr.empty()) {
+				auto tmp = boost::replace_all_copy(zonerp_cs, " ", "_");
+				IRCDDBAppRptrObject newRptr(dt, value, tmp, m_maxTime);
+				m_d->m_rptrMap[value] = newRptr;
 			}
 		}
+
+		IRCMessage *m2 = new IRCMessage("IDRT_USER");
+		m2->addParam(userCallsign);
+		m2->addParam(arearp_cs);
+		m2->addParam(zonerp_cs);
+		m2->addParam(ip_addr);
+		m2->addParam(std::string(update.date) + std::string(" ") + std::string(update.time));
+		m_d->m_replyQ.putMessage(m2);
 	}
 }
 
@@ -898,39 +975,26 @@ static std::string getTableIDString(int tableID, bool spaceBeforeNumber)
 void IRCDDBApp::msgQuery(IRCMessage *m)
 {
 	if (0 == m->getPrefixNick().compare(0, 2, "s-") && m->m_numParams >=2 ) {	// server msg
-		std::string msg(m->m_params[1]);
-		std::vector<std::string> tkz = CUtils::stringTokenizer(msg);
+		std::string_view restOfLine(m->m_params[1]);
+		std::string_view cmd = IRCDDBUpdateParser::nextToken(restOfLine);
 
-		if (tkz.empty())
+		if (cmd.empty())
 			return;  // no text in message
 
-		std::string cmd = tkz.front();
-		tkz.erase(tkz.begin());
-
 		if (0 == cmd.compare("UPDATE")) {
-			std::string restOfLine;
-			while (! tkz.empty()) {
-				restOfLine += tkz.front();
-				tkz.erase(tkz.begin());
-				if (! tkz.empty())
-					restOfLine.push_back(' ');
-			}
 			doUpdate(restOfLine);
 		} else if (0 == cmd.compare("LIST_END")) {
-			if (5 == m_d->m_state) // if in sendlist processing state
+			if (5 == m_d->m_state) { // if in sendlist processing state
 				m_d->m_state = 3;  // get next table
+				m_d->signalEvent();
+			}
 		} else if (0 == cmd.compare("LIST_MORE")) {
-			if (5 == m_d->m_state) // if in sendlist processing state
+			if (5 == m_d->m_state) { // if in sendlist processing state
 				m_d->m_state = 4;  // send next SENDLIST
+				m_d->signalEvent();
+			}
 		} else if (0 == cmd.compare("NOT_FOUND")) {
 			std::string callsign;
-			std::string restOfLine;
-			while (! tkz.empty()) {
-				restOfLine += tkz.front();
-				tkz.erase(tkz.begin());
-				if (! tkz.empty())
-					restOfLine.push_back(' ');
-			}
 			doNotFound(restOfLine, callsign);
 
 			if (callsign.size() > 0) {
@@ -943,25 +1007,31 @@ void IRCDDBApp::msgQuery(IRCMessage *m)
 			}
 		}
 	}
-	else if(m->m_params[0] == m_d->m_myNick) {
-		if(m->m_params.size() >= 2U && m->m_params[1] == "NATTRAVERSAL_G2") {
-			IRCMessage * m2 = new IRCMessage(m->m_params[1]);
-			m2->addParam(m->getPrefixHost());
-			m_d->m_replyQ.putMessage(m2);
-		}
-		else if(m->m_params.size() >= 2U && boost::starts_with(m->m_params[1], "NATTRAVERSAL_DEXTRA")) {
-			IRCMessage * m2 = new IRCMessage(m->m_params[1].substr(0, (std::string("NATTRAVERSAL_DEXTRA")).length()));
+	else if (m->m_numParams >= 2 && m->m_params[0] == m_d->m_myNick) {
+		std::string_view msg(m->m_params[1]);
+
+		if (msg == "NATTRAVERSAL_G2") {
+			IRCMessage *m2 = new IRCMessage(std::string(msg));
 			m2->addParam(m->getPrefixHost());
-			std::string remotePort = boost::trim_copy(boost::replace_all_copy(m->m_params[1], "NATTRAVERSAL_DEXTRA", ""));
-			m2->addParam(remotePort);
 			m_d->m_replyQ.putMessage(m2);
 		}
-		else if(m->m_params.size() >= 2U && boost::starts_with(m->m_params[1], "NATTRAVERSAL_DPLUS")) {
-			IRCMessage * m2 = new IRCMessage(m->m_params[1].substr(0, (std::string("NATTRAVERSAL_DPLUS")).length()));
-			m2->addParam(m->getPrefixHost());
-			std::string remotePort = boost::trim_copy(boost::replace_all_copy(m->m_params[1], "NATTRAVERSAL_DPLUS", ""));
-			m2->addParam(remotePort);
-			m_d->m_replyQ.putMessage(m2);
+		else {
+			for (std::string_view command : { std::string_view("NATTRAVERSAL_DEXTRA"), std::string_view("NATTRAVERSAL_DPLUS") }) {
+				if (0 != msg.compare(0, command.size(), command))
+					continue;
+
+				// The port follows the command, in the same parameter or in the next one as notifyRepeater*NatTraversal sends it
+				std::string_view restOfLine = msg.substr(command.size());
+				std::string_view remotePort = IRCDDBUpdateParser::nextToken(restOfLine);
+				if (remotePort.empty() && m->m_numParams >= 3)
+					remotePort = m->m_params[2];
+
+				IRCMessage *m2 = new IRCMessage(std::string(command));
+				m2->addParam(m->getPrefixHost());
+				m2->addParam(std::string(remotePort));
+				m_d->m_replyQ.putMessage(m2);
+				break;
+			}
 		}
 	}
 }
@@ -969,6 +1039,7 @@ void IRCDDBApp::msgQuery(IRCMessage *m)
 void IRCDDBApp::setSendQ(IRCMessageQueue *s)
 {
 	m_d->m_sendQ = s;
+	m_d->signalEvent();
 }
 
 IRCMessageQueue *IRCDDBApp::getSendQ()
@@ -996,9 +1067,12 @@ static bool needsDatabaseUpdate(int tableID)
 void IRCDDBApp::Entry()
 {
 	int sendlistTableID = 0;
+	int lastState = -1;
+	IRCDDBAppClock::time_point connectTime;
+
 	while (!m_d->m_terminateThread) {
-		if (m_d->m_timer > 0)
-			m_d->m_timer--;
+		int state = m_d->m_state;
+
 		switch(m_d->m_state) {
 			case 0:	// wait for network to start
 				if (getSendQ())
@@ -1006,19 +1080,21 @@ void IRCDDBApp::Entry()
 				break;
 
 			case 1:	// connect to db
+				connectTime = IRCDDBAppClock::now();
 				m_d->m_state = 2;
-				m_d->m_timer = 200;
+				m_d->startTimer(m_d->m_timer, 200U);
 				break;
 
 			case 2:	// choose server
-				CLog::logInfo("IRCDDBApp: state=2 choose new 's-'-user\n");
+				if (2 != lastState)
+					CLog::logInfo("IRCDDBApp: state=2 choose new 's-'-user\n");
 				if (NULL == getSendQ())
 					m_d->m_state = 10;
 				else {
 					if (findServerUser()) {
 						sendlistTableID = numberOfTables;
 						m_d->m_state = 3; // next: send "SENDLIST"
-					} else if (0 == m_d->m_timer) {
+					} else if (m_d->hasExpired(m_d->m_timer)) {
 						m_d->m_state = 10;
 						IRCMessage *m = new IRCMessage("QUIT");
 						m->addParam("no op user with 's-' found.");
@@ -1039,7 +1115,7 @@ void IRCDDBApp::Entry()
 					else {
 						CLog::logInfo("IRCDDBApp: state=3 tableID=%d\n", sendlistTableID);
 						m_d->m_state = 4; // send "SENDLIST"
-						m_d->m_timer = 900; // 15 minutes max for update
+						m_d->startTimer(m_d->m_timer, 900U); // 15 minutes max for update
 					}
 				}
 				break;
@@ -1062,7 +1138,7 @@ void IRCDDBApp::Entry()
 			case 5: // sendlist processing
 				if (NULL == getSendQ())
 					m_d->m_state = 10; // disconnect DB
-				else if (0 == m_d->m_timer) {
+				else if (m_d->hasExpired(m_d->m_timer)) {
 					m_d->m_state = 10; // disconnect DB
 					IRCMessage *m = new IRCMessage("QUIT");
 					m->addParam("timeout SENDLIST");
@@ -1076,8 +1152,9 @@ void IRCDDBApp::Entry()
 				if (NULL == getSendQ())
 					m_d->m_state = 10; // disconnect DB
 				else {
-					CLog::logInfo( "IRCDDBApp: state=6 initialization completed\n");
-					m_d->m_infoTimer = 2;
+					auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(IRCDDBAppClock::now() - connectTime);
+					CLog::logInfo("IRCDDBApp: state=6 initialization completed in %lld ms\n", (long long)elapsed.count());
+					m_d->startTimer(m_d->m_infoTimer, 2U);
 					m_d->m_initReady = true;
 					m_d->m_state = 7;
 				}
@@ -1087,69 +1164,66 @@ void IRCDDBApp::Entry()
 				if (NULL == getSendQ())
 					m_d->m_state = 10; // disconnect DB
 
-				if (m_d->m_infoTimer > 0) {
-					m_d->m_infoTimer--;
-
-					if (0 == m_d->m_infoTimer) {
-						{	// Scope for mutext locking
-							std::lock_guard lochQTHURL(m_d->m_moduleQTHURLMutex);
-							for (auto it = m_d->m_moduleQTH.begin(); it != m_d->m_moduleQTH.end(); ++it) {
-								std::string value = it->second;
-								IRCMessage *m = new IRCMessage(m_d->m_currentServer, std::string("IRCDDB RPTRQTH: ") + value);
-								IRCMessageQueue *q = getSendQ();
-								if (q != NULL)
-									q->putMessage(m);
-							}
-							m_d->m_moduleQTH.clear();
-
-							for (auto it = m_d->m_moduleURL.begin(); it != m_d->m_moduleURL.end(); ++it) {
-								std::string value = it->second;
-								IRCMessage *m = new IRCMessage(m_d->m_currentServer, std::string("IRCDDB RPTRURL: ") + value);
-								IRCMessageQueue *q = getSendQ();
-								if (q != NULL)
-									q->putMessage(m);
-							}
-							m_d->m_moduleURL.clear();
+				if (m_d->takeExpired(m_d->m_infoTimer)) {
+					{	// Scope for mutext locking
+						std::lock_guard lochQTHURL(m_d->m_moduleQTHURLMutex);
+						for (auto it = m_d->m_moduleQTH.begin(); it != m_d->m_moduleQTH.end(); ++it) {
+							std::string value = it->second;
+							IRCMessage *m = new IRCMessage(m_d->m_currentServer, std::string("IRCDDB RPTRQTH: ") + value);
+							IRCMessageQueue *q = getSendQ();
+							if (q != NULL)
+								q->putMessage(m);
 						}
+						m_d->m_moduleQTH.clear();
 
-						std::lock_guard lockModuleQRG(m_d->m_moduleQRGMutex);
-						for (auto it = m_d->m_moduleQRG.begin(); it != m_d->m_moduleQRG.end(); ++it) {
+						for (auto it = m_d->m_moduleURL.begin(); it != m_d->m_moduleURL.end(); ++it) {
 							std::string value = it->second;
-							IRCMessage* m = new IRCMessage(m_d->m_currentServer, std::string("IRCDDB RPTRQRG: ") + value);
-							IRCMessageQueue* q = getSendQ();
+							IRCMessage *m = new IRCMessage(m_d->m_currentServer, std::string("IRCDDB RPTRURL: ") + value);
+							IRCMessageQueue *q = getSendQ();
 							if (q != NULL)
 								q->putMessage(m);
 						}
-						m_d->m_moduleQRG.clear();
+						m_d->m_moduleURL.clear();
 					}
-				}
 
-				if (m_d->m_wdTimer > 0) {
-					m_d->m_wdTimer--;
+					std::lock_guard lockModuleQRG(m_d->m_moduleQRGMutex);
+					for (auto it = m_d->m_moduleQRG.begin(); it != m_d->m_moduleQRG.end(); ++it) {
+						std::string value = it->second;
+						IRCMessage* m = new IRCMessage(m_d->m_currentServer, std::string("IRCDDB RPTRQRG: ") + value);
+						IRCMessageQueue* q = getSendQ();
+						if (q != NULL)
+							q->putMessage(m);
+					}
+					m_d->m_moduleQRG.clear();
+				}
 
-					if (0 == m_d->m_wdTimer) {
-						std::lock_guard lockModuleWD(m_d->m_moduleWDMutex);
+				if (m_d->takeExpired(m_d->m_wdTimer)) {
+					std::lock_guard lockModuleWD(m_d->m_moduleWDMutex);
 
-						for (auto it = m_d->m_moduleWD.begin(); it != m_d->m_moduleWD.end(); ++it) {
-							std::string value = it->second;
-							IRCMessage *m = new IRCMessage(m_d->m_currentServer, std::string("IRCDDB RPTRSW: ") + value);
-							IRCMessageQueue *q = getSendQ();
-							if (q)
-								q->putMessage(m);
-						}
-						m_d->m_moduleWD.clear();
+					for (auto it = m_d->m_moduleWD.begin(); it != m_d->m_moduleWD.end(); ++it) {
+						std::string value = it->second;
+						IRCMessage *m = new IRCMessage(m_d->m_currentServer, std::string("IRCDDB RPTRSW: ") + value);
+						IRCMessageQueue *q = getSendQ();
+						if (q)
+							q->putMessage(m);
 					}
+					m_d->m_moduleWD.clear();
 				}
 				break;
 
 			case 10:
 				// disconnect db
 				m_d->m_state = 0;
-				m_d->m_timer = 0;
+				m_d->stopTimer(m_d->m_timer);
 				m_d->m_initReady = false;
 				break;
 		}
-		std::this_thread::sleep_for(std::chrono::seconds(1));
+
+		lastState = state;
+
+		// Keep going while the state changes, otherwise wait for something to happen
+		if (m_d->m_state == state)
+			m_d->waitEvent();
 	} // while
 	return;
 }
@@ -25,6 +25,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "IRCApplication.h"
 
 #include <string>
+#include <string_view>
 #include <future>
 #include <ctime>
 #include <vector>
@@ -88,10 +89,10 @@ protected:
 	void Entry();
 
 private:
-	void doUpdate(std::string& msg);
-	void doNotFound(std::string& msg, std::string& retval);
-	std::string getIPAddressFromCall(std::string& zonerp_cs);
-	std::string getIPAddressFromNick(std::string& ircUser);
+	void doUpdate(std::string_view msg);
+	void doNotFound(std::string_view msg, std::string& retval);
+	std::string getIPAddressFromCall(const std::string& zonerp_cs);
+	std::string getIPAddressFromNick(const std::string& ircUser);
 	bool findServerUser();
 	unsigned int calculateUsn(const std::string& nick);
 	std::string getLastEntryTime(int tableID);
@@ -23,20 +23,53 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 
 #include <stdio.h>
+#include <algorithm>
 
 #include "IRCDDBMultiClient.h"
 #include "Log.h"
 
-CIRCDDBMultiClient::CIRCDDBMultiClient(const CIRCDDB_Array& clients) :
+// Racing mode, a query still missing answers after this long is answered with what it has
+#define RACING_QUERY_TIMEOUT std::chrono::milliseconds(5000)
+// Racing mode, a network leaving this many queries in a row unanswered is not waited for anymore
+#define RACING_SLOW_TIMEOUTS 3U
+// A query still waiting for its answer after this long is sent again rather than joined
+#define PENDING_QUERY_TIMEOUT std::chrono::milliseconds(5000)
+// Expired not found callsigns are forgotten at most this often
+#define NOT_FOUND_PURGE_INTERVAL std::chrono::seconds(1)
+// Networks are tracked one bit each in the responded masks
+#define MULTICLIENT_MAX_CLIENTS 31U
+
+CIRCDDBMultiClient::CIRCDDBMultiClient(const CIRCDDB_Array& clients, bool racing, unsigned int graceWindowMs, unsigned int notFoundTTL) :
 m_clients(),
+m_racing(racing),
+m_graceWindow(graceWindowMs),
+m_networks(),
+m_lateQueries(),
+m_notFoundTTL(notFoundTTL),
+m_notFound(),
+m_notFoundPurge(CIRCDDBMultiClientClock::now()),
+m_suppressedInFlight(0UL),
+m_suppressedNotFound(0UL),
 m_queriesLock(),
 m_responseQueueLock()
 {
 	for (unsigned int i = 0; i < clients.size(); i++)	{
-		if (clients[i] != NULL)
+		if (clients[i] == NULL)
+			continue;
+
+		if (m_clients.size() < MULTICLIENT_MAX_CLIENTS) {
 			m_clients.push_back(clients[i]);
+		}
+		else {
+			CLog::logError("Only %u ircDDB networks are supported, ignoring the others", MULTICLIENT_MAX_CLIENTS);
+			delete clients[i];
+		}
 	}
 	m_clients.shrink_to_fit();
+	m_networks.resize(m_clients.size());
+
+	if (m_racing)
+		CLog::logInfo("ircDDB racing queries enabled, grace window %u ms", graceWindowMs);
 }
 
 CIRCDDBMultiClient::~CIRCDDBMultiClient()
@@ -150,9 +183,12 @@ void CIRCDDBMultiClient::sendDStarGatewayInfo(const std::string subcommand, cons
 
 bool CIRCDDBMultiClient::findGateway(const std::string & gatewayCallsign)
 {
+	if (suppressQuery(IDRT_GATEWAY, gatewayCallsign))
+		return true;
+
 	pushQuery(IDRT_GATEWAY, gatewayCallsign, new CIRCDDBMultiClientQuery("", "", gatewayCallsign, "", "", "", IDRT_GATEWAY));
 	bool result = true;
-	for (unsigned int i = 0; i < m_clients.size(); i++) {
+	for (unsigned int i : getDispatchOrder()) {
 		result = m_clients[i]->findGateway(gatewayCallsign) && result;
 	}
 
@@ -161,9 +197,12 @@ bool CIRCDDBMultiClient::findGateway(const std::string & gatewayCallsign)
 
 bool CIRCDDBMultiClient::findRepeater(const std::string & repeaterCallsign)
 {
+	if (suppressQuery(IDRT_REPEATER, repeaterCallsign))
+		return true;
+
 	pushQuery(IDRT_REPEATER, repeaterCallsign, new CIRCDDBMultiClientQuery("", repeaterCallsign, "", "", "", "", IDRT_REPEATER));
 	bool result = true;
-	for (unsigned int i = 0; i < m_clients.size(); i++) {
+	for (unsigned int i : getDispatchOrder()) {
 		result = m_clients[i]->findRepeater(repeaterCallsign) && result;
 	}
 
@@ -172,9 +211,12 @@ bool CIRCDDBMultiClient::findRepeater(const std::string & repeaterCallsign)
 
 bool CIRCDDBMultiClient::findUser(const std::string & userCallsign)
 {
+	if (suppressQuery(IDRT_USER, userCallsign))
+		return true;
+
 	pushQuery(IDRT_USER, userCallsign, new CIRCDDBMultiClientQuery(userCallsign, "", "", "", "", "", IDRT_USER));
 	bool result = true;
-	for (unsigned int i = 0; i < m_clients.size(); i++) {
+	for (unsigned int i : getDispatchOrder()) {
 		result = m_clients[i]->findUser(userCallsign) && result;
 	}
 
@@ -300,7 +342,10 @@ IRCDDB_RESPONSE_TYPE CIRCDDBMultiClient::getMessageType()
 			}
 		}
 
-		if (type != IDRT_NONE)
+		if (m_racing && (type == IDRT_USER || type == IDRT_GATEWAY || type == IDRT_REPEATER)) {
+			processRacingResponse(i, type, key, user, repeater, gateway, address, timestamp, port);
+		}
+		else if (type != IDRT_NONE)
 		{
 			m_queriesLock.lock();
 
@@ -309,6 +354,7 @@ IRCDDB_RESPONSE_TYPE CIRCDDBMultiClient::getMessageType()
 			CIRCDDBMultiClientQuery * item = popQuery(type, key);
 
 			if (item != NULL) {//is this a response to a query we've sent ?
+				networkResponded(i, item->getSentTime());
 				item->Update(user, repeater, gateway, address, timestamp, port);//update item (if needed)
 				canAddToQueue = (item->incrementResponseCount() >= m_clients.size()); //did all the clients respond or did we have an answer ?
 				wasQuery = true;
@@ -318,11 +364,8 @@ IRCDDB_RESPONSE_TYPE CIRCDDBMultiClient::getMessageType()
 				canAddToQueue = true;
 			}
 
-			if (canAddToQueue) {
-				m_responseQueueLock.lock();
-				m_responseQueue.push_back(item);
-				m_responseQueueLock.unlock();
-			}
+			if (canAddToQueue)
+				queueResponse(type, key, item, wasQuery);
 			else if (wasQuery)
 				pushQuery(type, key, item);
 
@@ -330,6 +373,11 @@ IRCDDB_RESPONSE_TYPE CIRCDDBMultiClient::getMessageType()
 		}
 	}
 
+	if (m_racing)
+		processRacingTimers();
+
+	purgeNotFound();
+
     IRCDDB_RESPONSE_TYPE result = IDRT_NONE;
 
 	m_responseQueueLock.lock();
@@ -394,6 +442,31 @@ void CIRCDDBMultiClient::close()
 	for (unsigned int i = 0; i < m_clients.size(); i++) {
 		m_clients[i]->close();
 	}
+
+	m_queriesLock.lock();
+	for (unsigned int i = 0; i < m_networks.size(); i++) {
+		if (m_networks[i].m_latency.getCount() > 0U)
+			CLog::logInfo("ircDDB Network %u response latency %s", i + 1U, m_networks[i].m_latency.toString("ms").c_str());
+	}
+	if (m_suppressedInFlight > 0UL || m_suppressedNotFound > 0UL)
+		CLog::logInfo("ircDDB queries not sent: %lu already in flight, %lu recently not found", m_suppressedInFlight, m_suppressedNotFound);
+	m_queriesLock.unlock();
+}
+
+unsigned long CIRCDDBMultiClient::getSuppressedInFlight() const
+{
+	return m_suppressedInFlight;
+}
+
+unsigned long CIRCDDBMultiClient::getSuppressedNotFound() const
+{
+	return m_suppressedNotFound;
+}
+
+unsigned int CIRCDDBMultiClient::getNotFoundCount()
+{
+	std::lock_guard lockQueries(m_queriesLock);
+	return m_notFound.size();
 }
 
 CIRCDDBMultiClientQuery * CIRCDDBMultiClient::checkAndGetNextResponse(IRCDDB_RESPONSE_TYPE expectedType, std::string errorMessage)
@@ -456,3 +529,228 @@ CIRCDDBMultiClientQuery_HashMap * CIRCDDBMultiClient::getQueriesHashMap(IRCDDB_R
 		return NULL;
 	}
 }
+
+// Answers the query from what we already know, returns false when it has to be sent
+bool CIRCDDBMultiClient::suppressQuery(IRCDDB_RESPONSE_TYPE type, const std::string& key)
+{
+	std::lock_guard lockQueries(m_queriesLock);
+	auto now = CIRCDDBMultiClientClock::now();
+
+	auto notFound = m_notFound.find(std::make_pair(type, key));
+	if (notFound != m_notFound.end()) {
+		if (now < notFound->second) {
+			m_suppressedNotFound++;
+			CIRCDDBMultiClientQuery * item = new CIRCDDBMultiClientQuery(type == IDRT_USER ? key : "", type == IDRT_REPEATER ? key : "", type == IDRT_GATEWAY ? key : "", "", "", "", type);
+			m_responseQueueLock.lock();
+			m_responseQueue.push_back(item);
+			m_responseQueueLock.unlock();
+			return true;
+		}
+		m_notFound.erase(notFound);
+	}
+
+	// The same lookup is already out, its answer will be handed to everyone waiting for it
+	CIRCDDBMultiClientQuery_HashMap * queries = getQueriesHashMap(type);
+	auto pending = queries->find(key);
+	if (pending != queries->end() && pending->second != NULL) {
+		if (now - pending->second->getSentTime() < PENDING_QUERY_TIMEOUT) {
+			m_suppressedInFlight++;
+			return true;
+		}
+		delete pending->second;
+		queries->erase(pending);
+	}
+
+	return false;
+}
+
+// Only the answers to our own queries tell that a callsign is not known, pushed updates may just lack the address
+void CIRCDDBMultiClient::queueResponse(IRCDDB_RESPONSE_TYPE type, const std::string& key, CIRCDDBMultiClientQuery * item, bool answersQuery)
+{
+	if (m_notFoundTTL.count() > 0 && (type == IDRT_USER || type == IDRT_GATEWAY || type == IDRT_REPEATER)) {
+		if (!item->getAddress().empty())
+			m_notFound.erase(std::make_pair(type, key));
+		else if (answersQuery)
+			m_notFound[std::make_pair(type, key)] = CIRCDDBMultiClientClock::now() + m_notFoundTTL;
+	}
+
+	m_responseQueueLock.lock();
+	m_responseQueue.push_back(item);
+	m_responseQueueLock.unlock();
+}
+
+// Callsigns not asked for again would otherwise stay in m_notFound forever
+void CIRCDDBMultiClient::purgeNotFound()
+{
+	std::lock_guard lockQueries(m_queriesLock);
+	auto now = CIRCDDBMultiClientClock::now();
+	if (now - m_notFoundPurge < NOT_FOUND_PURGE_INTERVAL)
+		return;
+
+	m_notFoundPurge = now;
+	for (auto it = m_notFound.begin(); it != m_notFound.end();) {
+		if (now >= it->second)
+			it = m_notFound.erase(it);
+		else
+			++it;
+	}
+}
+
+// Fastest networks first, the ones not waited for last
+std::vector<unsigned int> CIRCDDBMultiClient::getDispatchOrder()
+{
+	std::vector<unsigned int> order;
+	for (unsigned int i = 0; i < m_clients.size(); i++)
+		order.push_back(i);
+
+	if (m_racing) {
+		m_queriesLock.lock();
+		std::stable_sort(order.begin(), order.end(), [this](unsigned int a, unsigned int b) {
+			if (m_networks[a].m_slow != m_networks[b].m_slow)
+				return m_networks[b].m_slow;
+			return m_networks[a].m_latency.getPercentile(50.0) < m_networks[b].m_latency.getPercentile(50.0);
+		});
+		m_queriesLock.unlock();
+	}
+
+	return order;
+}
+
+void CIRCDDBMultiClient::networkResponded(unsigned int client, const CIRCDDBMultiClientClock::time_point& sent)
+{
+	CIRCDDBMultiClientNetwork& network = m_networks[client];
+	auto latency = std::chrono::duration_cast<std::chrono::milliseconds>(CIRCDDBMultiClientClock::now() - sent);
+	network.m_latency.add(latency.count());
+	network.m_timeouts = 0U;
+
+	if (network.m_slow) {
+		network.m_slow = false;
+		CLog::logInfo("ircDDB Network %u is answering again", client + 1U);
+	}
+}
+
+void CIRCDDBMultiClient::networksTimedOut(unsigned int respondedMask)
+{
+	for (unsigned int i = 0; i < m_networks.size(); i++) {
+		CIRCDDBMultiClientNetwork& network = m_networks[i];
+		if ((respondedMask & (1U << i)) != 0U)
+			continue;
+
+		network.m_timeouts++;
+		if (!network.m_slow && network.m_timeouts >= RACING_SLOW_TIMEOUTS) {
+			network.m_slow = true;
+			CLog::logWarning("ircDDB Network %u left %u queries unanswered, not waiting for it anymore", i + 1U, network.m_timeouts);
+		}
+	}
+}
+
+unsigned int CIRCDDBMultiClient::getAllMask() const
+{
+	return (1U << m_clients.size()) - 1U;
+}
+
+bool CIRCDDBMultiClient::isRacingQueryComplete(CIRCDDBMultiClientQuery * item, const CIRCDDBMultiClientClock::time_point& now)
+{
+	// Users have a timestamp, give the other networks a chance to know of a newer one
+	if (item->isAnswered() && (item->getType() != IDRT_USER || now - item->getFirstAnswerTime() >= m_graceWindow))
+		return true;
+
+	unsigned int expectedMask = 0U;
+	for (unsigned int i = 0; i < m_clients.size(); i++) {
+		if (!m_networks[i].m_slow && m_clients[i]->getConnectionState() == 7)
+			expectedMask |= 1U << i;
+	}
+	if (expectedMask == 0U)
+		expectedMask = getAllMask();
+
+	return (item->getRespondedMask() & expectedMask) == expectedMask;
+}
+
+void CIRCDDBMultiClient::releaseRacingQuery(IRCDDB_RESPONSE_TYPE type, const std::string& key, CIRCDDBMultiClientQuery * item, bool expectLate)
+{
+	if (expectLate && item->getRespondedMask() != getAllMask()) {
+		CIRCDDBMultiClientLateQuery& late = m_lateQueries[std::make_pair(type, key)];
+		late.m_sent = item->getSentTime();
+		late.m_timestamp = item->getTimestamp();
+		late.m_respondedMask = item->getRespondedMask();
+	}
+
+	queueResponse(type, key, item, true);
+}
+
+void CIRCDDBMultiClient::processRacingResponse(unsigned int client, IRCDDB_RESPONSE_TYPE type, const std::string& key, const std::string& user, const std::string& repeater, const std::string& gateway, const std::string& address, const std::string& timestamp, const std::string& port)
+{
+	std::lock_guard lockQueries(m_queriesLock);
+
+	CIRCDDBMultiClientQuery * item = popQuery(type, key);
+	if (item != NULL) {
+		networkResponded(client, item->getSentTime());
+		item->setResponded(client);
+		item->Answer(user, repeater, gateway, address, timestamp, port);
+
+		if (isRacingQueryComplete(item, CIRCDDBMultiClientClock::now()))
+			releaseRacingQuery(type, key, item, true);
+		else
+			pushQuery(type, key, item);
+		return;
+	}
+
+	auto late = m_lateQueries.find(std::make_pair(type, key));
+	if (late != m_lateQueries.end()) {
+		// Answer to a query we already replied to, only pass it on if it knows of something newer
+		if ((late->second.m_respondedMask & (1U << client)) == 0U) {
+			networkResponded(client, late->second.m_sent);
+			late->second.m_respondedMask |= 1U << client;
+		}
+
+		bool newer = !address.empty() && !timestamp.empty() && timestamp.compare(late->second.m_timestamp) > 0;
+		if (newer)
+			late->second.m_timestamp = timestamp;
+
+		if (late->second.m_respondedMask == getAllMask())
+			m_lateQueries.erase(late);
+
+		if (!newer)
+			return;
+	}
+
+	item = new CIRCDDBMultiClientQuery(user, repeater, gateway, address, timestamp, port, type);
+	queueResponse(type, key, item, false);
+}
+
+void CIRCDDBMultiClient::processRacingTimers()
+{
+	std::lock_guard lockQueries(m_queriesLock);
+	auto now = CIRCDDBMultiClientClock::now();
+
+	for (IRCDDB_RESPONSE_TYPE type : { IDRT_USER, IDRT_GATEWAY, IDRT_REPEATER }) {
+		CIRCDDBMultiClientQuery_HashMap * queries = getQueriesHashMap(type);
+		for (auto it = queries->begin(); it != queries->end();) {
+			CIRCDDBMultiClientQuery * item = it->second;
+			if (item == NULL) {
+				it = queries->erase(it);
+				continue;
+			}
+
+			bool timedOut = now - item->getSentTime() >= RACING_QUERY_TIMEOUT;
+			if (timedOut || isRacingQueryComplete(item, now)) {
+				// Timed out networks are accounted for here, do not wait for them any longer
+				if (timedOut)
+					networksTimedOut(item->getRespondedMask());
+				releaseRacingQuery(type, it->first, item, !timedOut);
+				it = queries->erase(it);
+			}
+			else
+				++it;
+		}
+	}
+
+	for (auto it = m_lateQueries.begin(); it != m_lateQueries.end();) {
+		if (now - it->second.m_sent >= RACING_QUERY_TIMEOUT) {
+			networksTimedOut(it->second.m_respondedMask);
+			it = m_lateQueries.erase(it);
+		}
+		else
+			++it;
+	}
+}
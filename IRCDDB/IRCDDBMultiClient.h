@@ -30,6 +30,11 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <map>
 #include <sstream> 
 #include <mutex>
+#include <chrono>
+
+#include "Histogram.h"
+
+typedef std::chrono::steady_clock CIRCDDBMultiClientClock;
 
 //Small data container to keep track of queries with sent to the inner clients
 class CIRCDDBMultiClientQuery
@@ -49,7 +54,11 @@ public:
 		m_timestamp(timestamp),
 		m_remotePort(remotePort),
 		m_type(type),
-		m_responseCount(0)
+		m_responseCount(0),
+		m_sent(CIRCDDBMultiClientClock::now()),
+		m_firstAnswer(),
+		m_answered(false),
+		m_respondedMask(0U)
 	{
 
 	}
@@ -113,6 +122,51 @@ public:
 		//wxLogMessage("After : %s"), toString());
 	}
 
+	/*
+		Racing mode update, only answers carrying an address count and among them the newest wins
+	*/
+	void Answer(const std::string& user, const std::string& repeater, const std::string& gateway, const std::string& address, const std::string& timestamp, const std::string& remotePort)
+	{
+		if (address.empty() || (m_answered && !timestamp.empty() && timestamp.compare(m_timestamp) < 0))
+			return;
+
+		m_user = user;
+		m_repeater = repeater;
+		m_gateway = gateway;
+		m_timestamp = timestamp;
+		m_remotePort = remotePort;
+		m_address = address;
+
+		if (!m_answered)
+			m_firstAnswer = CIRCDDBMultiClientClock::now();
+		m_answered = true;
+	}
+
+	bool isAnswered() const
+	{
+		return m_answered;
+	}
+
+	const CIRCDDBMultiClientClock::time_point& getSentTime() const
+	{
+		return m_sent;
+	}
+
+	const CIRCDDBMultiClientClock::time_point& getFirstAnswerTime() const
+	{
+		return m_firstAnswer;
+	}
+
+	unsigned int getRespondedMask() const
+	{
+		return m_respondedMask;
+	}
+
+	void setResponded(unsigned int client)
+	{
+		m_respondedMask |= 1U << client;
+	}
+
 	IRCDDB_RESPONSE_TYPE getType()
 	{
 		return m_type;
@@ -134,15 +188,51 @@ private:
 	std::string m_remotePort;
 	IRCDDB_RESPONSE_TYPE m_type;
 	unsigned int m_responseCount;
+	CIRCDDBMultiClientClock::time_point m_sent;
+	CIRCDDBMultiClientClock::time_point m_firstAnswer;
+	bool m_answered;
+	unsigned int m_respondedMask;
 };
 
 typedef std::map<std::string, CIRCDDBMultiClientQuery*> CIRCDDBMultiClientQuery_HashMap;
 typedef std::vector<CIRCDDBMultiClientQuery*> CIRCDDBMultiClientQuery_Array;
 
+// What is kept of a racing query once answered, to account for the networks answering after it
+class CIRCDDBMultiClientLateQuery
+{
+public:
+	CIRCDDBMultiClientClock::time_point m_sent;
+	std::string m_timestamp;
+	unsigned int m_respondedMask;
+};
+
+typedef std::map<std::pair<IRCDDB_RESPONSE_TYPE, std::string>, CIRCDDBMultiClientLateQuery> CIRCDDBMultiClientLateQuery_HashMap;
+// Callsigns ircDDB did not know of, with the time until which we trust that answer
+typedef std::map<std::pair<IRCDDB_RESPONSE_TYPE, std::string>, CIRCDDBMultiClientClock::time_point> CIRCDDBMultiClientNotFound_HashMap;
+
+// Response statistics of one ircDDB network
+class CIRCDDBMultiClientNetwork
+{
+public:
+	CIRCDDBMultiClientNetwork() :
+	m_latency(),
+	m_timeouts(0U),
+	m_slow(false)
+	{
+	}
+
+	CHistogram m_latency;		// milliseconds
+	unsigned int m_timeouts;	// consecutive queries left unanswered
+	bool m_slow;				// racing queries do not wait for this network
+};
+
 class CIRCDDBMultiClient : public CIRCDDB
 {
 public:
-	CIRCDDBMultiClient(const CIRCDDB_Array& clients);
+	// In racing mode user, repeater and gateway queries are answered on the first answer carrying an address.
+	// User answers are held for graceWindowMs in case another network knows of a newer one.
+	// Callsigns not found are answered from memory for notFoundTTL seconds, 0 disables this
+	CIRCDDBMultiClient(const CIRCDDB_Array& clients, bool racing = false, unsigned int graceWindowMs = 150U, unsigned int notFoundTTL = 0U);
 	~CIRCDDBMultiClient();
 
 	// Inherited via CIRCDDB
@@ -171,10 +261,24 @@ public:
 	virtual void sendDStarGatewayInfo(const std::string subcommand, const std::vector<std::string> parms);
 	virtual void close();
 
-	//
+	// Queries not sent because the same one was still waiting for its answer, or the callsign was recently not found
+	unsigned long getSuppressedInFlight() const;
+	unsigned long getSuppressedNotFound() const;
+
+	// Callsigns currently remembered as not found
+	unsigned int getNotFoundCount();
 
 private :
 	CIRCDDB_Array m_clients;
+	bool m_racing;
+	std::chrono::milliseconds m_graceWindow;
+	std::vector<CIRCDDBMultiClientNetwork> m_networks;
+	CIRCDDBMultiClientLateQuery_HashMap m_lateQueries;
+	std::chrono::seconds m_notFoundTTL;
+	CIRCDDBMultiClientNotFound_HashMap m_notFound;
+	CIRCDDBMultiClientClock::time_point m_notFoundPurge;
+	unsigned long m_suppressedInFlight;
+	unsigned long m_suppressedNotFound;
 	std::recursive_mutex m_queriesLock;
 	std::recursive_mutex m_responseQueueLock;
 
@@ -187,5 +291,17 @@ private :
 	void pushQuery(IRCDDB_RESPONSE_TYPE type, const std::string& key,  CIRCDDBMultiClientQuery * query);
 	CIRCDDBMultiClientQuery * popQuery(IRCDDB_RESPONSE_TYPE type, const std::string& key);
 	CIRCDDBMultiClientQuery_HashMap * getQueriesHashMap(IRCDDB_RESPONSE_TYPE type);
+
+	bool suppressQuery(IRCDDB_RESPONSE_TYPE type, const std::string& key);
+	void queueResponse(IRCDDB_RESPONSE_TYPE type, const std::string& key, CIRCDDBMultiClientQuery * item, bool answersQuery);
+	void purgeNotFound();
+	std::vector<unsigned int> getDispatchOrder();
+	void networkResponded(unsigned int client, const CIRCDDBMultiClientClock::time_point& sent);
+	void networksTimedOut(unsigned int respondedMask);
+	unsigned int getAllMask() const;
+	bool isRacingQueryComplete(CIRCDDBMultiClientQuery * item, const CIRCDDBMultiClientClock::time_point& now);
+	void releaseRacingQuery(IRCDDB_RESPONSE_TYPE type, const std::string& key, CIRCDDBMultiClientQuery * item, bool expectLate);
+	void processRacingResponse(unsigned int client, IRCDDB_RESPONSE_TYPE type, const std::string& key, const std::string& user, const std::string& repeater, const std::string& gateway, const std::string& address, const std::string& timestamp, const std::string& port);
+	void processRacingTimers();
 };
 
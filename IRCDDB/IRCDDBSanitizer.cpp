@@ -0,0 +1,74 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <array>
+#include <algorithm>
+
+#include "IRCDDBSanitizer.h"
+
+typedef std::array<bool, 256> TCharTable;
+
+static constexpr TCharTable makeTable(const char* extra, bool lower, bool graph)
+{
+	TCharTable table = {};
+
+	for (unsigned int c = 0U; c < 256U; c++) {
+		if (graph)
+			table[c] = c >= 0x21U && c <= 0x7EU;
+		else
+			table[c] = (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || (lower && c >= 'a' && c <= 'z');
+	}
+
+	for (const char* p = extra; *p != '\0'; p++)
+		table[(unsigned char)*p] = true;
+
+	return table;
+}
+
+static constexpr TCharTable CALLSIGN_CHARS    = makeTable("/_", false, false);
+static constexpr TCharTable GRAPH_CHARS       = makeTable("", false, true);
+static constexpr TCharTable DESCRIPTION_CHARS = makeTable(" +&(),./'-", true, false);
+
+static void removeNotIn(std::string& text, const TCharTable& table)
+{
+	text.erase(std::remove_if(text.begin(), text.end(), [&table](char c) { return !table[(unsigned char)c]; }), text.end());
+}
+
+void IRCDDBSanitizer::sanitizeCallsign(std::string& callsign)
+{
+	for (char& c : callsign) {
+		if (!CALLSIGN_CHARS[(unsigned char)c])
+			c = '_';
+	}
+}
+
+void IRCDDBSanitizer::appendCallsign(std::string& buffer, const std::string& callsign)
+{
+	for (char c : callsign)
+		buffer.push_back(CALLSIGN_CHARS[(unsigned char)c] ? c : '_');
+}
+
+void IRCDDBSanitizer::removeNonGraph(std::string& text)
+{
+	removeNotIn(text, GRAPH_CHARS);
+}
+
+void IRCDDBSanitizer::removeNonDescription(std::string& text)
+{
+	removeNotIn(text, DESCRIPTION_CHARS);
+}
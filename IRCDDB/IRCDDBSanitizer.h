@@ -0,0 +1,38 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <string>
+
+// In place replacements for the per call regular expressions used to clean what is sent to ircDDB,
+// each character is checked against a table built at compile time
+class IRCDDBSanitizer
+{
+public:
+	// Replaces every character but A-Z 0-9 / _ with _
+	static void sanitizeCallsign(std::string& callsign);
+	// Same as above while appending to buffer
+	static void appendCallsign(std::string& buffer, const std::string& callsign);
+
+	// Removes every character that is not printable or is a space, same as [^[:graph:]]
+	static void removeNonGraph(std::string& text);
+
+	// Removes every character not allowed in a QTH description, same as [^a-zA-Z0-9 +&(),./'-]
+	static void removeNonDescription(std::string& text);
+};
@@ -0,0 +1,166 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <cctype>
+#include <cstring>
+
+#include "IRCDDBUpdateParser.h"
+
+static inline bool isDigit(char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+static inline unsigned int toNumber(char tens, char units)
+{
+	return (unsigned int)(tens - '0') * 10U + (unsigned int)(units - '0');
+}
+
+IRCDDB_UPDATE_RESULT IRCDDBUpdateParser::parse(std::string_view line, int numberOfTables, TIRCDDBUpdate& update)
+{
+	update.tableID = 0;
+
+	std::string_view token = nextToken(line);
+	if (token.empty())
+		return IUR_INVALID;
+
+	if (isTableID(token)) {
+		update.tableID = token[0] - '0';
+		if (update.tableID >= numberOfTables)
+			return IUR_INVALID_TABLE;
+
+		token = nextToken(line);
+		if (token.empty())
+			return IUR_INVALID;
+	}
+
+	if (!isDate(token))
+		return IUR_INVALID;
+	update.date = token;
+
+	update.time = nextToken(line);
+	if (!isTime(update.time))
+		return IUR_INVALID;
+
+	update.key = nextToken(line);
+	if (!isKey(update.key))
+		return IUR_INVALID;
+
+	update.value = nextToken(line);
+	if (!isKey(update.value))
+		return IUR_INVALID;
+
+	return IUR_VALID;
+}
+
+std::string_view IRCDDBUpdateParser::nextToken(std::string_view& line)
+{
+	size_t start = 0U;
+	while (start < line.size() && ::isspace((unsigned char)line[start]))
+		start++;
+
+	size_t end = start;
+	while (end < line.size() && !::isspace((unsigned char)line[end]))
+		end++;
+
+	std::string_view token = line.substr(start, end - start);
+	line.remove_prefix(end);
+
+	return token;
+}
+
+bool IRCDDBUpdateParser::isTableID(std::string_view token)
+{
+	return token.size() == 1U && isDigit(token[0]);
+}
+
+bool IRCDDBUpdateParser::isDate(std::string_view token)
+{
+	if (token.size() != 10U || token[0] != '2' || token[1] != '0' || token[4] != '-' || token[7] != '-')
+		return false;
+
+	if (!isDigit(token[2]) || !isDigit(token[3]) || !isDigit(token[5]) || !isDigit(token[6]) || !isDigit(token[8]) || !isDigit(token[9]))
+		return false;
+
+	unsigned int month = toNumber(token[5], token[6]);
+	unsigned int day   = toNumber(token[8], token[9]);
+
+	return month >= 1U && month <= 12U && day >= 1U && day <= 31U;
+}
+
+bool IRCDDBUpdateParser::isTime(std::string_view token)
+{
+	if (token.size() != 8U || token[2] != ':' || token[5] != ':')
+		return false;
+
+	if (!isDigit(token[0]) || !isDigit(token[1]) || !isDigit(token[3]) || !isDigit(token[4]) || !isDigit(token[6]) || !isDigit(token[7]))
+		return false;
+
+	return toNumber(token[0], token[1]) <= 23U && token[3] <= '5' && token[6] <= '5';
+}
+
+bool IRCDDBUpdateParser::isKey(std::string_view token)
+{
+	if (token.size() != 8U)
+		return false;
+
+	for (char c : token) {
+		if (!isDigit(c) && !(c >= 'A' && c <= 'Z') && c != '_')
+			return false;
+	}
+
+	return true;
+}
+
+std::string_view IRCDDBUpdateParser::getFromNick(std::string_view line)
+{
+	const std::string_view from("(from: ");
+
+	size_t start = line.find(from);
+	if (start == std::string_view::npos)
+		return std::string_view();
+
+	start += from.size();
+
+	// Greedy up to the last closing parenthesis, not crossing a line break
+	size_t end = line.find_first_of("\r\n", start);
+	if (end != std::string_view::npos)
+		line = line.substr(0U, end);
+
+	size_t close = line.rfind(')');
+	if (close == std::string_view::npos || close < start)
+		return std::string_view();
+
+	return line.substr(start, close - start);
+}
+
+time_t IRCDDBUpdateParser::parseTime(std::string_view date, std::string_view time)
+{
+	struct tm stm;
+	::memset(&stm, 0, sizeof(struct tm));
+
+	stm.tm_year  = int(toNumber(date[0], date[1]) * 100U + toNumber(date[2], date[3])) - 1900;
+	stm.tm_mon   = int(toNumber(date[5], date[6])) - 1;
+	stm.tm_mday  = int(toNumber(date[8], date[9]));
+	stm.tm_hour  = int(toNumber(time[0], time[1]));
+	stm.tm_min   = int(toNumber(time[3], time[4]));
+	stm.tm_sec   = int(toNumber(time[6], time[7]));
+	stm.tm_isdst = -1;
+
+	return ::mktime(&stm);
+}
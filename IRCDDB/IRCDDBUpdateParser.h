@@ -0,0 +1,59 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <string_view>
+#include <ctime>
+
+enum IRCDDB_UPDATE_RESULT {
+	IUR_INVALID,		// Not an update line, or a malformed one
+	IUR_INVALID_TABLE,	// Table ID out of range
+	IUR_VALID
+};
+
+// Fields of an ircDDB "[table] date time key value" update line, they point into the parsed line
+typedef struct {
+	int              tableID;
+	std::string_view date;
+	std::string_view time;
+	std::string_view key;
+	std::string_view value;
+} TIRCDDBUpdate;
+
+// Validates and splits ircDDB update lines without regular expressions nor allocations.
+// Tokens are separated by white space the same way CUtils::stringTokenizer does.
+class IRCDDBUpdateParser
+{
+public:
+	static IRCDDB_UPDATE_RESULT parse(std::string_view line, int numberOfTables, TIRCDDBUpdate& update);
+
+	// Returns the next token and removes it from line, empty when there is none left
+	static std::string_view nextToken(std::string_view& line);
+
+	static bool isTableID(std::string_view token);	// ^[0-9]$
+	static bool isDate(std::string_view token);		// 20YY-MM-DD
+	static bool isTime(std::string_view token);		// HH:MM:SS
+	static bool isKey(std::string_view token);		// ^[0-9A-Z_]{8}$
+
+	// Nick in the "(from: nick)" trailer, empty when there is none
+	static std::string_view getFromNick(std::string_view line);
+
+	// Local time of validated date and time tokens
+	static time_t parseTime(std::string_view date, std::string_view time);
+};
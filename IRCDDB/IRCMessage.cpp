@@ -55,6 +55,47 @@ void IRCMessage::addParam(const std::string& p)
 	m_numParams = m_params.size();
 }
 
+std::string& IRCMessage::newParam()
+{
+	if (m_spareParams.empty()) {
+		m_params.emplace_back();
+	} else {
+		m_params.push_back(std::move(m_spareParams.back()));
+		m_spareParams.pop_back();
+		m_params.back().clear();
+	}
+
+	m_numParams = m_params.size();
+	return m_params.back();
+}
+
+void IRCMessage::clear()
+{
+	m_prefix.clear();
+	m_command.clear();
+
+	while (! m_params.empty()) {
+		m_spareParams.push_back(std::move(m_params.back()));
+		m_params.pop_back();
+	}
+
+	m_numParams = 0;
+	m_prefixComponents.clear();
+	m_prefixParsed = false;
+}
+
+IRCMessage *IRCMessage::newPooled()
+{
+	// Room for a typical server line, so filling it in does not have to grow the strings
+	IRCMessage *m = new IRCMessage();
+	m->m_prefix.reserve(64U);
+	m->m_command.reserve(16U);
+	m->m_params.reserve(15U);
+	m->m_spareParams.reserve(15U);
+
+	return m;
+}
+
 int IRCMessage::getParamCount()
 {
 	return m_params.size();
@@ -42,6 +42,12 @@ public:
 	std::string& getPrefixHost();
 	void composeMessage(std::string& output);
 	void addParam(const std::string& p);
+	// Appends an empty parameter, reusing the storage of a cleared one when there is any
+	std::string& newParam();
+
+	// Empties the message while keeping the allocated storage, for reuse from a pool
+	void clear();
+	static IRCMessage *newPooled();
 
 	std::string getCommand();
 	std::string getParam(int pos);
@@ -51,4 +57,5 @@ private:
 	bool parsePrefix();
 	std::vector<std::string> m_prefixComponents;
 	bool m_prefixParsed;
+	std::vector<std::string> m_spareParams;
 };
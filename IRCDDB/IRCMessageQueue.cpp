@@ -26,6 +26,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "IRCMessageQueue.h"
 
+// Above this many idle messages the recycled ones are freed
+#define IRCMESSAGE_POOL_MAX 1024U
+
 IRCMessageQueue::IRCMessageQueue()
 {
 	m_eof = false;
@@ -34,10 +37,16 @@ IRCMessageQueue::IRCMessageQueue()
 IRCMessageQueue::~IRCMessageQueue()
 {
 	std::lock_guard lockAccessQueue(m_accessMutex);
-	while (! m_queue.empty()) {
-		delete m_queue.front();
-		m_queue.pop();
-	}
+	for (auto m : m_drained)
+		delete m;
+	for (auto m : m_queue)
+		delete m;
+
+	std::lock_guard lockFree(m_freeMutex);
+	for (auto m : m_freeDrained)
+		delete m;
+	for (auto m : m_free)
+		delete m;
 }
 
 bool IRCMessageQueue::isEOF()
@@ -50,37 +59,69 @@ void IRCMessageQueue::signalEOF()
 	m_eof = true;
 }
 
-bool IRCMessageQueue::messageAvailable()
+bool IRCMessageQueue::drain()
 {
-  std::lock_guard lockAccessQueue(m_accessMutex);
-  bool retv = ! m_queue.empty();
+	if (m_drained.empty()) {
+		std::lock_guard lockAccessQueue(m_accessMutex);
+		m_drained.swap(m_queue);
+	}
 
-  return retv;
+	return ! m_drained.empty();
+}
+
+bool IRCMessageQueue::messageAvailable()
+{
+	return drain();
 }
 
 IRCMessage *IRCMessageQueue::peekFirst()
 {
-	std::lock_guard lockAccessQueue(m_accessMutex);
-	IRCMessage *msg = m_queue.empty() ? NULL : m_queue.front();
-	return msg;
+	return drain() ? m_drained.front() : NULL;
 }
 
 IRCMessage *IRCMessageQueue::getMessage()
 {
-	std::lock_guard lockAccessQueue(m_accessMutex);
-	IRCMessage *msg = m_queue.empty() ? NULL : m_queue.front();
-	if (msg)
-		m_queue.pop();
-	
+	if (! drain())
+		return NULL;
+
+	IRCMessage *msg = m_drained.front();
+	m_drained.pop_front();
+
 	return msg;
 }
 
 void IRCMessageQueue::putMessage(IRCMessage *m)
 {
 	std::lock_guard lockAccessQueue(m_accessMutex);
-	m_queue.push(m);
+	m_queue.push_back(m);
 }
 
+IRCMessage *IRCMessageQueue::getFreeMessage()
+{
+	if (m_freeDrained.empty()) {
+		std::lock_guard lockFree(m_freeMutex);
+		m_freeDrained.swap(m_free);
+	}
 
+	if (m_freeDrained.empty())
+		return IRCMessage::newPooled();
 
+	IRCMessage *msg = m_freeDrained.back();
+	m_freeDrained.pop_back();
 
+	return msg;
+}
+
+void IRCMessageQueue::recycleMessage(IRCMessage *m)
+{
+	if (m == NULL)
+		return;
+
+	m->clear();
+
+	std::lock_guard lockFree(m_freeMutex);
+	if (m_free.size() < IRCMESSAGE_POOL_MAX)
+		m_free.push_back(m);
+	else
+		delete m;
+}
@@ -27,10 +27,13 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #pragma once
 
 #include <mutex>
-#include <queue>
+#include <deque>
+#include <vector>
 
 #include "IRCMessage.h"
 
+// Any thread may put messages, only one thread may get them. The consumer swaps out
+// everything pending in one lock and then works through it without locking
 class IRCMessageQueue
 {
 public:
@@ -44,9 +47,22 @@ public:
 	IRCMessage *peekFirst();
 	void putMessage(IRCMessage *m);
 
+	// Pool of recycled messages, the producer takes its messages from here and the consumer gives them back
+	IRCMessage *getFreeMessage();
+	void recycleMessage(IRCMessage *m);
+
 private:
 	bool m_eof;
 	std::mutex m_accessMutex;
-	std::queue<IRCMessage *> m_queue;
+	std::deque<IRCMessage *> m_queue;
+	// Only touched by the consumer, refilled by swapping it with m_queue once empty
+	std::deque<IRCMessage *> m_drained;
+
+	std::mutex m_freeMutex;
+	std::vector<IRCMessage *> m_free;
+	// Only touched by the producer, refilled by swapping it with m_free once empty
+	std::vector<IRCMessage *> m_freeDrained;
+
+	bool drain();
 };
 
@@ -139,7 +139,7 @@ bool IRCProtocol::processQueues(IRCMessageQueue *recvQ, IRCMessageQueue *sendQ)
 			if (m->m_numParams>=2 && 0==m->m_params[0].compare(m_channel)) {
 				if (0 == m->m_params[1].compare(m_currentNick)) {
 					// i was kicked!!
-					delete m;
+					recvQ->recycleMessage(m);
 					return false;
 				} else if (m_app)
 					m_app->userLeave(m->m_params[1]);
@@ -186,7 +186,7 @@ bool IRCProtocol::processQueues(IRCMessageQueue *recvQ, IRCMessageQueue *sendQ)
 				m_app->setTopic(m->m_params[1]);
 		}
 
-		delete m;
+		recvQ->recycleMessage(m);
 	}
 
 	IRCMessage *m;
@@ -26,6 +26,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "Utils.h"
 #include "Log.h"
 
+#define IRC_RECEIVE_BUFFER_SIZE 4096
+
 IRCReceiver::IRCReceiver(int sock, IRCMessageQueue *q)
 {
 	m_sock = sock;
@@ -89,16 +91,15 @@ static int doRead(int sock, char *buf, int buf_size)
 
 void IRCReceiver::Entry()
 {
-	IRCMessage *m = new IRCMessage();
+	IRCMessage *m = m_recvQ->getFreeMessage();
 	int state = 0;
+	char buf[IRC_RECEIVE_BUFFER_SIZE];
 
 	while (! m_terminateThread) {
-		char buf[200];
 		int r = doRead(m_sock, buf, sizeof buf);
 
 		if (r < 0) {
 			m_recvQ->signalEOF();
-			delete m;  // delete unfinished IRCMessage
 			break;
 		}
 
@@ -107,7 +108,7 @@ void IRCReceiver::Entry()
 			if (b > 0) {
 				if (b == '\n') {
 					m_recvQ->putMessage(m);
-					m = new IRCMessage();
+					m = m_recvQ->getFreeMessage();
 					state = 0;
 				}
 				else if (b != '\r') {
@@ -131,18 +132,16 @@ void IRCReceiver::Entry()
 						case 2:
 							if (b == ' ') {
 								state = 3; // params are next
-								m->m_numParams = 1;
-								m->m_params.push_back(std::string(""));
+								m->newParam();
 							} else
 								m->m_command.push_back(b);
 							break;
 
 						case 3:
 							if (b == ' ') {
-								m->m_numParams++;
-								if (m->m_numParams >= 15)
+								if (m->m_numParams + 1 >= 15)
 									state = 5; // ignore the rest
-								m->m_params.push_back(std::string(""));
+								m->newParam();
 							} else if (b==':' && m->m_params[m->m_numParams-1].size()==0)
 								state = 4; // rest of line is this param
 							else
@@ -150,13 +149,21 @@ void IRCReceiver::Entry()
 							break;
 
 						case 4:
-							m->m_params[m->m_numParams-1].push_back(b);
+							{
+								// rest of line, copy the whole run in one go
+								int j = i + 1;
+								while (j < r && buf[j] > 0 && buf[j] != '\n' && buf[j] != '\r')
+									j++;
+								m->m_params[m->m_numParams-1].append(buf + i, j - i);
+								i = j - 1;
+							}
 							break;
 					} // switch
 				}
 			} // if
 		} // for
 	} // while
+
+	m_recvQ->recycleMessage(m);  // unfinished IRCMessage
 	return;
 }
-
@@ -20,9 +20,11 @@
 #include <filesystem>
 #include <string>
 #include <vector>
+#include <cstring>
 
 #include "AMBEFileReader.h"
 #include "AMBEData.h"
+#include "DStarDefines.h"
 
 namespace AMBEFileReaderTests
 {
@@ -112,4 +114,26 @@ namespace AMBEFileReaderTests
             delete d;
         }
     }
-}
\ No newline at end of file
+
+    TEST_F(AMBEFileReader_lookup, voiceMatchesFrames)
+    {
+        std::string indexFile = std::string(std::filesystem::current_path()) + "/AMBEFileReader/fr_FR.indx";
+        std::string ambeFile = std::string(std::filesystem::current_path()) + "/AMBEFileReader/fr_FR.ambe";
+        CAMBEFileReader reader(indexFile, ambeFile);
+        EXPECT_TRUE(reader.read());
+
+        std::vector<CAMBEData *> data;
+        std::vector<unsigned char> voice;
+        EXPECT_TRUE(reader.lookup("0", data));
+        EXPECT_TRUE(reader.lookup("0", voice));
+        EXPECT_FALSE(reader.lookup("This Id does not exist", voice));
+        ASSERT_EQ(voice.size(), data.size() * VOICE_FRAME_LENGTH_BYTES);
+
+        for(unsigned int i = 0U; i < data.size(); i++) {
+            unsigned char buffer[DV_FRAME_LENGTH_BYTES];
+            data[i]->getData(buffer, DV_FRAME_LENGTH_BYTES);
+            EXPECT_EQ(::memcmp(buffer, voice.data() + i * VOICE_FRAME_LENGTH_BYTES, VOICE_FRAME_LENGTH_BYTES), 0);
+            delete data[i];
+        }
+    }
+}
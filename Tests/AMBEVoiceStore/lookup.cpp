@@ -0,0 +1,152 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstring>
+
+#include "AMBEFileReader.h"
+#include "AMBEVoiceStore.h"
+#include "DStarDefines.h"
+
+namespace AMBEVoiceStoreTests
+{
+    class AMBEVoiceStore_lookup : public ::testing::Test {
+    protected:
+        void SetUp() override
+        {
+            m_dir = std::filesystem::temp_directory_path() / ("AMBEVoiceStore_" + std::to_string(::getpid()));
+            std::filesystem::create_directories(m_dir);
+
+            m_indexFile = std::string(std::filesystem::current_path()) + "/AMBEFileReader/fr_FR.indx";
+            m_ambeFile = std::string(std::filesystem::current_path()) + "/AMBEFileReader/fr_FR.ambe";
+            m_compiledFile = m_dir / "fr_FR.ambx";
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove_all(m_dir);
+        }
+
+        std::vector<std::string> readIds()
+        {
+            std::vector<std::string> ids = { " " };
+            std::ifstream index(m_indexFile);
+            std::string line;
+            while (std::getline(index, line)) {
+                std::istringstream fields(line);
+                std::string name;
+                if (fields >> name && name[0] != '#')
+                    ids.push_back(name);
+            }
+
+            return ids;
+        }
+
+        std::filesystem::path m_dir;
+        std::string m_indexFile;
+        std::string m_ambeFile;
+        std::string m_compiledFile;
+    };
+
+    TEST_F(AMBEVoiceStore_lookup, nonExistentFile)
+    {
+        CAMBEVoiceStore store;
+        EXPECT_FALSE(store.open("/this/file/does/not/exist"));
+        EXPECT_FALSE(store.isOpen());
+
+        const unsigned char* voice = nullptr;
+        unsigned int frames = 0U;
+        EXPECT_FALSE(store.lookup("0", voice, frames));
+    }
+
+    TEST_F(AMBEVoiceStore_lookup, invalidFile)
+    {
+        EXPECT_FALSE(CAMBEVoiceStore().open(m_indexFile)) << "open shall reject files which are not compiled voice files";
+
+        std::ofstream truncated(m_compiledFile, std::ios::binary);
+        truncated.write("AMBX\x01\x00\x00\x00\xff\xff\x00\x00", 12);
+        truncated.close();
+
+        EXPECT_FALSE(CAMBEVoiceStore().open(m_compiledFile)) << "open shall reject truncated files";
+    }
+
+    TEST_F(AMBEVoiceStore_lookup, compiledMatchesSource)
+    {
+        CAMBEFileReader source(m_indexFile, m_ambeFile);
+        ASSERT_TRUE(source.readSource());
+        ASSERT_TRUE(source.compile(m_compiledFile));
+
+        CAMBEVoiceStore store;
+        ASSERT_TRUE(store.open(m_compiledFile));
+
+        std::vector<std::string> ids = readIds();
+        unsigned int found = 0U;
+        for (const auto& id : ids) {
+            const unsigned char* expected = nullptr;
+            unsigned int expectedFrames = 0U;
+            bool inSource = source.lookup(id, expected, expectedFrames);
+
+            const unsigned char* voice = nullptr;
+            unsigned int frames = 0U;
+            ASSERT_EQ(store.lookup(id, voice, frames), inSource) << id;
+            if (!inSource)
+                continue;
+
+            found++;
+            ASSERT_EQ(frames, expectedFrames) << id;
+            EXPECT_EQ(::memcmp(voice, expected, frames * VOICE_FRAME_LENGTH_BYTES), 0) << id;
+        }
+
+        EXPECT_EQ(store.getEntryCount(), found);
+
+        const unsigned char* voice = nullptr;
+        unsigned int frames = 0U;
+        EXPECT_FALSE(store.lookup("This Id does not exist", voice, frames));
+    }
+
+    TEST_F(AMBEVoiceStore_lookup, readerPrefersCompiledFile)
+    {
+        std::string indexFile = m_dir / "fr_FR.indx";
+        std::string ambeFile = m_dir / "fr_FR.ambe";
+        std::filesystem::copy_file(m_indexFile, indexFile);
+        std::filesystem::copy_file(m_ambeFile, ambeFile);
+
+        CAMBEFileReader source(indexFile, ambeFile);
+        ASSERT_TRUE(source.readSource());
+        ASSERT_TRUE(source.compile(CAMBEFileReader::getCompiledFileName(ambeFile)));
+        EXPECT_EQ(CAMBEFileReader::getCompiledFileName(ambeFile), m_compiledFile);
+
+        // Without its sources, the reader can only succeed through the compiled file
+        std::filesystem::remove(indexFile);
+        std::filesystem::remove(ambeFile);
+
+        CAMBEFileReader reader(indexFile, ambeFile);
+        ASSERT_TRUE(reader.read());
+
+        std::vector<unsigned char> expected, voice;
+        EXPECT_TRUE(source.lookup("0", expected));
+        EXPECT_TRUE(reader.lookup("0", voice));
+        EXPECT_NE(voice.size(), 0U);
+        EXPECT_EQ(voice, expected);
+    }
+}
@@ -0,0 +1,80 @@
+/*
+ *   Copyright (c) 2021-2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+
+#include "APRSParser.h"
+
+namespace APRSParserTests
+{
+    class APRSParser_parseAPRSFrameView : public ::testing::Test {
+    
+    };
+
+    TEST_F(APRSParser_parseAPRSFrameView, pointsIntoParsedText)
+    {
+        std::string line("N0CALL>APRS,WIDE1-1,WIDE2-2::F4ABC    :Test Message");
+        CAPRSFrameView aprsFrame;
+        bool retVal = CAPRSParser::parseFrame(std::string_view(line), aprsFrame);
+
+        EXPECT_TRUE(retVal);
+        EXPECT_EQ(aprsFrame.getSource(), "N0CALL");
+        EXPECT_EQ(aprsFrame.getDestination(), "APRS");
+        EXPECT_EQ(aprsFrame.getBody(), ":F4ABC    :Test Message");
+        EXPECT_EQ(aprsFrame.getType(), APFT_MESSAGE);
+        ASSERT_EQ(aprsFrame.getPath().size(), 2U);
+        EXPECT_EQ(aprsFrame.getPath()[0], "WIDE1-1");
+        EXPECT_EQ(aprsFrame.getPath()[1], "WIDE2-2");
+        EXPECT_EQ(aprsFrame.getSource().data(), line.data());
+        EXPECT_EQ(aprsFrame.getBody().data(), line.data() + 28);
+    }
+
+    TEST_F(APRSParser_parseAPRSFrameView, reusedForInvalidFrame)
+    {
+        CAPRSFrameView aprsFrame;
+        EXPECT_TRUE(CAPRSParser::parseFrame(std::string_view("N0CALL>APRS,WIDE1-1:>Status"), aprsFrame));
+
+        EXPECT_FALSE(CAPRSParser::parseFrame(std::string_view("N0CALL>APRS,,WIDE1-1:>Status"), aprsFrame));
+        EXPECT_TRUE(aprsFrame.getSource().empty());
+        EXPECT_TRUE(aprsFrame.getDestination().empty());
+        EXPECT_TRUE(aprsFrame.getBody().empty());
+        EXPECT_EQ(aprsFrame.getPath().size(), 0U);
+        EXPECT_EQ(aprsFrame.getType(), APFT_UNKNOWN);
+    }
+
+    TEST_F(APRSParser_parseAPRSFrameView, shortMessageIsInvalid)
+    {
+        CAPRSFrameView aprsFrame;
+        EXPECT_FALSE(CAPRSParser::parseFrame(std::string_view("N0CALL>APRS::F4A"), aprsFrame));
+    }
+
+    TEST_F(APRSParser_parseAPRSFrameView, toFrameWithoutPath)
+    {
+        CAPRSFrameView aprsFrame;
+        ASSERT_TRUE(CAPRSParser::parseFrame(std::string_view("F4FXL-8>API51,DSTAR:!1234.56N/12345.67E[/A=000886QRV DStar"), aprsFrame));
+
+        CAPRSFrame frame;
+        aprsFrame.toFrame(frame, false);
+        EXPECT_EQ(frame.getSource(), "F4FXL-8");
+        EXPECT_EQ(frame.getDestination(), "API51");
+        EXPECT_EQ(frame.getBody(), "!1234.56N/12345.67E[/A=000886QRV DStar");
+        EXPECT_EQ(frame.getType(), APFT_POSITION);
+        EXPECT_EQ(frame.getPath().size(), 0U);
+    }
+}
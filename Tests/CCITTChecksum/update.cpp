@@ -0,0 +1,87 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+#include "CCITTChecksum.h"
+
+namespace CCITTChecksumTests
+{
+    // Bit at a time over the reflected 0x8408 polynomial
+    static uint16_t referenceCRC(const unsigned char* data, unsigned int length)
+    {
+        uint16_t crc = 0xFFFFU;
+
+        for (unsigned int i = 0U; i < length; i++) {
+            crc ^= data[i];
+            for (unsigned int n = 0U; n < 8U; n++)
+                crc = (crc & 0x0001U) != 0U ? (crc >> 1) ^ 0x8408U : crc >> 1;
+        }
+
+        return ~crc;
+    }
+
+    class CCITTChecksum_update : public ::testing::Test {
+
+    };
+
+    TEST_F(CCITTChecksum_update, matchesReference)
+    {
+        std::mt19937 random(49U);
+        std::vector<unsigned char> data(1100U);
+        for (auto& byte : data)
+            byte = (unsigned char)random();
+
+        for (unsigned int offset = 0U; offset < 8U; offset++) {
+            for (unsigned int length = 0U; length + offset <= data.size(); length++) {
+                CCCITTChecksum checksum;
+                checksum.update(data.data() + offset, length);
+
+                unsigned char result[2U];
+                checksum.result(result);
+
+                uint16_t expected = referenceCRC(data.data() + offset, length);
+                ASSERT_EQ(result[0], expected & 0xFFU) << "offset " << offset << " length " << length;
+                ASSERT_EQ(result[1], expected >> 8) << "offset " << offset << " length " << length;
+            }
+        }
+    }
+
+    TEST_F(CCITTChecksum_update, splitUpdates)
+    {
+        std::mt19937 random(490U);
+        unsigned char data[41U];
+        for (auto& byte : data)
+            byte = (unsigned char)random();
+
+        CCCITTChecksum whole;
+        whole.update(data, 39U);
+        unsigned char sum[2U];
+        whole.result(sum);
+
+        for (unsigned int split = 0U; split <= 39U; split++) {
+            CCCITTChecksum checksum;
+            checksum.update(data, split);
+            checksum.update(data + split, 39U - split);
+
+            EXPECT_TRUE(checksum.check(sum)) << "split " << split;
+        }
+    }
+}
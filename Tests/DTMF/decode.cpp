@@ -0,0 +1,183 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "DTMF.h"
+#include "DStarDefines.h"
+
+namespace DTMFTests
+{
+    // The symbol lookup as it was before the table, kept as the reference
+    static char referenceSymbol(const unsigned char* ambe)
+    {
+        const unsigned char MASK[] = {0x82U, 0x08U, 0x20U, 0x82U, 0x00U, 0x00U, 0x82U, 0x00U, 0x00U};
+        const unsigned char SIG[]  = {0x82U, 0x08U, 0x20U, 0x82U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U};
+        const unsigned char SYMBOLS[16U][4U] = {
+            {0x00U, 0x40U, 0x08U, 0x20U}, {0x00U, 0x00U, 0x00U, 0x00U}, {0x00U, 0x40U, 0x00U, 0x00U}, {0x10U, 0x00U, 0x00U, 0x00U},
+            {0x00U, 0x00U, 0x00U, 0x20U}, {0x00U, 0x40U, 0x00U, 0x20U}, {0x10U, 0x00U, 0x00U, 0x20U}, {0x00U, 0x00U, 0x08U, 0x00U},
+            {0x00U, 0x40U, 0x08U, 0x00U}, {0x10U, 0x00U, 0x08U, 0x00U}, {0x10U, 0x40U, 0x00U, 0x00U}, {0x10U, 0x40U, 0x00U, 0x20U},
+            {0x10U, 0x40U, 0x08U, 0x00U}, {0x10U, 0x40U, 0x08U, 0x20U}, {0x00U, 0x00U, 0x08U, 0x20U}, {0x10U, 0x00U, 0x08U, 0x20U}
+        };
+        const char CHARS[] = "0123456789ABCD*#";
+
+        for (unsigned int i = 0U; i < 9U; i++) {
+            if ((ambe[i] & MASK[i]) != SIG[i])
+                return 0;
+        }
+
+        unsigned char sym0 = ambe[4] & 0x10U;
+        unsigned char sym1 = ambe[5] & 0x40U;
+        unsigned char sym2 = ambe[7] & 0x08U;
+        unsigned char sym3 = ambe[8] & 0x20U;
+
+        for (unsigned int i = 0U; i < 16U; i++) {
+            if (sym0 == SYMBOLS[i][0] && sym1 == SYMBOLS[i][1] && sym2 == SYMBOLS[i][2] && sym3 == SYMBOLS[i][3])
+                return CHARS[i];
+        }
+
+        return ' ';
+    }
+
+    // Sets the twelve bits taking part in the signature and the symbol from bits, the others are random
+    static void buildFrame(unsigned int bits, std::mt19937& random, unsigned char* ambe)
+    {
+        const unsigned int BYTES[] = {0U, 0U, 1U, 2U, 3U, 3U, 6U, 6U, 4U, 5U, 7U, 8U};
+        const unsigned char MASKS[] = {0x80U, 0x02U, 0x08U, 0x20U, 0x80U, 0x02U, 0x80U, 0x02U, 0x10U, 0x40U, 0x08U, 0x20U};
+
+        for (unsigned int i = 0U; i < VOICE_FRAME_LENGTH_BYTES; i++)
+            ambe[i] = (unsigned char)random();
+
+        for (unsigned int i = 0U; i < 12U; i++) {
+            if ((bits & (1U << i)) != 0U)
+                ambe[BYTES[i]] |= MASKS[i];
+            else
+                ambe[BYTES[i]] &= ~MASKS[i];
+        }
+    }
+
+    // The symbol bits of buildFrame for each of "0123456789ABCD*#"
+    const unsigned int SYMBOL_BITS[16U] = {
+        0b1110U, 0b0000U, 0b0010U, 0b0001U, 0b1000U, 0b1010U, 0b1001U, 0b0100U,
+        0b0110U, 0b0101U, 0b0011U, 0b1011U, 0b0111U, 0b1111U, 0b1100U, 0b1101U
+    };
+    const char SYMBOL_CHARS[] = "0123456789ABCD*#";
+
+    // Valid signature: the set bits of bytes 0 to 3 and the cleared bits of byte 6
+    const unsigned int SIGNATURE_BITS = 0x3FU;
+
+    class DTMF_decode : public ::testing::Test {
+
+    };
+
+    TEST_F(DTMF_decode, everySignatureAndSymbol)
+    {
+        std::mt19937 random(48U);
+
+        for (unsigned int bits = 0U; bits < 4096U; bits++) {
+            for (unsigned int n = 0U; n < 8U; n++) {
+                unsigned char ambe[VOICE_FRAME_LENGTH_BYTES];
+                buildFrame(bits, random, ambe);
+
+                char expected = referenceSymbol(ambe);
+
+                CDTMF dtmf;
+                bool pressed = dtmf.decode(ambe, false);
+                ASSERT_EQ(pressed, expected != 0 && expected != ' ') << "bits " << bits;
+                if (!pressed)
+                    continue;
+
+                // A key press needs the same symbol on four frames in a row, so two frames of the
+                // reference symbol then two of the frame under test only make one when both agree
+                for (unsigned int i = 0U; i < 16U; i++) {
+                    unsigned char reference[VOICE_FRAME_LENGTH_BYTES];
+                    buildFrame(SIGNATURE_BITS | (SYMBOL_BITS[i] << 8), random, reference);
+
+                    CDTMF pair;
+                    pair.decode(reference, false);
+                    pair.decode(reference, false);
+                    pair.decode(ambe, false);
+                    pair.decode(ambe, false);
+                    pair.decode(ambe, true);
+
+                    ASSERT_EQ(pair.hasCommand(), SYMBOL_CHARS[i] == expected) << "bits " << bits << " symbol " << SYMBOL_CHARS[i];
+                }
+            }
+        }
+    }
+
+    TEST_F(DTMF_decode, symbols)
+    {
+        std::mt19937 random(480U);
+
+        for (unsigned int i = 0U; i < 16U; i++) {
+            unsigned char ambe[VOICE_FRAME_LENGTH_BYTES];
+            buildFrame(SIGNATURE_BITS | (SYMBOL_BITS[i] << 8), random, ambe);
+
+            ASSERT_EQ(referenceSymbol(ambe), SYMBOL_CHARS[i]);
+
+            CDTMF dtmf;
+            for (unsigned int n = 0U; n < 4U; n++)
+                EXPECT_TRUE(dtmf.decode(ambe, false));
+            dtmf.decode(ambe, true);
+
+            EXPECT_TRUE(dtmf.hasCommand());
+        }
+    }
+
+    TEST_F(DTMF_decode, bufferedTransmission)
+    {
+        // *030C between voice frames, as an echo recording would hold it
+        const unsigned int KEYS[] = { 14U, 0U, 3U, 0U, 12U };
+
+        unsigned char voice[DV_FRAME_LENGTH_BYTES];
+        ::memcpy(voice, NULL_AMBE_DATA_BYTES, VOICE_FRAME_LENGTH_BYTES);
+        ::memcpy(voice + VOICE_FRAME_LENGTH_BYTES, NULL_SLOW_DATA_BYTES, DATA_FRAME_LENGTH_BYTES);
+
+        std::mt19937 random(4800U);
+        std::vector<unsigned char> frames;
+
+        for (auto key : KEYS) {
+            unsigned char ambe[DV_FRAME_LENGTH_BYTES];
+            buildFrame(SIGNATURE_BITS | (SYMBOL_BITS[key] << 8), random, ambe);
+            for (unsigned int n = 0U; n < 6U; n++)
+                frames.insert(frames.end(), ambe, ambe + DV_FRAME_LENGTH_BYTES);
+
+            for (unsigned int n = 0U; n < 3U; n++)
+                frames.insert(frames.end(), voice, voice + DV_FRAME_LENGTH_BYTES);
+        }
+
+        unsigned int count = frames.size() / DV_FRAME_LENGTH_BYTES;
+
+        CDTMF batch;
+        ASSERT_TRUE(batch.decode(frames.data(), count, DV_FRAME_LENGTH_BYTES));
+
+        CDTMF single;
+        for (unsigned int i = 0U; i < count; i++)
+            single.decode(frames.data() + i * DV_FRAME_LENGTH_BYTES, false);
+        single.decode(frames.data(), true);
+
+        ASSERT_TRUE(single.hasCommand());
+        std::string command = batch.translate();
+        EXPECT_STREQ(command.c_str(), single.translate().c_str());
+        EXPECT_STREQ(command.c_str(), "REF030CL");
+    }
+}
@@ -0,0 +1,133 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <unistd.h>
+
+#include "DVTOOLFileReader.h"
+#include "DStarDefines.h"
+
+namespace DVTOOLFileReaderTests
+{
+    class DVTOOLFileReader_read : public ::testing::Test {
+    protected:
+        void SetUp() override
+        {
+            m_fileName = std::filesystem::temp_directory_path() / ("DVTOOLFileReader_" + std::to_string(::getpid()) + ".dvtool");
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove(m_fileName);
+        }
+
+        // Record count is big endian, record lengths are little endian
+        void writeFile(unsigned int frames, unsigned int truncate = 0U)
+        {
+            std::vector<unsigned char> file = { 'D', 'V', 'T', 'O', 'O', 'L', 0x00, 0x00, 0x00, (unsigned char)(frames + 1U) };
+
+            unsigned char header[RADIO_HEADER_LENGTH_BYTES];
+            ::memset(header, ' ', RADIO_HEADER_LENGTH_BYTES);
+            header[0U] = header[1U] = header[2U] = 0x00U;
+            ::memcpy(header + 27U, "F4FXL   ", LONG_CALLSIGN_LENGTH);
+            header[39U] = header[40U] = 0xFFU;
+            addRecord(file, 0x10U, 0U, header, RADIO_HEADER_LENGTH_BYTES);
+
+            for (unsigned int i = 0U; i < frames; i++) {
+                unsigned char frame[DV_FRAME_LENGTH_BYTES];
+                ::memset(frame, i, DV_FRAME_LENGTH_BYTES);
+                addRecord(file, 0x20U, i % 21U, frame, DV_FRAME_LENGTH_BYTES);
+            }
+
+            std::ofstream out(m_fileName, std::ios::binary);
+            out.write((const char*)file.data(), file.size() - truncate);
+        }
+
+        void addRecord(std::vector<unsigned char>& file, unsigned char flag, unsigned char seq, const unsigned char* payload, unsigned int length)
+        {
+            unsigned int recordLength = 15U + length;
+            file.push_back(recordLength % 256U);
+            file.push_back(recordLength / 256U);
+            file.insert(file.end(), { 'D', 'S', 'V', 'T', flag, 0x00, 0x00, 0x00, 0x20, 0x00, 0x01, 0x02, 0x00, 0x00, seq });
+            file.insert(file.end(), payload, payload + length);
+        }
+
+        std::string m_fileName;
+    };
+
+    TEST_F(DVTOOLFileReader_read, nonExistentFile)
+    {
+        CDVTOOLFileReader reader;
+
+        EXPECT_FALSE(reader.open(m_fileName)) << "open shall fail on a missing file";
+        EXPECT_EQ(reader.read(), DVTFR_NONE) << "read shall not return records of a file which is not open";
+    }
+
+    TEST_F(DVTOOLFileReader_read, headerAndFrames)
+    {
+        writeFile(30U);
+
+        CDVTOOLFileReader reader;
+        ASSERT_TRUE(reader.open(m_fileName));
+        EXPECT_EQ(reader.getRecords(), 31U);
+
+        ASSERT_EQ(reader.read(), DVTFR_HEADER);
+        CHeaderData* header = reader.readHeader();
+        ASSERT_NE(header, nullptr);
+        EXPECT_STREQ(header->getMyCall1().c_str(), "F4FXL   ");
+        delete header;
+
+        for (unsigned int i = 0U; i < 30U; i++) {
+            ASSERT_EQ(reader.read(), DVTFR_DATA);
+
+            unsigned int length = 0U;
+            const unsigned char* data = reader.getData(length);
+            ASSERT_NE(data, nullptr);
+            EXPECT_EQ(length, DV_FRAME_LENGTH_BYTES);
+            EXPECT_EQ(data[0U], i);
+
+            CAMBEData* ambe = reader.readData();
+            ASSERT_NE(ambe, nullptr);
+            EXPECT_EQ(ambe->getSeq(), i % 21U);
+            delete ambe;
+        }
+
+        EXPECT_EQ(reader.read(), DVTFR_NONE) << "read shall stop after the last record";
+    }
+
+    TEST_F(DVTOOLFileReader_read, truncatedRecord)
+    {
+        writeFile(3U, 5U);
+
+        CDVTOOLFileReader reader;
+        ASSERT_TRUE(reader.open(m_fileName));
+
+        EXPECT_EQ(reader.read(), DVTFR_HEADER);
+        EXPECT_EQ(reader.read(), DVTFR_DATA);
+        EXPECT_EQ(reader.read(), DVTFR_DATA);
+        EXPECT_EQ(reader.read(), DVTFR_NONE) << "read shall not return a record running past the end of the file";
+
+        unsigned int length = 0U;
+        EXPECT_EQ(reader.getData(length), nullptr);
+    }
+}
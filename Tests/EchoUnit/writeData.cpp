@@ -0,0 +1,156 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+#include "EchoUnit.h"
+#include "PlayoutScheduler.h"
+#include "PacketReplay.h"
+
+namespace EchoUnitTests
+{
+    class FakeRepeater : public IRepeaterCallback {
+    public:
+        bool process(CHeaderData&, DIRECTION, AUDIO_SOURCE) override
+        {
+            m_headers++;
+            return true;
+        }
+
+        bool process(CAMBEData& data, DIRECTION, AUDIO_SOURCE) override
+        {
+            unsigned char buffer[DV_FRAME_LENGTH_BYTES];
+            data.getData(buffer, DV_FRAME_LENGTH_BYTES);
+            m_payloads.push_back(buffer[0]);
+            m_ends.push_back(data.isEnd());
+            return true;
+        }
+
+        unsigned int m_headers = 0U;
+        std::vector<unsigned char> m_payloads;
+        std::vector<bool> m_ends;
+    };
+
+    class EchoUnit_writeData : public ::testing::Test {
+    protected:
+        void TearDown() override
+        {
+            CEchoUnit::setSharedBuffers(0U);
+        }
+
+        static void record(CEchoUnit& echo, unsigned int frames)
+        {
+            CHeaderData header;
+            header.setMyCall1("F4FXL   ");
+            echo.writeHeader(header);
+
+            for (unsigned int i = 0U; i < frames; i++) {
+                unsigned char buffer[DV_FRAME_LENGTH_BYTES] = { (unsigned char)i };
+                CAMBEData data;
+                data.setData(buffer, DV_FRAME_LENGTH_BYTES);
+                data.setEnd(i == frames - 1U);
+                echo.writeData(data);
+            }
+        }
+
+        static void play(CEchoUnit& echo)
+        {
+            // Reply delay then the frames, paced on 20ms deadlines
+            echo.clock(REPLY_TIME * 1000U);
+            for (unsigned int i = 0U; i < 10U; i++) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(DSTAR_FRAME_TIME_MS));
+                echo.clock(DSTAR_FRAME_TIME_MS);
+            }
+        }
+    };
+
+    TEST_F(EchoUnit_writeData, recordingIsPlayedBack)
+    {
+        FakeRepeater repeater;
+        CEchoUnit echo(&repeater, "F4FXL  B");
+
+        record(echo, 5U);
+        play(echo);
+
+        EXPECT_EQ(repeater.m_headers, 1U);
+        ASSERT_EQ(repeater.m_payloads.size(), 5U);
+        for (unsigned int i = 0U; i < 5U; i++) {
+            EXPECT_EQ(repeater.m_payloads[i], i);
+            EXPECT_EQ(repeater.m_ends[i], i == 4U);
+        }
+    }
+
+    TEST_F(EchoUnit_writeData, sharedBuffersAreLimited)
+    {
+        CEchoUnit::setSharedBuffers(1U);
+
+        FakeRepeater repeater1, repeater2;
+        CEchoUnit echo1(&repeater1, "F4FXL  B");
+        CEchoUnit echo2(&repeater2, "F4FXL  C");
+
+        record(echo1, 3U);
+        record(echo2, 3U);
+        play(echo2);
+        EXPECT_EQ(repeater2.m_headers, 0U) << "No buffer is left for a second recording";
+
+        play(echo1);
+        EXPECT_EQ(repeater1.m_payloads.size(), 3U);
+
+        record(echo2, 3U);
+        play(echo2);
+        EXPECT_EQ(repeater2.m_payloads.size(), 3U) << "The buffer is given back once played";
+    }
+
+    TEST_F(EchoUnit_writeData, playoutFollowsReplayClock)
+    {
+        // An empty capture is enough, only the simulated clock is used
+        std::string fileName = "/tmp/dgw_echounit_" + std::to_string(::getpid()) + ".dgwcap";
+        CPacketCaptureWriter writer(fileName);
+        ASSERT_TRUE(writer.open());
+        writer.close();
+
+        CPacketReplay replay(fileName, "");
+        ASSERT_TRUE(replay.open());
+        CPlayoutScheduler::setReplay(&replay);
+
+        FakeRepeater repeater;
+        CEchoUnit echo(&repeater, "F4FXL  B");
+        record(echo, 5U);
+        echo.clock(REPLY_TIME * 1000U);
+        EXPECT_TRUE(CPlayoutScheduler::isAnyPlaying());
+
+        // No real time goes by, frames are only released as the simulated clock reaches their deadlines, half a frame time per step
+        std::vector<size_t> released;
+        for (unsigned int i = 0U; i < 12U; i++) {
+            replay.clock(DSTAR_FRAME_TIME_MS / 2U);
+            echo.clock(DSTAR_FRAME_TIME_MS / 2U);
+            released.push_back(repeater.m_payloads.size());
+        }
+
+        CPlayoutScheduler::setReplay(NULL);
+        ::remove(fileName.c_str());
+
+        EXPECT_EQ(released, std::vector<size_t>({ 0U, 1U, 1U, 2U, 2U, 3U, 3U, 4U, 4U, 5U, 5U, 5U }));
+        EXPECT_FALSE(CPlayoutScheduler::isAnyPlaying());
+    }
+}
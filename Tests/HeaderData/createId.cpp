@@ -0,0 +1,69 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <vector>
+
+#include "HeaderData.h"
+
+namespace HeaderDataTests
+{
+    class HeaderData_createId : public ::testing::Test {
+    protected:
+        std::vector<unsigned int> draw(unsigned int seed)
+        {
+            CHeaderData::setIdSeed(seed);
+
+            std::vector<unsigned int> ids;
+            for(unsigned int i = 0U; i < 16U; i++)
+                ids.push_back(CHeaderData::createId());
+
+            return ids;
+        }
+    };
+
+    TEST_F(HeaderData_createId, sameSeedGivesSameIds)
+    {
+        EXPECT_EQ(draw(1U), draw(1U));
+        EXPECT_NE(draw(1U), draw(2U));
+    }
+
+    TEST_F(HeaderData_createId, seedingRandDoesNotChangeIds)
+    {
+        std::vector<unsigned int> expected = draw(1U);
+
+        CHeaderData::setIdSeed(1U);
+        ::srand(12345U);
+        std::vector<unsigned int> ids;
+        for(unsigned int i = 0U; i < 16U; i++) {
+            ids.push_back(CHeaderData::createId());
+            ::rand();
+        }
+
+        EXPECT_EQ(ids, expected);
+    }
+
+    TEST_F(HeaderData_createId, idsAreInRange)
+    {
+        for(unsigned int id : draw(42U)) {
+            EXPECT_GE(id, 1U);
+            EXPECT_LE(id, 65535U);
+        }
+    }
+}
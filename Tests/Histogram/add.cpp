@@ -0,0 +1,79 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Histogram.h"
+
+namespace HistogramTests
+{
+
+    class Histogram_add : public ::testing::Test {
+    
+    };
+
+    TEST_F(Histogram_add, EmptyHistogramReturnsZeros)
+    {
+        CHistogram histogram;
+
+        EXPECT_EQ(histogram.getCount(), 0U);
+        EXPECT_EQ(histogram.getMin(), 0U);
+        EXPECT_EQ(histogram.getMax(), 0U);
+        EXPECT_EQ(histogram.getMean(), 0U);
+    }
+
+    TEST_F(Histogram_add, TracksCountMinMaxAndMean)
+    {
+        CHistogram histogram;
+
+        histogram.add(10U);
+        histogram.add(2U);
+        histogram.add(30U);
+
+        EXPECT_EQ(histogram.getCount(), 3U);
+        EXPECT_EQ(histogram.getMin(), 2U);
+        EXPECT_EQ(histogram.getMax(), 30U);
+        EXPECT_EQ(histogram.getMean(), 14U);
+    }
+
+    TEST_F(Histogram_add, ResetClearsEverything)
+    {
+        CHistogram histogram;
+
+        histogram.add(1000U);
+        histogram.reset();
+
+        EXPECT_EQ(histogram.getCount(), 0U);
+        EXPECT_EQ(histogram.getMax(), 0U);
+        EXPECT_EQ(histogram.getPercentile(50.0), 0U);
+    }
+
+    TEST_F(Histogram_add, BucketIndexIsMonotonicAndInRange)
+    {
+        unsigned int previous = 0U;
+        for(uint64_t value = 0U; value < 100000U; value++) {
+            unsigned int index = CHistogram::getBucketIndex(value);
+            EXPECT_GE(index, previous);
+            EXPECT_GE(CHistogram::getBucketUpperBound(index), value);
+            previous = index;
+        }
+
+        EXPECT_LT(CHistogram::getBucketIndex(UINT64_MAX), HISTOGRAM_BUCKETS);
+        EXPECT_EQ(CHistogram::getBucketUpperBound(CHistogram::getBucketIndex(UINT64_MAX)), UINT64_MAX);
+    }
+}
@@ -0,0 +1,68 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Histogram.h"
+
+namespace HistogramTests
+{
+
+    class Histogram_getPercentile : public ::testing::Test {
+    
+    };
+
+    TEST_F(Histogram_getPercentile, SmallValuesAreExact)
+    {
+        CHistogram histogram;
+
+        for(uint64_t value = 1U; value <= 7U; value++)
+            histogram.add(value);
+
+        EXPECT_EQ(histogram.getPercentile(0.0), 1U);
+        EXPECT_EQ(histogram.getPercentile(50.0), 4U);
+        EXPECT_EQ(histogram.getPercentile(100.0), 7U);
+    }
+
+    TEST_F(Histogram_getPercentile, ErrorIsWithinBucketResolution)
+    {
+        CHistogram histogram;
+
+        for(uint64_t value = 1U; value <= 10000U; value++)
+            histogram.add(value);
+
+        uint64_t p50 = histogram.getPercentile(50.0);
+        uint64_t p99 = histogram.getPercentile(99.0);
+
+        EXPECT_GE(p50, 5000U);
+        EXPECT_LE(p50, 5000U + 5000U / 8U);
+        EXPECT_GE(p99, 9900U);
+        EXPECT_LE(p99, 10000U);
+    }
+
+    TEST_F(Histogram_getPercentile, NeverExceedsMax)
+    {
+        CHistogram histogram;
+
+        histogram.add(1000U);
+
+        EXPECT_EQ(histogram.getPercentile(50.0), 1000U);
+        EXPECT_EQ(histogram.getPercentile(99.0), 1000U);
+        EXPECT_EQ(histogram.toString("us"), "count=1 p50=1000us p99=1000us max=1000us");
+    }
+}
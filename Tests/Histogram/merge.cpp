@@ -0,0 +1,60 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Histogram.h"
+
+namespace HistogramTests
+{
+
+    class Histogram_merge : public ::testing::Test {
+    
+    };
+
+    TEST_F(Histogram_merge, MergingEmptyHistogramChangesNothing)
+    {
+        CHistogram histogram, empty;
+
+        histogram.add(5U);
+        histogram.merge(empty);
+
+        EXPECT_EQ(histogram.getCount(), 1U);
+        EXPECT_EQ(histogram.getMin(), 5U);
+        EXPECT_EQ(histogram.getMax(), 5U);
+    }
+
+    TEST_F(Histogram_merge, MergedHistogramIsSameAsAddingAllValues)
+    {
+        CHistogram first, second, all;
+
+        for(uint64_t value = 1U; value <= 1000U; value++) {
+            (value % 2U == 0U ? first : second).add(value * 3U);
+            all.add(value * 3U);
+        }
+
+        first.merge(second);
+
+        EXPECT_EQ(first.getCount(), all.getCount());
+        EXPECT_EQ(first.getMin(), all.getMin());
+        EXPECT_EQ(first.getMax(), all.getMax());
+        EXPECT_EQ(first.getMean(), all.getMean());
+        EXPECT_EQ(first.getPercentile(50.0), all.getPercentile(50.0));
+        EXPECT_EQ(first.getPercentile(99.0), all.getPercentile(99.0));
+    }
+}
@@ -0,0 +1,101 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+
+#include "IRCDDBApp.h"
+#include "IRCMessage.h"
+
+namespace IRCDDBAppTests
+{
+
+    class IRCDDBApp_findGateway : public ::testing::Test {
+    protected:
+        // Runs findGateway and returns the address of its reply
+        std::string findAddress(IRCDDBApp& app, const std::string& gateway)
+        {
+            IRCMessage * m;
+            while((m = app.getReplyMessage()) != nullptr)
+                delete m;
+
+            app.findGateway(gateway);
+
+            std::string address;
+            m = app.getReplyMessage();
+            if(m != nullptr && m->getParamCount() == 2)
+                address = m->getParam(1);
+            delete m;
+
+            return address;
+        }
+    };
+
+    TEST_F(IRCDDBApp_findGateway, UnknownGatewayHasNoAddress)
+    {
+        IRCDDBApp app("#dstar");
+        app.userJoin("F4FXL-1", "f4fxl", "10.0.0.1");
+
+        EXPECT_TRUE(findAddress(app, "F4ABC  G").empty());
+    }
+
+    TEST_F(IRCDDBApp_findGateway, LatestNickWins)
+    {
+        IRCDDBApp app("#dstar");
+        app.userJoin("F4FXL-1", "f4fxl", "10.0.0.1");
+        app.userJoin("F4FXL-2", "f4fxl", "10.0.0.2");
+
+        EXPECT_EQ(findAddress(app, "F4FXL  G"), "10.0.0.2");
+
+        // Rejoining gives the nick a higher USN
+        app.userLeave("F4FXL-1");
+        app.userJoin("F4FXL-1", "f4fxl", "10.0.0.3");
+
+        EXPECT_EQ(findAddress(app, "F4FXL  G"), "10.0.0.3");
+    }
+
+    TEST_F(IRCDDBApp_findGateway, LeavingFallsBackToRemainingNick)
+    {
+        IRCDDBApp app("#dstar");
+        app.userJoin("F4FXL-1", "f4fxl", "10.0.0.1");
+        app.userJoin("F4FXL-2", "f4fxl", "10.0.0.2");
+
+        app.userLeave("f4fxl-2");
+        EXPECT_EQ(findAddress(app, "F4FXL  G"), "10.0.0.1");
+
+        app.userLeave("F4FXL-1");
+        EXPECT_TRUE(findAddress(app, "F4FXL  G").empty());
+    }
+
+    TEST_F(IRCDDBApp_findGateway, OtherNicksAreNotGateways)
+    {
+        IRCDDBApp app("#dstar");
+        app.userJoin("F4FXL-5", "f4fxl", "10.0.0.5");
+        app.userJoin("F4FXL-12", "f4fxl", "10.0.0.12");
+
+        EXPECT_TRUE(findAddress(app, "F4FXL  G").empty());
+    }
+
+    TEST_F(IRCDDBApp_findGateway, ResetForgetsGateways)
+    {
+        IRCDDBApp app("#dstar");
+        app.userJoin("F4FXL-1", "f4fxl", "10.0.0.1");
+        app.userListReset();
+
+        EXPECT_TRUE(findAddress(app, "F4FXL  G").empty());
+    }
+}
@@ -0,0 +1,98 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+
+#include "IRCDDBApp.h"
+#include "IRCMessage.h"
+
+namespace IRCDDBAppTests
+{
+
+    class IRCDDBApp_msgQuery : public ::testing::Test {
+    protected:
+        // Hands msgQuery a PRIVMSG from a remote gateway
+        void query(IRCDDBApp& app, const std::string& toNick, const std::string& msg, const std::string& port = "")
+        {
+            IRCMessage m(toNick, msg);
+            m.m_prefix = "F4ABC-1!f4abc@10.0.0.7";
+            if(!port.empty())
+                m.addParam(port);
+
+            app.msgQuery(&m);
+        }
+    };
+
+    TEST_F(IRCDDBApp_msgQuery, G2NatTraversalToUsIsReplied)
+    {
+        IRCDDBApp app("#dstar");
+        app.setCurrentNick("f4fxl-1");
+
+        query(app, "f4fxl-1", "NATTRAVERSAL_G2");
+
+        EXPECT_EQ(app.getReplyMessageType(), IDRT_NATTRAVERSAL_G2);
+        IRCMessage * m = app.getReplyMessage();
+        ASSERT_NE(m, nullptr);
+        ASSERT_EQ(m->getParamCount(), 1);
+        EXPECT_EQ(m->getParam(0), "10.0.0.7");
+        delete m;
+    }
+
+    TEST_F(IRCDDBApp_msgQuery, DExtraNatTraversalToUsCarriesPort)
+    {
+        IRCDDBApp app("#dstar");
+        app.setCurrentNick("f4fxl-1");
+
+        query(app, "f4fxl-1", "NATTRAVERSAL_DEXTRA", "30001");
+
+        EXPECT_EQ(app.getReplyMessageType(), IDRT_NATTRAVERSAL_DEXTRA);
+        IRCMessage * m = app.getReplyMessage();
+        ASSERT_NE(m, nullptr);
+        ASSERT_EQ(m->getParamCount(), 2);
+        EXPECT_EQ(m->getParam(0), "10.0.0.7");
+        EXPECT_EQ(m->getParam(1), "30001");
+        delete m;
+    }
+
+    TEST_F(IRCDDBApp_msgQuery, DPlusNatTraversalToUsCarriesPort)
+    {
+        IRCDDBApp app("#dstar");
+        app.setCurrentNick("f4fxl-1");
+
+        query(app, "f4fxl-1", "NATTRAVERSAL_DPLUS 20001");
+
+        EXPECT_EQ(app.getReplyMessageType(), IDRT_NATTRAVERSAL_DPLUS);
+        IRCMessage * m = app.getReplyMessage();
+        ASSERT_NE(m, nullptr);
+        ASSERT_EQ(m->getParamCount(), 2);
+        EXPECT_EQ(m->getParam(0), "10.0.0.7");
+        EXPECT_EQ(m->getParam(1), "20001");
+        delete m;
+    }
+
+    TEST_F(IRCDDBApp_msgQuery, NatTraversalToOthersIsIgnored)
+    {
+        IRCDDBApp app("#dstar");
+        app.setCurrentNick("f4fxl-1");
+
+        query(app, "f4fxl-2", "NATTRAVERSAL_G2");
+
+        EXPECT_EQ(app.getReplyMessageType(), IDRT_NONE);
+        EXPECT_EQ(app.getReplyMessage(), nullptr);
+    }
+}
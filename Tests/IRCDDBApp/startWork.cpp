@@ -0,0 +1,102 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "IRCDDBApp.h"
+#include "IRCMessage.h"
+#include "IRCMessageQueue.h"
+
+namespace IRCDDBAppTests
+{
+
+    class IRCDDBApp_startWork : public ::testing::Test {
+    protected:
+        // Plays the ircDDB server until the app is ready, returns the SENDLIST commands it received
+        std::vector<std::string> runServer(IRCDDBApp& app, IRCMessageQueue& sendQ, std::chrono::milliseconds timeout)
+        {
+            std::vector<std::string> sendLists;
+            auto end = std::chrono::steady_clock::now() + timeout;
+
+            while(app.getConnectionState() < 7 && std::chrono::steady_clock::now() < end) {
+                IRCMessage * m = sendQ.getMessage();
+                if(m == nullptr) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    continue;
+                }
+
+                if(m->getParamCount() == 2 && m->getParam(1).compare(0, 8, "SENDLIST") == 0) {
+                    sendLists.push_back(m->getParam(1));
+
+                    IRCMessage listEnd("PRIVMSG");
+                    listEnd.m_prefix = "s-grp1s1!s-grp1s1@ircddb.net";
+                    listEnd.addParam("dstargw-1");
+                    listEnd.addParam("LIST_END");
+                    app.msgQuery(&listEnd);
+                }
+                delete m;
+            }
+
+            return sendLists;
+        }
+    };
+
+    TEST_F(IRCDDBApp_startWork, ReadyWithoutWaitingForTicks)
+    {
+        IRCDDBApp app("#dstar");
+        IRCMessageQueue sendQ;
+        app.setCurrentNick("dstargw-1");
+        app.userJoin("s-grp1s1", "s-grp1s1", "ircddb.net");
+        app.userChanOp("s-grp1s1", true);
+        app.startWork();
+        app.setSendQ(&sendQ);
+
+        auto sendLists = runServer(app, sendQ, std::chrono::milliseconds(500));
+
+        EXPECT_EQ(app.getConnectionState(), 7);
+        ASSERT_EQ(sendLists.size(), 1U);
+        EXPECT_EQ(sendLists[0].compare(0, 11, "SENDLIST 1 "), 0);
+
+        app.setSendQ(nullptr);
+        app.stopWork();
+    }
+
+    TEST_F(IRCDDBApp_startWork, WaitsForServerToJoin)
+    {
+        IRCDDBApp app("#dstar");
+        IRCMessageQueue sendQ;
+        app.setCurrentNick("dstargw-1");
+        app.startWork();
+        app.setSendQ(&sendQ);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        EXPECT_EQ(app.getConnectionState(), 2);
+
+        app.userJoin("s-grp1s1", "s-grp1s1", "ircddb.net");
+        app.userChanOp("s-grp1s1", true);
+        runServer(app, sendQ, std::chrono::milliseconds(500));
+
+        EXPECT_EQ(app.getConnectionState(), 7);
+
+        app.setSendQ(nullptr);
+        app.stopWork();
+    }
+}
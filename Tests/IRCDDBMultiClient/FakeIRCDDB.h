@@ -0,0 +1,96 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "IRCDDB.h"
+
+namespace IRCDDBMultiClientTests
+{
+    // Inner client answering user queries from a script, answers are handed out when release() is called
+    class CFakeIRCDDB : public CIRCDDB
+    {
+    public:
+        struct TAnswer {
+            std::string user;
+            std::string repeater;
+            std::string gateway;
+            std::string address;
+            std::string timestamp;
+        };
+
+        int m_state = 7;
+        std::deque<TAnswer> m_pending;
+        std::deque<TAnswer> m_ready;
+        std::vector<std::string> m_queries;
+
+        void answer(const std::string& user, const std::string& address, const std::string& timestamp)
+        {
+            m_pending.push_back({ user, "F4FXL  B", "F4FXL  G", address, timestamp });
+        }
+
+        void release()
+        {
+            while(!m_pending.empty()) {
+                m_ready.push_back(m_pending.front());
+                m_pending.pop_front();
+            }
+        }
+
+        bool open() { return true; }
+        void rptrQTH(const std::string&, double, double, const std::string&, const std::string&, const std::string&) { }
+        void rptrQRG(const std::string&, double, double, double, double) { }
+        void kickWatchdog(const std::string&, const std::string&) { }
+        int getConnectionState() { return m_state; }
+        bool sendHeard(const std::string&, const std::string&, const std::string&, const std::string&, const std::string&, unsigned char, unsigned char, unsigned char) { return true; }
+        bool sendHeardWithTXMsg(const std::string&, const std::string&, const std::string&, const std::string&, const std::string&, unsigned char, unsigned char, unsigned char, const std::string&, const std::string&) { return true; }
+        bool sendHeardWithTXStats(const std::string&, const std::string&, const std::string&, const std::string&, const std::string&, unsigned char, unsigned char, unsigned char, int, int, int) { return true; }
+        bool findGateway(const std::string&) { return true; }
+        bool findRepeater(const std::string&) { return true; }
+        bool findUser(const std::string& user) { m_queries.push_back(user); return true; }
+        bool notifyRepeaterG2NatTraversal(const std::string&) { return true; }
+        bool notifyRepeaterDextraNatTraversal(const std::string&, unsigned int) { return true; }
+        bool notifyRepeaterDPlusNatTraversal(const std::string&, unsigned int) { return true; }
+        void sendDStarGatewayInfo(const std::string, const std::vector<std::string>) { }
+        IRCDDB_RESPONSE_TYPE getMessageType() { return m_ready.empty() ? IDRT_NONE : IDRT_USER; }
+        bool receiveRepeater(std::string&, std::string&, std::string&) { return false; }
+        bool receiveGateway(std::string&, std::string&) { return false; }
+        bool receiveUser(std::string& user, std::string& repeater, std::string& gateway, std::string& address)
+        {
+            std::string timestamp;
+            return receiveUser(user, repeater, gateway, address, timestamp);
+        }
+        bool receiveUser(std::string& user, std::string& repeater, std::string& gateway, std::string& address, std::string& timestamp)
+        {
+            if(m_ready.empty())
+                return false;
+            TAnswer& a = m_ready.front();
+            user = a.user; repeater = a.repeater; gateway = a.gateway; address = a.address; timestamp = a.timestamp;
+            m_ready.pop_front();
+            return true;
+        }
+        bool receiveNATTraversalG2(std::string&) { return false; }
+        bool receiveNATTraversalDextra(std::string&, std::string&) { return false; }
+        bool receiveNATTraversalDPlus(std::string&, std::string&) { return false; }
+        void close() { }
+    };
+}
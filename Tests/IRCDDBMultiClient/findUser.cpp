@@ -0,0 +1,152 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+
+#include "IRCDDBMultiClient.h"
+#include "FakeIRCDDB.h"
+
+namespace IRCDDBMultiClientTests
+{
+    class IRCDDBMultiClient_findUser : public ::testing::Test {
+    protected:
+        CFakeIRCDDB * m_network;
+        CIRCDDB_Array m_clients;
+
+        void SetUp()
+        {
+            m_network = new CFakeIRCDDB();
+            m_clients = { m_network };
+        }
+
+        bool receive(CIRCDDBMultiClient& client, std::string& address)
+        {
+            if(client.getMessageType() != IDRT_USER)
+                return false;
+
+            std::string user, repeater, gateway;
+            return client.receiveUser(user, repeater, gateway, address);
+        }
+    };
+
+    TEST_F(IRCDDBMultiClient_findUser, InFlightQueryIsSentOnce)
+    {
+        CIRCDDBMultiClient client(m_clients);
+        client.findUser("F4FXL   ");
+        client.findUser("F4FXL   ");
+
+        EXPECT_EQ(m_network->m_queries.size(), 1U);
+        EXPECT_EQ(client.getSuppressedInFlight(), 1UL);
+
+        m_network->answer("F4FXL   ", "10.0.0.1", "2022-05-24 10:00:00");
+        m_network->release();
+
+        std::string address;
+        EXPECT_TRUE(receive(client, address));
+        EXPECT_EQ(address, "10.0.0.1");
+        EXPECT_FALSE(receive(client, address));
+    }
+
+    TEST_F(IRCDDBMultiClient_findUser, NotFoundIsAnsweredFromMemory)
+    {
+        CIRCDDBMultiClient client(m_clients, false, 150U, 30U);
+        client.findUser("F4FXL   ");
+        m_network->answer("F4FXL   ", "", "");
+        m_network->release();
+
+        std::string address = "unchanged";
+        EXPECT_TRUE(receive(client, address));
+        EXPECT_TRUE(address.empty());
+
+        address = "unchanged";
+        client.findUser("F4FXL   ");
+        EXPECT_EQ(m_network->m_queries.size(), 1U);
+        EXPECT_EQ(client.getSuppressedNotFound(), 1UL);
+        EXPECT_TRUE(receive(client, address));
+        EXPECT_TRUE(address.empty());
+    }
+
+    TEST_F(IRCDDBMultiClient_findUser, NotFoundIsAskedAgainWhenDisabled)
+    {
+        CIRCDDBMultiClient client(m_clients);
+        client.findUser("F4FXL   ");
+        m_network->answer("F4FXL   ", "", "");
+        m_network->release();
+
+        std::string address;
+        EXPECT_TRUE(receive(client, address));
+
+        client.findUser("F4FXL   ");
+        EXPECT_EQ(m_network->m_queries.size(), 2U);
+        EXPECT_EQ(client.getSuppressedNotFound(), 0UL);
+    }
+
+    TEST_F(IRCDDBMultiClient_findUser, UserHeardAgainIsAskedFor)
+    {
+        CIRCDDBMultiClient client(m_clients, false, 150U, 30U);
+        client.findUser("F4FXL   ");
+        m_network->answer("F4FXL   ", "", "");
+        m_network->release();
+
+        std::string address;
+        EXPECT_TRUE(receive(client, address));
+
+        // Unsolicited update, the user has been heard somewhere since
+        m_network->answer("F4FXL   ", "10.0.0.1", "2022-05-24 10:00:00");
+        m_network->release();
+        EXPECT_TRUE(receive(client, address));
+
+        client.findUser("F4FXL   ");
+        EXPECT_EQ(m_network->m_queries.size(), 2U);
+    }
+
+    TEST_F(IRCDDBMultiClient_findUser, UnsolicitedNotFoundIsNotRemembered)
+    {
+        CIRCDDBMultiClient client(m_clients, false, 150U, 30U);
+
+        // Pushed update without an address, nobody asked for it
+        m_network->answer("F4FXL   ", "", "");
+        m_network->release();
+
+        std::string address;
+        EXPECT_TRUE(receive(client, address));
+
+        client.findUser("F4FXL   ");
+        EXPECT_EQ(m_network->m_queries.size(), 1U);
+        EXPECT_EQ(client.getSuppressedNotFound(), 0UL);
+    }
+
+    TEST_F(IRCDDBMultiClient_findUser, ExpiredNotFoundIsForgotten)
+    {
+        CIRCDDBMultiClient client(m_clients, false, 150U, 1U);
+        client.findUser("F4FXL   ");
+        m_network->answer("F4FXL   ", "", "");
+        m_network->release();
+
+        std::string address;
+        EXPECT_TRUE(receive(client, address));
+        EXPECT_EQ(client.getNotFoundCount(), 1U);
+
+        // Never asked for again, it is purged once its time to live is over
+        std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+        client.getMessageType();
+        EXPECT_EQ(client.getNotFoundCount(), 0U);
+    }
+}
@@ -0,0 +1,154 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+
+#include "IRCDDBMultiClient.h"
+#include "FakeIRCDDB.h"
+
+namespace IRCDDBMultiClientTests
+{
+    class IRCDDBMultiClient_getMessageType : public ::testing::Test {
+    protected:
+        CFakeIRCDDB * m_fast;
+        CFakeIRCDDB * m_slow;
+        CIRCDDB_Array m_clients;
+
+        void SetUp()
+        {
+            m_fast = new CFakeIRCDDB();
+            m_slow = new CFakeIRCDDB();
+            m_clients = { m_fast, m_slow };
+        }
+
+        // Polls like the gateway thread does until an answer comes or the time is up
+        bool waitAnswer(CIRCDDBMultiClient& client, std::string& address, std::chrono::milliseconds timeout)
+        {
+            auto end = std::chrono::steady_clock::now() + timeout;
+            while(std::chrono::steady_clock::now() < end) {
+                if(client.getMessageType() == IDRT_USER) {
+                    std::string user, repeater, gateway;
+                    return client.receiveUser(user, repeater, gateway, address);
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            return false;
+        }
+    };
+
+    TEST_F(IRCDDBMultiClient_getMessageType, AllModeWaitsForEveryNetwork)
+    {
+        CIRCDDBMultiClient client(m_clients);
+        client.findUser("F4FXL   ");
+        m_fast->answer("F4FXL   ", "10.0.0.1", "2022-05-24 10:00:00");
+        m_fast->release();
+
+        std::string address;
+        EXPECT_FALSE(waitAnswer(client, address, std::chrono::milliseconds(50)));
+
+        m_slow->answer("F4FXL   ", "", "");
+        m_slow->release();
+        EXPECT_TRUE(waitAnswer(client, address, std::chrono::milliseconds(50)));
+    }
+
+    TEST_F(IRCDDBMultiClient_getMessageType, RacingAnswersAfterGraceWindow)
+    {
+        CIRCDDBMultiClient client(m_clients, true, 20U);
+        client.findUser("F4FXL   ");
+        m_fast->answer("F4FXL   ", "10.0.0.1", "2022-05-24 10:00:00");
+        m_fast->release();
+
+        std::string address;
+        auto start = std::chrono::steady_clock::now();
+        EXPECT_TRUE(waitAnswer(client, address, std::chrono::milliseconds(500)));
+        EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(400));
+        EXPECT_EQ(address, "10.0.0.1");
+
+        // The slow network answering the same later is not passed on a second time
+        m_slow->answer("F4FXL   ", "10.0.0.1", "2022-05-24 10:00:00");
+        m_slow->release();
+        EXPECT_FALSE(waitAnswer(client, address, std::chrono::milliseconds(30)));
+    }
+
+    TEST_F(IRCDDBMultiClient_getMessageType, RacingKeepsNewestWithinGraceWindow)
+    {
+        CIRCDDBMultiClient client(m_clients, true, 100U);
+        client.findUser("F4FXL   ");
+        m_fast->answer("F4FXL   ", "10.0.0.1", "2022-05-24 10:00:00");
+        m_fast->release();
+        client.getMessageType();
+        m_slow->answer("F4FXL   ", "10.0.0.2", "2022-05-24 11:00:00");
+        m_slow->release();
+
+        std::string address;
+        EXPECT_TRUE(waitAnswer(client, address, std::chrono::milliseconds(500)));
+        EXPECT_EQ(address, "10.0.0.2");
+    }
+
+    TEST_F(IRCDDBMultiClient_getMessageType, RacingNotFoundWaitsForEveryNetwork)
+    {
+        CIRCDDBMultiClient client(m_clients, true, 20U);
+        client.findUser("F4FXL   ");
+        m_fast->answer("F4FXL   ", "", "");
+        m_fast->release();
+
+        std::string address;
+        EXPECT_FALSE(waitAnswer(client, address, std::chrono::milliseconds(50)));
+
+        m_slow->answer("F4FXL   ", "10.0.0.2", "2022-05-24 11:00:00");
+        m_slow->release();
+        EXPECT_TRUE(waitAnswer(client, address, std::chrono::milliseconds(500)));
+        EXPECT_EQ(address, "10.0.0.2");
+    }
+
+    TEST_F(IRCDDBMultiClient_getMessageType, RacingDoesNotWaitForDisconnectedNetwork)
+    {
+        CIRCDDBMultiClient client(m_clients, true, 20U);
+        m_slow->m_state = 2;
+        client.findUser("F4FXL   ");
+        m_fast->answer("F4FXL   ", "", "");
+        m_fast->release();
+
+        std::string address = "unchanged";
+        EXPECT_TRUE(waitAnswer(client, address, std::chrono::milliseconds(50)));
+        EXPECT_TRUE(address.empty());
+    }
+
+    TEST_F(IRCDDBMultiClient_getMessageType, NetworksAboveMaskWidthAreIgnored)
+    {
+        // The two fixture networks plus 30 more, the last one does not fit in the masks
+        std::vector<CFakeIRCDDB *> fakes = { m_fast, m_slow };
+        while(fakes.size() < 32U)
+            fakes.push_back(new CFakeIRCDDB());
+        CIRCDDB_Array clients(fakes.begin(), fakes.end());
+
+        CIRCDDBMultiClient client(clients, true, 20U);
+        client.findUser("F4FXL   ");
+        for(unsigned int i = 0U; i < 31U; i++) {
+            EXPECT_EQ(fakes[i]->m_queries.size(), 1U);
+            fakes[i]->answer("F4FXL   ", "", "");
+            fakes[i]->release();
+        }
+
+        std::string address = "unchanged";
+        EXPECT_TRUE(waitAnswer(client, address, std::chrono::milliseconds(500)));
+        EXPECT_TRUE(address.empty());
+    }
+}
@@ -0,0 +1,76 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+#include <regex>
+
+#include "IRCDDBSanitizer.h"
+
+namespace IRCDDBSanitizerTests
+{
+
+    class IRCDDBSanitizer_removeNonGraph : public ::testing::Test {
+    
+    };
+
+    TEST_F(IRCDDBSanitizer_removeNonGraph, SpacesAndControlsAreRemoved)
+    {
+        std::string text(" linux_DStarGateway-1.0\t20220524\r\n");
+        IRCDDBSanitizer::removeNonGraph(text);
+
+        EXPECT_EQ(text, "linux_DStarGateway-1.020220524");
+    }
+
+    TEST_F(IRCDDBSanitizer_removeNonGraph, MatchesFormerRegex)
+    {
+        std::string all;
+        for(unsigned int i = 1U; i < 128U; i++)
+            all.push_back(char(i));
+
+        std::string expected = std::regex_replace(all, std::regex("[^[:graph:]]"), "");
+        std::string text(all);
+        IRCDDBSanitizer::removeNonGraph(text);
+
+        EXPECT_EQ(text, expected);
+    }
+
+    class IRCDDBSanitizer_removeNonDescription : public ::testing::Test {
+    
+    };
+
+    TEST_F(IRCDDBSanitizer_removeNonDescription, ForbiddenCharactersAreRemoved)
+    {
+        std::string text("Strasbourg, France! <Cathedral>");
+        IRCDDBSanitizer::removeNonDescription(text);
+
+        EXPECT_EQ(text, "Strasbourg, France Cathedral");
+    }
+
+    TEST_F(IRCDDBSanitizer_removeNonDescription, MatchesFormerRegex)
+    {
+        std::string all;
+        for(unsigned int i = 1U; i < 256U; i++)
+            all.push_back(char(i));
+
+        std::string expected = std::regex_replace(all, std::regex("[^a-zA-Z0-9 +&(),./'-]"), "");
+        std::string text(all);
+        IRCDDBSanitizer::removeNonDescription(text);
+
+        EXPECT_EQ(text, expected);
+    }
+}
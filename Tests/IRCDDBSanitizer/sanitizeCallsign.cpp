@@ -0,0 +1,69 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+#include <regex>
+
+#include "IRCDDBSanitizer.h"
+
+namespace IRCDDBSanitizerTests
+{
+
+    class IRCDDBSanitizer_sanitizeCallsign : public ::testing::Test {
+    
+    };
+
+    TEST_F(IRCDDBSanitizer_sanitizeCallsign, SpacesAndLowerCaseAreReplaced)
+    {
+        std::string callsign("F4fxl  B");
+        IRCDDBSanitizer::sanitizeCallsign(callsign);
+
+        EXPECT_EQ(callsign, "F4_____B");
+    }
+
+    TEST_F(IRCDDBSanitizer_sanitizeCallsign, AllowedCharactersAreKept)
+    {
+        std::string callsign("F4FXL/P_");
+        IRCDDBSanitizer::sanitizeCallsign(callsign);
+
+        EXPECT_EQ(callsign, "F4FXL/P_");
+    }
+
+    TEST_F(IRCDDBSanitizer_sanitizeCallsign, MatchesFormerRegex)
+    {
+        std::string all;
+        for(unsigned int i = 1U; i < 256U; i++)
+            all.push_back(char(i));
+
+        std::string expected = std::regex_replace(all, std::regex("[^A-Z0-9/_]"), "_");
+        std::string callsign(all);
+        IRCDDBSanitizer::sanitizeCallsign(callsign);
+
+        EXPECT_EQ(callsign, expected);
+    }
+
+    TEST_F(IRCDDBSanitizer_sanitizeCallsign, AppendKeepsBufferContent)
+    {
+        std::string buffer("UPDATE ");
+        IRCDDBSanitizer::appendCallsign(buffer, "F4FXL  B");
+        buffer.push_back(' ');
+        IRCDDBSanitizer::appendCallsign(buffer, "CQCQCQ  ");
+
+        EXPECT_EQ(buffer, "UPDATE F4FXL__B CQCQCQ__");
+    }
+}
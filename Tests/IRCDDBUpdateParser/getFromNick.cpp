@@ -0,0 +1,48 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+
+#include "IRCDDBUpdateParser.h"
+
+namespace IRCDDBUpdateParserTests
+{
+
+    class IRCDDBUpdateParser_getFromNick : public ::testing::Test {
+    
+    };
+
+    TEST_F(IRCDDBUpdateParser_getFromNick, NickIsExtracted)
+    {
+        EXPECT_EQ(IRCDDBUpdateParser::getFromNick("2022-05-24 09:15:32 F4FXL___ F4FXL__B (from: f4fxl-1)"), "f4fxl-1");
+    }
+
+    TEST_F(IRCDDBUpdateParser_getFromNick, NoTrailerGivesEmptyNick)
+    {
+        EXPECT_TRUE(IRCDDBUpdateParser::getFromNick("2022-05-24 09:15:32 F4FXL___ F4FXL__B").empty());
+        EXPECT_TRUE(IRCDDBUpdateParser::getFromNick("2022-05-24 09:15:32 F4FXL___ F4FXL__B (from: f4fxl-1").empty());
+        EXPECT_TRUE(IRCDDBUpdateParser::getFromNick("(from: f4fxl-1\n)").empty());
+    }
+
+    TEST_F(IRCDDBUpdateParser_getFromNick, MatchesUpToLastParenthesis)
+    {
+        // Same as the greedy "\(from: (.*)\)" regular expression it replaces
+        EXPECT_EQ(IRCDDBUpdateParser::getFromNick("(from: a) (b)"), "a) (b");
+        EXPECT_EQ(IRCDDBUpdateParser::getFromNick("(from: )"), "");
+    }
+}
@@ -0,0 +1,110 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+
+#include "IRCDDBUpdateParser.h"
+
+namespace IRCDDBUpdateParserTests
+{
+
+    class IRCDDBUpdateParser_parse : public ::testing::Test {
+    
+    };
+
+    TEST_F(IRCDDBUpdateParser_parse, UserRow)
+    {
+        TIRCDDBUpdate update;
+        auto res = IRCDDBUpdateParser::parse("2022-05-24 09:15:32 F4FXL___ F4FXL__B (from: f4fxl-1)", 2, update);
+
+        EXPECT_EQ(res, IUR_VALID);
+        EXPECT_EQ(update.tableID, 0);
+        EXPECT_EQ(update.date, "2022-05-24");
+        EXPECT_EQ(update.time, "09:15:32");
+        EXPECT_EQ(update.key, "F4FXL___");
+        EXPECT_EQ(update.value, "F4FXL__B");
+    }
+
+    TEST_F(IRCDDBUpdateParser_parse, RepeaterRowWithExtraWhiteSpace)
+    {
+        TIRCDDBUpdate update;
+        auto res = IRCDDBUpdateParser::parse("  1\t2022-12-31   23:59:59 F4FXL__B F4FXL__G  ", 2, update);
+
+        EXPECT_EQ(res, IUR_VALID);
+        EXPECT_EQ(update.tableID, 1);
+        EXPECT_EQ(update.date, "2022-12-31");
+        EXPECT_EQ(update.time, "23:59:59");
+        EXPECT_EQ(update.key, "F4FXL__B");
+        EXPECT_EQ(update.value, "F4FXL__G");
+    }
+
+    TEST_F(IRCDDBUpdateParser_parse, TableOutOfRange)
+    {
+        TIRCDDBUpdate update;
+        auto res = IRCDDBUpdateParser::parse("2 2022-05-24 09:15:32 F4FXL___ F4FXL__B", 2, update);
+
+        EXPECT_EQ(res, IUR_INVALID_TABLE);
+        EXPECT_EQ(update.tableID, 2);
+    }
+
+    TEST_F(IRCDDBUpdateParser_parse, InvalidLines)
+    {
+        const char* lines[] = {
+            "",
+            "   ",
+            "1",
+            "2022-05-24",
+            "2022-05-24 09:15:32",
+            "2022-05-24 09:15:32 F4FXL___",
+            "1922-05-24 09:15:32 F4FXL___ F4FXL__B",	// year not 20xx
+            "2022-13-24 09:15:32 F4FXL___ F4FXL__B",	// month
+            "2022-00-24 09:15:32 F4FXL___ F4FXL__B",
+            "2022-05-32 09:15:32 F4FXL___ F4FXL__B",	// day
+            "2022-05-00 09:15:32 F4FXL___ F4FXL__B",
+            "2022-5-24 09:15:32 F4FXL___ F4FXL__B",
+            "2022-05-24 24:15:32 F4FXL___ F4FXL__B",	// hour
+            "2022-05-24 09:60:32 F4FXL___ F4FXL__B",	// minute
+            "2022-05-24 09:15:60 F4FXL___ F4FXL__B",	// second
+            "2022-05-24 09:15 F4FXL___ F4FXL__B",
+            "2022-05-24 09:15:32 f4fxl___ F4FXL__B",	// lower case key
+            "2022-05-24 09:15:32 F4FXL__ F4FXL__B",	// short key
+            "2022-05-24 09:15:32 F4FXL___ F4FXL B",	// space in value
+            "2022-05-24 09:15:32 F4FXL___ F4FXL__BB",	// long value
+            "12 2022-05-24 09:15:32 F4FXL___ F4FXL__B",	// two digits table
+        };
+
+        for(auto line : lines) {
+            TIRCDDBUpdate update;
+            EXPECT_EQ(IRCDDBUpdateParser::parse(line, 2, update), IUR_INVALID) << line;
+        }
+    }
+
+    TEST_F(IRCDDBUpdateParser_parse, TimeIsLocalTime)
+    {
+        struct tm expected = {};
+        expected.tm_year = 2022 - 1900;
+        expected.tm_mon = 4;
+        expected.tm_mday = 24;
+        expected.tm_hour = 9;
+        expected.tm_min = 15;
+        expected.tm_sec = 32;
+        expected.tm_isdst = -1;
+
+        EXPECT_EQ(IRCDDBUpdateParser::parseTime("2022-05-24", "09:15:32"), mktime(&expected));
+    }
+}
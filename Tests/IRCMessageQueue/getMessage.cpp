@@ -0,0 +1,64 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+
+#include "IRCMessageQueue.h"
+
+namespace IRCMessageQueueTests
+{
+
+    class IRCMessageQueue_getMessage : public ::testing::Test {
+    
+    };
+
+    TEST_F(IRCMessageQueue_getMessage, EmptyQueueGivesNull)
+    {
+        IRCMessageQueue queue;
+
+        EXPECT_FALSE(queue.messageAvailable());
+        EXPECT_EQ(queue.peekFirst(), nullptr);
+        EXPECT_EQ(queue.getMessage(), nullptr);
+    }
+
+    TEST_F(IRCMessageQueue_getMessage, MessagesComeOutInOrder)
+    {
+        IRCMessageQueue queue;
+        IRCMessage * m1 = new IRCMessage("PING");
+        IRCMessage * m2 = new IRCMessage("PONG");
+        queue.putMessage(m1);
+        queue.putMessage(m2);
+
+        EXPECT_TRUE(queue.messageAvailable());
+        EXPECT_EQ(queue.peekFirst(), m1);
+        EXPECT_EQ(queue.getMessage(), m1);
+
+        // Put while the consumer still has drained messages pending
+        IRCMessage * m3 = new IRCMessage("JOIN");
+        queue.putMessage(m3);
+
+        EXPECT_EQ(queue.getMessage(), m2);
+        EXPECT_EQ(queue.peekFirst(), m3);
+        EXPECT_EQ(queue.getMessage(), m3);
+        EXPECT_FALSE(queue.messageAvailable());
+
+        delete m1;
+        delete m2;
+        delete m3;
+    }
+}
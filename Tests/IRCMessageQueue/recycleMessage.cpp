@@ -0,0 +1,71 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+
+#include "IRCMessageQueue.h"
+
+namespace IRCMessageQueueTests
+{
+
+    class IRCMessageQueue_recycleMessage : public ::testing::Test {
+    
+    };
+
+    TEST_F(IRCMessageQueue_recycleMessage, RecycledMessageIsReusedCleared)
+    {
+        IRCMessageQueue queue;
+        IRCMessage * m = queue.getFreeMessage();
+        m->m_prefix.assign("s-grp1s1!s-grp1s1@ircddb.net");
+        m->m_command.assign("PRIVMSG");
+        m->newParam().assign("dstargw-1");
+        m->newParam().assign("UPDATE 2022-05-24 10:00:00 F4FXL___ F4FXL__B");
+        EXPECT_EQ(m->getPrefixNick(), "s-grp1s1");
+
+        queue.recycleMessage(m);
+        IRCMessage * reused = queue.getFreeMessage();
+
+        EXPECT_EQ(reused, m);
+        EXPECT_TRUE(reused->m_prefix.empty());
+        EXPECT_TRUE(reused->m_command.empty());
+        EXPECT_EQ(reused->getParamCount(), 0);
+        EXPECT_EQ(reused->m_numParams, 0);
+
+        reused->m_prefix.assign("nick!name@host");
+        EXPECT_EQ(reused->getPrefixNick(), "nick");
+
+        queue.recycleMessage(reused);
+    }
+
+    TEST_F(IRCMessageQueue_recycleMessage, NewParamStartsEmpty)
+    {
+        IRCMessageQueue queue;
+        IRCMessage * m = queue.getFreeMessage();
+        m->newParam().assign("first");
+        queue.recycleMessage(m);
+
+        m = queue.getFreeMessage();
+        std::string& param = m->newParam();
+
+        EXPECT_TRUE(param.empty());
+        EXPECT_EQ(m->m_numParams, 1);
+        EXPECT_EQ(m->getParamCount(), 1);
+
+        queue.recycleMessage(m);
+    }
+}
@@ -0,0 +1,73 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+
+#include "LoopProfiler.h"
+
+namespace LoopProfilerTests
+{
+
+    class LoopProfiler_getMetrics : public ::testing::Test {
+    protected:
+        void TearDown() override
+        {
+            CLoopProfiler::setEnabled(false);
+            CLoopProfiler::reset();
+        }
+    };
+
+    TEST_F(LoopProfiler_getMetrics, DisabledProfilerRecordsNothing)
+    {
+        CLoopProfiler::setEnabled(false);
+        CLoopProfiler::reset();
+
+        CLoopProfiler::beginIteration();
+        CLoopProfiler::mark(LS_REPEATER);
+        CLoopProfiler::endIteration();
+
+        std::vector<std::string> metrics;
+        CLoopProfiler::getMetrics(metrics);
+
+        EXPECT_TRUE(metrics.empty());
+    }
+
+    TEST_F(LoopProfiler_getMetrics, EnabledProfilerRecordsEachMarkedStage)
+    {
+        CLoopProfiler::setSummaryInterval(0U);
+        CLoopProfiler::setTickInterval(5U);
+        CLoopProfiler::setEnabled(true);
+        CLoopProfiler::reset();
+
+        for(unsigned int i = 0U; i < 3U; i++) {
+            CLoopProfiler::beginIteration();
+            CLoopProfiler::mark(LS_REPEATER);
+            CLoopProfiler::mark(LS_CLOCK);
+            CLoopProfiler::endIteration();
+        }
+
+        std::vector<std::string> metrics;
+        CLoopProfiler::getMetrics(metrics);
+
+        ASSERT_EQ(metrics.size(), 4U);
+        EXPECT_EQ(metrics[0].find("loop.busy count=3 "), 0U);
+        EXPECT_EQ(metrics[1].find("loop.lag count=2 "), 0U);
+        EXPECT_EQ(metrics[2].find("loop.repeater count=3 "), 0U);
+        EXPECT_EQ(metrics[3].find("loop.clock count=3 "), 0U);
+    }
+}
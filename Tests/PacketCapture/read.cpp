@@ -0,0 +1,98 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <cstdio>
+#include <unistd.h>
+
+#include "PacketCapture.h"
+#include "NetUtils.h"
+
+namespace PacketCaptureTests
+{
+
+    class PacketCapture_read : public ::testing::Test {
+    protected:
+        std::string m_fileName;
+
+        void SetUp() override
+        {
+            m_fileName = "/tmp/dgw_packetcapture_" + std::to_string(::getpid()) + ".dgwcap";
+        }
+
+        void TearDown() override
+        {
+            ::remove(m_fileName.c_str());
+        }
+    };
+
+    TEST_F(PacketCapture_read, ReadsBackWrittenRecords)
+    {
+        struct sockaddr_storage address;
+        ::memset(&address, 0, sizeof(address));
+        address.ss_family = AF_INET;
+        TOIPV4(address)->sin_addr.s_addr = htonl(0x7F000001U);
+        TOIPV4(address)->sin_port = htons(20011U);
+
+        const unsigned char data1[] = { 'D', 'S', 'R', 'P', 0x00U };
+        const unsigned char data2[] = { 0x01U, 0x02U, 0x03U };
+
+        CPacketCaptureWriter writer(m_fileName);
+        ASSERT_TRUE(writer.open());
+        writer.write(0x0102030405060708ULL, 20010U, CD_INCOMING, address, data1, sizeof(data1));
+        writer.write(42U, 30001U, CD_OUTGOING, address, data2, sizeof(data2));
+        writer.close();
+
+        EXPECT_EQ(writer.getCount(), 2U);
+
+        CPacketCaptureReader reader(m_fileName);
+        ASSERT_TRUE(reader.open());
+
+        TCapturedPacket packet;
+        ASSERT_TRUE(reader.read(packet));
+        EXPECT_EQ(packet.time, 0x0102030405060708ULL);
+        EXPECT_EQ(packet.localPort, 20010U);
+        EXPECT_EQ(packet.direction, CD_INCOMING);
+        EXPECT_EQ(packet.address.ss_family, AF_INET);
+        EXPECT_EQ(TOIPV4(packet.address)->sin_addr.s_addr, htonl(0x7F000001U));
+        EXPECT_EQ(ntohs(TOIPV4(packet.address)->sin_port), 20011U);
+        ASSERT_EQ(packet.data.size(), sizeof(data1));
+        EXPECT_EQ(::memcmp(packet.data.data(), data1, sizeof(data1)), 0);
+
+        ASSERT_TRUE(reader.read(packet));
+        EXPECT_EQ(packet.time, 42U);
+        EXPECT_EQ(packet.localPort, 30001U);
+        EXPECT_EQ(packet.direction, CD_OUTGOING);
+        ASSERT_EQ(packet.data.size(), sizeof(data2));
+        EXPECT_EQ(::memcmp(packet.data.data(), data2, sizeof(data2)), 0);
+
+        EXPECT_FALSE(reader.read(packet));
+    }
+
+    TEST_F(PacketCapture_read, RejectsFileWithoutHeader)
+    {
+        FILE* file = ::fopen(m_fileName.c_str(), "wb");
+        ASSERT_NE(file, nullptr);
+        ::fputs("not a capture", file);
+        ::fclose(file);
+
+        CPacketCaptureReader reader(m_fileName);
+        EXPECT_FALSE(reader.open());
+    }
+}
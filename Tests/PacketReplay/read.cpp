@@ -0,0 +1,121 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <cstdio>
+#include <unistd.h>
+
+#include "PacketReplay.h"
+#include "NetUtils.h"
+
+namespace PacketReplayTests
+{
+
+    class PacketReplay_read : public ::testing::Test {
+    protected:
+        std::string m_fileName;
+        struct sockaddr_storage m_address;
+
+        void SetUp() override
+        {
+            m_fileName = "/tmp/dgw_packetreplay_" + std::to_string(::getpid()) + ".dgwcap";
+
+            ::memset(&m_address, 0, sizeof(m_address));
+            m_address.ss_family = AF_INET;
+            TOIPV4(m_address)->sin_addr.s_addr = htonl(0x7F000001U);
+            TOIPV4(m_address)->sin_port = htons(20011U);
+
+            // Two datagrams 20ms apart on port 20010, one outgoing that must not be replayed, one on another port
+            const unsigned char data[] = { 0x01U, 0x02U };
+            CPacketCaptureWriter writer(m_fileName);
+            writer.open();
+            writer.write(1000000000ULL, 20010U, CD_INCOMING, m_address, data, sizeof(data));
+            writer.write(1005000000ULL, 20010U, CD_OUTGOING, m_address, data, sizeof(data));
+            writer.write(1020000000ULL, 20010U, CD_INCOMING, m_address, data, sizeof(data));
+            writer.write(1020000000ULL, 30001U, CD_INCOMING, m_address, data, sizeof(data));
+            writer.close();
+        }
+
+        void TearDown() override
+        {
+            ::remove(m_fileName.c_str());
+        }
+    };
+
+    TEST_F(PacketReplay_read, DeliversDatagramsWhenTheyAreDue)
+    {
+        CPacketReplay replay(m_fileName, "");
+        ASSERT_TRUE(replay.open());
+
+        unsigned char buffer[10U];
+        struct sockaddr_storage address;
+
+        EXPECT_EQ(replay.read(20010U, buffer, sizeof(buffer), address), 2);
+        EXPECT_EQ(ntohs(TOIPV4(address)->sin_port), 20011U);
+        EXPECT_EQ(replay.read(20010U, buffer, sizeof(buffer), address), 0) << "Second datagram is not due yet";
+
+        replay.clock(10U);
+        EXPECT_EQ(replay.read(20010U, buffer, sizeof(buffer), address), 0);
+
+        replay.clock(10U);
+        EXPECT_EQ(replay.read(20010U, buffer, sizeof(buffer), address), 2);
+        EXPECT_EQ(replay.read(30001U, buffer, sizeof(buffer), address), 2);
+        EXPECT_EQ(replay.read(20010U, buffer, sizeof(buffer), address), 0) << "Outgoing datagrams are not replayed";
+
+        EXPECT_EQ(replay.getDelivered(), 3U);
+        EXPECT_EQ(replay.getUnclaimed(), 0U);
+    }
+
+    TEST_F(PacketReplay_read, FinishesAfterDrainingPastLastDatagram)
+    {
+        CPacketReplay replay(m_fileName, "");
+        ASSERT_TRUE(replay.open());
+
+        replay.clock(20U);
+        EXPECT_FALSE(replay.isFinished());
+
+        replay.clock(6000U);
+        EXPECT_TRUE(replay.isFinished());
+    }
+
+    TEST_F(PacketReplay_read, WritesOutgoingDatagramsAtSimulatedTime)
+    {
+        std::string output = m_fileName + ".out";
+        CPacketReplay replay(m_fileName, output);
+        ASSERT_TRUE(replay.open());
+
+        const unsigned char data[] = { 0x03U };
+        replay.clock(15U);
+        EXPECT_TRUE(replay.write(20010U, data, sizeof(data), m_address));
+        EXPECT_EQ(replay.getWritten(), 1U);
+        replay.close();
+
+        CPacketCaptureReader reader(output);
+        ASSERT_TRUE(reader.open());
+
+        TCapturedPacket packet;
+        ASSERT_TRUE(reader.read(packet));
+        EXPECT_EQ(packet.time, 15000000ULL);
+        EXPECT_EQ(packet.direction, CD_OUTGOING);
+        EXPECT_EQ(packet.localPort, 20010U);
+
+        reader.close();
+        ::remove(output.c_str());
+    }
+}
@@ -0,0 +1,131 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "PlayoutScheduler.h"
+
+namespace PlayoutSchedulerTests
+{
+    class FakeRepeater : public IRepeaterCallback, public IPlayoutSource {
+    public:
+        bool process(CHeaderData&, DIRECTION, AUDIO_SOURCE) override
+        {
+            return true;
+        }
+
+        bool process(CAMBEData& data, DIRECTION, AUDIO_SOURCE source) override
+        {
+            unsigned char buffer[DV_FRAME_LENGTH_BYTES];
+            data.getData(buffer, DV_FRAME_LENGTH_BYTES);
+
+            m_payloads.push_back(buffer[0]);
+            m_ids.push_back(data.getId());
+            m_seqs.push_back(data.getSeq());
+            m_ends.push_back(data.isEnd());
+            m_source = source;
+            return true;
+        }
+
+        void getFrame(unsigned int n, unsigned char* data) override
+        {
+            ::memset(data, 0, DV_FRAME_LENGTH_BYTES);
+            data[0] = n;
+        }
+
+        std::vector<unsigned char> m_payloads;
+        std::vector<unsigned int> m_ids;
+        std::vector<unsigned int> m_seqs;
+        std::vector<bool> m_ends;
+        AUDIO_SOURCE m_source = AS_DUP;
+    };
+
+    class PlayoutScheduler_clock : public ::testing::Test {
+    protected:
+        void TearDown() override
+        {
+            CPlayoutScheduler::reset();
+        }
+    };
+
+    TEST_F(PlayoutScheduler_clock, nothingBeforeFirstDeadline)
+    {
+        FakeRepeater repeater;
+        CPlayoutScheduler scheduler(&repeater, &repeater, AS_ECHO);
+
+        EXPECT_FALSE(scheduler.clock()) << "An idle scheduler has nothing to release";
+
+        scheduler.start(0x1234U, 3U);
+        EXPECT_TRUE(scheduler.isPlaying());
+        EXPECT_FALSE(scheduler.clock());
+        EXPECT_TRUE(repeater.m_payloads.empty()) << "The first frame follows the header by one frame time";
+
+        scheduler.stop();
+        EXPECT_FALSE(scheduler.isPlaying());
+    }
+
+    TEST_F(PlayoutScheduler_clock, overdueFramesAreReleasedAndCounted)
+    {
+        FakeRepeater repeater;
+        CPlayoutScheduler scheduler(&repeater, &repeater, AS_VERSION);
+
+        scheduler.start(0x1234U, 23U);
+        std::this_thread::sleep_for(std::chrono::milliseconds(23U * DSTAR_FRAME_TIME_MS + 10U));
+        EXPECT_TRUE(scheduler.clock());
+        EXPECT_FALSE(scheduler.isPlaying());
+
+        ASSERT_EQ(repeater.m_payloads.size(), 23U);
+        EXPECT_EQ(repeater.m_source, AS_VERSION);
+        for (unsigned int i = 0U; i < 23U; i++) {
+            EXPECT_EQ(repeater.m_payloads[i], i);
+            EXPECT_EQ(repeater.m_ids[i], 0x1234U);
+            EXPECT_EQ(repeater.m_seqs[i], i % 21U);
+            EXPECT_EQ(repeater.m_ends[i], i == 22U);
+        }
+
+        EXPECT_EQ(scheduler.getBursts(), 1U);
+        EXPECT_GE(scheduler.getLate(), 22U);
+
+        std::vector<std::string> metrics;
+        CPlayoutScheduler::getMetrics(metrics);
+        ASSERT_EQ(metrics.size(), 3U);
+        EXPECT_EQ(metrics[0].find("playout.lateness count=23 "), 0U);
+        EXPECT_EQ(metrics[2], "playout.bursts count=1");
+    }
+
+    TEST_F(PlayoutScheduler_clock, sleepWakesUpForDeadlines)
+    {
+        FakeRepeater repeater;
+        CPlayoutScheduler scheduler(&repeater, &repeater, AS_INFO);
+
+        scheduler.start(1U, 5U);
+
+        unsigned int iterations = 0U;
+        while (!scheduler.clock() && iterations < 1000U) {
+            CPlayoutScheduler::sleep(100U);
+            iterations++;
+        }
+
+        ASSERT_EQ(repeater.m_payloads.size(), 5U);
+        EXPECT_LT(iterations, 20U) << "Sleeping shall stop at the next deadline rather than the requested time";
+    }
+}
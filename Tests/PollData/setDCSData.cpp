@@ -0,0 +1,66 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+#include <netinet/in.h>
+
+#include "PollData.h"
+#include "DStarDefines.h"
+
+namespace PollDataTests
+{
+    class PollData_setDCSData : public ::testing::Test {
+
+    };
+
+    TEST_F(PollData_setDCSData, pollWithNulAfterCallsign)
+    {
+        // A 17 byte DCS poll has a NUL between the two callsigns
+        in_addr address;
+        address.s_addr = htonl(INADDR_LOOPBACK);
+        CPollData outgoing("F4FXL  B", "DCS933 B", DIR_OUTGOING, address, 30051U);
+
+        unsigned char data[22U];
+        unsigned int length = outgoing.getDCSData(data, sizeof(data));
+        ASSERT_EQ(length, 17U);
+
+        CPollData poll;
+        EXPECT_TRUE(poll.setDCSData(data, length, address, 30051U, 30051U));
+        EXPECT_EQ(poll.getData1(), "F4FXL  B");
+        EXPECT_EQ(poll.getData2(), "DCS933 B");
+        EXPECT_EQ(poll.getDirection(), DIR_INCOMING);
+        EXPECT_EQ(poll.getLength(), 17U);
+    }
+
+    TEST_F(PollData_setDCSData, replyWithNulInside)
+    {
+        in_addr address;
+        address.s_addr = htonl(INADDR_LOOPBACK);
+        CPollData incoming("DCS933 B", "F4FXL  B", DIR_INCOMING, address, 30051U);
+
+        unsigned char data[22U];
+        unsigned int length = incoming.getDCSData(data, sizeof(data));
+        ASSERT_EQ(length, 22U);
+
+        CPollData poll;
+        EXPECT_TRUE(poll.setDCSData(data, length, address, 30051U, 30051U));
+        EXPECT_EQ(poll.getData1(), "DCS933 B");
+        EXPECT_EQ(poll.getData2(), "F4FXL  B");
+        EXPECT_EQ(poll.getDirection(), DIR_OUTGOING);
+    }
+}
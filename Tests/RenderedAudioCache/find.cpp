@@ -0,0 +1,88 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+#include "RenderedAudioCache.h"
+#include "DStarDefines.h"
+
+namespace RenderedAudioCacheTests
+{
+    class RenderedAudioCache_find : public ::testing::Test {
+    protected:
+        void SetUp()
+        {
+            CRenderedAudioCache::clear();
+        }
+
+        void TearDown()
+        {
+            CRenderedAudioCache::clear();
+        }
+
+        std::shared_ptr<const CRenderedAudio> makeAudio(unsigned int count, unsigned char fill)
+        {
+            return std::make_shared<const CRenderedAudio>(std::vector<unsigned char>(count * DV_FRAME_LENGTH_BYTES, fill));
+        }
+    };
+
+    TEST_F(RenderedAudioCache_find, missThenHit)
+    {
+        unsigned long hits = CRenderedAudioCache::getHits();
+        unsigned long misses = CRenderedAudioCache::getMisses();
+
+        EXPECT_EQ(CRenderedAudioCache::find(TL_FRANCAIS, LS_LINKED_DEXTRA, "XRF012 C", "Linked to XRF012 C"), nullptr);
+
+        auto audio = makeAudio(50U, 0x55U);
+        CRenderedAudioCache::add(TL_FRANCAIS, LS_LINKED_DEXTRA, "XRF012 C", "Linked to XRF012 C", audio);
+
+        auto found = CRenderedAudioCache::find(TL_FRANCAIS, LS_LINKED_DEXTRA, "XRF012 C", "Linked to XRF012 C");
+        EXPECT_EQ(found, audio);
+        EXPECT_EQ(found->getCount(), 50U);
+        EXPECT_EQ(found->getFrame(49U)[0], 0x55U);
+
+        EXPECT_EQ(CRenderedAudioCache::getHits(), hits + 1UL);
+        EXPECT_EQ(CRenderedAudioCache::getMisses(), misses + 1UL);
+        EXPECT_EQ(CRenderedAudioCache::getSize(), 50U * DV_FRAME_LENGTH_BYTES);
+    }
+
+    TEST_F(RenderedAudioCache_find, keyedOnEveryField)
+    {
+        CRenderedAudioCache::add(TL_FRANCAIS, LS_LINKED_DEXTRA, "XRF012 C", "Linked to XRF012 C", makeAudio(1U, 0x00U));
+
+        EXPECT_EQ(CRenderedAudioCache::find(TL_ENGLISH_UK, LS_LINKED_DEXTRA, "XRF012 C", "Linked to XRF012 C"), nullptr);
+        EXPECT_EQ(CRenderedAudioCache::find(TL_FRANCAIS, LS_LINKING_DEXTRA, "XRF012 C", "Linked to XRF012 C"), nullptr);
+        EXPECT_EQ(CRenderedAudioCache::find(TL_FRANCAIS, LS_LINKED_DEXTRA, "XRF012 B", "Linked to XRF012 C"), nullptr);
+        EXPECT_EQ(CRenderedAudioCache::find(TL_FRANCAIS, LS_LINKED_DEXTRA, "XRF012 C", "Linked to XRF012 B"), nullptr);
+    }
+
+    TEST_F(RenderedAudioCache_find, oldestIsEvictedButStaysUsable)
+    {
+        auto first = makeAudio(2U, 0xAAU);
+        CRenderedAudioCache::add(TL_FRANCAIS, LS_NONE, "", "0", first);
+        for(unsigned int i = 1U; i <= 64U; i++)
+            CRenderedAudioCache::add(TL_FRANCAIS, LS_NONE, "", std::to_string(i), makeAudio(1U, 0x00U));
+
+        EXPECT_EQ(CRenderedAudioCache::find(TL_FRANCAIS, LS_NONE, "", "0"), nullptr);
+        EXPECT_NE(CRenderedAudioCache::find(TL_FRANCAIS, LS_NONE, "", "64"), nullptr);
+        EXPECT_EQ(CRenderedAudioCache::getSize(), 64U * DV_FRAME_LENGTH_BYTES);
+        EXPECT_EQ(first->getFrame(1U)[0], 0xAAU);
+    }
+}
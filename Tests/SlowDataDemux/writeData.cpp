@@ -0,0 +1,115 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+
+#include "SlowDataDemux.h"
+#include "SlowDataEncoder.h"
+#include "TextCollector.h"
+#include "DStarDefines.h"
+
+namespace SlowDataDemuxTests
+{
+    class SlowDataDemux_writeData : public ::testing::Test {
+    protected:
+        CAMBEData frame(const unsigned char* slowData, unsigned int seq, bool end = false)
+        {
+            unsigned char buffer[DV_FRAME_LENGTH_BYTES];
+            ::memcpy(buffer, NULL_AMBE_DATA_BYTES, VOICE_FRAME_LENGTH_BYTES);
+            ::memcpy(buffer + VOICE_FRAME_LENGTH_BYTES, slowData, DATA_FRAME_LENGTH_BYTES);
+
+            CAMBEData data;
+            data.setData(buffer, DV_FRAME_LENGTH_BYTES);
+            data.setSeq(seq);
+            data.setEnd(end);
+
+            return data;
+        }
+
+        std::vector<unsigned char> m_gps;
+        std::vector<unsigned char> m_text;
+    };
+
+    TEST_F(SlowDataDemux_writeData, routesByType)
+    {
+        CSlowDataDemux demux;
+        demux.addHandler(SLOW_DATA_TYPE_GPS, [this](const unsigned char* block) { m_gps.insert(m_gps.end(), block, block + 6U); });
+        demux.addHandler(SLOW_DATA_TYPE_TEXT, [this](const unsigned char* block) { m_text.insert(m_text.end(), block, block + 6U); });
+
+        CSlowDataEncoder encoder;
+        encoder.setGPSData("$GPRMC,1234");
+
+        for (unsigned int i = 1U; i < 21U; i++) {
+            unsigned char slowData[DATA_FRAME_LENGTH_BYTES];
+            encoder.getInterleavedData(slowData);
+            demux.writeData(frame(slowData, i));
+        }
+
+        EXPECT_TRUE(m_text.empty()) << "GPS blocks shall not reach the text handlers";
+        ASSERT_GE(m_gps.size(), 12U);
+        EXPECT_EQ(m_gps[0U], SLOW_DATA_TYPE_GPS | 0x05U) << "blocks shall be descrambled";
+        EXPECT_EQ(::memcmp(m_gps.data() + 1U, "$GPRM", 5U), 0);
+        EXPECT_EQ(::memcmp(m_gps.data() + 7U, "C,123", 5U), 0);
+    }
+
+    TEST_F(SlowDataDemux_writeData, syncRealigns)
+    {
+        CSlowDataDemux demux;
+        demux.addHandler(SLOW_DATA_TYPE_TEXT, [this](const unsigned char* block) { m_text.insert(m_text.end(), block, block + 6U); });
+
+        unsigned char first[DATA_FRAME_LENGTH_BYTES] = { (unsigned char)((SLOW_DATA_TYPE_TEXT | 0x00U) ^ SCRAMBLER_BYTE1), 'A' ^ SCRAMBLER_BYTE2, 'B' ^ SCRAMBLER_BYTE3 };
+        unsigned char second[DATA_FRAME_LENGTH_BYTES] = { 'C' ^ SCRAMBLER_BYTE1, 'D' ^ SCRAMBLER_BYTE2, 'E' ^ SCRAMBLER_BYTE3 };
+
+        // A lone first half, then the sync frame
+        demux.writeData(frame(first, 20U));
+        demux.writeData(frame(DATA_SYNC_BYTES, 0U));
+        EXPECT_TRUE(m_text.empty());
+
+        demux.writeData(frame(first, 1U));
+        demux.writeData(frame(second, 2U));
+        ASSERT_EQ(m_text.size(), 6U);
+        EXPECT_EQ(::memcmp(m_text.data() + 1U, "ABCDE", 5U), 0);
+
+        // End frames carry no slow data
+        demux.writeData(frame(first, 3U));
+        demux.writeData(frame(second, 4U, true));
+        EXPECT_EQ(m_text.size(), 6U);
+    }
+
+    TEST_F(SlowDataDemux_writeData, textCollector)
+    {
+        CTextCollector collector;
+        CSlowDataDemux demux;
+        demux.addHandler(SLOW_DATA_TYPE_TEXT, [&collector](const unsigned char* block) { collector.writeBlock(block); });
+
+        CSlowDataEncoder encoder;
+        encoder.setTextData("Hello from F4FXL");
+        encoder.setGPSData("$$CRC1234,F4FXL>API51:!4898.03N/00844.64E>\r");
+
+        for (unsigned int i = 0U; i < 200U && !collector.hasData(); i++) {
+            unsigned char slowData[DATA_FRAME_LENGTH_BYTES];
+            encoder.getInterleavedData(slowData);
+            demux.writeData(frame(slowData, (i % 20U) + 1U));
+        }
+
+        ASSERT_TRUE(collector.hasData());
+        EXPECT_STREQ(collector.getData().c_str(), "Hello from F4FXL    ");
+    }
+}
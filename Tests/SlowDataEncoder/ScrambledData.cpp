@@ -0,0 +1,107 @@
+/*
+ *   Copyright (C) 2021-2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+
+#include "SlowDataEncoder.h"
+#include "DStarDefines.h"
+
+namespace SlowDataEncoderTests
+{
+    class SlowDataEncoder_scrambledData : public ::testing::Test {
+
+    };
+
+    // Sets one of the eight combinations of header, text and GPS data
+    static void setData(CSlowDataEncoder& encoder, unsigned int combination)
+    {
+        CHeaderData header("F4FXL  B", "ID51", "CQCQCQ  ", "F4FXL  B", "F4FXL  G");
+
+        if((combination & 0x01U) != 0U)
+            encoder.setHeaderData(header);
+        if((combination & 0x02U) != 0U)
+            encoder.setTextData("DStarGateway test");
+        if((combination & 0x04U) != 0U)
+            encoder.setGPSData("$GPGGA,092750.000,5321.6802,N,00630.3372,W,1,8,1.03,61.7,M,55.2,M,,*76\r\n");
+    }
+
+    TEST_F(SlowDataEncoder_scrambledData, sameAsInterleavedData)
+    {
+        // No data at all is left out, getInterleavedData has nothing to walk through then
+        for(unsigned int combination = 1U; combination < 8U; combination++) {
+            CSlowDataEncoder encoder;
+            setData(encoder, combination);
+
+            auto scrambled = encoder.getScrambledData();
+            ASSERT_EQ(scrambled->size() % 60U, 0U) << "combination " << combination;
+
+            // Twice round the cycle
+            for(unsigned int i = 0U; i < 2U * scrambled->size(); i += DATA_FRAME_LENGTH_BYTES) {
+                unsigned char buffer[DATA_FRAME_LENGTH_BYTES];
+                encoder.getInterleavedData(buffer);
+
+                EXPECT_EQ(::memcmp(buffer, scrambled->data() + i % scrambled->size(), DATA_FRAME_LENGTH_BYTES), 0) << "combination " << combination << " offset " << i;
+            }
+        }
+    }
+
+    TEST_F(SlowDataEncoder_scrambledData, cachedUntilDataChanges)
+    {
+        CSlowDataEncoder encoder;
+        encoder.setTextData("DStarGateway test");
+
+        auto first = encoder.getScrambledData();
+        EXPECT_EQ(encoder.getScrambledData(), first) << "Same data shall give the same buffer";
+
+        encoder.setTextData("Other text");
+        auto second = encoder.getScrambledData();
+        EXPECT_NE(second, first);
+        EXPECT_NE(::memcmp(second->data(), first->data(), 60U), 0) << "Previous buffer shall be left untouched";
+    }
+
+    TEST_F(SlowDataEncoder_scrambledData, frames)
+    {
+        const unsigned int COUNT = 100U;
+
+        for(unsigned int combination = 1U; combination < 8U; combination++) {
+            CSlowDataEncoder reference;
+            setData(reference, combination);
+
+            std::vector<unsigned char> expected(COUNT * DV_FRAME_LENGTH_BYTES, 0x00U);
+            for(unsigned int i = 0U; i < COUNT; i++) {
+                unsigned char* buffer = expected.data() + i * DV_FRAME_LENGTH_BYTES;
+                if(i % 21U == 0U) {
+                    ::memcpy(buffer + VOICE_FRAME_LENGTH_BYTES, DATA_SYNC_BYTES, DATA_FRAME_LENGTH_BYTES);
+                    reference.sync();
+                } else {
+                    reference.getInterleavedData(buffer + VOICE_FRAME_LENGTH_BYTES);
+                }
+            }
+
+            CSlowDataEncoder encoder;
+            setData(encoder, combination);
+
+            std::vector<unsigned char> frames(COUNT * DV_FRAME_LENGTH_BYTES, 0x00U);
+            encoder.getScrambledData(frames.data(), COUNT);
+
+            EXPECT_EQ(frames, expected) << "combination " << combination;
+        }
+    }
+}
@@ -0,0 +1,77 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "TCPReaderWriterClient.h"
+
+namespace TCPReaderWriterClientTests
+{
+    class TCPReaderWriterClient_readLine : public ::testing::Test {
+    protected:
+        int m_peer;
+        CTCPReaderWriterClient * m_client;
+
+        void SetUp()
+        {
+            int socks[2];
+            ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, socks), 0);
+            m_client = new CTCPReaderWriterClient(socks[0]);
+            m_peer = socks[1];
+        }
+
+        void TearDown()
+        {
+            m_client->close();
+            delete m_client;
+            ::close(m_peer);
+        }
+    };
+
+    TEST_F(TCPReaderWriterClient_readLine, bufferedLinesAreReadBack)
+    {
+        std::string sent = "# aprsc 2.1.11\r\nF4FXL-B>APDG01:>status\r\nF4FX";
+        ASSERT_EQ(::send(m_peer, sent.data(), sent.length(), 0), ssize_t(sent.length()));
+
+        std::string line;
+        EXPECT_EQ(m_client->readLine(line, 1U), 16);
+        EXPECT_EQ(line, "# aprsc 2.1.11\r\n");
+        EXPECT_TRUE(m_client->hasBufferedData());
+        EXPECT_EQ(m_client->readLine(line, 1U), 24);
+        EXPECT_EQ(line, "F4FXL-B>APDG01:>status\r\n");
+
+        // The unfinished line waits for the rest of it
+        EXPECT_EQ(m_client->readLine(line, 0U), 0);
+        ASSERT_EQ(::send(m_peer, "L\r\n", 3, 0), 3);
+        EXPECT_EQ(m_client->readLine(line, 1U), 7);
+        EXPECT_EQ(line, "F4FXL\r\n");
+    }
+
+    TEST_F(TCPReaderWriterClient_readLine, overlongLineIsAnError)
+    {
+        std::string sent(4096U, 'A');
+        ASSERT_EQ(::send(m_peer, sent.data(), sent.length(), 0), ssize_t(sent.length()));
+
+        std::string line;
+        EXPECT_EQ(m_client->readLine(line, 1U), -1);
+        EXPECT_FALSE(m_client->hasBufferedData());
+    }
+}
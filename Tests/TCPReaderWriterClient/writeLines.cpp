@@ -0,0 +1,90 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "TCPReaderWriterClient.h"
+
+namespace TCPReaderWriterClientTests
+{
+    class TCPReaderWriterClient_writeLines : public ::testing::Test {
+    protected:
+        int m_peer;
+        CTCPReaderWriterClient * m_client;
+
+        void SetUp()
+        {
+            int socks[2];
+            ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, socks), 0);
+            m_client = new CTCPReaderWriterClient(socks[0]);
+            m_peer = socks[1];
+        }
+
+        void TearDown()
+        {
+            m_client->close();
+            delete m_client;
+            ::close(m_peer);
+        }
+
+        std::string receive(size_t length)
+        {
+            std::string received;
+            char buffer[256];
+            while(received.length() < length) {
+                ssize_t len = ::recv(m_peer, buffer, sizeof(buffer), 0);
+                if(len <= 0)
+                    break;
+                received.append(buffer, len);
+            }
+            return received;
+        }
+    };
+
+    TEST_F(TCPReaderWriterClient_writeLines, linesAreSentInOrder)
+    {
+        std::vector<std::string> lines = { "F4FXL-B>APDG01:!4849.00N/00220.00E\r\n", "", "F4FXL-C>APDG01:!4849.00N/00220.00E\r\n" };
+
+        EXPECT_TRUE(m_client->writeLines(lines));
+
+        std::string expected = lines[0] + lines[2];
+        EXPECT_EQ(receive(expected.length()), expected);
+    }
+
+    TEST_F(TCPReaderWriterClient_writeLines, moreLinesThanOneSystemCallTakes)
+    {
+        std::vector<std::string> lines;
+        std::string expected;
+        for(unsigned int i = 0U; i < 2000U; i++) {
+            lines.push_back("F4FXL-" + std::to_string(i) + ">APDG01:>status\r\n");
+            expected.append(lines.back());
+        }
+
+        std::string received;
+        std::thread reader([&]() { received = receive(expected.length()); });
+        EXPECT_TRUE(m_client->writeLines(lines));
+        reader.join();
+
+        EXPECT_EQ(received, expected);
+    }
+}
@@ -0,0 +1,85 @@
+/*
+ *   Copyright (C) 2022 by Geoffrey Merck F4FXL / KC3FRA
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <unistd.h>
+
+#include "UDPReaderWriter.h"
+
+namespace UDPReaderWriterTests
+{
+    class UDPReaderWriter_writeMany : public ::testing::Test {
+    protected:
+        int m_peer;
+        unsigned int m_port;
+
+        void SetUp()
+        {
+            m_peer = ::socket(AF_INET, SOCK_DGRAM, 0);
+            ASSERT_GE(m_peer, 0);
+
+            // Leave room for every datagram sent by the test
+            int size = 1024 * 1024;
+            ::setsockopt(m_peer, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+
+            sockaddr_in addr = {};
+            addr.sin_family = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            ASSERT_EQ(::bind(m_peer, (sockaddr*)&addr, sizeof(addr)), 0);
+
+            socklen_t len = sizeof(addr);
+            ASSERT_EQ(::getsockname(m_peer, (sockaddr*)&addr, &len), 0);
+            m_port = ntohs(addr.sin_port);
+        }
+
+        void TearDown()
+        {
+            ::close(m_peer);
+        }
+    };
+
+    TEST_F(UDPReaderWriter_writeMany, everyDatagramIsSentInOrder)
+    {
+        const unsigned int LENGTH = 27U;
+        const unsigned int COUNT = 40U;
+
+        std::vector<unsigned char> buffer(LENGTH * COUNT);
+        for (unsigned int i = 0U; i < COUNT; i++)
+            std::fill(buffer.begin() + i * LENGTH, buffer.begin() + (i + 1U) * LENGTH, (unsigned char)i);
+
+        CUDPReaderWriter writer("", 0U);
+        ASSERT_TRUE(writer.open());
+
+        in_addr address;
+        address.s_addr = htonl(INADDR_LOOPBACK);
+        EXPECT_TRUE(writer.writeMany(buffer.data(), LENGTH, COUNT, address, m_port));
+        writer.close();
+
+        for (unsigned int i = 0U; i < COUNT; i++) {
+            unsigned char received[64U];
+            ssize_t len = ::recv(m_peer, received, sizeof(received), 0);
+            ASSERT_EQ(len, ssize_t(LENGTH)) << "Datagram " << i;
+            EXPECT_EQ(received[0], i);
+            EXPECT_EQ(received[LENGTH - 1U], i);
+        }
+    }
+}
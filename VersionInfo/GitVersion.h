@@ -0,0 +1,3 @@
+#pragma once
+#include <string>
+const std::string gitversion("064516c");